@@ -618,6 +618,11 @@ std::string TraceInterpreter::executeRecordsWithMarkerOptions() {
       // Do nothing.
       break;
   }
+  if (!options_.interpreterProfile.empty()) {
+    if (auto *hermesRuntime = dynamic_cast<HermesRuntime *>(&rt_)) {
+      hermesRuntime->enableInterpreterProfiler(options_.interpreterProfile);
+    }
+  }
   executeRecords();
 
 #ifdef HERMESVM_PROFILER_BB
@@ -1241,17 +1246,17 @@ std::string TraceInterpreter::printStats() {
   }
   std::string stats = rt_.instrumentation().getRecordedGCStats();
   ::hermes::vm::instrumentation::PerfEvents::endAndInsertStats(stats);
-#ifdef HERMESVM_PROFILER_OPCODE
-  stats += "\n";
-  std::ostringstream os;
-  if (auto *hermesRuntime = dynamic_cast<HermesRuntime *>(&rt_)) {
-    hermesRuntime->dumpOpcodeStats(os);
-  } else {
-    throw std::runtime_error("Unable to cast runtime into HermesRuntime");
+  if (!options_.interpreterProfile.empty()) {
+    stats += "\n";
+    std::ostringstream os;
+    if (auto *hermesRuntime = dynamic_cast<HermesRuntime *>(&rt_)) {
+      hermesRuntime->disableInterpreterProfiler();
+      hermesRuntime->dumpInterpreterProfile(os);
+    } else {
+      throw std::runtime_error("Unable to cast runtime into HermesRuntime");
+    }
+    stats += os.str();
   }
-  stats += os.str();
-  stats += "\n";
-#endif
   return stats;
 }
 
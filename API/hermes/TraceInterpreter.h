@@ -89,6 +89,11 @@ class TraceInterpreter final {
     /// Output file name for any profiling information.
     std::string profileFileName;
 
+    /// If not empty, profile the interpreter while replaying, and add the
+    /// profile to the stats. See HermesRuntime::enableInterpreterProfiler()
+    /// for the format.
+    std::string interpreterProfile;
+
     // These are the config parameters.  We wrap them in llvh::Optional
     // to indicate whether the corresponding command line flag was set
     // explicitly.  We override the trace's config only when that is true.
@@ -497,6 +497,9 @@ void CDPAgentImpl::DomainAgentsImpl::handleCommand(
     } else if (method == "stopSampling") {
       heapProfilerAgent_->stopSampling(
           static_cast<m::heapProfiler::StopSamplingRequest &>(*command));
+    } else if (method == "getSamplingProfile") {
+      heapProfilerAgent_->getSamplingProfile(
+          static_cast<m::heapProfiler::GetSamplingProfileRequest &>(*command));
     } else {
       handled = false;
     }
@@ -301,6 +301,36 @@ void HeapProfilerDomainAgent::stopSampling(
 #endif // HERMES_MEMORY_INSTRUMENTATION
 }
 
+void HeapProfilerDomainAgent::getSamplingProfile(
+    const m::heapProfiler::GetSamplingProfileRequest &req) {
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  if (!samplingHeap_) {
+    sendResponseToClient(m::makeErrorResponse(
+        req.id, m::ErrorCode::InvalidRequest, "Heap sampling not active"));
+    return;
+  }
+
+  // Unlike stopSampling, keep sampling, so that a client can take profiles
+  // periodically from a long running session.
+  std::ostringstream stream;
+  runtime_.heapSamplingProfileToStream(stream);
+
+  m::heapProfiler::GetSamplingProfileResponse resp;
+  auto profile = m::heapProfiler::makeSamplingHeapProfile(stream.str());
+  if (profile == nullptr) {
+    sendResponseToClient(m::makeErrorResponse(
+        req.id, m::ErrorCode::InternalError, "Failed to create profile"));
+    return;
+  }
+  resp.id = req.id;
+  resp.profile = std::move(*profile);
+  sendResponseToClient(resp);
+#else
+  sendResponseToClient(m::makeErrorResponse(
+      req.id, m::ErrorCode::InvalidRequest, kNoInstrumentation));
+#endif // HERMES_MEMORY_INSTRUMENTATION
+}
+
 } // namespace cdp
 } // namespace hermes
 } // namespace facebook
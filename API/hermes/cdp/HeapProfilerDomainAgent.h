@@ -54,6 +54,10 @@ class HeapProfilerDomainAgent : public DomainAgent {
   /// Handle HeapProfiler.stopSampling
   void stopSampling(const m::heapProfiler::StopSamplingRequest &req);
 
+  /// Handle HeapProfiler.getSamplingProfile
+  void getSamplingProfile(
+      const m::heapProfiler::GetSamplingProfileRequest &req);
+
  private:
   void sendSnapshot(int reqId, bool reportProgress, bool captureNumericValue);
 
@@ -117,6 +117,8 @@ std::unique_ptr<Request> Request::fromJson(const std::string &str) {
        tryMake<heapProfiler::GetHeapObjectIdRequest>},
       {"HeapProfiler.getObjectByHeapObjectId",
        tryMake<heapProfiler::GetObjectByHeapObjectIdRequest>},
+      {"HeapProfiler.getSamplingProfile",
+       tryMake<heapProfiler::GetSamplingProfileRequest>},
       {"HeapProfiler.startSampling",
        tryMake<heapProfiler::StartSamplingRequest>},
       {"HeapProfiler.startTrackingHeapObjects",
@@ -1343,6 +1345,32 @@ void heapProfiler::GetObjectByHeapObjectIdRequest::accept(
   handler.handle(*this);
 }
 
+heapProfiler::GetSamplingProfileRequest::GetSamplingProfileRequest()
+    : Request("HeapProfiler.getSamplingProfile") {}
+
+std::unique_ptr<heapProfiler::GetSamplingProfileRequest>
+heapProfiler::GetSamplingProfileRequest::tryMake(const JSONObject *obj) {
+  std::unique_ptr<heapProfiler::GetSamplingProfileRequest> req =
+      std::make_unique<heapProfiler::GetSamplingProfileRequest>();
+  TRY_ASSIGN(req->id, obj, "id");
+  TRY_ASSIGN(req->method, obj, "method");
+
+  return req;
+}
+
+JSONValue *heapProfiler::GetSamplingProfileRequest::toJsonVal(
+    JSONFactory &factory) const {
+  llvh::SmallVector<JSONFactory::Prop, 1> props;
+  put(props, "id", id, factory);
+  put(props, "method", method, factory);
+  return factory.newObject(props.begin(), props.end());
+}
+
+void heapProfiler::GetSamplingProfileRequest::accept(
+    RequestHandler &handler) const {
+  handler.handle(*this);
+}
+
 heapProfiler::StartSamplingRequest::StartSamplingRequest()
     : Request("HeapProfiler.startSampling") {}
 
@@ -2332,6 +2360,39 @@ JSONValue *heapProfiler::GetObjectByHeapObjectIdResponse::toJsonVal(
   return factory.newObject(props.begin(), props.end());
 }
 
+std::unique_ptr<heapProfiler::GetSamplingProfileResponse>
+heapProfiler::GetSamplingProfileResponse::tryMake(const JSONObject *obj) {
+  std::unique_ptr<heapProfiler::GetSamplingProfileResponse> resp =
+      std::make_unique<heapProfiler::GetSamplingProfileResponse>();
+  TRY_ASSIGN(resp->id, obj, "id");
+
+  JSONValue *v = obj->get("result");
+  if (v == nullptr) {
+    return nullptr;
+  }
+  auto convertResult = valueFromJson<JSONObject *>(v);
+  if (!convertResult) {
+    return nullptr;
+  }
+  auto *res = *convertResult;
+  TRY_ASSIGN(resp->profile, res, "profile");
+  return resp;
+}
+
+JSONValue *heapProfiler::GetSamplingProfileResponse::toJsonVal(
+    JSONFactory &factory) const {
+  llvh::SmallVector<JSONFactory::Prop, 1> resProps;
+  put(resProps, "profile", profile, factory);
+
+  llvh::SmallVector<JSONFactory::Prop, 2> props;
+  put(props, "id", id, factory);
+  put(props,
+      "result",
+      factory.newObject(resProps.begin(), resProps.end()),
+      factory);
+  return factory.newObject(props.begin(), props.end());
+}
+
 std::unique_ptr<heapProfiler::StopSamplingResponse>
 heapProfiler::StopSamplingResponse::tryMake(const JSONObject *obj) {
   std::unique_ptr<heapProfiler::StopSamplingResponse> resp =
@@ -99,6 +99,8 @@ struct GetHeapObjectIdRequest;
 struct GetHeapObjectIdResponse;
 struct GetObjectByHeapObjectIdRequest;
 struct GetObjectByHeapObjectIdResponse;
+struct GetSamplingProfileRequest;
+struct GetSamplingProfileResponse;
 using HeapSnapshotObjectId = std::string;
 struct HeapStatsUpdateNotification;
 struct LastSeenObjectIdNotification;
@@ -148,6 +150,7 @@ struct RequestHandler {
   virtual void handle(const heapProfiler::GetHeapObjectIdRequest &req) = 0;
   virtual void handle(
       const heapProfiler::GetObjectByHeapObjectIdRequest &req) = 0;
+  virtual void handle(const heapProfiler::GetSamplingProfileRequest &req) = 0;
   virtual void handle(const heapProfiler::StartSamplingRequest &req) = 0;
   virtual void handle(
       const heapProfiler::StartTrackingHeapObjectsRequest &req) = 0;
@@ -194,6 +197,7 @@ struct NoopRequestHandler : public RequestHandler {
   void handle(const heapProfiler::GetHeapObjectIdRequest &req) override {}
   void handle(
       const heapProfiler::GetObjectByHeapObjectIdRequest &req) override {}
+  void handle(const heapProfiler::GetSamplingProfileRequest &req) override {}
   void handle(const heapProfiler::StartSamplingRequest &req) override {}
   void handle(
       const heapProfiler::StartTrackingHeapObjectsRequest &req) override {}
@@ -778,6 +782,15 @@ struct heapProfiler::GetObjectByHeapObjectIdRequest : public Request {
   std::optional<std::string> objectGroup;
 };
 
+struct heapProfiler::GetSamplingProfileRequest : public Request {
+  GetSamplingProfileRequest();
+  static std::unique_ptr<GetSamplingProfileRequest> tryMake(
+      const JSONObject *obj);
+
+  JSONValue *toJsonVal(JSONFactory &factory) const override;
+  void accept(RequestHandler &handler) const override;
+};
+
 struct heapProfiler::StartSamplingRequest : public Request {
   StartSamplingRequest();
   static std::unique_ptr<StartSamplingRequest> tryMake(const JSONObject *obj);
@@ -1061,6 +1074,15 @@ struct heapProfiler::GetObjectByHeapObjectIdResponse : public Response {
   runtime::RemoteObject result{};
 };
 
+struct heapProfiler::GetSamplingProfileResponse : public Response {
+  GetSamplingProfileResponse() = default;
+  static std::unique_ptr<GetSamplingProfileResponse> tryMake(
+      const JSONObject *obj);
+  JSONValue *toJsonVal(JSONFactory &factory) const override;
+
+  heapProfiler::SamplingHeapProfile profile{};
+};
+
 struct heapProfiler::StopSamplingResponse : public Response {
   StopSamplingResponse() = default;
   static std::unique_ptr<StopSamplingResponse> tryMake(const JSONObject *obj);
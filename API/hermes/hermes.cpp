@@ -394,12 +394,10 @@ class HermesRuntimeImpl final : public HermesRuntime,
       const std::string &path,
       const HeapSnapshotOptions &options) override {
 #ifdef HERMES_MEMORY_INSTRUMENTATION
-    std::error_code code;
-    llvh::raw_fd_ostream os(path, code, llvh::sys::fs::FileAccess::FA_Write);
-    if (code) {
+    if (std::error_code code = runtime_.getHeap().createSnapshotToFile(
+            path, options.captureNumericValue)) {
       throw std::system_error(code);
     }
-    runtime_.getHeap().createSnapshot(os, options.captureNumericValue);
 #else
     throw std::logic_error(
         "Cannot create heap snapshots if Hermes isn't built with "
@@ -1099,9 +1097,11 @@ std::pair<const uint8_t *, size_t> HermesRuntime::getBytecodeEpilogue(
   return std::make_pair(epi.data(), epi.size());
 }
 
-void HermesRuntime::enableSamplingProfiler(double meanHzFreq) {
+void HermesRuntime::enableSamplingProfiler(
+    double meanHzFreq,
+    bool hardwareCounters) {
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
-  ::hermes::vm::SamplingProfiler::enable(meanHzFreq);
+  ::hermes::vm::SamplingProfiler::enable(meanHzFreq, hardwareCounters);
 #else
   throwHermesNotCompiledWithSamplingProfilerSupport();
 #endif // HERMESVM_SAMPLING_PROFILER_AVAILABLE
@@ -1310,12 +1310,60 @@ void HermesRuntime::dumpBasicBlockProfileTrace(std::ostream &stream) const {
 }
 #endif
 
-#ifdef HERMESVM_PROFILER_OPCODE
-void HermesRuntime::dumpOpcodeStats(std::ostream &stream) const {
+void HermesRuntime::enableInterpreterProfiler(const std::string &kinds) {
+  auto parsed = vm::InterpreterProfiler::parseKinds(kinds);
+  if (!parsed)
+    throw std::invalid_argument("Invalid interpreter profiler kinds: " + kinds);
+  impl(this)->runtime_.getInterpreterProfiler().enable(*parsed);
+}
+
+void HermesRuntime::disableInterpreterProfiler() {
+  impl(this)->runtime_.getInterpreterProfiler().disable();
+}
+
+void HermesRuntime::resetInterpreterProfiler() {
+  impl(this)->runtime_.getInterpreterProfiler().reset();
+}
+
+void HermesRuntime::dumpInterpreterProfile(std::ostream &stream) const {
+  llvh::raw_os_ostream os(stream);
+  static_cast<const HermesRuntimeImpl *>(this)
+      ->runtime_.getInterpreterProfiler()
+      .dump(os);
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+/// \return the heap of \p runtime, if heap sampling is running.
+static vm::GCBase &getSampledHeap(vm::Runtime &runtime) {
+  vm::GCBase &heap = runtime.getHeap();
+  if (!heap.getSamplingAllocationTracker().isEnabled()) {
+    throw jsi::JSINativeException("Heap sampling is not running");
+  }
+  return heap;
+}
+#endif
+
+void HermesRuntime::heapSamplingProfileToStream(std::ostream &stream) {
+#ifdef HERMES_MEMORY_INSTRUMENTATION
   llvh::raw_os_ostream os(stream);
-  static_cast<const HermesRuntimeImpl *>(this)->runtime_.dumpOpcodeStats(os);
+  getSampledHeap(impl(this)->runtime_).writeSamplingHeapProfile(os);
+#else
+  throw std::logic_error(
+      "Cannot perform heap sampling if Hermes isn't built with "
+      "memory instrumentation.");
+#endif
 }
+
+void HermesRuntime::heapSamplingSitesToStream(std::ostream &stream) {
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  llvh::raw_os_ostream os(stream);
+  getSampledHeap(impl(this)->runtime_).writeSamplingHeapProfileSites(os);
+#else
+  throw std::logic_error(
+      "Cannot perform heap sampling if Hermes isn't built with "
+      "memory instrumentation.");
 #endif
+}
 
 debugger::Debugger &HermesRuntime::getDebugger() {
   return *(impl(this)->debugger_);
@@ -1786,8 +1834,7 @@ jsi::Value HermesRuntimeImpl::createValueFromJsonUtf8(
     size_t length) {
   vm::GCScope gcScope(runtime_);
   llvh::ArrayRef<uint8_t> ref(json, length);
-  vm::CallResult<vm::HermesValue> res =
-      runtimeJSONParseRef(runtime_, ::hermes::UTF16Stream(ref));
+  vm::CallResult<vm::HermesValue> res = runtimeJSONParseUTF8(runtime_, ref);
   checkStatus(res.getStatus());
   return valueFromHermesValue(*res);
 }
@@ -74,7 +74,12 @@ class HERMES_EXPORT HermesRuntime : public jsi::Runtime {
   /// Starts a separate thread that polls VM state with \p meanHzFreq frequency.
   /// Any subsequent call to \c enableSamplingProfiler() is ignored until
   /// next call to \c disableSamplingProfiler()
-  static void enableSamplingProfiler(double meanHzFreq = 100);
+  /// If \p hardwareCounters is true, the CPU performance counters of the
+  /// runtime thread are read with each sample, on platforms that have them,
+  /// and the dumped trace includes them.
+  static void enableSamplingProfiler(
+      double meanHzFreq = 100,
+      bool hardwareCounters = false);
 
   /// Disable the sampling profiler
   static void disableSamplingProfiler();
@@ -154,10 +159,35 @@ class HERMES_EXPORT HermesRuntime : public jsi::Runtime {
   void dumpBasicBlockProfileTrace(std::ostream &os) const;
 #endif
 
-#ifdef HERMESVM_PROFILER_OPCODE
-  /// Write the opcode stats to the given stream.
-  void dumpOpcodeStats(std::ostream &os) const;
-#endif
+  /// Start profiling the interpreter of this runtime, in addition to what is
+  /// already profiled. \p kinds is a comma separated list of "opcodes",
+  /// "functions", "native" and "all". Functions that are already running when
+  /// the profiler is enabled are not profiled.
+  /// Throws std::invalid_argument if \p kinds contains anything else.
+  void enableInterpreterProfiler(const std::string &kinds = "all");
+
+  /// Stop profiling the interpreter. The profile recorded so far is kept.
+  void disableInterpreterProfiler();
+
+  /// Clear the interpreter profile recorded so far.
+  void resetInterpreterProfiler();
+
+  /// Write the interpreter profile recorded so far to the given stream: the
+  /// count and time of each opcode, and the calls and self time of each JS
+  /// and native function.
+  void dumpInterpreterProfile(std::ostream &os) const;
+
+  /// Write the samples of the heap sampling profiler started with
+  /// jsi::Instrumentation::startHeapSampling() that are still alive to the
+  /// given stream, in the same format as stopHeapSampling(), without stopping
+  /// it. Throws if heap sampling isn't running.
+  void heapSamplingProfileToStream(std::ostream &os);
+
+  /// Write the bytes that the heap sampling profiler attributes to each
+  /// allocation site, those still alive and those that were freed, to the
+  /// given stream, as a plain table that can be diffed across runs and
+  /// builds. Throws if heap sampling isn't running.
+  void heapSamplingSitesToStream(std::ostream &os);
 
   /// \return a reference to the Debugger for this Runtime.
   debugger::Debugger &getDebugger();
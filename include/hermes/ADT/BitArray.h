@@ -11,6 +11,7 @@
 #include "llvh/Support/MathExtras.h"
 
 #include <array>
+#include <atomic>
 #include <bitset>
 
 #pragma GCC diagnostic push
@@ -142,6 +143,44 @@ class BitArray {
       allBits_[wordIdx] &= ~mask;
   }
 
+  /// Set the bits in the range [from, to) to \p val, a word at a time.
+  inline void set(size_t from, size_t to, bool val) {
+    assert(from <= to && to <= N && "Range must be within the bitset");
+    if (from == to)
+      return;
+    const size_t firstWord = from / kBitsPerWord;
+    const size_t lastWord = (to - 1) / kBitsPerWord;
+    const uintptr_t firstMask = std::numeric_limits<uintptr_t>::max()
+        << (from % kBitsPerWord);
+    const uintptr_t lastMask = std::numeric_limits<uintptr_t>::max() >>
+        (kBitsPerWord - 1 - (to - 1) % kBitsPerWord);
+    for (size_t wordIdx = firstWord; wordIdx <= lastWord; ++wordIdx) {
+      uintptr_t mask = std::numeric_limits<uintptr_t>::max();
+      if (wordIdx == firstWord)
+        mask &= firstMask;
+      if (wordIdx == lastWord)
+        mask &= lastMask;
+      if (val)
+        allBits_[wordIdx] |= mask;
+      else
+        allBits_[wordIdx] &= ~mask;
+    }
+  }
+
+  /// Atomically set the bit at \p idx to 1, such that concurrent calls on
+  /// bits in the same word do not lose each other's updates.
+  /// \return true if the bit was 0 before the call.
+  inline bool testAndSetAtomic(size_t idx) {
+    static_assert(
+        sizeof(std::atomic<uintptr_t>) == sizeof(uintptr_t),
+        "Words must be accessible as atomics");
+    assert(idx < N && "Index must be within the bitset");
+    const uintptr_t mask = 1ULL << (idx % kBitsPerWord);
+    auto *word = reinterpret_cast<std::atomic<uintptr_t> *>(
+        &allBits_[idx / kBitsPerWord]);
+    return !(word->fetch_or(mask, std::memory_order_relaxed) & mask);
+  }
+
   /// Set all bits to 0.
   inline void reset() {
     std::fill_n(allBits_.begin(), kNumWords, 0);
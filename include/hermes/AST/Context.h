@@ -85,6 +85,9 @@ struct OptimizationSettings {
   /// Reuse property cache entries for same property name.
   bool reusePropCache{true};
 
+  /// Replace common pairs of bytecode instructions with superinstructions.
+  bool fuseInstructions{false};
+
   /// Recognize calls to global functions like Object.keys() and turn them
   /// into builtin calls.
   bool staticBuiltins{false};
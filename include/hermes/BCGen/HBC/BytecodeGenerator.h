@@ -57,6 +57,13 @@ class AllocationTable {
     return nextId;
   }
 
+  /// \return the ID of \p val, which must have been allocated.
+  unsigned lookup(T val) const {
+    auto it = indexMap_.find(val);
+    assert(it != indexMap_.end() && "Element not allocated");
+    return it->second;
+  }
+
   const ArrayRef<T> getElements() const {
     return elements_;
   }
@@ -131,7 +138,12 @@ class BytecodeFunctionGenerator : public BytecodeInstructionGenerator {
       uint32_t environmentSize,
       uint32_t nameID = 0);
 
-  unsigned getFunctionID(Function *F);
+  /// Add \p F to the module if it isn't already in it.
+  /// \return the ID of \p F.
+  unsigned addFunction(Function *F);
+
+  /// \return the ID of \p F, which must have been added with addFunction().
+  unsigned getFunctionID(Function *F) const;
 
   unsigned getScopeDescID(ScopeDesc *S);
 
@@ -214,6 +226,12 @@ class BytecodeFunctionGenerator : public BytecodeInstructionGenerator {
   void
   updateJumpTableOffset(offset_t loc, uint32_t jumpTableOffset, uint32_t cs);
 
+  /// Replace the first instruction of each common pair of instructions with
+  /// the superinstruction that also executes the second one. Pairs don't
+  /// overlap, and are chosen from the start of the function. This must be
+  /// called once all jumps are resolved, since only short jumps are fused.
+  void fuseInstructions();
+
   /// Change the opcode of a long jump instruction into a short jump.
   inline void longToShortJump(offset_t loc) {
     switch (opcodes_[loc]) {
@@ -358,6 +376,13 @@ class BytecodeModuleGenerator {
   /// Add a function to functionIDMap_ if not already exist. Returns the ID.
   unsigned addFunction(Function *F);
 
+  /// \return the ID of \p F, which must have been added with addFunction().
+  /// This doesn't modify the generator, so the functions of the module can be
+  /// generated concurrently once all their IDs are allocated.
+  unsigned getFunctionID(Function *F) const {
+    return functionIDMap_.lookup(F);
+  }
+
   /// Add a ScopeDesc to scopeDescIDMap_ if not already in it. Returns the ID.
   unsigned addScopeDesc(ScopeDesc *S);
 
@@ -55,6 +55,8 @@ class BytecodeSerializer {
   uint32_t overflowStringEntryCount_{0};
   /// Hash of everything written in non-layout mode so far.
   llvh::SHA1 outputHasher_;
+  /// The functions in the order their bytecode and info are written.
+  std::vector<BytecodeFunction *> layoutOrder_{};
 
   /// Each subsection of a function's `info' section is aligned thusly.
   static constexpr uint32_t INFO_ALIGNMENT = 4;
@@ -110,6 +112,10 @@ class BytecodeSerializer {
 
   void finishLayout(BytecodeModule &BM);
 
+  /// Compute layoutOrder_ from the function table of \p BM and the layout
+  /// order in the options.
+  void computeLayoutOrder(BytecodeModule &BM);
+
   void visitFunctionHeaders();
   void visitStringKinds();
   void visitIdentifierHashes();
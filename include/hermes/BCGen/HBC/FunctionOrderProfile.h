@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_BCGEN_HBC_FUNCTIONORDERPROFILE_H
+#define HERMES_BCGEN_HBC_FUNCTIONORDERPROFILE_H
+
+#include "hermes/Support/SHA1.h"
+
+#include "llvh/ADT/Optional.h"
+#include "llvh/ADT/StringRef.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <string>
+#include <vector>
+
+namespace hermes {
+namespace hbc {
+
+/// The order in which the functions of a bytecode module were first executed.
+/// The VM records it, and the compiler uses it to lay out the bytecode of the
+/// same source so that starting up touches as few pages as possible.
+///
+/// The text format is a header line "hbc-function-order <source hash>",
+/// followed by one function ID per line.
+struct FunctionOrderProfile {
+  /// Hash of the source the profiled bytecode was compiled from. The function
+  /// IDs only identify the same functions in bytecode compiled from the same
+  /// source.
+  SHA1 sourceHash{};
+
+  /// IDs of the functions, in the order they were first executed.
+  std::vector<uint32_t> functionIDs{};
+
+  /// Write the profile to \p OS.
+  void write(llvh::raw_ostream &OS) const;
+
+  /// Parse the profile in \p text.
+  /// \return the profile, or None and set \p error if it is malformed.
+  static llvh::Optional<FunctionOrderProfile> parse(
+      llvh::StringRef text,
+      std::string &error);
+};
+
+} // namespace hbc
+} // namespace hermes
+
+#endif // HERMES_BCGEN_HBC_FUNCTIONORDERPROFILE_H
@@ -127,6 +127,10 @@ class HBCISel {
   /// Saved identifier of "__proto__" for fast comparisons.
   Identifier protoIdent_{};
 
+  /// The basic blocks in the order in which they are generated. Set by
+  /// prepare().
+  llvh::SmallVector<BasicBlock *, 16> order_{};
+
   /// Encode a value into a param_t type.
   unsigned encodeValue(Value *);
 
@@ -236,6 +240,21 @@ class HBCISel {
   /// Generate bytecode for the instruction \p II.
   void generate(Instruction *ii, BasicBlock *next);
 
+  /// Add the entries of the module-level tables that the code of the function
+  /// refers to (function IDs, regexps and bigints) in the order in which the
+  /// code refers to them, and report the diagnostics about the code. After
+  /// this, generateCode() only looks up module-level state.
+  void prepare();
+
+  /// Generate the bytecode stream for the function, and resolve its jumps and
+  /// exception handlers. Once prepare() has been called for a set of
+  /// functions, this may run concurrently for all of them.
+  void generateCode();
+
+  /// Add the debug info and the remaining per-function tables, which adds
+  /// filenames and scope descriptors to the module-level tables.
+  void finishGeneration(SourceMapGenerator *outSourceMap);
+
   /// Generate the bytecode stream for the function.
   void generate(SourceMapGenerator *outSourceMap);
 };
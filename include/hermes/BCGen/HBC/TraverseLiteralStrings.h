@@ -54,6 +54,12 @@ void traverseLiteralStrings(
     std::function<bool(Function *)> shouldVisitFunction,
     std::function<void(llvh::StringRef, bool)> traversal);
 
+/// Call \p traversal for each string used by the instructions of \p F, like
+/// traverseLiteralStrings() does for every function it visits.
+void traverseFunctionLiteralStrings(
+    Function *F,
+    const std::function<void(llvh::StringRef, bool)> &traversal);
+
 } // namespace hbc
 } // namespace hermes
 
@@ -101,9 +101,12 @@ class UniquingStringLiteralAccumulator final : public StringLiteralIDMapping {
   /// \p strings.  If \p optimize is set, attempt to pack the strings to
   /// reduce the size taken up by the character buffer.  The mapping from ID
   /// to String is not preserved between \p strings and the resulting table.
+  /// The new strings in \p hotStrings are stored first, in that order, ahead
+  /// of the other strings.
   static StringLiteralTable toTable(
       UniquingStringLiteralAccumulator strings,
-      bool optimize = false);
+      bool optimize = false,
+      llvh::ArrayRef<llvh::StringRef> hotStrings = {});
 };
 
 inline size_t StringLiteralIDMapping::count() const {
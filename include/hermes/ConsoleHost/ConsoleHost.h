@@ -141,8 +141,27 @@ struct ExecuteOptions {
   /// Run the sampling profiler.
   bool sampleProfiling{false};
 
+  /// Read the hardware performance counters with each sample.
+  bool sampleProfilingCounters{false};
+
+  /// If not empty, the kinds of profiling of the interpreter to do, as
+  /// accepted by vm::InterpreterProfiler::parseKinds().
+  std::string interpreterProfile{};
+
   /// Start tracking heap objects before executing bytecode.
   bool heapTimeline{false};
+
+  /// If not empty, run the sampling heap profiler and write the bytes it
+  /// attributes to each allocation site to this file.
+  std::string heapSamplingSites{};
+
+  /// The mean number of bytes allocated between two samples of the sampling
+  /// heap profiler.
+  uint32_t heapSamplingInterval{1 << 15};
+
+  /// If not empty, write the order in which the functions of the bytecode were
+  /// first executed to this file.
+  std::string functionOrderProfile{};
 };
 
 /// Executes the HBC bytecode provided in HermesVM.
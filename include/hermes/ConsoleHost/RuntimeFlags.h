@@ -89,12 +89,49 @@ static opt<double> OccupancyTarget(
     cat(GCCategory),
     init(GCConfig::getDefaultOccupancyTarget()));
 
+static opt<unsigned> GCMarkThreads(
+    "gc-mark-threads",
+    desc("Number of threads that mark the old generation concurrently with "
+         "the mutator."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultNumMarkThreads()));
+
+static opt<unsigned> GCEvacuationThreads(
+    "gc-evacuation-threads",
+    desc("Number of threads that evacuate the young generation during a "
+         "collection."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultNumEvacuationThreads()));
+
+static opt<bool> GCPretenure(
+    "gc-pretenure",
+    desc("Allocate the objects of allocation sites whose objects usually "
+         "survive a young generation collection directly in the old "
+         "generation."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultPretenure()));
+
 static opt<bool> SampleProfiling(
     "sample-profiling",
     init(false),
     desc("Enable sampling profiler"),
     cat(RuntimeCategory));
 
+static opt<bool> SampleProfilingCounters(
+    "sample-profiling-counters",
+    init(false),
+    desc("With -sample-profiling, read the CPU performance counters (cycles, "
+         "instructions, cache and branch misses) with each sample, on Linux"),
+    cat(RuntimeCategory));
+
+static opt<std::string> ProfileInterpreter(
+    "profile-interpreter",
+    desc("Profile the interpreter and print the profile to stderr at exit. "
+         "The value is a comma separated list of: opcodes, functions, "
+         "native, all"),
+    init(""),
+    cat(RuntimeCategory));
+
 static opt<MemorySize, false, MemorySizeParser> MaxHeapSize(
     "gc-max-heap",
     desc("Max heap size.  Format: <unsigned>{K,M,G}{iB}"),
@@ -154,6 +191,14 @@ static opt<bool> EnableHermesInternalTestMethods(
     llvh::cl::init(RuntimeConfig::getDefaultEnableHermesInternalTestMethods()),
     llvh::cl::Hidden);
 
+static opt<std::string> RecordFunctionOrder(
+    "record-function-order",
+    llvh::cl::desc(
+        "Write the order in which the functions of the bytecode are first "
+        "executed to this file, for hermesc -function-order-profile"),
+    llvh::cl::init(""),
+    cat(RuntimeCategory));
+
 static opt<bool> HeapTimeline(
     "Xheap-timeline",
     llvh::cl::desc(
@@ -161,6 +206,22 @@ static opt<bool> HeapTimeline(
     llvh::cl::init(false),
     cat(RuntimeCategory));
 
+static opt<std::string> HeapSamplingSites(
+    "heap-sampling-sites",
+    llvh::cl::desc(
+        "Sample heap allocations, and at exit write the bytes attributed to "
+        "each allocation site, alive and freed, to this file"),
+    llvh::cl::init(""),
+    cat(RuntimeCategory));
+
+static opt<unsigned> HeapSamplingInterval(
+    "heap-sampling-interval",
+    llvh::cl::desc(
+        "With -heap-sampling-sites, the mean number of bytes allocated "
+        "between two samples"),
+    llvh::cl::init(1 << 15),
+    cat(RuntimeCategory));
+
 } // namespace cl
 
 #endif // HERMES_VM_RUNTIMEFLAGS_H
@@ -144,7 +144,23 @@ class Regex {
         markedCount_,
         static_cast<uint16_t>(loopCount_),
         flags_.toByte(),
-        matchConstraints_};
+        matchConstraints_,
+        0,
+        0,
+        {},
+        {}};
+    // A regex anchored at the start is only tried at one position, so it does
+    // not need the code units that a match starts with.
+    MatchStart start;
+    if (!(matchConstraints_ & MatchConstraintAnchoredAtStart))
+      Node::appendMatchStartForList(nodes_, &start);
+    header.prefixLength = start.prefix.size();
+    std::copy(start.prefix.begin(), start.prefix.end(), header.prefix);
+    header.firstCodeUnitCount = start.firstCodeUnits.size();
+    std::copy(
+        start.firstCodeUnits.begin(),
+        start.firstCodeUnits.end(),
+        header.firstCodeUnits);
     RegexBytecodeStream bcs(header);
     Node::compile(nodes_, bcs);
     return bcs.acquireBytecode();
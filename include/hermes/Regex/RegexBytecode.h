@@ -8,6 +8,8 @@
 #ifndef HERMES_REGEX_REGEXBYTECODE_H
 #define HERMES_REGEX_REGEXBYTECODE_H
 
+#include "hermes/Regex/RegexTypes.h"
+
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/Support/Casting.h"
 
@@ -273,6 +275,21 @@ struct RegexBytecodeHeader {
 
   /// Constraints on what strings can match this regex.
   MatchConstraintSet constraints;
+
+  /// Number of code units in prefix. If non-zero, every match starts with
+  /// prefix.
+  uint8_t prefixLength;
+
+  /// Number of code units in firstCodeUnits. If non-zero, every match starts
+  /// with one of firstCodeUnits.
+  uint8_t firstCodeUnitCount;
+
+  /// Code units that every match starts with, if prefixLength is non-zero.
+  char16_t prefix[constants::kMaxMatchPrefixLength];
+
+  /// Code units that every match starts with one of, if firstCodeUnitCount is
+  /// non-zero.
+  char16_t firstCodeUnits[constants::kMaxMatchFirstCodeUnits];
 };
 
 LLVM_PACKED_END;
@@ -24,8 +24,10 @@
 #include "hermes/Regex/RegexBytecode.h"
 #include "hermes/Regex/RegexTypes.h"
 
+#include "llvh/ADT/STLExtras.h"
 #include "llvh/ADT/SmallVector.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -39,6 +41,18 @@ using NodeList = std::vector<Node *>;
 /// A NodeHolder is list of owned Nodes. Note it is move-only.
 using NodeHolder = std::vector<std::unique_ptr<Node>>;
 
+/// The code units that every match of a regex must start with. The executor
+/// uses these to skip input positions where no match can start.
+struct MatchStart {
+  /// If non-empty, every match starts with these code units.
+  llvh::SmallVector<char16_t, constants::kMaxMatchPrefixLength> prefix;
+
+  /// If non-empty, every match starts with one of these code units. This is
+  /// only computed while prefix is empty.
+  llvh::SmallVector<char16_t, constants::kMaxMatchFirstCodeUnits>
+      firstCodeUnits;
+};
+
 /// Base class representing some part of a compiled regular expression.
 /// A Node is part of an expression that knows how to match against a State.
 /// There are nodes for Alternations, Literals, etc.
@@ -82,6 +96,20 @@ class Node {
     return result;
   }
 
+  /// Add the code units that every match of the list of nodes \p nodes must
+  /// start with to \p start, which describes the nodes preceding the list.
+  /// \return true if the list matches exactly the code units added to
+  /// start->prefix, so that the nodes following the list may extend it.
+  static bool appendMatchStartForList(
+      const NodeList &nodes,
+      MatchStart *start) {
+    for (const auto &node : nodes) {
+      if (!node->appendMatchStart(start))
+        return false;
+    }
+    return true;
+  }
+
   /// Reverse the order of the node list \p nodes, and recursively ask each node
   /// to reverse the order of its children.
   inline static void reverseNodeList(NodeList &nodes);
@@ -111,6 +139,13 @@ class Node {
     return 0;
   }
 
+  /// Add the code units that every match of this node must start with to
+  /// \p start. See appendMatchStartForList(). The default is for nodes that
+  /// match the empty string, such as assertions, which add nothing.
+  virtual bool appendMatchStart(MatchStart *start) const {
+    return true;
+  }
+
   /// \return whether this is a goal node.
   virtual bool isGoal() const {
     return false;
@@ -226,6 +261,13 @@ class LoopNode final : public Node {
     return {&loopee_};
   }
 
+  /// A loop that runs at least once starts like its loopee.
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    if (min_ > 0)
+      appendMatchStartForList(loopee_, start);
+    return false;
+  }
+
  protected:
   void reverseChildren() override {
     reverseNodeList(loopee_);
@@ -353,6 +395,49 @@ class AlternationNode final : public Node {
     return restConstraints_.front() | Super::matchConstraints();
   }
 
+  /// Alternations start with the prefix common to all their alternatives, or
+  /// else with one of the code units that any alternative starts with.
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    decltype(MatchStart::prefix) common;
+    decltype(MatchStart::firstCodeUnits) units;
+    bool unitsKnown = true;
+    for (size_t i = 0; i < alternatives_.size(); ++i) {
+      MatchStart altStart;
+      appendMatchStartForList(alternatives_[i], &altStart);
+      if (i == 0) {
+        common = altStart.prefix;
+      } else {
+        auto mismatch = std::mismatch(
+            common.begin(),
+            common.end(),
+            altStart.prefix.begin(),
+            altStart.prefix.end());
+        common.erase(mismatch.first, common.end());
+      }
+      llvh::ArrayRef<char16_t> altUnits = altStart.firstCodeUnits;
+      if (!altStart.prefix.empty())
+        altUnits = llvh::makeArrayRef(altStart.prefix).take_front();
+      if (altUnits.empty())
+        unitsKnown = false;
+      for (char16_t c : altUnits) {
+        if (llvh::is_contained(units, c))
+          continue;
+        if (units.size() == constants::kMaxMatchFirstCodeUnits)
+          unitsKnown = false;
+        else
+          units.push_back(c);
+      }
+    }
+    for (char16_t c : common) {
+      if (start->prefix.size() == constants::kMaxMatchPrefixLength)
+        break;
+      start->prefix.push_back(c);
+    }
+    if (start->prefix.empty() && unitsKnown)
+      start->firstCodeUnits = units;
+    return false;
+  }
+
   virtual llvh::SmallVector<NodeList *, 1> getChildren() override {
     llvh::SmallVector<NodeList *, 1> ret;
     ret.reserve(alternatives_.size());
@@ -448,6 +533,10 @@ class MarkedSubexpressionNode final : public Node {
     return contentsConstraints_ | Super::matchConstraints();
   }
 
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    return appendMatchStartForList(contents_, start);
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (!emitEnd_) {
@@ -473,6 +562,10 @@ class BackRefNode final : public Node {
     mexp_ = mexp;
   }
 
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    return false;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     bcs.emit<BackRefInsn>()->mexp = mexp_;
@@ -556,6 +649,10 @@ class MatchAnyNode final : public Node {
     return MatchConstraintNonEmpty | Super::matchConstraints();
   }
 
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    return false;
+  }
+
   virtual bool matchesExactlyOneCharacter() const override {
     // In Unicode we may match a surrogate pair.
     return !unicode_;
@@ -626,6 +723,20 @@ class MatchCharNode final : public Node {
     return true;
   }
 
+  /// Case-sensitive characters that match a single code unit extend the
+  /// prefix.
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    if (icase_)
+      return false;
+    for (CodePoint c : chars_) {
+      if (start->prefix.size() == constants::kMaxMatchPrefixLength ||
+          mayRequireDecodingSurrogatePair(c))
+        return false;
+      start->prefix.push_back(c);
+    }
+    return true;
+  }
+
   /// \return whether matching the code point \p cp may require
   /// decoding a surrogate pair from the input string.
   bool mayRequireDecodingSurrogatePair(uint32_t cp) const {
@@ -844,6 +955,32 @@ class BracketNode : public Node {
     return result | Super::matchConstraints();
   }
 
+  /// A case-sensitive bracket of a few code units starts with one of them, and
+  /// one of a single code unit extends the prefix.
+  virtual bool appendMatchStart(MatchStart *start) const override {
+    if (negate_ || icase_ || !classes_.empty())
+      return false;
+    decltype(MatchStart::firstCodeUnits) units;
+    for (const CodePointRange &range : codePointSet_.ranges()) {
+      if (range.length > constants::kMaxMatchFirstCodeUnits - units.size())
+        return false;
+      for (CodePoint c = range.first; c != range.first + range.length; ++c) {
+        if (!isMemberOfBMP(c) ||
+            (unicode_ && (isHighSurrogate(c) || isLowSurrogate(c))))
+          return false;
+        units.push_back(c);
+      }
+    }
+    if (units.size() == 1 &&
+        start->prefix.size() < constants::kMaxMatchPrefixLength) {
+      start->prefix.push_back(units.front());
+      return true;
+    }
+    if (start->prefix.empty())
+      start->firstCodeUnits = units;
+    return false;
+  }
+
   virtual bool matchesExactlyOneCharacter() const override {
     // A unicode bracket may match a surrogate pair.
     return !unicode_;
@@ -180,6 +180,14 @@ constexpr uint16_t kMaxCaptureGroupCount = 65535;
 /// Maximum number of supported loops.
 constexpr uint16_t kMaxLoopCount = 65535;
 
+/// Maximum length of the literal prefix that every match must start with,
+/// as recorded in the bytecode header.
+constexpr uint8_t kMaxMatchPrefixLength = 8;
+
+/// Maximum number of code units in the set of code units that every match
+/// must start with one of, as recorded in the bytecode header.
+constexpr uint8_t kMaxMatchFirstCodeUnits = 4;
+
 } // namespace constants
 
 /// After compiling a regex, there are certain properties we can test for that
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_SUPPORT_GZIPOSTREAM_H
+#define HERMES_SUPPORT_GZIPOSTREAM_H
+
+#include "llvh/ADT/StringRef.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <memory>
+
+struct mz_stream_s;
+
+namespace hermes {
+
+/// A stream that compresses what is written to it in the gzip format, and
+/// writes the result to another stream as it goes. Its memory use is fixed:
+/// an input buffer, an output buffer, and the state of the compressor, none
+/// of which depend on the amount of data written.
+///
+/// The gzip trailer is written when the stream is destroyed, after which the
+/// output is complete.
+class GzipOStream final : public llvh::raw_ostream {
+ public:
+  /// Size of the input and of the output buffers.
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  /// Compress to \p os, with a compression \p level between 1 (fastest) and 9
+  /// (smallest).
+  explicit GzipOStream(llvh::raw_ostream &os, int level = 1);
+  ~GzipOStream() override;
+
+  /// \return whether \p fileName has the extension of a gzip file.
+  static bool isGzipFileName(llvh::StringRef fileName) {
+    return fileName.endswith(".gz");
+  }
+
+ private:
+  void write_impl(const char *ptr, size_t size) override;
+
+  uint64_t current_pos() const override {
+    return inputSize_;
+  }
+
+  /// Compress \p size bytes at \p ptr, and write the output that the
+  /// compressor produced. \p flush is the mz_deflate flush mode.
+  void deflate(const char *ptr, size_t size, int flush);
+
+  /// The stream that receives the compressed data.
+  llvh::raw_ostream &os_;
+
+  /// The state of the compressor.
+  std::unique_ptr<mz_stream_s> stream_;
+
+  /// The buffer receiving the output of the compressor.
+  std::unique_ptr<char[]> outBuffer_;
+
+  /// CRC-32 of the data written so far.
+  uint32_t crc_{0};
+
+  /// The number of bytes written so far.
+  uint64_t inputSize_{0};
+};
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_GZIPOSTREAM_H
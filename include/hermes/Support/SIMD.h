@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+//===----------------------------------------------------------------------===//
+/// \file
+/// Vector primitives for scanning 8-bit and UTF-16 code units with SSE2 or
+/// NEON. HERMES_SIMD_VECTOR is defined when one of them is available, and
+/// callers must provide a scalar path otherwise.
+//===----------------------------------------------------------------------===//
+
+#ifndef HERMES_SUPPORT_SIMD_H
+#define HERMES_SUPPORT_SIMD_H
+
+#include "llvh/Support/MathExtras.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HERMES_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define HERMES_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(HERMES_SIMD_SSE2) || defined(HERMES_SIMD_NEON)
+#define HERMES_SIMD_VECTOR 1
+
+namespace hermes {
+
+/// Classifies vectors of code units of type T, which is char or char16_t.
+/// Every operation except toMask() produces a vector with all bits set in the
+/// matching lanes; toMask() turns it into a mask with the bit
+/// (lane * kBitsPerLane) set for every matching lane and no other bits, so
+/// the lanes can be enumerated by clearing the lowest set bit. Code units are
+/// compared as unsigned values.
+template <typename T>
+struct CodeUnitVector;
+
+#ifdef HERMES_SIMD_SSE2
+template <>
+struct CodeUnitVector<char> {
+  using Vec = __m128i;
+  static constexpr size_t kLanes = 16;
+  static constexpr unsigned kBitsPerLane = 1;
+  static constexpr uint64_t kAllLanes = 0xFFFF;
+
+  static Vec load(const char *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static Vec splat(char c) {
+    return _mm_set1_epi8(c);
+  }
+  static Vec eq(Vec a, Vec b) {
+    return _mm_cmpeq_epi8(a, b);
+  }
+  static Vec eq(Vec v, char c) {
+    return eq(v, splat(c));
+  }
+  /// v <= hi iff max(v, hi) == hi, as unsigned bytes.
+  static Vec lessEqual(Vec v, char hi) {
+    const Vec vHi = splat(hi);
+    return _mm_cmpeq_epi8(_mm_max_epu8(v, vHi), vHi);
+  }
+  /// Match the range [lo, hi], with lo <= hi.
+  static Vec inRange(Vec v, char lo, char hi) {
+    return lessEqual(_mm_sub_epi8(v, splat(lo)), (char)(hi - lo));
+  }
+  /// Non-ASCII bytes are the ones with the sign bit set.
+  static Vec nonASCII(Vec v) {
+    return _mm_cmplt_epi8(v, _mm_setzero_si128());
+  }
+  static Vec either(Vec a, Vec b) {
+    return _mm_or_si128(a, b);
+  }
+  /// Set the ASCII case bit, which maps upper case letters to lower case and
+  /// no other code unit to a lower case letter.
+  static Vec toLower(Vec v) {
+    return _mm_or_si128(v, splat(0x20));
+  }
+  static uint64_t toMask(Vec v) {
+    return (uint32_t)_mm_movemask_epi8(v);
+  }
+};
+
+template <>
+struct CodeUnitVector<char16_t> {
+  using Vec = __m128i;
+  static constexpr size_t kLanes = 8;
+  static constexpr unsigned kBitsPerLane = 2;
+  static constexpr uint64_t kAllLanes = 0x5555;
+
+  static Vec load(const char16_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static Vec splat(char16_t c) {
+    return _mm_set1_epi16((short)c);
+  }
+  static Vec eq(Vec a, Vec b) {
+    return _mm_cmpeq_epi16(a, b);
+  }
+  static Vec eq(Vec v, char16_t c) {
+    return eq(v, splat(c));
+  }
+  /// v <= hi iff v - hi saturates to 0, as unsigned 16-bit lanes.
+  static Vec lessEqual(Vec v, char16_t hi) {
+    return _mm_cmpeq_epi16(_mm_subs_epu16(v, splat(hi)), _mm_setzero_si128());
+  }
+  /// Match the range [lo, hi], with lo <= hi.
+  static Vec inRange(Vec v, char16_t lo, char16_t hi) {
+    return lessEqual(_mm_sub_epi16(v, splat(lo)), (char16_t)(hi - lo));
+  }
+  static Vec nonASCII(Vec v) {
+    return _mm_xor_si128(lessEqual(v, 0x7F), _mm_set1_epi8(-1));
+  }
+  static Vec either(Vec a, Vec b) {
+    return _mm_or_si128(a, b);
+  }
+  static Vec toLower(Vec v) {
+    return _mm_or_si128(v, splat(0x20));
+  }
+  static uint64_t toMask(Vec v) {
+    // Every 16-bit lane produces two bits in the byte mask; keep one.
+    return (uint32_t)_mm_movemask_epi8(v) & kAllLanes;
+  }
+};
+#endif // HERMES_SIMD_SSE2
+
+#ifdef HERMES_SIMD_NEON
+template <>
+struct CodeUnitVector<char> {
+  using Vec = uint8x16_t;
+  static constexpr size_t kLanes = 16;
+  static constexpr unsigned kBitsPerLane = 4;
+  static constexpr uint64_t kAllLanes = 0x1111111111111111ull;
+
+  static Vec load(const char *p) {
+    return vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+  }
+  static Vec splat(char c) {
+    return vdupq_n_u8((uint8_t)c);
+  }
+  static Vec eq(Vec a, Vec b) {
+    return vceqq_u8(a, b);
+  }
+  static Vec eq(Vec v, char c) {
+    return eq(v, splat(c));
+  }
+  static Vec lessEqual(Vec v, char hi) {
+    return vcleq_u8(v, splat(hi));
+  }
+  static Vec inRange(Vec v, char lo, char hi) {
+    return vandq_u8(vcgeq_u8(v, splat(lo)), lessEqual(v, hi));
+  }
+  static Vec nonASCII(Vec v) {
+    return vcgeq_u8(v, vdupq_n_u8(0x80));
+  }
+  static Vec either(Vec a, Vec b) {
+    return vorrq_u8(a, b);
+  }
+  static Vec toLower(Vec v) {
+    return vorrq_u8(v, vdupq_n_u8(0x20));
+  }
+  static uint64_t toMask(Vec v) {
+    // Narrow every 8-bit lane to 4 bits of a 64-bit mask, and keep one.
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & kAllLanes;
+  }
+};
+
+template <>
+struct CodeUnitVector<char16_t> {
+  using Vec = uint16x8_t;
+  static constexpr size_t kLanes = 8;
+  static constexpr unsigned kBitsPerLane = 8;
+  static constexpr uint64_t kAllLanes = 0x0101010101010101ull;
+
+  static Vec load(const char16_t *p) {
+    return vld1q_u16(reinterpret_cast<const uint16_t *>(p));
+  }
+  static Vec splat(char16_t c) {
+    return vdupq_n_u16((uint16_t)c);
+  }
+  static Vec eq(Vec a, Vec b) {
+    return vceqq_u16(a, b);
+  }
+  static Vec eq(Vec v, char16_t c) {
+    return eq(v, splat(c));
+  }
+  static Vec lessEqual(Vec v, char16_t hi) {
+    return vcleq_u16(v, splat(hi));
+  }
+  static Vec inRange(Vec v, char16_t lo, char16_t hi) {
+    return vandq_u16(vcgeq_u16(v, splat(lo)), lessEqual(v, hi));
+  }
+  static Vec nonASCII(Vec v) {
+    return vcgeq_u16(v, vdupq_n_u16(0x80));
+  }
+  static Vec either(Vec a, Vec b) {
+    return vorrq_u16(a, b);
+  }
+  static Vec toLower(Vec v) {
+    return vorrq_u16(v, vdupq_n_u16(0x20));
+  }
+  static uint64_t toMask(Vec v) {
+    // Narrow every 16-bit lane to 8 bits of a 64-bit mask, and keep one.
+    uint8x8_t narrowed = vmovn_u16(v);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & kAllLanes;
+  }
+};
+#endif // HERMES_SIMD_NEON
+
+/// \return the lane of the lowest bit set in \p mask, which must not be 0
+/// and must come from CodeUnitVector<T>::toMask().
+template <typename T>
+inline size_t firstLane(uint64_t mask) {
+  return llvh::countTrailingZeros(mask) / CodeUnitVector<T>::kBitsPerLane;
+}
+
+} // namespace hermes
+
+#endif // HERMES_SIMD_SSE2 || HERMES_SIMD_NEON
+
+#endif // HERMES_SUPPORT_SIMD_H
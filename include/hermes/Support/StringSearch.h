@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+//===----------------------------------------------------------------------===//
+/// \file
+/// Substring search over 8-bit and UTF-16 code unit sequences.
+///
+/// The algorithm is chosen by the length of the needle: single code units are
+/// found with memchr() or a vector scan, short needles with a vector filter
+/// on their first and last code units (SSE2 or NEON when available), and long
+/// needles with Boyer-Moore-Horspool.
+//===----------------------------------------------------------------------===//
+
+#ifndef HERMES_SUPPORT_STRINGSEARCH_H
+#define HERMES_SUPPORT_STRINGSEARCH_H
+
+#include "llvh/ADT/ArrayRef.h"
+
+#include <cstddef>
+
+namespace hermes {
+
+/// Returned by the search functions when there is no match.
+constexpr size_t kStringSearchNotFound = ~(size_t)0;
+
+/// Find the first occurrence of \p needle in \p haystack that starts at or
+/// after \p from.
+/// \return the index of the occurrence, or kStringSearchNotFound. An empty
+///   needle is found at \p from if it is not past the end of \p haystack.
+size_t stringSearch(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> needle,
+    size_t from = 0);
+size_t stringSearch(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> needle,
+    size_t from = 0);
+
+/// Find the last occurrence of \p needle in \p haystack that starts at or
+/// before \p maxStart.
+/// \return the index of the occurrence, or kStringSearchNotFound. An empty
+///   needle is found at min(maxStart, haystack.size()).
+size_t stringSearchLast(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> needle,
+    size_t maxStart = kStringSearchNotFound);
+size_t stringSearchLast(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> needle,
+    size_t maxStart = kStringSearchNotFound);
+
+/// Find the first code unit in \p haystack at or after \p from that is equal
+/// to any of \p codeUnits. Sets of up to four code units are scanned with
+/// vector instructions when available.
+/// \return the index of the code unit, or kStringSearchNotFound.
+size_t stringSearchAnyOf(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> codeUnits,
+    size_t from = 0);
+size_t stringSearchAnyOf(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> codeUnits,
+    size_t from = 0);
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_STRINGSEARCH_H
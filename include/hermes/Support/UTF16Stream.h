@@ -22,6 +22,8 @@ namespace hermes {
 /// unless you can somehow guarantee the data will not move.
 class UTF16Stream {
  public:
+  using CharT = char16_t;
+
   /// A stream that simply passes through the data in \p str.
   explicit UTF16Stream(llvh::ArrayRef<char16_t> str)
       : cur_(str.begin()),
@@ -60,6 +62,23 @@ class UTF16Stream {
     return *this;
   }
 
+  /// Returns the UTF16 units that are available from the current stream
+  /// position without converting more input, so that they can be scanned in
+  /// bulk. The next units are made available by calling hasChar once these
+  /// are consumed.
+  /// \pre hasChar returns true.
+  llvh::ArrayRef<char16_t> chunk() const {
+    assert(cur_ != end_ && "must check hasChar");
+    return {cur_, end_};
+  }
+
+  /// Advances the stream by \p n UTF16 units.
+  /// \pre n <= chunk().size().
+  void skip(size_t n) {
+    assert(n <= (size_t)(end_ - cur_) && "skipping past the chunk");
+    cur_ += n;
+  }
+
   /// Begin capturing the stream of values. Once the capture is completed with a
   /// call to endCapture(), the captured stream can be viewed via an ArrayRef.
   void beginCapture();
@@ -8,6 +8,9 @@
 #ifndef HERMES_UTILS_OPTIONS_H
 #define HERMES_UTILS_OPTIONS_H
 
+#include <cstdint>
+#include <vector>
+
 namespace hermes {
 
 enum OutputFormatKind {
@@ -59,6 +62,15 @@ struct BytecodeGenerationOptions {
   /// Strip the source map URL.
   bool stripSourceMappingURL = false;
 
+  /// Number of threads that allocate registers and generate the code of the
+  /// functions. The output does not depend on it.
+  unsigned jobs = 1;
+
+  /// IDs of the functions whose bytecode, strings and literals are laid out
+  /// first, in this order, usually the order in which they were first executed.
+  /// The remaining functions follow in ID order.
+  std::vector<uint32_t> functionLayoutOrder{};
+
   /* implicit */ BytecodeGenerationOptions(OutputFormatKind format)
       : format(format) {}
 
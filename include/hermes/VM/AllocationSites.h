@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_ALLOCATIONSITES_H
+#define HERMES_VM_ALLOCATIONSITES_H
+
+#include "hermes/VM/AllocOptions.h"
+#include "hermes/VM/GCDecl.h"
+#include "hermes/VM/WeakRoot.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace hermes {
+class JSONEmitter;
+
+namespace vm {
+
+class CodeBlock;
+class GCCell;
+class Runtime;
+struct WeakRootAcceptor;
+
+/// Lifetime feedback for the allocation sites of the interpreter, i.e. the
+/// NewObject, NewArray and literal instructions, keyed by CodeBlock and
+/// bytecode offset. It is owned by the Runtime when pretenuring is enabled.
+/// Sites whose objects usually survive a YG collection allocate them directly
+/// in the OG, which saves copying them out of the YG.
+///
+/// Lifetimes are sampled: some of the objects that a site allocates in the YG
+/// are kept as weak roots. Once a YG collection ran, a sample that was moved
+/// out of the YG survived it, and a sample that was cleared died. Pretenured
+/// sites keep allocating a few samples in the YG, so that they go back to
+/// allocating in the YG when their objects stop surviving.
+class AllocationSites {
+ public:
+  /// Where a site allocates its next object.
+  struct Decision {
+    /// The index of the site, to pass to addSample.
+    uint32_t site;
+    /// Whether the object is allocated directly in the OG.
+    LongLived longLived;
+    /// Whether the object must be passed to addSample once it is allocated.
+    bool sample;
+  };
+
+  /// Decide where the instruction at \p offset in \p codeBlock allocates its
+  /// next object.
+  Decision decide(CodeBlock *codeBlock, uint32_t offset);
+
+  /// Record \p cell, which was allocated by \p site after a decision to
+  /// sample it, as a sample of the lifetime of the objects of \p site.
+  void addSample(Runtime &runtime, uint32_t site, GCCell *cell);
+
+  /// Mark the samples as weak roots.
+  void markWeakRoots(WeakRootAcceptor &acceptor);
+
+  /// Emit the number of sites, and how many of them were pretenured, to
+  /// \p json.
+  void printStats(JSONEmitter &json) const;
+
+ private:
+  /// The number of allocations between two samples of a site that allocates
+  /// in the YG. It doubles every time the site is found to be short-lived, up
+  /// to kMaxSampleInterval, to keep the cost of sampling low.
+  static constexpr uint32_t kMinSampleInterval = 4;
+  static constexpr uint32_t kMaxSampleInterval = 256;
+
+  /// The number of allocations between two samples of a pretenured site.
+  static constexpr uint32_t kPretenuredSampleInterval = 64;
+
+  /// The number of resolved samples after which the site is reconsidered.
+  static constexpr uint32_t kSamplesPerDecision = 32;
+
+  /// A site allocating in the YG is pretenured if at least this percentage of
+  /// its samples survived, and a pretenured site goes back to the YG if less
+  /// than kRevertPercent survived.
+  static constexpr uint32_t kPretenurePercent = 85;
+  static constexpr uint32_t kRevertPercent = 50;
+
+  /// The maximum number of pending samples.
+  static constexpr size_t kMaxSamples = 512;
+
+  /// The maximum number of sites. Sites are never freed, so this bounds the
+  /// memory used by code that is loaded and unloaded repeatedly. Allocations
+  /// from sites beyond this limit always go to the YG.
+  static constexpr uint32_t kMaxSites = 1 << 16;
+
+  /// The index of the site that stands for all sites beyond kMaxSites.
+  static constexpr uint32_t kNoSite = ~0u;
+
+  struct Site {
+    /// The number of allocations until the next sample.
+    uint32_t untilSample{kMinSampleInterval};
+    /// The current number of allocations between samples.
+    uint32_t sampleInterval{kMinSampleInterval};
+    /// The number of resolved samples since the last decision.
+    uint32_t numSamples{0};
+    /// How many of those samples survived a YG collection.
+    uint32_t numSurvivors{0};
+    /// Whether the site allocates directly in the OG.
+    bool pretenured{false};
+  };
+
+  struct Sample {
+    WeakRoot<GCCell> cell;
+    uint32_t site;
+  };
+
+  /// Update the sites of the samples that a YG collection resolved, and drop
+  /// those samples.
+  void resolveSamples(Runtime &runtime);
+
+  /// Count a resolved sample of \p site, which survived if \p survived, and
+  /// reconsider where the site allocates once it has enough samples.
+  void recordLifetime(Site &site, bool survived);
+
+  std::vector<Site> sites_;
+
+  /// The samples that no YG collection has resolved yet, oldest first.
+  std::vector<Sample> samples_;
+
+  /// The number of times a site was pretenured, and went back to the YG.
+  uint64_t numPretenured_{0};
+  uint64_t numReverted_{0};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_ALLOCATIONSITES_H
@@ -430,13 +430,6 @@ class NativeFunction : public Callable {
   /// Pointer to the actual code.
   const NativeFunctionPtr functionPtr_;
 
-#ifdef HERMESVM_PROFILER_NATIVECALL
-  /// How many times the function was called.
-  uint32_t callCount_{0};
-  /// Total duration of all calls.
-  uint64_t callDuration_{0};
-#endif
-
  public:
   using Super = Callable;
   static const CallableVTable vt;
@@ -459,22 +452,6 @@ class NativeFunction : public Callable {
     return functionPtr_;
   }
 
-#ifdef HERMESVM_PROFILER_NATIVECALL
-  uint32_t getCallCount() const {
-    return callCount_;
-  }
-  uint32_t getCallDuration() const {
-    return callDuration_;
-  }
-#else
-  uint32_t getCallCount() const {
-    return 0;
-  }
-  uint32_t getCallDuration() const {
-    return 0;
-  }
-#endif
-
   /// This is a lightweight and unsafe wrapper intended to be used only by the
   /// interpreter. Its purpose is to avoid needlessly exposing the private
   /// fields.
@@ -499,17 +476,15 @@ class NativeFunction : public Callable {
           Runtime::StackOverflowKind::JSRegisterStack);
     }
 
-#ifdef HERMESVM_PROFILER_NATIVECALL
-    auto t1 = HERMESVM_RDTSC();
-#endif
+    InterpreterProfiler &profiler = runtime.getInterpreterProfiler();
+    if (LLVM_UNLIKELY(profiler.isEnabled(InterpreterProfiler::NativeCalls)))
+      profiler.enterNativeFunction((void *)self->functionPtr_);
 
     auto res =
         self->functionPtr_(self->context_, runtime, newFrame.getNativeArgs());
 
-#ifdef HERMESVM_PROFILER_NATIVECALL
-    self->callDuration_ = HERMESVM_RDTSC() - t1;
-    ++self->callCount_;
-#endif
+    if (LLVM_UNLIKELY(profiler.isEnabled(InterpreterProfiler::NativeCalls)))
+      profiler.exitNativeFunction((void *)self->functionPtr_);
     runtime.restoreStackAndPreviousFrame(newFrame);
     if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
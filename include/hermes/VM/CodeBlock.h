@@ -14,9 +14,10 @@
 #include "hermes/Support/SourceErrorManager.h"
 #include "hermes/VM/HermesValue.h"
 #include "hermes/VM/IdentifierTable.h"
-#include "hermes/VM/Profiler.h"
+#include "hermes/VM/Profiler/InterpreterProfiler.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/SerializedLiteralParser.h"
+#include "llvh/ADT/DenseMap.h"
 #include "llvh/ADT/DenseSet.h"
 #include "llvh/ADT/Optional.h"
 #include "llvh/Support/TrailingObjects.h"
@@ -63,6 +64,10 @@ class CodeBlock final
   /// cache.
   const uint32_t writePropCacheOffset_;
 
+  /// The indices in the Runtime's AllocationSites of the allocation sites of
+  /// this function, by bytecode offset. Only used when pretenuring is enabled.
+  llvh::DenseMap<uint32_t, uint32_t> allocationSites_;
+
 #ifndef HERMESVM_LEAN
   /// Compiles a lazy CodeBlock. Intended to be called from lazyCompile.
   ExecutionStatus lazyCompileImpl(Runtime &runtime);
@@ -99,10 +104,9 @@ class CodeBlock final
   }
 
  public:
-#if defined(HERMESVM_PROFILER_JSFUNCTION)
-  /// ID written/read by JS function profiler on first/later function events.
+  /// ID assigned by the interpreter profiler the first time it records a call
+  /// to this function.
   ProfilerID profilerID{NO_PROFILER_ID};
-#endif
 
   /// Create a CodeBlock for a given runtime module \p runtimeModule. The result
   /// must be deallocated via delete, which is overridden.
@@ -279,6 +283,12 @@ class CodeBlock final
     return &propertyCache()[writePropCacheOffset_ + idx];
   }
 
+  /// \return the indices of the allocation sites of this function in the
+  /// Runtime's AllocationSites, by bytecode offset.
+  llvh::DenseMap<uint32_t, uint32_t> &allocationSites() {
+    return allocationSites_;
+  }
+
   // Mark all hidden classes in the property cache as roots.
   void markCachedHiddenClasses(Runtime &runtime, WeakRootAcceptor &acceptor);
 
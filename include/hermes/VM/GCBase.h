@@ -535,8 +535,20 @@ class GCBase {
     ///   mechanism, giving deterministic output.
     void enable(size_t samplingInterval, int64_t seed);
 
+    /// Write out the profile like writeProfile(), then turn the profiler off
+    /// and forget all the samples.
     void disable(llvh::raw_ostream &os);
 
+    /// Write the samples of the objects that are still alive to \p os, in
+    /// the format of Chrome's sampling heap profile. Sampling goes on.
+    void writeProfile(llvh::raw_ostream &os);
+
+    /// Write to \p os a line for each allocation site that was sampled, with
+    /// the bytes and the objects sampled there that are still alive and that
+    /// were freed, and estimates of the bytes they stand for. The lines are
+    /// sorted by stack, so that the output of two runs can be diffed.
+    void writeSites(llvh::raw_ostream &os);
+
    private:
     struct Sample final {
       size_t size;
@@ -544,10 +556,29 @@ class GCBase {
       /// This is the auto-incremented sample ID, not the ID of the object
       /// associated with the sample.
       uint64_t id;
+      /// The number of bytes allocated that this sample stands for, per byte
+      /// of the sample: small objects are less likely to be sampled than
+      /// large ones, so each of their samples stands for more bytes.
+      double weight;
+    };
+
+    /// The samples taken at an allocation site. The freed ones accumulate
+    /// over the GCs that free them.
+    struct Site final {
+      /// The number and the bytes of the sampled objects that are alive.
+      uint64_t liveCount{0};
+      uint64_t liveBytes{0};
+      /// The number and the bytes of the sampled objects that were freed.
+      uint64_t freedCount{0};
+      uint64_t freedBytes{0};
+      /// Estimates of the bytes allocated at the site that are alive and that
+      /// were freed, sampled or not.
+      double estimatedLiveBytes{0};
+      double estimatedFreedBytes{0};
     };
 
-    /// This mutex protects stackMap_ and samples_. Not needed for enabling and
-    /// disabling because those only happen while the world is stopped.
+    /// This mutex protects samples_ and freedSites_. Not needed for enabling
+    /// and disabling because those only happen while the world is stopped.
     Mutex mtx_;
 
     GCBase *gc_;
@@ -559,9 +590,19 @@ class GCBase {
     /// Track all samples that have been taken.
     llvh::DenseMap<HeapSnapshot::NodeID, Sample> samples_;
 
-    /// Use a poisson distribution to decide when to take the next sample.
+    /// The samples that were freed at each allocation site. The samples that
+    /// are alive are only in samples_, and are added up when writing.
+    llvh::DenseMap<StackTracesTreeNode *, Site> freedSites_;
+
+    /// Samples are taken at the arrivals of a Poisson process over the bytes
+    /// allocated, whose intervals follow an exponential distribution. This
+    /// gives every byte the same chance to be sampled, whatever the sizes and
+    /// the order of the allocations.
     std::minstd_rand randomEngine_;
-    std::unique_ptr<std::poisson_distribution<>> dist_;
+    std::unique_ptr<std::exponential_distribution<>> dist_;
+
+    /// The mean number of bytes between two samples.
+    size_t samplingInterval_{0};
 
     /// An auto-incrementing integer representing a unique ID for a sample.
     /// Used for ordering samples.
@@ -995,9 +1036,12 @@ class GCBase {
   LLVM_ATTRIBUTE_NORETURN void oom(std::error_code reason);
 
 #ifdef HERMES_MEMORY_INSTRUMENTATION
-  /// Creates a snapshot of the heap and writes it to the given \p fileName.
+  /// Creates a snapshot of the heap and writes it to the given \p fileName,
+  /// compressed with gzip if it ends with ".gz".
   /// \return An error code on failure, else an empty error code.
-  std::error_code createSnapshotToFile(const std::string &fileName);
+  std::error_code createSnapshotToFile(
+      const std::string &fileName,
+      bool captureNumericValue = true);
 
   /// An edges counter array for each root section. The counter is uninitialized
   /// if a root section is not visited yet.
@@ -1055,6 +1099,15 @@ class GCBase {
   /// trace to \p os. After this call, any remembered data about sampled objects
   /// will be gone.
   virtual void disableSamplingHeapProfiler(llvh::raw_ostream &os);
+
+  /// Write out the samples of the sampling heap profiler that are still alive
+  /// to \p os, in the same format as disableSamplingHeapProfiler(), without
+  /// turning it off.
+  void writeSamplingHeapProfile(llvh::raw_ostream &os);
+
+  /// Write out the bytes that the sampling heap profiler attributes to each
+  /// allocation site, alive and freed, to \p os as a plain table.
+  void writeSamplingHeapProfileSites(llvh::raw_ostream &os);
 #endif // HERMES_MEMORY_INSTRUMENTATION
 
   /// Inform the GC about external memory retained by objects.
@@ -14,9 +14,11 @@
 #include "hermes/VM/HeapAlign.h"
 #include "hermes/VM/VTable.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #pragma GCC diagnostic push
 
 #ifdef HERMES_COMPILER_SUPPORTS_WSHORTEN_64_TO_32
@@ -218,6 +220,41 @@ class GCCell {
     return isMarked();
   }
 
+  /// These two functions are atomic versions of the above, for when several GC
+  /// threads may forward the same cell concurrently.
+
+  /// \return the marked forwarding pointer of this cell, or null if none has
+  /// been set, in which case \p size is set to the allocated size of the cell.
+  /// NOTE: this should only be used by the GC.
+  CompressedPointer getMarkedForwardingPointerAtomic(uint32_t &size) const {
+    const CompressedPointer::RawType raw =
+        header().load(std::memory_order_acquire);
+    if (raw & 0x1)
+      return CompressedPointer::fromRaw(raw - 0x1);
+    KindAndSize kindAndSize;
+    std::memcpy(&kindAndSize, &raw, sizeof(kindAndSize));
+    size = kindAndSize.getSize();
+    return CompressedPointer(nullptr);
+  }
+
+  /// Sets this cell to contain a marked forwarding pointer to \p cell, unless
+  /// another thread set one first.
+  /// \return the forwarding pointer held by this cell, which is \p cell if
+  ///   this call set it.
+  /// NOTE: this should only be used by the GC.
+  CompressedPointer setMarkedForwardingPointerAtomic(CompressedPointer cell) {
+    CompressedPointer::RawType raw = header().load(std::memory_order_relaxed);
+    while (!(raw & 0x1)) {
+      if (header().compare_exchange_weak(
+              raw,
+              cell.getRaw() | 0x1,
+              std::memory_order_release,
+              std::memory_order_acquire))
+        return cell;
+    }
+    return CompressedPointer::fromRaw(raw - 0x1);
+  }
+
   const GCCell *nextCell() const {
     return reinterpret_cast<const GCCell *>(
         reinterpret_cast<const char *>(this) + getAllocatedSize());
@@ -280,6 +317,18 @@ class GCCell {
   static constexpr uint32_t maxSize() {
     return KindAndSize::maxSize();
   }
+
+ private:
+  /// \return the first word of the cell, which holds either its KindAndSize
+  /// or a forwarding pointer, as an atomic.
+  std::atomic<CompressedPointer::RawType> &header() const {
+    static_assert(
+        sizeof(KindAndSize) == sizeof(CompressedPointer::RawType) &&
+            sizeof(forwardingPointer_) == sizeof(CompressedPointer::RawType),
+        "The header must fit in a single atomic word");
+    return *reinterpret_cast<std::atomic<CompressedPointer::RawType> *>(
+        const_cast<AssignableCompressedPointer *>(&forwardingPointer_));
+  }
 };
 
 /// A VariableSizeRuntimeCell is a GCCell with a variable size only known
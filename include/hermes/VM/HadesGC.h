@@ -20,6 +20,7 @@
 #include "llvh/Support/ErrorOr.h"
 #include "llvh/Support/PointerLikeTypeTraits.h"
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -347,6 +348,8 @@ class HadesGC final : public GCBase {
   class MarkWeakRootsAcceptor;
   class OldGen;
   class Executor;
+  class WorkerPool;
+  class ParallelEvacuation;
 
   struct CopyListCell final : public GCCell {
     // Linked list of cells pointing to the next cell that was copied.
@@ -408,6 +411,19 @@ class HadesGC final : public GCBase {
     /// \post This function either successfully allocates, or reports OOM.
     GCCell *alloc(uint32_t sz);
 
+    /// Like alloc, but returns the error instead of reporting OOM, for threads
+    /// other than the mutator.
+    llvh::ErrorOr<GCCell *> allocOrError(uint32_t sz);
+
+    /// Searches the OG for a space to allocate memory into.
+    /// \return A pointer to uninitialized memory that can be written into, null
+    ///   if no such space exists.
+    GCCell *search(uint32_t sz);
+
+    /// Put the \p sz bytes at \p start, which were allocated by alloc or
+    /// search but not used, back on the freelist of their segment.
+    void returnToFreelist(char *start, uint32_t sz);
+
     /// \return the total number of bytes that are in use by the OG section of
     /// the JS heap, including any bytes allocated in a pending compactee, and
     /// excluding free list entries.
@@ -637,11 +653,6 @@ class HadesGC final : public GCBase {
 #endif
     } sweepIterator_;
 
-    /// Searches the OG for a space to allocate memory into.
-    /// \return A pointer to uninitialized memory that can be written into, null
-    ///   if no such space exists.
-    GCCell *search(uint32_t sz);
-
     /// Common path for when an allocation has succeeded.
     /// \param cell The free memory that will soon have an object allocated into
     ///   it.
@@ -689,6 +700,18 @@ class HadesGC final : public GCBase {
   /// Protected by gcMutex_.
   OldGen oldGen_;
 
+  /// A region of the OG that the mutator allocates long-lived cells from
+  /// without taking gcMutex_. The cells occupy [start + minAllocationSize(),
+  /// level). While the buffer is in use, a FillerCell at its start covers all
+  /// of it, so that the sweeper and heap walks skip it, and all of its mark
+  /// bits are set, so that the marker treats its cells as allocated black.
+  /// Only accessed by the mutator.
+  struct LongLivedBuffer {
+    char *start{nullptr};
+    char *level{nullptr};
+    char *end{nullptr};
+  } longLivedBuffer_;
+
   /// Whoever holds this lock is permitted to modify data structures around the
   /// GC. This includes mark bits, free lists, etc.
   Mutex gcMutex_;
@@ -732,6 +755,45 @@ class HadesGC final : public GCBase {
   /// concurrently with the mutator.
   std::unique_ptr<Executor> backgroundExecutor_;
 
+  /// Threads that help the background thread mark the OG. Only created when
+  /// more than one mark thread is configured, in concurrent mode.
+  std::unique_ptr<WorkerPool> markWorkers_;
+
+  /// The markers used by markWorkers_, one per helper thread. They are only
+  /// accessed while the background thread holds gcMutex_ and waits for the
+  /// helpers, or during the STW pause of completeMarking.
+  std::vector<std::unique_ptr<MarkAcceptor>> helperMarkers_;
+
+  /// Marking throughput of one of the mark threads, accumulated over all OG
+  /// collections.
+  struct MarkThreadStats {
+    /// Number of bytes marked by the thread.
+    uint64_t markedBytes{0};
+    /// Wall time the thread spent marking, in seconds.
+    double markTime{0};
+  };
+
+  /// The stats of each mark thread in parallel marking, where the first is
+  /// the background thread. Protected by gcMutex_.
+  std::vector<MarkThreadStats> markThreadStats_;
+
+  /// Threads that help the mutator evacuate the YG. Only created when more
+  /// than one evacuation thread is configured, in concurrent mode.
+  std::unique_ptr<WorkerPool> evacWorkers_;
+
+  /// Serializes the OG allocations made by the threads of a parallel
+  /// evacuation, which the mutator runs while holding gcMutex_.
+  Mutex promotionMutex_;
+
+  /// The number of buckets in ygPauseHistogram_.
+  static constexpr size_t kNumYGPauseBuckets = 10;
+
+  /// The number of YG collections by pause time. The first bucket counts the
+  /// pauses shorter than 0.25 ms, and each following bucket doubles that limit,
+  /// except the last one, which counts the pauses of 64 ms or more. Protected by
+  /// gcMutex_.
+  std::array<uint64_t, kNumYGPauseBuckets> ygPauseHistogram_{};
+
   /// True from the time the background task is created, to the time it exits
   /// the collection loop. False otherwise. Protected by gcMutex_.
   bool backgroundTaskActive_{false};
@@ -864,6 +926,25 @@ class HadesGC final : public GCBase {
   /// necessary to create room).
   void *allocLongLived(uint32_t sz);
 
+  /// Allocate a long-lived cell of size \p sz from longLivedBuffer_, without
+  /// taking gcMutex_ unless the buffer has to be replaced.
+  /// \return the allocated memory, or null if the cell should be allocated
+  ///   with allocLongLived instead.
+  inline void *allocLongLivedInBuffer(uint32_t sz);
+
+  /// Retire longLivedBuffer_ and replace it with a new buffer to allocate \p sz
+  /// bytes from.
+  /// \return the allocated memory, or null if \p sz is too large for a buffer
+  ///   or the OG could not provide one.
+  void *refillLongLivedBuffer(uint32_t sz);
+
+  /// Set the cell heads and the mark bits of the cells in longLivedBuffer_,
+  /// put its unused rest back on the freelist, and stop using it. This must
+  /// be done before anything that walks the OG, or relies on the mark bits or
+  /// the cell heads being exact.
+  /// \pre gcMutex_ must be held, and this must be called by the mutator.
+  void retireLongLivedBuffer();
+
   /// Perform a YG garbage collection. All live objects in YG will be evacuated
   /// to the OG.
   /// \param cause The cause of the GC, used for logging.
@@ -873,9 +954,25 @@ class HadesGC final : public GCBase {
   ///   allocations.
   void youngGenCollection(std::string cause, bool forceOldGenCollection);
 
+  /// Evacuate all the live objects in the YG, and in the compactee if
+  /// \p doCompaction is true, to the OG.
+  /// \return the number of bytes that were evacuated.
+  template <bool CompactionEnabled>
+  uint64_t youngGenEvacuate(bool doCompaction);
+
   template <typename Acceptor>
   void youngGenEvacuateImpl(Acceptor &acceptor, bool doCompaction);
 
+  /// Same as youngGenEvacuateImpl, but splits the work between the threads of
+  /// evacWorkers_.
+  /// \return the number of bytes that were evacuated.
+  template <bool CompactionEnabled>
+  uint64_t youngGenEvacuateInParallel(bool doCompaction);
+
+  /// Add a YG collection that paused the mutator for \p pause to
+  /// ygPauseHistogram_.
+  void recordYGPause(std::chrono::microseconds pause);
+
   /// In the "no GC before TTI" mode, move the Young Gen heap segment to the
   /// Old Gen without scanning for garbage.
   /// \return true if a promotion occurred, false if it did not.
@@ -937,6 +1034,12 @@ class HadesGC final : public GCBase {
   /// whether this call was made from the background thread.
   void incrementalCollect(bool backgroundThread);
 
+  /// Drain some of the mark worklist using all the mark threads, stealing work
+  /// from each other. Returns early if the mutator requests the background
+  /// thread to pause.
+  /// \return true if there is any remaining work in the local worklist.
+  bool drainMarkWorkInParallel();
+
   /// Iterate the list of `weakMapEntrySlots_`, for each non-free slot, if
   /// both the key and the owner are marked, mark the mapped value.
   /// Note that this may further cause other values to be marked, so we need to
@@ -966,9 +1069,9 @@ class HadesGC final : public GCBase {
 
   /// Search a single segment for pointers that may need to be updated as the
   /// YG/compactee are evacuated.
-  template <bool CompactionEnabled>
+  template <typename Acceptor>
   void scanDirtyCardsForSegment(
-      SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
+      SlotVisitor<Acceptor> &visitor,
       HeapSegment &segment);
 
   /// Find all pointers from OG into the YG/compactee during a YG collection.
@@ -1086,6 +1189,10 @@ inline T *HadesGC::makeA(uint32_t size, Args &&...args) {
       "Call to makeA must use a size aligned to HeapAlign");
   assert(noAllocLevel_ == 0 && "No allocs allowed right now.");
   if (longLived == LongLived::Yes) {
+    if (void *mem = allocLongLivedInBuffer(size))
+      return constructCell<T>(mem, size, std::forward<Args>(args)...);
+    // Large cells are allocated directly, and must be constructed before the
+    // sweeper can see them.
     auto lk = ensureBackgroundTaskPaused();
     return constructCell<T>(
         allocLongLived(size), size, std::forward<Args>(args)...);
@@ -1120,6 +1227,20 @@ void *HadesGC::allocWork(uint32_t sz) {
   return resPtr;
 }
 
+void *HadesGC::allocLongLivedInBuffer(uint32_t sz) {
+  LongLivedBuffer &buf = longLivedBuffer_;
+  const size_t available = buf.end - buf.level;
+  // The rest of the buffer must be empty or large enough to go back on the
+  // freelist.
+  if (LLVM_UNLIKELY(
+          sz + minAllocationSize() > available && sz != available))
+    return refillLongLivedBuffer(sz);
+  void *const res = buf.level;
+  buf.level += sz;
+  totalAllocatedBytes_ += sz;
+  return res;
+}
+
 /// \}
 
 } // namespace vm
@@ -24,6 +24,7 @@
 
 #include <bitset>
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace hermes {
@@ -111,9 +112,20 @@ class HeapSnapshot {
       size_t traceFunctionCount,
       StackTracesTree *stackTracesTree);
 
+  /// Create a snapshot that writes nothing, and only counts the nodes, edges
+  /// and trace functions added to it, without keeping the tables needed to
+  /// write them. Edges are counted along with their nodes, so it only needs
+  /// the Nodes section and emitAllocationTraceInfo().
+  explicit HeapSnapshot(StackTracesTree *stackTracesTree);
+
   /// NOTE: this destructor writes to \p json.
   ~HeapSnapshot();
 
+  /// \return whether this snapshot only counts what is added to it.
+  bool isCountOnly() const {
+    return countOnly_;
+  }
+
   /// Opens \p section.  All sections between the next section to be closed
   ///(inclusive) and this one (exclusive) will be skipped by implicitly opening
   /// and closing them.
@@ -195,8 +207,17 @@ class HeapSnapshot {
   /// Whether the nextSection_ has been opened already.
   bool sectionOpened_{false};
 
+  /// Whether this snapshot only counts what is added to it.
+  const bool countOnly_{false};
+
+  /// The emitter of a snapshot that only counts, which writes nowhere.
+  std::unique_ptr<JSONEmitter> nullJSON_;
+
   JSONEmitter &json_;
   StackTracesTree *stackTracesTree_;
+  /// The index of each node, which edges and locations refer to. This is the
+  /// only table proportional to the size of the heap, since nodes and edges
+  /// are written out as they are added.
   llvh::DenseMap<NodeID, NodeIndex> nodeToIndex_;
   std::shared_ptr<StringSetVector> stringTable_;
   NodeIndex nodeCount_{0};
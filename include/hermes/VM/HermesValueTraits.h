@@ -39,7 +39,6 @@ HERMES_VM_GCOBJECT(Domain);
 HERMES_VM_GCOBJECT(Environment);
 HERMES_VM_GCOBJECT(FinalizableNativeFunction);
 HERMES_VM_GCOBJECT(GeneratorInnerFunction);
-HERMES_VM_GCOBJECT(HashMapEntry);
 HERMES_VM_GCOBJECT(HiddenClass);
 HERMES_VM_GCOBJECT(HostObject);
 HERMES_VM_GCOBJECT(JSArray);
@@ -58,6 +57,7 @@ HERMES_VM_GCOBJECT(JSGenerator);
 HERMES_VM_GCOBJECT(JSGeneratorFunction);
 HERMES_VM_GCOBJECT(JSNumber);
 HERMES_VM_GCOBJECT(JSObject);
+HERMES_VM_GCOBJECT(JSPromise);
 HERMES_VM_GCOBJECT(JSProxy);
 HERMES_VM_GCOBJECT(JSRegExp);
 HERMES_VM_GCOBJECT(JSRegExpStringIterator);
@@ -115,6 +115,14 @@ template <typename T>
 class BufferedStringPrimitive;
 template <typename T>
 struct IsGCObject<BufferedStringPrimitive<T>> : public std::true_type {};
+template <typename T>
+class ConcatStringPrimitive;
+template <typename T>
+struct IsGCObject<ConcatStringPrimitive<T>> : public std::true_type {};
+template <typename T>
+class SlicedStringPrimitive;
+template <typename T>
+struct IsGCObject<SlicedStringPrimitive<T>> : public std::true_type {};
 
 template <size_t Size>
 struct EmptyCell;
@@ -248,6 +256,18 @@ struct HermesValueTraits<BufferedStringPrimitive<char>, true>
 template <>
 struct HermesValueTraits<BufferedStringPrimitive<char16_t>, true>
     : public StringTraitsImpl<BufferedStringPrimitive<char16_t>> {};
+template <>
+struct HermesValueTraits<ConcatStringPrimitive<char>, true>
+    : public StringTraitsImpl<ConcatStringPrimitive<char>> {};
+template <>
+struct HermesValueTraits<ConcatStringPrimitive<char16_t>, true>
+    : public StringTraitsImpl<ConcatStringPrimitive<char16_t>> {};
+template <>
+struct HermesValueTraits<SlicedStringPrimitive<char>, true>
+    : public StringTraitsImpl<SlicedStringPrimitive<char>> {};
+template <>
+struct HermesValueTraits<SlicedStringPrimitive<char16_t>, true>
+    : public StringTraitsImpl<SlicedStringPrimitive<char16_t>> {};
 
 template <class T>
 struct HermesValueTraits<T, true> {
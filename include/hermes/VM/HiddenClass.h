@@ -328,6 +328,19 @@ class HiddenClass final : public GCCell {
     forInCache_.setNull(runtime.getHeap());
   }
 
+  /// \return The JSON.stringify cache if one has been set, otherwise nullptr.
+  ArrayStorage *getJSONCache(Runtime &runtime) const {
+    return jsonCache_.get(runtime);
+  }
+
+  void setJSONCache(ArrayStorage *arr, Runtime &runtime) {
+    jsonCache_.set(runtime, arr, runtime.getHeap());
+  }
+
+  void clearJSONCache(Runtime &runtime) {
+    jsonCache_.setNull(runtime.getHeap());
+  }
+
   /// Reset the property map, unless this class is in dictionary mode.
   /// May be called by the GC for any HiddenClass not in a Handle.
   void clearPropertyMap(GC &gc) {
@@ -591,6 +604,11 @@ class HiddenClass final : public GCCell {
   /// Never used in dictionary mode.
   GCPointer<BigStorage> forInCache_{};
 
+  /// Cache that contains the prototype classes and the quoted property names
+  /// used by JSON.stringify for objects of this class. Never used in
+  /// dictionary mode.
+  GCPointer<ArrayStorage> jsonCache_{};
+
   /// Computes the updated class flags for a class with flags \p flags for when
   /// a property is added or updated with property flags \p pf and based on
   /// whether a new index like property has been added.
@@ -132,12 +132,16 @@ class Interpreter {
   /// Inlining this function is forbidden because it stores label values in a
   /// local static variable. Due to a bug in LLVM, it may sometimes be inlined
   /// anyway, so explicitly mark it as noinline.
-  template <bool SingleStep, bool EnableCrashTrace>
+  /// \tparam EnableProfiler whether to report opcodes and function calls to
+  ///   the InterpreterProfiler of the runtime.
+  template <bool SingleStep, bool EnableCrashTrace, bool EnableProfiler>
   LLVM_ATTRIBUTE_NOINLINE static CallResult<HermesValue> interpretFunction(
       Runtime &runtime,
       InterpreterState &state);
 
   /// Populates an object with literal values from the object buffer.
+  /// \param ip the instruction creating the object, which is its allocation
+  ///   site.
   /// \param numLiterals the amount of literals to read from the buffer.
   /// \param keyBufferIndex the first element of the key buffer to read.
   /// \param valBufferIndex the first element of the val buffer to read.
@@ -145,17 +149,21 @@ class Interpreter {
   static CallResult<PseudoHandle<>> createObjectFromBuffer(
       Runtime &runtime,
       CodeBlock *curCodeBlock,
+      const Inst *ip,
       unsigned numLiterals,
       unsigned keyBufferIndex,
       unsigned valBufferIndex);
 
   /// Populates an array with literal values from the array buffer.
+  /// \param ip the instruction creating the array, which is its allocation
+  ///   site.
   /// \param numLiterals the amount of literals to read from the buffer.
   /// \param bufferIndex the first element of the buffer to read.
   /// \return ExecutionStatus::EXCEPTION if the property definitions throw.
   static CallResult<PseudoHandle<>> createArrayFromBuffer(
       Runtime &runtime,
       CodeBlock *curCodeBlock,
+      const Inst *ip,
       unsigned numElements,
       unsigned numLiterals,
       unsigned bufferIndex);
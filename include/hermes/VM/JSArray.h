@@ -304,7 +304,8 @@ class JSArray final : public ArrayImpl {
       Handle<JSObject> prototypeHandle,
       Handle<HiddenClass> classHandle,
       size_type capacity = 0,
-      size_type length = 0);
+      size_type length = 0,
+      LongLived longLived = LongLived::No);
 
   /// Create an instance of Array, with [[Prototype]] initialized with
   /// \p prototypeHandle, with capacity for \p capacity elements and actual size
@@ -339,8 +340,13 @@ class JSArray final : public ArrayImpl {
 
   /// Create an instance of Array, using the standard array prototype, with
   /// capacity for \p capacity elements and actual size \p length.
-  static CallResult<Handle<JSArray>>
-  create(Runtime &runtime, size_type capacity, size_type length);
+  /// \param longLived whether to allocate the array directly in the old
+  ///   generation, for allocation sites whose objects usually survive.
+  static CallResult<Handle<JSArray>> create(
+      Runtime &runtime,
+      size_type capacity,
+      size_type length,
+      LongLived longLived = LongLived::No);
 
   /// A convenience method for setting the \c .length property of the array.
   /// It performs the necessary checks and updates the property. It could fail
@@ -23,6 +23,12 @@ CallResult<HermesValue> runtimeJSONParse(
 /// Alternative interface to runtimeJSONParse for strings outside the JS heap.
 CallResult<HermesValue> runtimeJSONParseRef(Runtime &runtime, UTF16Stream &&s);
 
+/// Parse the UTF8 JSON text \p utf8, which is outside the JS heap. ASCII text
+/// is scanned in place.
+CallResult<HermesValue> runtimeJSONParseUTF8(
+    Runtime &runtime,
+    llvh::ArrayRef<uint8_t> utf8);
+
 /// Returns a String in JSON format representing an ECMAScript value,
 /// according to 15.12.3.
 CallResult<HermesValue> runtimeJSONStringify(
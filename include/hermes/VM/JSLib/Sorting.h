@@ -8,15 +8,23 @@
 #ifndef HERMES_VM_JSLIB_SORTING_H
 #define HERMES_VM_JSLIB_SORTING_H
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include "hermes/VM/CallResult.h"
 
+#include "llvh/ADT/ArrayRef.h"
+#include "llvh/ADT/SmallVector.h"
+
 /// Defines custom sorting routines used in cases that we can't use std::sort.
 /// std::sort doesn't always use std::swap, performing operations that bypass
 /// the user-defined swap routines. When calling [[Put]] and [[Delete]], we
 /// can't bypass those operations, so we use a custom SortModel and define our
 /// own swap and less functions, which are used by these sorting functions.
+///
+/// All the sorting routines here are stable, and the comparison functions
+/// may fail, in which case sorting stops and the failure is propagated.
 
 namespace hermes {
 namespace vm {
@@ -38,9 +46,294 @@ class SortModel {
   virtual ~SortModel() = 0;
 };
 
-/// QuickSort to sort elements in the range [begin, end). Returns immediately
-/// with ExecutionStatus::EXCEPTION if any compare or swap operations fail.
-ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end);
+/// Stable sort of the elements in the range [begin, end) of \p sm. Elements
+/// are only compared while sorting, always by their original index, and the
+/// final order is then applied with at most (end - begin - 1) swaps. Returns
+/// immediately with ExecutionStatus::EXCEPTION if any compare or swap
+/// operations fail.
+ExecutionStatus timSort(SortModel *sm, uint32_t begin, uint32_t end);
+
+/// Stable sort of \p arr in place. \p less is invoked as less(a, b) with two
+/// elements of \p arr and must return a CallResult<bool>, which is true if a
+/// must be ordered before b. Returns immediately with
+/// ExecutionStatus::EXCEPTION if \p less fails. The sort terminates, and \p
+/// arr remains a permutation of its original elements, even if \p less is
+/// not a consistent comparator.
+template <typename T, typename Less>
+ExecutionStatus timSort(llvh::MutableArrayRef<T> arr, Less less);
+
+namespace sorting {
+
+/// Arrays shorter than this are sorted with binary insertion sort only, and
+/// this is the upper bound of the minimum run length.
+constexpr uint32_t kMinMerge = 32;
+
+/// \return the minimum length of a run for an array of length \p n, chosen
+/// so that n / minRun is close to, but no more than, a power of two.
+inline uint32_t minRunLength(uint32_t n) {
+  uint32_t r = 0;
+  while (n >= kMinMerge) {
+    r |= n & 1;
+    n >>= 1;
+  }
+  return n + r;
+}
+
+/// Implementation of timSort(): natural runs are detected (strictly
+/// descending runs are reversed), extended to a minimum length with binary
+/// insertion sort, and merged while maintaining the TimSort invariants on the
+/// run stack. Merges skip the prefix of the left run and the suffix of the
+/// right run that are already in place, so sorted and nearly sorted inputs
+/// require close to n comparisons.
+template <typename T, typename Less>
+class TimSorter {
+ public:
+  TimSorter(llvh::MutableArrayRef<T> arr, Less &less) : a_(arr), less_(less) {}
+
+  ExecutionStatus sort() {
+    uint32_t n = a_.size();
+    if (n < 2)
+      return ExecutionStatus::RETURNED;
+
+    if (n < kMinMerge) {
+      auto runRes = countRunAndMakeAscending(0, n);
+      if (LLVM_UNLIKELY(runRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      return binaryInsertionSort(0, n, *runRes);
+    }
+
+    uint32_t minRun = minRunLength(n);
+    uint32_t lo = 0;
+    uint32_t remaining = n;
+    do {
+      auto runRes = countRunAndMakeAscending(lo, n);
+      if (LLVM_UNLIKELY(runRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      uint32_t runLen = *runRes;
+      // Extend short runs to minRun elements.
+      if (runLen < minRun) {
+        uint32_t force = std::min(remaining, minRun);
+        if (LLVM_UNLIKELY(
+                binaryInsertionSort(lo, lo + force, lo + runLen) ==
+                ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        runLen = force;
+      }
+      runs_.push_back({lo, runLen});
+      if (LLVM_UNLIKELY(mergeCollapse() == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      lo += runLen;
+      remaining -= runLen;
+    } while (remaining != 0);
+
+    return mergeForceCollapse();
+  }
+
+ private:
+  /// A sorted run of elements [base, base + len).
+  struct Run {
+    uint32_t base;
+    uint32_t len;
+  };
+
+  /// The array being sorted.
+  llvh::MutableArrayRef<T> a_;
+
+  /// The comparison function.
+  Less &less_;
+
+  /// Temporary storage for merges, sized to the largest left run merged.
+  std::vector<T> tmp_{};
+
+  /// Stack of pending runs.
+  llvh::SmallVector<Run, 40> runs_{};
+
+  /// \return the length of the run starting at \p lo, which ends before \p
+  /// hi. If the run is strictly descending, reverse it.
+  CallResult<uint32_t> countRunAndMakeAscending(uint32_t lo, uint32_t hi) {
+    uint32_t runHi = lo + 1;
+    if (runHi == hi)
+      return 1;
+
+    auto res = less_(a_[runHi], a_[lo]);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    ++runHi;
+    if (*res) {
+      // Strictly descending, which is required for stability when reversing.
+      for (; runHi < hi; ++runHi) {
+        res = less_(a_[runHi], a_[runHi - 1]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (!*res)
+          break;
+      }
+      std::reverse(a_.begin() + lo, a_.begin() + runHi);
+    } else {
+      for (; runHi < hi; ++runHi) {
+        res = less_(a_[runHi], a_[runHi - 1]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        if (*res)
+          break;
+      }
+    }
+    return runHi - lo;
+  }
+
+  /// Sort [lo, hi), where [lo, start) is already sorted, by inserting each
+  /// remaining element after all the elements it is not less than.
+  ExecutionStatus
+  binaryInsertionSort(uint32_t lo, uint32_t hi, uint32_t start) {
+    for (; start < hi; ++start) {
+      T pivot = std::move(a_[start]);
+      uint32_t left = lo;
+      uint32_t right = start;
+      while (left < right) {
+        uint32_t mid = left + (right - left) / 2;
+        auto res = less_(pivot, a_[mid]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          a_[start] = std::move(pivot);
+          return ExecutionStatus::EXCEPTION;
+        }
+        if (*res)
+          right = mid;
+        else
+          left = mid + 1;
+      }
+      std::move_backward(
+          a_.begin() + left, a_.begin() + start, a_.begin() + start + 1);
+      a_[left] = std::move(pivot);
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// \return the first index in [lo, hi) whose element is greater than \p
+  /// key, or hi.
+  CallResult<uint32_t> upperBound(const T &key, uint32_t lo, uint32_t hi) {
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      auto res = less_(key, a_[mid]);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res)
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    return lo;
+  }
+
+  /// \return the first index in [lo, hi) whose element is not less than \p
+  /// key, or hi.
+  CallResult<uint32_t> lowerBound(const T &key, uint32_t lo, uint32_t hi) {
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      auto res = less_(a_[mid], key);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+
+  /// Merge adjacent runs until the run lengths on the stack satisfy
+  /// len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i].
+  ExecutionStatus mergeCollapse() {
+    while (runs_.size() > 1) {
+      size_t n = runs_.size() - 2;
+      if ((n > 0 && runs_[n - 1].len <= runs_[n].len + runs_[n + 1].len) ||
+          (n > 1 && runs_[n - 2].len <= runs_[n - 1].len + runs_[n].len)) {
+        if (runs_[n - 1].len < runs_[n + 1].len)
+          --n;
+      } else if (runs_[n].len > runs_[n + 1].len) {
+        break;
+      }
+      if (LLVM_UNLIKELY(mergeAt(n) == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// Merge all the runs on the stack into one.
+  ExecutionStatus mergeForceCollapse() {
+    while (runs_.size() > 1) {
+      size_t n = runs_.size() - 2;
+      if (n > 0 && runs_[n - 1].len < runs_[n + 1].len)
+        --n;
+      if (LLVM_UNLIKELY(mergeAt(n) == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// Merge the runs at stack indices \p i and i + 1.
+  ExecutionStatus mergeAt(size_t i) {
+    uint32_t base1 = runs_[i].base;
+    uint32_t len1 = runs_[i].len;
+    uint32_t base2 = runs_[i + 1].base;
+    uint32_t len2 = runs_[i + 1].len;
+    assert(base1 + len1 == base2 && "runs must be adjacent");
+
+    runs_[i].len = len1 + len2;
+    runs_.erase(runs_.begin() + i + 1);
+
+    // Elements of the left run that are not greater than the first element
+    // of the right run are already in place.
+    auto boundRes = upperBound(a_[base2], base1, base2);
+    if (LLVM_UNLIKELY(boundRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    len1 -= *boundRes - base1;
+    base1 = *boundRes;
+    if (len1 == 0)
+      return ExecutionStatus::RETURNED;
+
+    // Elements of the right run that are not less than the last element of
+    // the left run are already in place.
+    boundRes = lowerBound(a_[base1 + len1 - 1], base2, base2 + len2);
+    if (LLVM_UNLIKELY(boundRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    len2 = *boundRes - base2;
+    if (len2 == 0)
+      return ExecutionStatus::RETURNED;
+
+    // Move the left run out of the way, and merge forward into its place.
+    // On failure, the remaining elements are moved back so that the array
+    // stays a permutation of the original.
+    tmp_.assign(
+        std::make_move_iterator(a_.begin() + base1),
+        std::make_move_iterator(a_.begin() + base2));
+    uint32_t left = 0;
+    uint32_t right = base2;
+    uint32_t dest = base1;
+    const uint32_t rightEnd = base2 + len2;
+    while (left < len1 && right < rightEnd) {
+      auto res = less_(a_[right], tmp_[left]);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+        std::move(tmp_.begin() + left, tmp_.begin() + len1, a_.begin() + dest);
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (*res)
+        a_[dest++] = std::move(a_[right++]);
+      else
+        a_[dest++] = std::move(tmp_[left++]);
+    }
+    // Whatever is left of the right run is already in place.
+    std::move(tmp_.begin() + left, tmp_.begin() + len1, a_.begin() + dest);
+    return ExecutionStatus::RETURNED;
+  }
+};
+
+} // namespace sorting
+
+template <typename T, typename Less>
+ExecutionStatus timSort(llvh::MutableArrayRef<T> arr, Less less) {
+  return sorting::TimSorter<T, Less>(arr, less).sort();
+}
 
 } // namespace vm
 } // namespace hermes
@@ -51,19 +51,19 @@ class JSMapImpl final : public JSObject {
     return ExecutionStatus::RETURNED;
   }
 
-  /// Advance iterator and return the next.
-  HashMapEntry *iteratorNext(Runtime &runtime, HashMapEntry *entry) {
-    return storage_.getNonNull(runtime)->iteratorNext(runtime, entry);
+  /// \return the table that a new iteration starts at.
+  SegmentedArray *iteratorBegin(Runtime &runtime) {
+    return storage_.getNonNull(runtime)->iteratorBegin(runtime);
   }
 
   /// Add a value.
-  static void addValue(
+  static ExecutionStatus addValue(
       Handle<JSMapImpl> self,
       Runtime &runtime,
       Handle<> key,
       Handle<> value) {
     self->assertInitialized();
-    OrderedHashMap::insert(
+    return OrderedHashMap::insert(
         runtime.makeHandle<OrderedHashMap>(self->storage_),
         runtime,
         key,
@@ -99,9 +99,10 @@ class JSMapImpl final : public JSObject {
   }
 
   /// Clear all elements from the storage.
-  static void clear(Handle<JSMapImpl> self, Runtime &runtime) {
+  static ExecutionStatus clear(Handle<JSMapImpl> self, Runtime &runtime) {
     self->assertInitialized();
-    self->storage_.getNonNull(runtime)->clear(runtime);
+    return OrderedHashMap::clear(
+        runtime.makeHandle<OrderedHashMap>(self->storage_), runtime);
   }
 
   /// Call \p callbackfn for each entry, with \p thisArg as this.
@@ -111,15 +112,19 @@ class JSMapImpl final : public JSObject {
       Handle<Callable> callbackfn,
       Handle<> thisArg) {
     self->assertInitialized();
-    MutableHandle<HashMapEntry> entry{runtime};
+    MutableHandle<SegmentedArray> table{runtime, self->iteratorBegin(runtime)};
+    uint32_t index = 0;
     GCScopeMarkerRAII marker{runtime};
-    for (entry = self->storage_.getNonNull(runtime)->iteratorNext(runtime);
-         entry;
-         entry = self->storage_.getNonNull(runtime)->iteratorNext(
-             runtime, entry.get())) {
+    for (;;) {
       marker.flush();
-      HermesValue key = entry->key;
-      HermesValue value = entry->value;
+      SegmentedArray *cur = table.get();
+      auto entry = OrderedHashMap::iteratorNext(runtime, cur, index);
+      if (!entry) {
+        break;
+      }
+      table = cur;
+      HermesValue key = OrderedHashMap::iteratorKey(runtime, cur, *entry);
+      HermesValue value = OrderedHashMap::iteratorValue(runtime, cur, *entry);
       assert(!key.isEmpty() && "Invalid key encountered");
       assert(!value.isEmpty() && "Invalid value encountered");
       if (LLVM_UNLIKELY(
@@ -192,6 +197,8 @@ class JSMapIteratorImpl final : public JSObject {
       Handle<JSMapImpl<JSMapTypeTraits<C>::ContainerKind>> data,
       IterationKind kind) {
     data_.set(runtime, data.get(), runtime.getHeap());
+    table_.set(runtime, data->iteratorBegin(runtime), runtime.getHeap());
+    index_ = 0;
     iterationKind_ = kind;
 
     assert(data_ && "Invalid storage data");
@@ -213,18 +220,16 @@ class JSMapIteratorImpl final : public JSObject {
       // Iteration has not yet reached the end previously.
       assert(self->data_ && "Storage uninitialized");
       // Advance the iterator.
-      self->itr_.set(
-          runtime,
-          self->data_.getNonNull(runtime)->iteratorNext(
-              runtime, self->itr_.get(runtime)),
-          runtime.getHeap());
-      if (self->itr_) {
+      SegmentedArray *table = self->table_.getNonNull(runtime);
+      auto entry = OrderedHashMap::iteratorNext(runtime, table, self->index_);
+      self->table_.setNonNull(runtime, table, runtime.getHeap());
+      if (entry) {
         switch (self->iterationKind_) {
           case IterationKind::Key:
-            value = self->itr_.getNonNull(runtime)->key;
+            value = OrderedHashMap::iteratorKey(runtime, table, *entry);
             break;
           case IterationKind::Value:
-            value = self->itr_.getNonNull(runtime)->value;
+            value = OrderedHashMap::iteratorValue(runtime, table, *entry);
             break;
           case IterationKind::Entry: {
             // If we are iterating both key and value, we need to create an
@@ -234,9 +239,12 @@ class JSMapIteratorImpl final : public JSObject {
               return ExecutionStatus::EXCEPTION;
             }
             auto arrHandle = *arrRes;
-            value = self->itr_.getNonNull(runtime)->key;
+            // The allocation may have moved the table.
+            table = self->table_.getNonNull(runtime);
+            value = OrderedHashMap::iteratorKey(runtime, table, *entry);
             JSArray::setElementAt(arrHandle, runtime, 0, value);
-            value = self->itr_.getNonNull(runtime)->value;
+            table = self->table_.getNonNull(runtime);
+            value = OrderedHashMap::iteratorValue(runtime, table, *entry);
             JSArray::setElementAt(arrHandle, runtime, 1, value);
             value = arrHandle.getHermesValue();
             break;
@@ -250,6 +258,7 @@ class JSMapIteratorImpl final : public JSObject {
         // reached the end.
         self->iterationFinished_ = true;
         self->data_.setNull(runtime.getHeap());
+        self->table_.setNull(runtime.getHeap());
       }
     }
     return createIterResultObject(runtime, value, self->iterationFinished_)
@@ -272,8 +281,12 @@ class JSMapIteratorImpl final : public JSObject {
   /// initialized or the iteration has ended.
   GCPointer<JSMapImpl<JSMapTypeTraits<C>::ContainerKind>> data_{nullptr};
 
-  /// Iteration pointer to the element storage in the Map.
-  GCPointer<HashMapEntry> itr_{nullptr};
+  /// The table of the iteration cursor in the Map storage. nullptr if the
+  /// iterator has not been initialized or the iteration has ended.
+  GCPointer<SegmentedArray> table_{nullptr};
+
+  /// The index of the next entry to visit in table_.
+  uint32_t index_{0};
 
   IterationKind iterationKind_;
 
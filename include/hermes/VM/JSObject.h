@@ -386,9 +386,12 @@ class JSObject : public GCCell {
 
   /// Attempts to allocate a JSObject with the given prototype.
   /// If allocation fails, the GC declares an OOM.
+  /// \param longLived whether to allocate the object directly in the old
+  ///   generation, for allocation sites whose objects usually survive.
   static PseudoHandle<JSObject> create(
       Runtime &runtime,
-      Handle<JSObject> parentHandle);
+      Handle<JSObject> parentHandle,
+      LongLived longLived = LongLived::No);
 
   /// Attempts to allocate a JSObject with the standard Object prototype.
   /// If allocation fails, the GC declares an OOM.
@@ -406,9 +409,12 @@ class JSObject : public GCCell {
   /// preallocated. If allocation fails, the GC declares an
   /// OOM.
   /// \param clazz the hidden class for the new object.
+  /// \param longLived whether to allocate the object directly in the old
+  ///   generation.
   static PseudoHandle<JSObject> create(
       Runtime &runtime,
-      Handle<HiddenClass> clazz);
+      Handle<HiddenClass> clazz,
+      LongLived longLived = LongLived::No);
 
   /// Allocates a JSObject with the given hidden class and prototype.
   /// If allocation fails, the GC declares an OOM.
@@ -946,6 +952,16 @@ class JSObject : public GCCell {
       PropOpFlags opFlags = PropOpFlags(),
       PropertyCacheEntry *cacheEntry = nullptr);
 
+  /// Check whether the prototype chain entry of \p cacheEntry applies to \p
+  /// self, i.e. whether \p self and each of its prototypes up to the cached
+  /// depth still have the recorded classes.
+  /// \return the object holding the cached property, or nullptr if the entry
+  ///   does not apply.
+  static inline JSObject *getCachedPropertyHolder(
+      JSObject *self,
+      PointerBase &base,
+      const PropertyCacheEntry &cacheEntry);
+
   // getNamedOrIndexed accesses a property with a SymbolIDs which may be
   // index-like.
   static CallResult<PseudoHandle<>> getNamedOrIndexed(
@@ -1353,6 +1369,17 @@ class JSObject : public GCCell {
     return static_cast<const ObjectVTable *>(GCCell::getVT());
   }
 
+  /// Populate the prototype chain entry of \p cacheEntry for a named
+  /// property found in \p propObj with descriptor \p desc, where \p propObj
+  /// is \p self or one of its prototypes. Does nothing if the lookup cannot
+  /// be cached, e.g. because an object in the chain is a dictionary.
+  static void cachePrototypeChainLookup(
+      JSObject *self,
+      PointerBase &base,
+      JSObject *propObj,
+      NamedPropertyDescriptor desc,
+      PropertyCacheEntry *cacheEntry);
+
   /// Allocate storage for a new slot after the slot index itself has been
   /// allocated by the hidden class.
   /// Note that slot storage is never truly released once allocated. Released
@@ -1933,6 +1960,30 @@ inline CallResult<PseudoHandle<>> JSObject::getNamed_RJS(
       selfHandle, runtime, name, selfHandle, opFlags, cacheEntry);
 }
 
+inline JSObject *JSObject::getCachedPropertyHolder(
+    JSObject *self,
+    PointerBase &base,
+    const PropertyCacheEntry &cacheEntry) {
+  assert(
+      cacheEntry.protoDepth != PropertyCacheEntry::kNoProtoEntry &&
+      "no prototype chain entry");
+  JSObject *curr = self;
+  for (unsigned depth = 0;; ++depth) {
+    CompressedPointer clazzPtr{curr->clazz_};
+    if (cacheEntry.protoChain[depth] != clazzPtr ||
+        LLVM_UNLIKELY(
+            curr->flags_.lazyObject || curr->flags_.hostObject ||
+            curr->flags_.proxyObject)) {
+      return nullptr;
+    }
+    if (depth == cacheEntry.protoDepth)
+      return curr;
+    curr = curr->parent_.get(base);
+    if (!curr)
+      return nullptr;
+  }
+}
+
 inline CallResult<PseudoHandle<>> JSObject::getComputed_RJS(
     Handle<JSObject> selfHandle,
     Runtime &runtime,
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JSPROMISE_H
+#define HERMES_VM_JSPROMISE_H
+
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/JSObject.h"
+#include "hermes/VM/Runtime.h"
+
+namespace hermes {
+namespace vm {
+
+/// A native Promise.
+///
+/// Reactions to a promise are native functions holding their handlers in
+/// internal slots (see \c ReactionSlot). When the promise settles, each of
+/// them is queued as a job, so that running a reaction doesn't allocate
+/// anything besides the record itself. A promise resolved with another native
+/// promise adopts its state synchronously instead of waiting for a job, and
+/// forwards its reactions to it.
+class JSPromise final : public JSObject {
+  using Super = JSObject;
+
+  friend void JSPromiseBuildMeta(const GCCell *cell, Metadata::Builder &mb);
+
+ public:
+  static const ObjectVTable vt;
+
+  enum class State : uint8_t {
+    Pending,
+    Fulfilled,
+    Rejected,
+    /// Resolved with another native promise, whose state this promise follows.
+    /// The result is that promise.
+    Adopted,
+  };
+
+  /// The internal slots of a reaction record.
+  enum ReactionSlot {
+    /// The handler called with the result of a fulfilled promise.
+    OnFulfilled,
+    /// The handler called with the result of a rejected promise.
+    OnRejected,
+    /// The capability settled with the outcome of the handler: a JSPromise,
+    /// or a capability created by \c newPromiseCapability(). Cleared once the
+    /// reaction has run.
+    Capability,
+    /// The promise that settled, set when the reaction is queued.
+    Settled,
+    ReactionSlotCount
+  };
+
+  static constexpr CellKind getCellKind() {
+    return CellKind::JSPromiseKind;
+  }
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == CellKind::JSPromiseKind;
+  }
+
+  /// Create a pending promise with prototype \p parentHandle.
+  static PseudoHandle<JSPromise> create(
+      Runtime &runtime,
+      Handle<JSObject> parentHandle);
+
+  /// Create a pending promise with %Promise.prototype% as its prototype.
+  static PseudoHandle<JSPromise> create(Runtime &runtime) {
+    return create(runtime, Handle<JSObject>::vmcast(&runtime.promisePrototype));
+  }
+
+  State getState() const {
+    return state_;
+  }
+
+  /// \return the value or reason of a settled promise, or the adopted promise.
+  HermesValue getResult() const {
+    return result_;
+  }
+
+  /// \return the promise whose state \p self follows, which is \p self unless
+  /// it has adopted another promise.
+  static JSPromise *getTarget(JSPromise *self);
+
+  /// Resolve \p self with \p resolution. A native promise using the intrinsic
+  /// `then` is adopted, the `then` method of any other thenable is called
+  /// synchronously, and any other value fulfills \p self. Errors thrown along
+  /// the way reject \p self.
+  /// \return EXCEPTION only if an uncatchable error was thrown.
+  static ExecutionStatus
+  resolve(Handle<JSPromise> self, Runtime &runtime, Handle<> resolution);
+
+  /// Reject \p self with \p reason.
+  static ExecutionStatus
+  reject(Handle<JSPromise> self, Runtime &runtime, Handle<> reason);
+
+  /// Create a reaction record running \p job, with all its slots undefined.
+  static Handle<NativeFunction> createReactionRecord(
+      Runtime &runtime,
+      NativeFunctionPtr job);
+
+  /// Create a reaction record calling \p onFulfilled or \p onRejected and
+  /// settling \p capability with the outcome. Handlers that aren't callable
+  /// pass the result through.
+  static Handle<NativeFunction> createReaction(
+      Runtime &runtime,
+      Handle<> onFulfilled,
+      Handle<> onRejected,
+      Handle<JSObject> capability);
+
+  /// Queue \p reaction when \p self settles, or immediately if it has settled
+  /// already.
+  static ExecutionStatus addReaction(
+      Handle<JSPromise> self,
+      Runtime &runtime,
+      Handle<NativeFunction> reaction);
+
+  /// Queue \p reaction as a job, on the runtime's job queue when microtasks
+  /// are enabled and with the global `setImmediate` otherwise.
+  static ExecutionStatus enqueueReaction(
+      Runtime &runtime,
+      Handle<NativeFunction> reaction);
+
+  /// Create a pair of resolving functions for \p self. Only the first call to
+  /// either of them has an effect.
+  static std::pair<Handle<NativeFunction>, Handle<NativeFunction>>
+  createResolvingFunctions(Handle<JSPromise> self, Runtime &runtime);
+
+  /// ES2023 27.2.1.5 NewPromiseCapability(C).
+  /// \return a capability for a promise created by the constructor \p C, from
+  /// which \c getCapabilityPromise() retrieves the promise.
+  static CallResult<Handle<JSObject>> newPromiseCapability(
+      Runtime &runtime,
+      Handle<> C);
+
+  /// \return the promise of \p capability.
+  static HermesValue getCapabilityPromise(
+      Runtime &runtime,
+      Handle<JSObject> capability);
+
+  /// Resolve or reject \p capability with \p value.
+  static ExecutionStatus settleCapability(
+      Runtime &runtime,
+      Handle<JSObject> capability,
+      Handle<> value,
+      bool isReject);
+
+  /// \return whether \p value is the intrinsic Promise.prototype.then.
+  static bool isIntrinsicThen(HermesValue value);
+
+  JSPromise(
+      Runtime &runtime,
+      Handle<JSObject> parent,
+      Handle<HiddenClass> clazz)
+      : JSObject(runtime, *parent, *clazz) {}
+
+ private:
+  /// Settle \p self, which must be pending, and queue its reactions.
+  static ExecutionStatus settle(
+      Handle<JSPromise> self,
+      Runtime &runtime,
+      State state,
+      Handle<> result);
+
+  /// Take the reactions of \p self and add them to \p target, which \p self
+  /// has settled or adopted.
+  static ExecutionStatus moveReactions(
+      Handle<JSPromise> self,
+      Runtime &runtime,
+      Handle<JSPromise> target);
+
+  /// The value or reason once settled, or the adopted promise.
+  GCHermesValue result_;
+
+  /// The reactions of a pending promise: undefined, a single reaction record,
+  /// or an ArrayStorage of them.
+  GCHermesValue reactions_;
+
+  State state_{State::Pending};
+
+  /// Whether a reaction was ever added, so a rejection would be handled.
+  bool isHandled_{false};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JSPROMISE_H
@@ -55,12 +55,23 @@ class MarkBitArrayNC {
   /// range of the array.
   inline void mark(size_t ind);
 
+  /// Marks the bit for the given index atomically, so that it can be called
+  /// concurrently for other bits of the array.
+  /// \return true if the bit was not marked before the call.
+  inline bool markAtomic(size_t ind);
+
   /// Clears the bit array.
   inline void clear();
 
   /// Sets all bits to true.
   inline void markAll();
 
+  /// Mark the bits in the range [from, to).
+  inline void markRange(size_t from, size_t to);
+
+  /// Unmark the bits in the range [from, to).
+  inline void clearRange(size_t from, size_t to);
+
   /// Finds the next bit in the MarkBitArray that is set to 1, starting at and
   /// including \p ind, the index from which to begin searching. Returns one
   /// past the last array index if there is not another marked bit.
@@ -140,6 +151,11 @@ void MarkBitArrayNC::mark(size_t ind) {
   bitArray_.set(ind, true);
 }
 
+bool MarkBitArrayNC::markAtomic(size_t ind) {
+  assert(ind < kNumBits && "precondition: ind must be within the index range");
+  return bitArray_.testAndSetAtomic(ind);
+}
+
 void MarkBitArrayNC::clear() {
   bitArray_.reset();
 }
@@ -148,6 +164,14 @@ void MarkBitArrayNC::markAll() {
   bitArray_.set();
 }
 
+void MarkBitArrayNC::markRange(size_t from, size_t to) {
+  bitArray_.set(from, to, true);
+}
+
+void MarkBitArrayNC::clearRange(size_t from, size_t to) {
+  bitArray_.set(from, to, false);
+}
+
 size_t MarkBitArrayNC::findNextMarkedBitFrom(size_t ind) {
   return bitArray_.findNextSetBitFrom(ind);
 }
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_NUMBERSTRINGCACHE_H
+#define HERMES_VM_NUMBERSTRINGCACHE_H
+
+#include "hermes/Support/OptValue.h"
+#include "hermes/VM/CompressedPointer.h"
+#include "hermes/VM/GCDecl.h"
+#include "hermes/VM/WeakRoot.h"
+
+#include <cstdint>
+
+namespace hermes {
+namespace vm {
+
+class StringPrimitive;
+struct WeakRootAcceptor;
+
+/// Direct-mapped caches of the conversions between numbers and strings, owned
+/// by the Runtime. A number that is converted to a string again finds the
+/// string allocated by the previous conversion, and a string that is
+/// converted to a number again skips parsing it.
+///
+/// The strings are weak roots, so the caches don't keep them alive: the GC
+/// clears the entries of strings that were collected, and updates the entries
+/// of strings that were moved.
+class NumberStringCache {
+ public:
+  /// Log2 of the number of entries in each cache.
+  static constexpr unsigned kLogSize = 8;
+
+  /// Number of entries in each cache.
+  static constexpr uint32_t kSize = 1u << kLogSize;
+
+  /// \return the string that \p number was last converted to, or nullptr if
+  /// it is not in the cache.
+  StringPrimitive *getString(PointerBase &base, GC &gc, double number) const;
+
+  /// Record that \p number converts to \p str.
+  void putString(PointerBase &base, double number, StringPrimitive *str);
+
+  /// \return the number that \p str was last converted to, or None if it is
+  /// not in the cache.
+  OptValue<double> getNumber(PointerBase &base, const StringPrimitive *str)
+      const;
+
+  /// Record that \p str converts to \p number.
+  void putNumber(PointerBase &base, const StringPrimitive *str, double number);
+
+  /// Mark the cached strings as weak roots.
+  void markWeakRoots(WeakRootAcceptor &acceptor);
+
+ private:
+  struct NumberToStringEntry {
+    double number{0};
+    WeakRoot<StringPrimitive> string{nullptr};
+  };
+
+  struct StringToNumberEntry {
+    WeakRoot<StringPrimitive> string{nullptr};
+    double number{0};
+  };
+
+  /// \return the index of the entry for \p number.
+  static uint32_t indexOf(double number);
+
+  /// \return the index of the entry for the string at \p ptr.
+  static uint32_t indexOf(CompressedPointer ptr);
+
+  NumberToStringEntry numberToString_[kSize]{};
+  StringToNumberEntry stringToNumber_[kSize]{};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_NUMBERSTRINGCACHE_H
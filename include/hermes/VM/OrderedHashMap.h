@@ -9,74 +9,43 @@
 #define HERMES_VM_ORDERED_HASHMAP_H
 
 #include "hermes/Support/ErrorHandling.h"
-#include "hermes/VM/ArrayStorage.h"
+#include "hermes/Support/OptValue.h"
 #include "hermes/VM/Runtime.h"
-
-#include <vector>
+#include "hermes/VM/SegmentedArray.h"
 
 namespace hermes {
 namespace vm {
 
-/// HashMapEntry is a gc-managed entry in the OrderedHashMap.
-/// We use HashMapEntry to form two separate linked lists,
-/// one that tracks the insertion order for iteration purpose, one
-/// tracks the list of entries in a hash table bucket for hash operations.
-class HashMapEntry final : public GCCell {
- public:
-  static const VTable vt;
-
-  /// The key.
-  GCHermesValue key;
-
-  /// The value.
-  GCHermesValue value;
-
-  /// Previous entry in insertion order.
-  GCPointer<HashMapEntry> prevIterationEntry{nullptr};
-
-  /// Next entry in insertion order.
-  GCPointer<HashMapEntry> nextIterationEntry{nullptr};
-
-  /// Next entry in the hash table bucket.
-  GCPointer<HashMapEntry> nextEntryInBucket{nullptr};
-
-  static constexpr CellKind getCellKind() {
-    return CellKind::HashMapEntryKind;
-  }
-  static bool classof(const GCCell *cell) {
-    return cell->getKind() == CellKind::HashMapEntryKind;
-  }
-
-  static CallResult<PseudoHandle<HashMapEntry>> create(Runtime &runtime);
-
-  /// Indicates whether this entry has been deleted.
-  bool isDeleted() const {
-    assert(key.isEmpty() == value.isEmpty() && "Inconsistent deleted status");
-    return value.isEmpty();
-  }
-
-  /// Mark this entry as deleted.
-  void markDeleted(Runtime &runtime) {
-    key.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
-    value.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
-  }
-}; // HashMapEntry
-
 /// OrderedHashMap is a gc-managed hash map that maintains insertion order.
-/// The map contains two conceptual parts: a standard chained hash table,
-/// to store and lookup HermesValue; a linked list to maintain the insertion
-/// order.
-/// When an element is added, it's always appended to the end of the linked
-/// list. When an element is deleted, we mark it as deleted and remove it
-/// from the linked list, unless it's the last element.
-/// Iterators are pointers to the entries, which are always linked according
-/// to insertion order.
-/// When the size of the hash table becomes unreasonably large or small
-/// comparing to the number of alive elements, we will rehash the table.
-/// We always make sure that any entry at any moment can successfully find
-/// the next entry according to insertion order, and rely on GC to manage
-/// the "deleted" entries", free them when no more iterators are before
-/// that entry.
+/// It is a deterministic hash table in the style of Tyler Close: the entries
+/// are stored densely in insertion order, and a table of buckets holds, for
+/// each hash bucket, the index of the last entry inserted into the bucket.
+/// The entries of a bucket are chained together by index, so neither lookups
+/// nor insertions allocate a cell per entry.
+///
+/// The buckets and the entries live in a single SegmentedArray, the "table",
+/// which is laid out as:
+///
+///   [header (kHeaderSize slots)]
+///   [buckets (numBuckets slots)]
+///   [entries (kEntrySize slots each, capacity = numBuckets * kLoadFactor)]
+///
+/// Every entry is a key, a value and the index of the next entry in its
+/// bucket. Bucket heads and chain links are native uint32 values, with empty
+/// marking the end of a chain. Erasing an entry leaves a hole in the entries
+/// (empty key and value), which is dropped the next time the table is
+/// rehashed. New entries are always appended after the last used entry, and
+/// the table is rehashed into a new one when the entries are exhausted or
+/// when too few of them are alive.
+///
+/// Iteration is done with a cursor: a table and the index of the next entry
+/// to visit in it. Because a rehash moves the entries to a new table, the old
+/// table is left behind as a forwarding table: it points to its replacement,
+/// and maps each of its entry indices to the index of the first entry at or
+/// after it that survived the rehash. A cursor into an old table follows the
+/// forwarding tables until it reaches the current one, so iterators keep
+/// their position across rehashes and clears, and visit entries inserted
+/// after they were created.
 class OrderedHashMap final : public GCCell {
   friend void OrderedHashMapBuildMeta(
       const GCCell *cell,
@@ -102,11 +71,6 @@ class OrderedHashMap final : public GCCell {
   static HermesValue
   get(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
 
-  /// Lookup \p key in the table and \return the value if exists.
-  /// Otherwise \return nullptr.
-  static HashMapEntry *
-  find(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
-
   /// Insert a key/value pair into the map, if not already existing.
   static ExecutionStatus insert(
       Handle<OrderedHashMap> self,
@@ -118,72 +82,152 @@ class OrderedHashMap final : public GCCell {
   static bool
   erase(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
 
-  /// Clear the map.  The \p gc parameter is necessary for write barriers.
-  void clear(Runtime &runtime);
+  /// Clear the map.
+  static ExecutionStatus clear(Handle<OrderedHashMap> self, Runtime &runtime);
 
   /// \return the size of the map.
   uint32_t size() const {
     return size_;
   }
 
-  /// \return the next element in insertion order.
-  /// If \p entry is nullptr, we are starting the iteration from the first
-  /// entry that is not deleted.
-  /// Otherwise, we look for the next element after \p entry that is not
-  /// deleted.
-  HashMapEntry *iteratorNext(Runtime &runtime, HashMapEntry *entry = nullptr)
-      const;
+  /// \return the table that a new iteration starts at, with index 0.
+  SegmentedArray *iteratorBegin(Runtime &runtime) const {
+    return table_.getNonNull(runtime);
+  }
 
-  OrderedHashMap(Runtime &runtime, Handle<ArrayStorageSmall> hashTableStorage);
+  /// Advance the iteration cursor (\p table, \p index) to the next live entry
+  /// in insertion order, moving it to the current table first if \p table
+  /// has been rehashed or cleared.
+  /// \return the index in \p table of the entry, whose key and value can be
+  ///   read with iteratorKey() and iteratorValue(), after which the cursor
+  ///   points past it; or None if there are no more entries.
+  static OptValue<uint32_t>
+  iteratorNext(PointerBase &base, SegmentedArray *&table, uint32_t &index);
 
- private:
-  /// The hashtable, with size always equal to capacity_. The number of
-  /// reachable entries from hashTable_ should be equal to size_.
-  GCPointer<ArrayStorageSmall> hashTable_{nullptr};
+  /// \return the key of the entry at \p entry in \p table.
+  static HermesValue
+  iteratorKey(PointerBase &base, const SegmentedArray *table, uint32_t entry) {
+    return table->at(base, keySlot(table, base, entry));
+  }
 
-  /// The first entry ever inserted. We need this entry to begin an iteration.
-  GCPointer<HashMapEntry> firstIterationEntry_{nullptr};
+  /// \return the value of the entry at \p entry in \p table.
+  static HermesValue iteratorValue(
+      PointerBase &base,
+      const SegmentedArray *table,
+      uint32_t entry) {
+    return table->at(base, keySlot(table, base, entry) + kValueOffset);
+  }
 
-  /// The last entry inserted. We need it to add new elements afterwards.
-  GCPointer<HashMapEntry> lastIterationEntry_{nullptr};
+  OrderedHashMap(Runtime &runtime, Handle<SegmentedArray> table);
 
-  /// Initial capacity of the hash table.
-  static constexpr uint32_t INITIAL_CAPACITY = 16;
+ private:
+  /// The slots of the table header.
+  enum HeaderSlot : uint32_t {
+    /// Empty while the table is in use. Once the table has been rehashed, the
+    /// table that replaced it.
+    kNextTableSlot,
+    /// The number of buckets, a power of 2.
+    kNumBucketsSlot,
+    /// The number of entries used so far, including deleted ones.
+    kNumEntriesSlot,
+    /// The number of deleted entries among the used ones.
+    kNumDeletedSlot,
+    kHeaderSize,
+  };
+
+  /// The slots of an entry, relative to its first slot.
+  enum EntryOffset : uint32_t {
+    kKeyOffset,
+    kValueOffset,
+    /// In a table that is in use, the index of the next entry in the same
+    /// bucket. In a forwarding table, the index in the next table of the
+    /// first entry at or after this one that survived the rehash.
+    kChainOffset,
+    kEntrySize,
+  };
+
+  /// The number of entries per bucket.
+  static constexpr uint32_t kLoadFactor = 2;
+
+  /// Number of buckets of a new table.
+  static constexpr uint32_t INITIAL_NUM_BUCKETS = 4;
+
+  /// Maximum number of buckets. The table, with its header, buckets and
+  /// entries, must fit in a SegmentedArray.
+  static constexpr uint32_t MAX_NUM_BUCKETS = 1u << 26;
+  static_assert(
+      kHeaderSize + MAX_NUM_BUCKETS * (1 + kLoadFactor * kEntrySize) <=
+          SegmentedArray::maxElements(),
+      "The largest table must fit in a SegmentedArray");
+
+  /// The current table.
+  GCPointer<SegmentedArray> table_{nullptr};
+
+  /// Number of alive entries in the map.
+  uint32_t size_{0};
 
-  /// Maximum capacity cannot exceed the maximum capacity of the underlying
-  /// ArrayStorage.
-  // It needs to be less than 1/4th the max 32-bit integer in order to use an
-  // integer-based load factor check of 0.75.
-  static constexpr uint32_t MAX_CAPACITY =
-      std::min(ArrayStorageSmall::maxElements(), UINT32_MAX / 4);
+  /// Allocate a table with \p numBuckets buckets and no entries.
+  static CallResult<PseudoHandle<SegmentedArray>> createTable(
+      Runtime &runtime,
+      uint32_t numBuckets);
 
-  /// Capacity of the hash table.
-  uint32_t capacity_{INITIAL_CAPACITY};
+  /// \return the native uint32 stored in \p slot of \p table.
+  static uint32_t
+  getUInt32(const SegmentedArray *table, PointerBase &base, uint32_t slot) {
+    return table->at(base, slot).getNativeUInt32();
+  }
 
-  /// Number of alive entries in the storage.
-  uint32_t size_{0};
+  /// Store the native uint32 \p value in \p slot of \p table.
+  static void setUInt32(
+      SegmentedArray *table,
+      Runtime &runtime,
+      uint32_t slot,
+      uint32_t value) {
+    table->setNonPtr(runtime, slot, HermesValue::encodeNativeUInt32(value));
+  }
+
+  /// \return the entry index stored in the bucket head or chain link at
+  /// \p slot of \p table, or None at the end of the chain.
+  static OptValue<uint32_t>
+  getLink(const SegmentedArray *table, PointerBase &base, uint32_t slot) {
+    HermesValue link = table->at(base, slot);
+    if (link.isEmpty())
+      return llvh::None;
+    return link.getNativeUInt32();
+  }
+
+  /// \return the index of the first slot of \p entry in \p table.
+  static uint32_t
+  keySlot(const SegmentedArray *table, PointerBase &base, uint32_t entry) {
+    return kHeaderSize + getUInt32(table, base, kNumBucketsSlot) +
+        entry * kEntrySize;
+  }
 
-  /// Hash a HermesValue to an index to our hash table.
+  /// \return the slot of the bucket head for \p key in the current table.
   static uint32_t
-  hashToBucket(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key) {
-    auto hash = runtime.gcStableHashHermesValue(key);
+  bucketSlot(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key) {
+    uint32_t numBuckets =
+        getUInt32(self->table_.getNonNull(runtime), runtime, kNumBucketsSlot);
     assert(
-        (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-        "capacity_ must be power of 2");
-    return hash & (self->capacity_ - 1);
+        (numBuckets & (numBuckets - 1)) == 0 &&
+        "numBuckets must be power of 2");
+    return kHeaderSize +
+        (runtime.gcStableHashHermesValue(key) & (numBuckets - 1));
   }
 
-  /// Remove a node from the linked list.
-  void removeLinkedListNode(Runtime &runtime, HashMapEntry *entry, GC &gc);
+  /// Lookup the entry with key \p key in the current table, starting from the
+  /// bucket head at \p bucket.
+  /// \return the index of the first slot of the entry, or None.
+  OptValue<uint32_t>
+  lookupInBucket(Runtime &runtime, uint32_t bucket, HermesValue key) const;
 
-  /// Lookup an entry with key as \p key in a given \p bucket.
-  HashMapEntry *
-  lookupInBucket(Runtime &runtime, uint32_t bucket, HermesValue key);
+  /// Move the live entries to a new table with \p numBuckets buckets, and
+  /// turn the current table into a forwarding table to it.
+  static ExecutionStatus
+  rehash(Handle<OrderedHashMap> self, Runtime &runtime, uint32_t numBuckets);
 
-  /// Adjust the capacity of the hashtable and rehash if necessary.
-  /// We make decisions based on the Load Factor (size / capacity).
-  /// Rehash if load factor is outside of the range of [0.25, 0.75].
-  static ExecutionStatus rehashIfNecessary(
+  /// Shrink the table if few of its entries are alive.
+  static ExecutionStatus shrinkIfNecessary(
       Handle<OrderedHashMap> self,
       Runtime &runtime);
 }; // OrderedHashMap
@@ -102,6 +102,10 @@ class CodeCoverageProfiler {
   /// \return executed function information for this profiler.
   std::vector<CodeCoverageProfiler::FuncInfo> getExecutedFunctionsLocal();
 
+  /// \return the IDs of the executed functions of \p module, in the order in
+  /// which they were first executed.
+  std::vector<uint32_t> getFirstExecutionOrder(RuntimeModule *module);
+
  private:
   static std::unordered_set<CodeCoverageProfiler *> &allProfilers();
   static std::mutex &globalMutex();
@@ -129,6 +133,10 @@ class CodeCoverageProfiler {
   /// RuntimeModule.
   llvh::DenseMap<RuntimeModule *, std::vector<bool>> executedFuncBitsArrayMap_;
 
+  /// RuntimeModule => IDs of its executed functions, in the order in which
+  /// they were first executed.
+  llvh::DenseMap<RuntimeModule *, std::vector<uint32_t>> firstExecutionOrder_;
+
   /// Domains to keep its RuntimeModules alive. Will be marked by markRoots().
   /// Does not require localMutex_ to be held since it is only modified and read
   /// by the runtime.
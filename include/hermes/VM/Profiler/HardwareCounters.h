@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_PROFILER_HARDWARECOUNTERS_H
+#define HERMES_VM_PROFILER_HARDWARECOUNTERS_H
+
+#include <array>
+#include <cstdint>
+
+namespace hermes {
+namespace vm {
+
+/// The CPU performance counters of one thread, read together with each sample
+/// of the sampling profiler. Comparing them across functions tells apart code
+/// that is bound by instruction dispatch (many instructions per cycle) from
+/// code that is bound by memory (many cache misses, few instructions per
+/// cycle).
+///
+/// The counters are only available on Linux, through perf_event_open(2), and
+/// only if the kernel exposes the CPU's PMU to the process. Everywhere else
+/// open() fails and nothing is ever counted.
+///
+/// open() and read() are async-signal-safe, so that they can be called from
+/// the signal handler that samples the thread.
+class HardwareCounters {
+ public:
+  enum Counter : uint8_t {
+    Cycles,
+    Instructions,
+    L1DCacheMisses,
+    LLCMisses,
+    BranchMisses,
+    NumCounters,
+  };
+
+  /// Value of a counter that couldn't be read.
+  static constexpr uint64_t kNoValue = UINT64_MAX;
+
+  /// Values indexed by Counter.
+  using Values = std::array<uint64_t, NumCounters>;
+
+  /// \return the name of \p counter, as emitted in profiles.
+  static const char *getName(Counter counter);
+
+  /// \return values where no counter was read.
+  static Values noValues() {
+    Values values;
+    values.fill(kNoValue);
+    return values;
+  }
+
+  HardwareCounters() = default;
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+  ~HardwareCounters() {
+    close();
+  }
+
+  /// Start counting on the calling thread, unless already counting on it.
+  /// Counting on another thread is stopped first. If no counter could be
+  /// opened once, e.g. because the CPU has no PMU, later calls fail without
+  /// trying again.
+  /// \return whether the counters are available.
+  bool openForCurrentThread();
+
+  /// Stop counting.
+  void close();
+
+  /// \return whether the counters are open.
+  bool isOpen() const {
+    return leaderFD_ != -1;
+  }
+
+  /// Store in \p values the events counted since the previous call, or since
+  /// the counters were opened. Counters that are not available, or that were
+  /// not scheduled on the CPU in that time, are set to kNoValue. Counts of a
+  /// group that was only scheduled part of the time are scaled up to the
+  /// whole time. May be called from any thread.
+  void readDeltas(Values &values);
+
+ private:
+  /// The file descriptor of the group leader, which reads the whole group, or
+  /// -1 when closed.
+  int leaderFD_{-1};
+
+  /// The file descriptor of each counter, or -1 if it isn't available.
+  std::array<int, NumCounters> fds_{{-1, -1, -1, -1, -1}};
+
+  /// The kernel ID of the thread being counted.
+  long tid_{0};
+
+  /// The values at the previous read.
+  Values last_{};
+
+  /// The times the group was enabled and running at the previous read.
+  uint64_t lastEnabled_{0};
+  uint64_t lastRunning_{0};
+
+  /// Whether opening failed for every counter, so that it isn't retried.
+  bool unavailable_{false};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_PROFILER_HARDWARECOUNTERS_H
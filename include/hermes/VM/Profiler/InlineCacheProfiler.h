@@ -59,6 +59,14 @@ class InlineCacheProfiler {
       ++hitCount;
     }
 
+    /// Whether the cache entry at this location was ever observed holding
+    /// more than one hidden class.
+    bool polymorphic{false};
+
+    /// Whether the cache entry at this location was ever observed in the
+    /// megamorphic state, where it no longer caches new hidden classes.
+    bool megamorphic{false};
+
     /// Total number of inline caching misses at the source location.
     uint64_t missCount{0};
 
@@ -87,6 +95,14 @@ class InlineCacheProfiler {
   /// Record an inline caching hit.
   bool insertICHit(CodeBlock *codeblock, uint32_t instOffset);
 
+  /// Record the polymorphism state of the cache entry used at a specific
+  /// source location.
+  void recordCacheState(
+      CodeBlock *codeblock,
+      uint32_t instOffset,
+      bool polymorphic,
+      bool megamorphic);
+
   /// Get the total number of inline caching misses.
   uint32_t getTotalMisses() {
     return totalMisses_;
@@ -163,6 +179,9 @@ class InlineCacheProfiler {
   /// Total number of inline caching hits during the program execution.
   uint64_t totalHits_{0};
 
+  /// Number of source locations whose cache entry became megamorphic.
+  uint64_t totalMegamorphic_{0};
+
   /// Store the data structure of all inline caching misses information.
   /// The map is keyed by pairs <instruction offset, CodeBlock> and maps
   /// to ICMiss objects, which keeps track of hidden classes and frequency.
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_PROFILER_INTERPRETERPROFILER_H
+#define HERMES_VM_PROFILER_INTERPRETERPROFILER_H
+
+#include "hermes/Inst/Inst.h"
+#include "hermes/Support/OptValue.h"
+
+#include "llvh/ADT/DenseMap.h"
+#include "llvh/ADT/StringRef.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define HERMESVM_PROFILER_RDTSC 1
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define HERMESVM_PROFILER_RDTSC 1
+#endif
+
+namespace hermes {
+namespace vm {
+
+class CodeBlock;
+class Runtime;
+
+/// ID assigned to each function the interpreter profiler encounters.
+using ProfilerID = uint32_t;
+
+constexpr ProfilerID NO_PROFILER_ID = UINT32_MAX;
+
+/// Profiler of the interpreter of a runtime, which can be turned on and off
+/// while the runtime runs. It records:
+/// - how many times each opcode was executed, and the time spent in it,
+/// - how many times each JS function was called, and its self time,
+/// - how many times each native function was called, and its self time.
+/// Time is measured in CPU cycles on x86 and in nanoseconds elsewhere. The
+/// self time of a function excludes the time spent in the JS and native
+/// functions it called.
+///
+/// The interpreter only calls into the profiler from a separate instantiation
+/// of its loop, which it switches to on the first call to a JS function after
+/// the profiler was turned on. Functions that were already running are not
+/// profiled, and when the profiler is off, its only cost is a check on every
+/// call.
+class InterpreterProfiler {
+ public:
+  /// What to profile, as a bit set.
+  enum Kind : uint8_t {
+    Opcodes = 1 << 0,
+    Functions = 1 << 1,
+    NativeCalls = 1 << 2,
+    AllKinds = Opcodes | Functions | NativeCalls,
+  };
+
+  /// Parse a comma separated list of "opcodes", "functions", "native" and
+  /// "all" in \p str.
+  /// \return the set of kinds, or None if \p str contains anything else.
+  static OptValue<uint8_t> parseKinds(llvh::StringRef str);
+
+  /// \return the current timestamp in the unit of the profile.
+  static uint64_t now() {
+#ifdef HERMESVM_PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+  }
+
+  /// Start profiling \p kinds, in addition to what is already profiled.
+  void enable(uint8_t kinds) {
+    kinds_ |= kinds;
+  }
+
+  /// Stop profiling everything. The data recorded so far is kept.
+  void disable();
+
+  /// Clear all the data recorded so far.
+  void reset();
+
+  /// \return whether any of \p kinds is being profiled.
+  bool isEnabled(uint8_t kinds = AllKinds) const {
+    return kinds_ & kinds;
+  }
+
+  /// Record the execution of an instruction with \p opCode, and attribute the
+  /// time since the previous one was recorded to the previous opcode.
+  void recordOpcode(inst::OpCode opCode) {
+    if (!isEnabled(Opcodes))
+      return;
+    uint64_t time = now();
+    if (lastOpcode_ != kNoOpcode)
+      opcodes_[lastOpcode_].time += time - lastOpcodeStart_;
+    ++opcodes_[(uint8_t)opCode].count;
+    lastOpcode_ = (uint8_t)opCode;
+    lastOpcodeStart_ = time;
+  }
+
+  /// Stop attributing time to the last recorded opcode. Called when control
+  /// leaves an activation of the interpreter, so that the time spent outside
+  /// of it isn't counted as part of the opcode it executed last.
+  void pauseOpcodeTiming() {
+    lastOpcode_ = kNoOpcode;
+  }
+
+  /// Record a call to the JS function of \p codeBlock.
+  void enterFunction(Runtime &runtime, CodeBlock *codeBlock);
+
+  /// Record the return, normal or not, from the JS function of \p codeBlock.
+  void exitFunction(CodeBlock *codeBlock);
+
+  /// Record a call to the native function \p fn.
+  void enterNativeFunction(void *fn);
+
+  /// Record the return from the native function \p fn.
+  void exitNativeFunction(void *fn);
+
+  /// Print the data recorded so far to \p os, sorted by decreasing time.
+  void dump(llvh::raw_ostream &os) const;
+
+ private:
+  static constexpr uint16_t kNoOpcode = UINT16_MAX;
+  static constexpr size_t kNumOpcodes = (size_t)inst::OpCode::_last;
+
+  /// What is recorded about an opcode or a function.
+  struct Entry {
+    uint64_t count{0};
+    uint64_t time{0};
+  };
+
+  /// A function on the shadow call stack.
+  struct Frame {
+    /// The ID of a JS function or the index of a native function.
+    uint32_t id;
+    bool isNative;
+    /// When the function was entered.
+    uint64_t start;
+    /// The time spent in the functions it called.
+    uint64_t childrenTime;
+  };
+
+  /// Push a frame for function \p id.
+  void push(uint32_t id, bool isNative);
+
+  /// Pop the frame of function \p id and add its self time to \p entry. Does
+  /// nothing if it isn't on top of the stack, because the profiler was turned
+  /// on while it ran.
+  void pop(uint32_t id, bool isNative, Entry &entry);
+
+  /// The kinds of profiling that are on.
+  uint8_t kinds_{0};
+
+  /// Stats of each opcode, indexed by opcode.
+  Entry opcodes_[kNumOpcodes]{};
+
+  /// The opcode executed last, or kNoOpcode.
+  uint16_t lastOpcode_{kNoOpcode};
+  /// When the last opcode started executing.
+  uint64_t lastOpcodeStart_{0};
+
+  /// Name and stats of each JS function, indexed by the profiler ID stored in
+  /// its CodeBlock.
+  std::vector<std::pair<std::string, Entry>> functions_{};
+
+  /// Native function pointer => index in nativeFunctions_.
+  llvh::DenseMap<void *, uint32_t> nativeIndices_{};
+  /// Pointer and stats of each native function.
+  std::vector<std::pair<void *, Entry>> nativeFunctions_{};
+
+  /// The functions currently executing, innermost last.
+  std::vector<Frame> stack_{};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_PROFILER_INTERPRETERPROFILER_H
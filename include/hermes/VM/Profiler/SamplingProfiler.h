@@ -14,6 +14,7 @@
 
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/JSNativeFunctions.h"
+#include "hermes/VM/Profiler/HardwareCounters.h"
 #include "hermes/VM/Runtime.h"
 
 #include "llvh/ADT/DenseMap.h"
@@ -98,14 +99,20 @@ class SamplingProfiler {
     TimeStampType timeStamp;
     /// Captured stack frames.
     std::vector<StackFrame> stack;
+    /// The hardware events counted on the thread since the previous sample.
+    HardwareCounters::Values counters = HardwareCounters::noValues();
 
     explicit StackTrace(uint32_t preallocatedSize) : stack(preallocatedSize) {}
     explicit StackTrace(
         ThreadId tid,
         TimeStampType ts,
         const std::vector<StackFrame>::iterator stackStart,
-        const std::vector<StackFrame>::iterator stackEnd)
-        : tid(tid), timeStamp(ts), stack(stackStart, stackEnd) {}
+        const std::vector<StackFrame>::iterator stackEnd,
+        const HardwareCounters::Values &counters)
+        : tid(tid),
+          timeStamp(ts),
+          stack(stackStart, stackEnd),
+          counters(counters) {}
   };
 
   /// \return true if this SamplingProfiler belongs to the current running
@@ -185,6 +192,10 @@ class SamplingProfiler {
   /// Protected by runtimeDataLock_.
   std::vector<NativeFunction *> nativeFunctions_;
 
+  /// Hardware counters of the runtime thread, opened by the first sample that
+  /// reads them. Protected by runtimeDataLock_.
+  HardwareCounters hardwareCounters_;
+
  protected:
   Runtime &runtime_;
 
@@ -262,8 +273,10 @@ class SamplingProfiler {
   /// Static wrapper for dumpChromeTrace.
   static void dumpChromeTraceGlobal(llvh::raw_ostream &OS);
 
-  /// Enable and start profiling.
-  static bool enable(double meanHzFreq = 100);
+  /// Enable and start profiling. If \p hardwareCounters is true, the CPU
+  /// performance counters of the runtime thread are read with each sample, if
+  /// the platform provides them.
+  static bool enable(double meanHzFreq = 100, bool hardwareCounters = false);
 
   /// Disable and stop profiling.
   static bool disable();
@@ -22,12 +22,163 @@ class HiddenClass;
 /// If the class operation that we are performing
 /// matches the values in the cache entry, \c slot is the index of a
 /// non-accessor property.
+///
+/// The entry is polymorphic: besides the primary \c clazz/\c slot pair, which
+/// is checked first by the interpreter fast path, it holds up to
+/// kNumPolyEntries additional pairs. Once more distinct classes than fit have
+/// been observed, the entry becomes megamorphic and stops being updated, so
+/// that sites with many shapes do not keep thrashing the cache.
+///
+/// Separately, the entry can record a property that was found on the
+/// prototype chain, or that is an accessor: \c protoChain holds the class of
+/// the receiver followed by the classes of its prototypes, up to the object
+/// holding the property. The entry applies only if every object along the
+/// chain still has the recorded class, so any change to the shape of one of
+/// the prototypes, which always produces a new HiddenClass for non-dictionary
+/// objects, invalidates it.
 struct PropertyCacheEntry {
+  /// Number of additional class/slot pairs, beyond the primary one.
+  static constexpr unsigned kNumPolyEntries = 3;
+
+  /// Total number of classes an entry can hold before becoming megamorphic.
+  static constexpr unsigned kMaxClasses = kNumPolyEntries + 1;
+
+  /// Maximum number of prototypes that can be traversed by a prototype chain
+  /// entry.
+  static constexpr unsigned kMaxProtoDepth = 3;
+
+  /// Value of \c protoDepth when there is no prototype chain entry.
+  static constexpr uint8_t kNoProtoEntry = 0xff;
+
   /// Cached class.
   WeakRoot<HiddenClass> clazz{nullptr};
 
   /// Cached property index.
   SlotIndex slot{0};
+
+  /// Set when more than kMaxClasses distinct classes were seen at this site.
+  /// A megamorphic entry still services hits for the classes it holds, but
+  /// is never updated again.
+  bool megamorphic{false};
+
+  /// Additional cached classes. Empty (null) slots may be interleaved with
+  /// valid ones, since classes can be collected independently.
+  WeakRoot<HiddenClass> polyClazz[kNumPolyEntries]{
+      WeakRoot<HiddenClass>{nullptr},
+      WeakRoot<HiddenClass>{nullptr},
+      WeakRoot<HiddenClass>{nullptr}};
+
+  /// Property indices corresponding to \c polyClazz.
+  SlotIndex polySlot[kNumPolyEntries]{};
+
+  /// Classes of the receiver and its prototypes, as described above. Only
+  /// the first protoDepth + 1 elements are used.
+  WeakRoot<HiddenClass> protoChain[kMaxProtoDepth + 1]{
+      WeakRoot<HiddenClass>{nullptr},
+      WeakRoot<HiddenClass>{nullptr},
+      WeakRoot<HiddenClass>{nullptr},
+      WeakRoot<HiddenClass>{nullptr}};
+
+  /// Slot of the property in the object at \c protoDepth.
+  SlotIndex protoSlot{0};
+
+  /// Number of prototypes between the receiver and the object holding the
+  /// property, or kNoProtoEntry. A depth of 0 is used for own accessors.
+  uint8_t protoDepth{kNoProtoEntry};
+
+  /// Whether the cached property is an accessor, whose getter must be called.
+  bool protoAccessor{false};
+
+  /// Look up \p clazzPtr in the additional entries. The primary entry is
+  /// expected to have been checked by the caller already.
+  /// \return a pointer to the cached slot, or nullptr if not cached.
+  const SlotIndex *findPoly(CompressedPointer clazzPtr) const {
+    for (unsigned i = 0; i < kNumPolyEntries; ++i) {
+      if (polyClazz[i] == clazzPtr)
+        return &polySlot[i];
+    }
+    return nullptr;
+  }
+
+  /// Look up \p clazzPtr in all the entries, starting with the primary one.
+  /// \return a pointer to the cached slot, or nullptr if not cached.
+  const SlotIndex *find(CompressedPointer clazzPtr) const {
+    return clazz == clazzPtr ? &slot : findPoly(clazzPtr);
+  }
+
+  /// \return true if \p clazzPtr is cached in any of the entries.
+  bool contains(CompressedPointer clazzPtr) const {
+    return find(clazzPtr);
+  }
+
+  /// \return true if at least one additional entry is in use.
+  bool isPolymorphic() const {
+    for (unsigned i = 0; i < kNumPolyEntries; ++i) {
+      if (polyClazz[i])
+        return true;
+    }
+    return false;
+  }
+
+  /// Record that objects of class \p clazzPtr have the property at \p
+  /// slotIndex. The most recently added class always becomes the primary
+  /// entry, and the previous primary moves to a free additional entry. If no
+  /// free entry is left, the cache becomes megamorphic and is left unchanged.
+  void update(CompressedPointer clazzPtr, SlotIndex slotIndex) {
+    if (clazz == clazzPtr) {
+      slot = slotIndex;
+      return;
+    }
+    for (unsigned i = 0; i < kNumPolyEntries; ++i) {
+      if (polyClazz[i] == clazzPtr) {
+        polySlot[i] = slotIndex;
+        return;
+      }
+    }
+    if (LLVM_UNLIKELY(megamorphic))
+      return;
+    if (clazz) {
+      unsigned i = 0;
+      while (i < kNumPolyEntries && polyClazz[i])
+        ++i;
+      if (i == kNumPolyEntries) {
+        megamorphic = true;
+        return;
+      }
+      polyClazz[i] = clazz.getNoBarrierUnsafe();
+      polySlot[i] = slot;
+    }
+    clazz = clazzPtr;
+    slot = slotIndex;
+  }
+
+  /// \return true if there is a prototype chain entry whose receiver class
+  /// is \p clazzPtr.
+  bool hasProtoEntry(CompressedPointer clazzPtr) const {
+    return protoDepth != kNoProtoEntry && protoChain[0] == clazzPtr;
+  }
+
+  /// Drop the prototype chain entry.
+  void clearProtoEntry() {
+    protoDepth = kNoProtoEntry;
+    for (auto &pc : protoChain)
+      pc = CompressedPointer(nullptr);
+  }
+
+  /// Invoke \p fn on every class root in this entry, used for marking.
+  template <typename Fn>
+  void forEachClass(Fn fn) {
+    if (clazz)
+      fn(clazz);
+    for (auto &pc : polyClazz) {
+      if (pc)
+        fn(pc);
+    }
+    for (auto &pc : protoChain) {
+      if (pc)
+        fn(pc);
+    }
+  }
 };
 
 } // namespace vm
@@ -15,6 +15,7 @@
 #include "hermes/Support/StackOverflowGuard.h"
 #include "hermes/VM/AllocOptions.h"
 #include "hermes/VM/AllocResult.h"
+#include "hermes/VM/AllocationSites.h"
 #include "hermes/VM/BasicBlockExecutionInfo.h"
 #include "hermes/VM/CallResult.h"
 #include "hermes/VM/Casting.h"
@@ -27,9 +28,10 @@
 #include "hermes/VM/IdentifierTable.h"
 #include "hermes/VM/InternalProperty.h"
 #include "hermes/VM/InterpreterState.h"
+#include "hermes/VM/NumberStringCache.h"
 #include "hermes/VM/PointerBase.h"
 #include "hermes/VM/Predefined.h"
-#include "hermes/VM/Profiler.h"
+#include "hermes/VM/Profiler/InterpreterProfiler.h"
 #include "hermes/VM/Profiler/SamplingProfilerDefs.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/PropertyDescriptor.h"
@@ -430,6 +432,16 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
     return identifierTable_;
   }
 
+  NumberStringCache &getNumberStringCache() {
+    return numberStringCache_;
+  }
+
+  /// \return the lifetime feedback of the allocation sites, or nullptr if
+  /// pretenuring is disabled.
+  AllocationSites *getAllocationSites() {
+    return allocationSites_.get();
+  }
+
   SymbolRegistry &getSymbolRegistry() {
     return symbolRegistry_;
   }
@@ -795,44 +807,6 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
 
   const SynthTraceMode traceMode;
 
-#ifdef HERMESVM_PROFILER_OPCODE
-  /// Track the frequency of each opcode in the interpreter.
-  uint32_t opcodeExecuteFrequency[256] = {0};
-
-  /// Track time spent of each opcode in the interpreter, in CPU cycles.
-  uint64_t timeSpent[256] = {0};
-
-  /// Dump opcode stats to a stream.
-  void dumpOpcodeStats(llvh::raw_ostream &os) const;
-#endif
-
-#if defined(HERMESVM_PROFILER_JSFUNCTION)
-  static std::atomic<ProfilerID> nextProfilerId;
-
-  std::vector<ProfilerFunctionInfo> functionInfo{};
-
-  /// Get block's index in functionInfo (creating a new entry if needed).
-  ProfilerID getProfilerID(CodeBlock *block);
-
-  /// Get profiler info associated with given id or nullptr if the id
-  /// is not associated with any function.
-  const ProfilerFunctionInfo *getProfilerInfo(ProfilerID id);
-
-  /// Track the maximum size of the stack.
-  uint32_t maxStackLevel = 0;
-#endif
-
-#if defined(HERMESVM_PROFILER_JSFUNCTION)
-  std::vector<ProfilerFunctionEvent> functionEvents{};
-
-  /// Total number of opcodes executed by this runtime.
-  uint64_t opcodeCount = 0;
-
-  /// Dump function profiling stats to stdout.
-  enum class ProfileType{TIME, OPCODES, ALL};
-  void dumpJSFunctionStats(ProfileType type = ProfileType::ALL);
-#endif
-
 #ifdef HERMESVM_PROFILER_BB
   BasicBlockExecutionInfo &getBasicBlockExecutionInfo();
 
@@ -844,6 +818,10 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
     return *codeCoverageProfiler_;
   }
 
+  InterpreterProfiler &getInterpreterProfiler() {
+    return interpreterProfiler_;
+  }
+
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
   /// Sampling profiler data for this runtime. The ctor/dtor of SamplingProfiler
   /// will automatically register/unregister this runtime from profiling.
@@ -853,11 +831,6 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Time limit monitor data for this runtime.
   std::shared_ptr<TimeLimitMonitor> timeLimitMonitor;
 
-#ifdef HERMESVM_PROFILER_NATIVECALL
-  /// Dump statistics about native calls.
-  void dumpNativeCallStats(llvh::raw_ostream &OS);
-#endif
-
 #ifdef HERMES_ENABLE_DEBUGGER
   Debugger &getDebugger() {
     return debugger_;
@@ -974,13 +947,17 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// collected.
   void preventHCGC(HiddenClass *hc);
 
-  /// Inserts Hidden Classes into InlineCacheProfiler
+  /// Inserts Hidden Classes into InlineCacheProfiler.
+  /// \param polymorphic whether the cache entry holds more than one class.
+  /// \param megamorphic whether the cache entry has stopped being updated.
   void recordHiddenClass(
       CodeBlock *codeBlock,
       const Inst *cacheMissInst,
       SymbolID symbolID,
       HiddenClass *objectHiddenClass,
-      HiddenClass *cachedHiddenClass);
+      HiddenClass *cachedHiddenClass,
+      bool polymorphic = false,
+      bool megamorphic = false);
 
   /// Resolve HiddenClass pointers from its hidden class Id.
   HiddenClass *resolveHiddenClassId(ClassId classId);
@@ -1106,12 +1083,6 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// object. Private native builtins are added by \c createHermesBuiltins().
   void initNativeBuiltins();
 
-  /// Populate JS builtins into the builtins table, after verifying they do
-  /// exist from the result of running internal bytecode.
-  void initJSBuiltins(
-      llvh::MutableArrayRef<Callable *> builtins,
-      Handle<JSObject> jsBuiltins);
-
   /// Walk all the builtin methods, assert that they are not overridden. If they
   /// are, throw an exception. This will be called at most once, before freezing
   /// the builtins.
@@ -1276,6 +1247,13 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Cache for property lookups in non-JS code.
   PropertyCacheEntry fixedPropCache_[(size_t)PropCacheID::_COUNT];
 
+  /// Cache of recent conversions between numbers and strings.
+  NumberStringCache numberStringCache_;
+
+  /// Lifetime feedback of the allocation sites, only present if pretenuring
+  /// is enabled.
+  const std::unique_ptr<AllocationSites> allocationSites_;
+
   /// StringPrimitive representation of the first 256 characters.
   /// These are allocated as "long-lived" objects, so they don't need
   /// to be scanned as roots in young-gen collections.
@@ -1330,6 +1308,9 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// Pointer to the code coverage profiler.
   const std::unique_ptr<CodeCoverageProfiler> codeCoverageProfiler_;
 
+  /// Opcode, JS function and native call profiler.
+  InterpreterProfiler interpreterProfiler_{};
+
   /// Bit flags for async break request reasons.
   enum class AsyncBreakReasonBits : uint8_t {
     DebuggerExplicit = 0x1,
@@ -1515,14 +1496,14 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   /// * At the entry point of a CodeBlock if this is the first entry into the
   ///   interpter loop.
   inline void pushCallStack(const CodeBlock *codeBlock, const inst::Inst *ip) {
-    if (stackTracesTree_) {
+    if (LLVM_UNLIKELY(trackingCallStack_)) {
       pushCallStackImpl(codeBlock, ip);
     }
   }
 
   /// Must pair up with every call to \c pushCallStack .
   inline void popCallStack() {
-    if (stackTracesTree_) {
+    if (LLVM_UNLIKELY(trackingCallStack_)) {
       popCallStackImpl();
     }
   }
@@ -1558,6 +1539,13 @@ class HERMES_EMPTY_BASES Runtime : public PointerBase,
   void popCallStackImpl();
   void pushCallStackImpl(const CodeBlock *codeBlock, const inst::Inst *ip);
   std::unique_ptr<StackTracesTree> stackTracesTree_;
+
+  /// Whether stackTracesTree_ follows every call and return, which is needed
+  /// by the allocation location tracker since it takes the stack of every
+  /// allocation. The heap sampling profiler only takes a stack once in a
+  /// while, so it walks the stack when it does instead, which keeps calls at
+  /// full speed.
+  bool trackingCallStack_{false};
 #endif
 };
 
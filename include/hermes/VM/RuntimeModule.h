@@ -86,6 +86,18 @@ class RuntimeModule final : public llvh::ilist_node<RuntimeModule> {
   /// SymbolID.
   std::vector<RootSymbolID> stringIDMap_;
 
+  /// A run of consecutive identifiers in the string table, and the index of
+  /// the precomputed hash of the first one.
+  struct IdentifierRun {
+    StringID firstID;
+    uint32_t count;
+    uint32_t firstHash;
+  };
+
+  /// The identifier runs of the string table, sorted by string ID. Only
+  /// populated when the identifiers are imported on first use.
+  std::vector<IdentifierRun> identifierRuns_{};
+
   /// Weak pointer to a GC-managed Domain that owns this RuntimeModule.
   /// We use WeakRoot<Domain> here to express that the RuntimeModule does not
   /// own the Domain.
@@ -231,14 +243,16 @@ class RuntimeModule final : public llvh::ilist_node<RuntimeModule> {
   void prepareForDestruction();
 
   /// For opcodes that use a stringID as identifier explicitly, we know that
-  /// the compiler would have marked the stringID as identifier, and hence
-  /// we should have created the symbol during identifier table initialization.
-  /// The symbol must already exist in the map. This is a fast path.
-  SymbolID getSymbolIDMustExist(StringID stringID) {
-    assert(
-        stringIDMap_[stringID].isValid() &&
-        "Symbol must exist for this string ID");
-    return stringIDMap_[stringID];
+  /// the compiler would have marked the stringID as identifier. The symbol is
+  /// either created when the module is initialized, or registered as a lazy
+  /// identifier the first time it is used, which does not allocate in the GC
+  /// heap. This is a fast path.
+  SymbolID getIdentifierSymbolID(StringID stringID) {
+    SymbolID id = stringIDMap_[stringID];
+    if (LLVM_UNLIKELY(!id.isValid()))
+      id = importIdentifier(stringID);
+    assert(id.isValid() && "Symbol must exist for this string ID");
+    return id;
   }
 
   /// \return the \c SymbolID for a string by string index. The symbol may not
@@ -249,7 +263,8 @@ class RuntimeModule final : public llvh::ilist_node<RuntimeModule> {
     if (LLVM_UNLIKELY(!id.isValid())) {
       // Materialize this lazily created symbol.
       auto entry = bcProvider_->getStringTableEntry(stringID);
-      id = createSymbolFromStringIDMayAllocate(stringID, entry, llvh::None);
+      id = createSymbolFromStringIDMayAllocate(
+          stringID, entry, getIdentifierHash(stringID));
     }
     assert(id.isValid() && "Failed to create symbol for stringID");
     return id;
@@ -419,9 +434,19 @@ class RuntimeModule final : public llvh::ilist_node<RuntimeModule> {
   }
 
  private:
-  /// Import the string table from the supplied module.
+  /// Import the string table from the supplied module. The identifiers of
+  /// persistent modules are registered the first time they are used, the
+  /// others are created here.
   void importStringIDMapMayAllocate();
 
+  /// \return the hash of the identifier \p stringID precomputed by the
+  /// compiler, if the identifiers are imported on first use.
+  OptValue<uint32_t> getIdentifierHash(StringID stringID) const;
+
+  /// Register the identifier \p stringID of a persistent module, the first
+  /// time it is used. \return its symbol ID.
+  LLVM_ATTRIBUTE_NOINLINE SymbolID importIdentifier(StringID stringID);
+
   /// Initialize functionMap_, without actually creating the code blocks.
   /// They will be created lazily when needed.
   void initializeFunctionMap();
@@ -39,6 +39,10 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   friend class StringView;
   template <typename T>
   friend class BufferedStringPrimitive;
+  template <typename T>
+  friend class ConcatStringPrimitive;
+  template <typename T>
+  friend class SlicedStringPrimitive;
 
   friend llvh::raw_ostream &operator<<(
       llvh::raw_ostream &OS,
@@ -139,6 +143,16 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   static constexpr uint32_t CONCAT_STRING_MIN_SIZE =
       std::max(256u, EXTERNAL_STRING_MIN_SIZE);
 
+  /// Concatenation producing a ConcatStringPrimitive deeper than this copies
+  /// both sides into a BufferedStringPrimitive instead. This bounds the number
+  /// of cells a single string can keep alive and the work needed to flatten
+  /// it.
+  static constexpr uint32_t MAX_ROPE_DEPTH = 128;
+
+  /// Slices at least this long are represented by a SlicedStringPrimitive
+  /// referring to the characters of the sliced string, instead of a copy.
+  static constexpr uint32_t SLICED_STRING_MIN_SIZE = 64;
+
   static bool classof(const GCCell *cell) {
     return kindInRange(
         cell->getKind(),
@@ -268,17 +282,18 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   static Handle<StringPrimitive> ensureFlat(
       Runtime &runtime,
       Handle<StringPrimitive> self) {
-    // In the future, ensureFlat may trigger GC as it might allocate for
-    // ropes. Move the heap here.
+    // Flattening a rope does not currently allocate in the JS heap, but
+    // callers must not rely on that. Move the heap here.
     runtime.potentiallyMoveHeap();
+    if (LLVM_UNLIKELY(!self->isFlat())) {
+      flattenRope(runtime, self);
+    }
     return self;
-    // TODO: Deal with different subclasses (e.g. rope)
   }
 
-  /// \return true if the string is flat.
-  bool isFlat() const {
-    return true;
-  }
+  /// \return true if the string is flat, i.e. it is not a rope that
+  /// ensureFlat() still has to flatten.
+  inline bool isFlat() const;
 
   /// \return a StringView of this string. In the case of a rope, we will need
   /// to resolve the rope, which might involve object allocations.
@@ -309,6 +324,16 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   }
 
  private:
+  /// Flatten the rope \p self, which must not be flat yet, and release the
+  /// strings it was made of.
+  static void flattenRope(Runtime &runtime, Handle<StringPrimitive> self);
+
+  /// Call \p visit with each flat string \p str is made of, from left to
+  /// right. That is \p str itself, unless it is a rope whose characters have
+  /// not been copied into contiguous memory yet.
+  template <typename F>
+  static void forEachFlatPart(const StringPrimitive *str, F visit);
+
   /// Similar to appendUTF16String(SmallVectorImpl), copy the string into
   /// a raw pointer \p ptr. Since there is no size check, this function should
   /// only be called in rare cases carefully.
@@ -785,17 +810,242 @@ inline bool isBufferedStringPrimitive(const GCCell *cell) {
 /// buffered concatenation, or when the left string is already a
 /// BufferedStringPrimitive. Internally it does the right thing by either
 /// appending to an existing concatenation buffer, if it can, or by allocating a
-/// new one.
-/// Some cases where it needs to allocate a new buffer include:
-/// - the left string is not a BufferedStringPrimitive
-/// - appending UTF16 to ASCII
-/// - appending to the middle of the concatenation chain.
+/// new one when appending UTF16 to the end of an ASCII concatenation chain, or
+/// when appending a shorter string to a flat string. In other cases, such as
+/// when prepending to a long string or appending to the middle of a
+/// concatenation chain, it allocates a ConcatStringPrimitive referring to both
+/// strings, or copies them into a new concatenation buffer if the rope would
+/// exceed MAX_ROPE_DEPTH.
 /// \pre The combined length must have been validated by the caller.
 PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
     Runtime &runtime,
     Handle<StringPrimitive> leftHnd,
     Handle<StringPrimitive> rightHnd);
 
+/// An immutable JavaScript primitive representing the concatenation of two
+/// other StringPrimitives without copying them (a "rope"). It is the result of
+/// a concatenation that cannot append to a concatenation buffer, such as
+/// prepending to a long string or appending to a string in the middle of a
+/// concatenation chain.
+///
+/// A rope is flattened the first time its characters are needed in contiguous
+/// memory. They are copied into a buffer outside the JS heap owned by the
+/// rope, so flattening never allocates in the JS heap and can happen wherever
+/// a pointer to the characters is requested. A rope flattened through
+/// StringPrimitive::ensureFlat() also releases the two strings it was made of.
+///
+/// Concatenation that would create a rope deeper than MAX_ROPE_DEPTH copies
+/// into a new BufferedStringPrimitive instead.
+template <typename T>
+class ConcatStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  template <typename U>
+  friend class BufferedStringPrimitive;
+  friend PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
+      Runtime &runtime,
+      Handle<StringPrimitive> leftHnd,
+      Handle<StringPrimitive> rightHnd);
+  friend void ConcatASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void ConcatUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::ConcatUTF16StringPrimitiveKind
+        : CellKind::ConcatASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == ConcatStringPrimitive::getCellKind();
+  }
+
+#ifdef UNIT_TEST
+  /// Expose the depth of the rope for unit tests.
+  uint32_t testGetDepth() const {
+    return getDepth();
+  }
+#endif
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct a rope of depth \p depth representing the concatenation of
+  /// \p left and \p right.
+  ConcatStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> left,
+      Handle<StringPrimitive> right,
+      uint32_t depth)
+      : StringPrimitive(left->getStringLength() + right->getStringLength()),
+        left_(left.getHermesValue(), runtime.getHeap()),
+        right_(right.getHermesValue(), runtime.getHeap()),
+        depth_(depth) {}
+
+ private:
+  /// Allocate a rope representing the concatenation of \p left and \p right.
+  /// \pre The types must be compatible (cannot concatenate UTF16 into an ASCII
+  /// rope) and the combined length must have been validated.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> left,
+      Handle<StringPrimitive> right,
+      uint32_t depth);
+
+  /// \return whether the rope has been flattened through flatten().
+  bool isReleased() const {
+    return released_;
+  }
+
+  /// \return the depth of the rope: 0 once it has been flattened, otherwise
+  /// one more than the depth of the deeper of the two strings it is made of.
+  uint32_t getDepth() const {
+    return flat_ ? 0 : depth_;
+  }
+
+  /// \return a const pointer to the first character of the string, flattening
+  /// the rope if necessary.
+  const T *getRawPointer() const {
+    if (LLVM_UNLIKELY(!flat_)) {
+      flattenContents();
+    }
+    return flat_;
+  }
+
+  /// Copy the characters of the rope into a new buffer owned by the rope.
+  void flattenContents() const;
+
+  /// Flatten the rope if necessary, account for the flattened buffer as
+  /// external memory, and release the two strings the rope was made of.
+  void flatten(Runtime &runtime);
+
+  /// \return the size of the flattened buffer, which may not exist yet.
+  size_t calcExternalMemorySize() const {
+    return flat_ ? getStringLength() * sizeof(T) : 0;
+  }
+
+  /// Finalizer to free the flattened buffer.
+  static void _finalizeImpl(GCCell *cell, GC &gc);
+
+  /// \return the size of the flattened buffer of \p cell, which is assumed to
+  /// be a ConcatStringPrimitive.
+  static size_t _mallocSizeImpl(GCCell *cell);
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+#endif
+
+  /// The two strings this rope is made of. They are cleared when the rope is
+  /// flattened through flatten().
+  GCHermesValue left_;
+  GCHermesValue right_;
+
+  /// The flattened characters, allocated with malloc, or null if the rope has
+  /// not been flattened yet.
+  mutable T *flat_{nullptr};
+
+  /// Depth of the rope when it was created.
+  uint32_t depth_;
+
+  /// Whether flatten() has run: the flattened buffer has been credited to the
+  /// GC as external memory and the two halves have been released. A rope
+  /// flattened by getRawPointer() alone keeps its halves.
+  bool released_{false};
+};
+
+/// \return true if this is one of the ConcatStringPrimitive classes.
+inline bool isConcatStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::ConcatUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::ConcatASCIIStringPrimitiveKind;
+}
+
+/// An immutable JavaScript primitive referring to a range of the characters of
+/// another StringPrimitive, the result of slicing at least
+/// SLICED_STRING_MIN_SIZE characters out of it. Note that it keeps the whole
+/// sliced string alive.
+template <typename T>
+class SlicedStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend void SlicedASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void SlicedUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::SlicedUTF16StringPrimitiveKind
+        : CellKind::SlicedASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == SlicedStringPrimitive::getCellKind();
+  }
+
+#ifdef UNIT_TEST
+  /// Expose the sliced string for unit tests.
+  StringPrimitive *testGetParent() const {
+    return vmcast<StringPrimitive>(parentHV_);
+  }
+#endif
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct a string of length \p length referring to the characters of
+  /// \p parent starting at \p offset.
+  SlicedStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> parent,
+      uint32_t offset,
+      uint32_t length)
+      : StringPrimitive(length),
+        parentHV_(parent.getHermesValue(), runtime.getHeap()),
+        offset_(offset) {
+    assert(
+        offset + length <= parent->getStringLength() &&
+        "slice exceeds the sliced string");
+  }
+
+ private:
+  /// Allocate a string of length \p length referring to the characters of
+  /// \p parent starting at \p offset. If \p parent is itself a
+  /// SlicedStringPrimitive, refer to the string it slices instead.
+  /// \pre \p parent is flat and its characters are of type T.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> parent,
+      uint32_t offset,
+      uint32_t length);
+
+  /// \return a const pointer to the first character of the string.
+  const T *getRawPointer() const {
+    return vmcast<StringPrimitive>(parentHV_)->template castToPointer<T>() +
+        offset_;
+  }
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+#endif
+
+  /// The string whose characters this one refers to.
+  GCHermesValue parentHV_;
+
+  /// Index of the first character of this string in the sliced string.
+  uint32_t offset_;
+};
+
 template <typename T, bool Uniqued>
 const VTable DynamicStringPrimitive<T, Uniqued>::vt = VTable(
     DynamicStringPrimitive<T, Uniqued>::getCellKind(),
@@ -865,6 +1115,48 @@ const VTable BufferedStringPrimitive<T>::vt = VTable(
 using BufferedUTF16StringPrimitive = BufferedStringPrimitive<char16_t>;
 using BufferedASCIIStringPrimitive = BufferedStringPrimitive<char>;
 
+template <typename T>
+const VTable ConcatStringPrimitive<T>::vt = VTable(
+    ConcatStringPrimitive<T>::getCellKind(),
+    0,
+    ConcatStringPrimitive<T>::_finalizeImpl,
+    ConcatStringPrimitive<T>::_mallocSizeImpl,
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata{
+        HeapSnapshot::NodeType::String,
+        ConcatStringPrimitive<T>::_snapshotNameImpl,
+        ConcatStringPrimitive<T>::_snapshotAddEdgesImpl,
+        ConcatStringPrimitive<T>::_snapshotAddNodesImpl,
+        nullptr}
+#endif
+);
+
+using ConcatUTF16StringPrimitive = ConcatStringPrimitive<char16_t>;
+using ConcatASCIIStringPrimitive = ConcatStringPrimitive<char>;
+
+template <typename T>
+const VTable SlicedStringPrimitive<T>::vt = VTable(
+    SlicedStringPrimitive<T>::getCellKind(),
+    0,
+    nullptr, // finalize.
+    nullptr, // mallocSize
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata{
+        HeapSnapshot::NodeType::String,
+        SlicedStringPrimitive<T>::_snapshotNameImpl,
+        SlicedStringPrimitive<T>::_snapshotAddEdgesImpl,
+        SlicedStringPrimitive<T>::_snapshotAddNodesImpl,
+        nullptr}
+#endif
+);
+
+using SlicedUTF16StringPrimitive = SlicedStringPrimitive<char16_t>;
+using SlicedASCIIStringPrimitive = SlicedStringPrimitive<char>;
+
 //===----------------------------------------------------------------------===//
 // StringPrimitive inline methods.
 
@@ -1017,8 +1309,12 @@ inline const char *StringPrimitive::castToASCIIPointer() const {
     return vmcast<DynamicUniquedASCIIStringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicASCIIStringPrimitive>(this)) {
     return vmcast<DynamicASCIIStringPrimitive>(this)->getRawPointer();
-  } else {
+  } else if (vmisa<BufferedASCIIStringPrimitive>(this)) {
     return vmcast<BufferedASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedASCIIStringPrimitive>(this)) {
+    return vmcast<SlicedASCIIStringPrimitive>(this)->getRawPointer();
+  } else {
+    return vmcast<ConcatASCIIStringPrimitive>(this)->getRawPointer();
   }
 }
 
@@ -1029,8 +1325,12 @@ inline const char16_t *StringPrimitive::castToUTF16Pointer() const {
     return vmcast<DynamicUniquedUTF16StringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicUTF16StringPrimitive>(this)) {
     return vmcast<DynamicUTF16StringPrimitive>(this)->getRawPointer();
-  } else {
+  } else if (vmisa<BufferedUTF16StringPrimitive>(this)) {
     return vmcast<BufferedUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedUTF16StringPrimitive>(this)) {
+    return vmcast<SlicedUTF16StringPrimitive>(this)->getRawPointer();
+  } else {
+    return vmcast<ConcatUTF16StringPrimitive>(this)->getRawPointer();
   }
 }
 
@@ -1084,6 +1384,10 @@ inline bool StringPrimitive::isASCII() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::ConcatUTF16StringPrimitiveKind,
+          CellKind::ConcatASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
@@ -1095,6 +1399,14 @@ inline bool StringPrimitive::isASCII() const {
       (static_cast<uint32_t>(CellKind::DynamicASCIIStringPrimitiveKind) & 1u);
 }
 
+inline bool StringPrimitive::isFlat() const {
+  if (LLVM_LIKELY(!isConcatStringPrimitive(this))) {
+    return true;
+  }
+  return isASCII() ? vmcast<ConcatASCIIStringPrimitive>(this)->isReleased()
+                   : vmcast<ConcatUTF16StringPrimitive>(this)->isReleased();
+}
+
 inline bool StringPrimitive::isExternal() const {
   // We require that external cell kinds be larger than dynamic cell kinds.
   static_assert(
@@ -1103,6 +1415,10 @@ inline bool StringPrimitive::isExternal() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::ConcatUTF16StringPrimitiveKind,
+          CellKind::ConcatASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
@@ -958,9 +958,16 @@ BytecodeSectionWalker::BytecodeSectionWalker(
       bcProvider->getCJSModuleTable().begin(),
       bcProvider->getCJSModuleTable().end());
 
+  // Function bodies and infos may be laid out in any order, so find the
+  // first of each.
   auto firstFuncStart = bcProvider->getBytecode(0);
-  auto firstFuncHeader = bcProvider->getFunctionHeader(0);
-  auto firstFuncInfoStart = bytecodeStart + firstFuncHeader.infoOffset();
+  uint32_t firstFuncInfoOffset = bcProvider->getFunctionHeader(0).infoOffset();
+  for (uint32_t i = 1, e = bcProvider->getFunctionCount(); i < e; ++i) {
+    firstFuncStart = std::min(firstFuncStart, bcProvider->getBytecode(i));
+    firstFuncInfoOffset = std::min(
+        firstFuncInfoOffset, bcProvider->getFunctionHeader(i).infoOffset());
+  }
+  auto firstFuncInfoStart = bytecodeStart + firstFuncInfoOffset;
   auto debugInfoStart = bytecodeStart + fileHeader->debugInfoOffset;
   addSection("Function body", firstFuncStart, firstFuncInfoStart);
   addSection("Function info", firstFuncInfoStart, debugInfoStart);
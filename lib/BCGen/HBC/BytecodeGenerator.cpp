@@ -8,6 +8,7 @@
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
 
 #include "hermes/FrontEndDefs/Builtins.h"
+#include "hermes/Inst/InstDecode.h"
 
 #include "llvh/ADT/SmallString.h"
 #include "llvh/Support/Format.h"
@@ -151,10 +152,14 @@ BytecodeFunctionGenerator::generateBytecodeFunction(
       std::move(opcodes_), std::move(header), std::move(exceptionHandlers_));
 }
 
-unsigned BytecodeFunctionGenerator::getFunctionID(Function *F) {
+unsigned BytecodeFunctionGenerator::addFunction(Function *F) {
   return BMGen_.addFunction(F);
 }
 
+unsigned BytecodeFunctionGenerator::getFunctionID(Function *F) const {
+  return BMGen_.getFunctionID(F);
+}
+
 unsigned BytecodeFunctionGenerator::getScopeDescID(ScopeDesc *S) {
   return BMGen_.addScopeDesc(S);
 }
@@ -194,6 +199,52 @@ void BytecodeFunctionGenerator::updateJumpTableOffset(
       sizeof(uint32_t));
 }
 
+/// \return the superinstruction for the instruction \p first followed by
+/// \p second, or None if they are not fused.
+static OptValue<Operator> fusedOperator(Operator first, Operator second) {
+  switch (first) {
+    case GetByValOp:
+      if (second == AddOp)
+        return GetByValAddOp;
+      break;
+    case AddOp:
+      if (second == IncOp)
+        return AddIncOp;
+      break;
+    case IncOp:
+      if (second == JLessOp)
+        return IncJLessOp;
+      break;
+    case MovOp:
+      if (second == JLessOp)
+        return MovJLessOp;
+      break;
+    default:
+      break;
+  }
+  return llvh::None;
+}
+
+void BytecodeFunctionGenerator::fuseInstructions() {
+  assert(
+      !complete_ &&
+      "Cannot modify BytecodeFunction after call to bytecodeGenerationComplete.");
+  offset_t loc = 0;
+  const offset_t end = opcodes_.size();
+  while (loc < end) {
+    auto first = (Operator)opcodes_[loc];
+    offset_t next = loc + inst::getInstSize((inst::OpCode)first);
+    if (next >= end)
+      break;
+    auto second = (Operator)opcodes_[next];
+    if (auto fused = fusedOperator(first, second)) {
+      opcodes_[loc] = *fused;
+      next += inst::getInstSize((inst::OpCode)second);
+    }
+    loc = next;
+  }
+}
+
 void BytecodeFunctionGenerator::bytecodeGenerationComplete() {
   assert(!complete_ && "Can only call bytecodeGenerationComplete once");
   complete_ = true;
@@ -141,6 +141,7 @@ BCProviderFromSrc::createBCProviderFromSrcImpl(
   optSettings.staticBuiltins = compileFlags.staticBuiltins.hasValue()
       ? compileFlags.staticBuiltins.getValue()
       : false;
+  optSettings.fuseInstructions = !!runOptimizationPasses;
 
   auto context = std::make_shared<Context>(codeGenOpts, optSettings);
   std::unique_ptr<SimpleDiagHandlerRAII> outputManager;
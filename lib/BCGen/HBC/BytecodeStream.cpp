@@ -44,10 +44,12 @@ void BytecodeSerializer::serialize(BytecodeModule &BM, const SHA1 &sourceHash) {
   // Sizes of file and function headers are tuned for good cache line packing.
   // If you reorder the format, try to avoid headers crossing cache lines.
   visitBytecodeSegmentsInOrder(*this);
+  if (isLayout_)
+    computeLayoutOrder(BM);
   serializeFunctionsBytecode(BM);
 
-  for (auto &entry : BM.getFunctionTable()) {
-    serializeFunctionInfo(*entry);
+  for (BytecodeFunction *BF : layoutOrder_) {
+    serializeFunctionInfo(*BF);
   }
 
   serializeDebugInfo(BM);
@@ -75,6 +77,23 @@ void BytecodeSerializer::finishLayout(BytecodeModule &BM) {
   loc_ = 0;
 }
 
+void BytecodeSerializer::computeLayoutOrder(BytecodeModule &BM) {
+  auto &functions = BM.getFunctionTable();
+  layoutOrder_.clear();
+  layoutOrder_.reserve(functions.size());
+  std::vector<bool> added(functions.size());
+  for (uint32_t id : options_.functionLayoutOrder) {
+    if (id < functions.size() && !added[id]) {
+      added[id] = true;
+      layoutOrder_.push_back(functions[id].get());
+    }
+  }
+  for (uint32_t id = 0, e = functions.size(); id != e; ++id) {
+    if (!added[id])
+      layoutOrder_.push_back(functions[id].get());
+  }
+}
+
 // ========================== Function Table ==========================
 void BytecodeSerializer::serializeFunctionTable(BytecodeModule &BM) {
   for (auto &entry : BM.getFunctionTable()) {
@@ -183,7 +202,7 @@ void BytecodeSerializer::serializeFunctionsBytecode(BytecodeModule &BM) {
   // Map from opcodes and jumptables to offsets, used to deduplicate bytecode.
   using DedupKey = llvh::ArrayRef<opcode_atom_t>;
   llvh::DenseMap<DedupKey, uint32_t> bcMap;
-  for (auto &entry : BM.getFunctionTable()) {
+  for (BytecodeFunction *entry : layoutOrder_) {
     if (options_.optimizationEnabled) {
       // If identical bytecode exists, we'll reuse it.
       bool reuse = false;
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/BCGen/HBC/FunctionOrderProfile.h"
+
+#include "llvh/ADT/StringExtras.h"
+
+namespace hermes {
+namespace hbc {
+
+namespace {
+/// The first word of the header line.
+constexpr llvh::StringLiteral kMagic{"hbc-function-order"};
+} // namespace
+
+void FunctionOrderProfile::write(llvh::raw_ostream &OS) const {
+  OS << kMagic << ' ' << hashAsString(sourceHash) << '\n';
+  for (uint32_t id : functionIDs)
+    OS << id << '\n';
+}
+
+llvh::Optional<FunctionOrderProfile> FunctionOrderProfile::parse(
+    llvh::StringRef text,
+    std::string &error) {
+  FunctionOrderProfile profile;
+
+  llvh::StringRef header;
+  std::tie(header, text) = text.split('\n');
+  llvh::StringRef magic, hash;
+  std::tie(magic, hash) = header.trim().split(' ');
+  if (magic != kMagic) {
+    error = "missing function order profile header";
+    return llvh::None;
+  }
+  if (hash.size() != SHA1_NUM_BYTES * 2 ||
+      hash.find_if_not(llvh::isHexDigit) != llvh::StringRef::npos) {
+    error = "invalid source hash";
+    return llvh::None;
+  }
+  std::string bytes = llvh::fromHex(hash);
+  std::copy(bytes.begin(), bytes.end(), profile.sourceHash.begin());
+
+  for (unsigned lineNo = 2; !text.empty(); ++lineNo) {
+    llvh::StringRef line;
+    std::tie(line, text) = text.split('\n');
+    line = line.trim();
+    if (line.empty())
+      continue;
+    uint32_t id;
+    if (line.getAsInteger(10, id)) {
+      error = "invalid function ID on line " + std::to_string(lineNo);
+      return llvh::None;
+    }
+    profile.functionIDs.push_back(id);
+  }
+  return profile;
+}
+
+} // namespace hbc
+} // namespace hermes
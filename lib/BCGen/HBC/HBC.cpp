@@ -29,6 +29,9 @@
 #include "hermes/Support/PerfSection.h"
 #include "hermes/Support/UTF8.h"
 
+#include <atomic>
+#include <thread>
+
 #define DEBUG_TYPE "hbc-backend"
 
 using namespace hermes;
@@ -169,6 +172,11 @@ class UniquedStringVector {
     return set_.end();
   }
 
+  /// \return how many unique strings the vector contains.
+  size_t setSize() const {
+    return set_.size();
+  }
+
   /// \return the index in the uniqued set corresponding to the insertion index
   ///     \p insertionIndex.
   uint32_t indexInSet(size_t insertionIndex) const {
@@ -189,19 +197,19 @@ class UniquedStringVector {
 class LiteralBufferBuilder {
  public:
   /// Constructor.
-  /// \param m the IR module to process.
-  /// \param shouldVisitFunction a predicate indicating whether a function
-  ///     should be processed or not. (In some cases like segment splitting we
-  ///     want to exclude part of the module.)
+  /// \param functions the functions to process, in layout order. (In some
+  ///     cases like segment splitting we want to exclude part of the module.)
+  /// \param numHot how many functions at the start of \p functions have their
+  ///     literals laid out ahead of the others.
   /// \param bmGen the BytecodeModuleGenerator to use.
   /// \param optimize whether to deduplicate the serialized literals.
   LiteralBufferBuilder(
-      Module *m,
-      const std::function<bool(Function const *)> &shouldVisitFunction,
+      llvh::ArrayRef<Function *> functions,
+      size_t numHot,
       BytecodeModuleGenerator &bmGen,
       bool optimize)
-      : M_(m),
-        shouldVisitFunction_(shouldVisitFunction),
+      : functions_(functions),
+        numHot_(numHot),
         bmGen_(bmGen),
         optimize_(optimize),
         literalGenerator_(bmGen) {}
@@ -211,11 +219,17 @@ class LiteralBufferBuilder {
   void generate();
 
  private:
-  /// Traverse the module, skipping functions that should not be visited,
-  /// and collect all serialized array and object literals and the corresponding
-  /// instruction.
+  /// Traverse the functions, and collect all serialized array and object
+  /// literals and the corresponding instruction.
   void traverse();
 
+  /// Construct the storage of the literals in \p literals, optionally
+  /// optimizing it. The first \p numHot literals are stored ahead of the
+  /// others.
+  ConsecutiveStringStorage buildStorage(
+      const UniquedStringVector &literals,
+      size_t numHot);
+
   // Serialization handlers for different instructions.
 
   void serializeLiteralFor(AllocArrayInst *AAI);
@@ -231,11 +245,10 @@ class LiteralBufferBuilder {
       bool isKeyBuffer);
 
  private:
-  /// The IR module to process.
-  Module *const M_;
-  /// A predicate indicating whether a function should be processed or not. (In
-  /// some cases like segment splitting we want to exclude part of the module.)
-  const std::function<bool(const Function *)> &shouldVisitFunction_;
+  /// The functions to process, in layout order.
+  llvh::ArrayRef<Function *> functions_;
+  /// How many functions at the start of functions_ are laid out first.
+  size_t const numHot_;
   /// The BytecodeModuleGenerator to use.
   BytecodeModuleGenerator &bmGen_;
   /// Whether to deduplicate the serialized literals.
@@ -251,6 +264,12 @@ class LiteralBufferBuilder {
   /// Each element is a serialized array literal.
   UniquedStringVector arrays_{};
 
+  /// Number of unique literals in arrays_, objKeys_ and objVals_ collected
+  /// from the hot functions.
+  size_t hotArrays_{0};
+  size_t hotObjKeys_{0};
+  size_t hotObjVals_{0};
+
   /// Each element records the instruction whose literal was serialized at the
   /// corresponding index in \c arrays_.
   std::vector<const Instruction *> arraysInst_{};
@@ -270,12 +289,9 @@ void LiteralBufferBuilder::generate() {
   traverse();
 
   // Construct the serialized storage, optionally optimizing it.
-  ConsecutiveStringStorage arrayStorage{
-      arrays_.beginSet(), arrays_.endSet(), std::true_type{}, optimize_};
-  ConsecutiveStringStorage keyStorage{
-      objKeys_.beginSet(), objKeys_.endSet(), std::true_type{}, optimize_};
-  ConsecutiveStringStorage valStorage{
-      objVals_.beginSet(), objVals_.endSet(), std::true_type{}, optimize_};
+  ConsecutiveStringStorage arrayStorage = buildStorage(arrays_, hotArrays_);
+  ConsecutiveStringStorage keyStorage = buildStorage(objKeys_, hotObjKeys_);
+  ConsecutiveStringStorage valStorage = buildStorage(objVals_, hotObjVals_);
 
   // Populate the offset map.
   BytecodeModuleGenerator::LiteralOffsetMapTy literalOffsetMap{};
@@ -315,20 +331,36 @@ void LiteralBufferBuilder::generate() {
 }
 
 void LiteralBufferBuilder::traverse() {
-  for (auto &F : *M_) {
-    if (!shouldVisitFunction_(&F))
-      continue;
-
-    for (auto &BB : F) {
-      for (auto &I : BB) {
-        if (auto *AAI = dyn_cast<AllocArrayInst>(&I)) {
-          serializeLiteralFor(AAI);
-        } else if (auto *AOFB = dyn_cast<HBCAllocObjectFromBufferInst>(&I)) {
-          serializeLiteralFor(AOFB);
+  auto traverseFunctions = [this](llvh::ArrayRef<Function *> functions) {
+    for (Function *F : functions) {
+      for (auto &BB : *F) {
+        for (auto &I : BB) {
+          if (auto *AAI = dyn_cast<AllocArrayInst>(&I)) {
+            serializeLiteralFor(AAI);
+          } else if (auto *AOFB = dyn_cast<HBCAllocObjectFromBufferInst>(&I)) {
+            serializeLiteralFor(AOFB);
+          }
         }
       }
     }
-  }
+  };
+
+  traverseFunctions(functions_.take_front(numHot_));
+  hotArrays_ = arrays_.setSize();
+  hotObjKeys_ = objKeys_.setSize();
+  hotObjVals_ = objVals_.setSize();
+  traverseFunctions(functions_.drop_front(numHot_));
+}
+
+ConsecutiveStringStorage LiteralBufferBuilder::buildStorage(
+    const UniquedStringVector &literals,
+    size_t numHot) {
+  auto mid = literals.beginSet() + numHot;
+  ConsecutiveStringStorage storage{
+      literals.beginSet(), mid, std::true_type{}, optimize_};
+  storage.appendStorage(ConsecutiveStringStorage{
+      mid, literals.endSet(), std::true_type{}, optimize_});
+  return storage;
 }
 
 void LiteralBufferBuilder::serializeInto(
@@ -372,6 +404,120 @@ void LiteralBufferBuilder::serializeLiteralFor(
       "objKeys_ and objVals_ must be the same size");
   objInst_.push_back(AOFB);
 }
+
+/// Generates the bytecode of a single function in stages. The stages that only
+/// touch the function itself may run concurrently for different functions;
+/// the others add to module-level state and must run in function order.
+class FunctionCodeGenerator {
+ public:
+  FunctionCodeGenerator(
+      Function *F,
+      BytecodeModuleGenerator &BMGen,
+      const BytecodeGenerationOptions &options,
+      FunctionScopeAnalysis &scopeAnalysis,
+      FileAndSourceMapIdCache &debugCache)
+      : F_(F),
+        BMGen_(BMGen),
+        options_(options),
+        scopeAnalysis_(scopeAnalysis),
+        debugCache_(debugCache),
+        RA_(F),
+        SRA_(F, RA_) {
+    if (!options.optimizationEnabled) {
+      RA_.setFastPassThreshold(kFastRegisterAllocationThreshold);
+      RA_.setMemoryLimit(kRegisterAllocationMemoryLimit);
+    }
+  }
+
+  /// Allocate the registers of the function. This only modifies the IR of the
+  /// function, so it may run concurrently for different functions.
+  void allocateRegisters() {
+    PostOrderAnalysis PO(F_);
+    /// The order of the blocks is reverse-post-order, which is a simply
+    /// topological sort.
+    llvh::SmallVector<BasicBlock *, 16> order(PO.rbegin(), PO.rend());
+    RA_.allocate(order);
+
+    if (options_.format == DumpRA) {
+      RA_.dump();
+    }
+  }
+
+  /// Run the lowering passes that depend on the allocated registers, and add
+  /// the module-level table entries that the code refers to.
+  void lowerAndPrepare() {
+    PassManager PM{F_->getContext().getCodeGenerationSettings()};
+    PM.addPass<LowerStoreInstrs>(RA_);
+    PM.addPass<LowerCalls>(RA_);
+    if (options_.optimizationEnabled) {
+      PM.addPass<MovElimination>(RA_);
+      PM.addPass<RecreateCheapValues>(RA_);
+      PM.addPass<LoadConstantValueNumbering>(RA_);
+    }
+    PM.addPass<SpillRegisters>(RA_);
+    if (options_.basicBlockProfiling) {
+      // Insert after all other passes so that it sees final basic block
+      // list.
+      PM.addPass<InsertProfilePoint>();
+    }
+    PM.run(F_);
+
+    if (options_.format == DumpLRA)
+      RA_.dump();
+
+    if (options_.format == DumpPostRA)
+      F_->dump();
+
+    funcGen_ =
+        BytecodeFunctionGenerator::create(BMGen_, RA_.getMaxRegisterUsage());
+    hbciSel_.emplace(
+        F_, funcGen_.get(), RA_, scopeAnalysis_, SRA_, options_, debugCache_);
+    hbciSel_->prepare();
+  }
+
+  /// Generate the bytecode stream of the function. Once lowerAndPrepare() has
+  /// been called for a set of functions, this may run concurrently for all of
+  /// them.
+  void generateCode() {
+    hbciSel_->generateCode();
+  }
+
+  /// Add the debug info of the function.
+  /// \return the finished generator of the function.
+  std::unique_ptr<BytecodeFunctionGenerator> finish(
+      SourceMapGenerator *sourceMapGen) {
+    hbciSel_->finishGeneration(sourceMapGen);
+    return std::move(funcGen_);
+  }
+
+ private:
+  Function *const F_;
+  BytecodeModuleGenerator &BMGen_;
+  const BytecodeGenerationOptions &options_;
+  FunctionScopeAnalysis &scopeAnalysis_;
+  FileAndSourceMapIdCache &debugCache_;
+  HVMRegisterAllocator RA_;
+  ScopeRegisterAnalysis SRA_;
+  std::unique_ptr<BytecodeFunctionGenerator> funcGen_{};
+  llvh::Optional<HBCISel> hbciSel_{};
+};
+
+/// Call \p fn with every index in [0, count), using up to \p jobs threads
+/// including the calling one.
+template <typename Fn>
+void parallelFor(unsigned jobs, size_t count, const Fn &fn) {
+  std::atomic<size_t> next{0};
+  auto work = [&next, count, &fn]() {
+    for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+      fn(i);
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1, e = std::min<size_t>(jobs, count); i < e; ++i)
+    threads.emplace_back(work);
+  work();
+  for (auto &thread : threads)
+    thread.join();
+}
 }; // namespace
 
 std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
@@ -449,6 +595,34 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
     shouldGenerate = [](const Function *) { return true; };
   }
 
+  // The functions to generate, in module order, which is also the order of
+  // their IDs.
+  std::vector<Function *> functions{};
+  for (auto &F : *M) {
+    if (shouldGenerate(&F))
+      functions.push_back(&F);
+  }
+
+  // The functions in layout order: the ones listed in the options first, then
+  // the rest in module order.
+  std::vector<Function *> layoutOrder{};
+  size_t numHot = 0;
+  {
+    layoutOrder.reserve(functions.size());
+    std::vector<bool> added(functions.size());
+    for (uint32_t id : options.functionLayoutOrder) {
+      if (id < functions.size() && !added[id]) {
+        added[id] = true;
+        layoutOrder.push_back(functions[id]);
+      }
+    }
+    numHot = layoutOrder.size();
+    for (size_t id = 0, e = functions.size(); id != e; ++id) {
+      if (!added[id])
+        layoutOrder.push_back(functions[id]);
+    }
+  }
+
   /// Mapping of the source text UTF-8 to the modified UTF-16-like
   /// representation used by string literal encoding.
   /// See appendUnicodeToStorage.
@@ -528,14 +702,24 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
       traverseCJSModuleNames(M, shouldGenerate, addString);
     }
 
+    // Store the strings used by the hot functions first, in the order they
+    // are first used.
+    std::vector<llvh::StringRef> hotStrings{};
+    for (size_t i = 0; i < numHot; ++i) {
+      traverseFunctionLiteralStrings(
+          layoutOrder[i], [&hotStrings](llvh::StringRef str, bool) {
+            hotStrings.push_back(str);
+          });
+    }
+
     BMGen.initializeStringTable(UniquingStringLiteralAccumulator::toTable(
-        std::move(strings), options.optimizationEnabled));
+        std::move(strings), options.optimizationEnabled, hotStrings));
   }
 
   // Generate the serialized literal buffers.
   {
     LiteralBufferBuilder litBuilder{
-        M, shouldGenerate, BMGen, options.optimizationEnabled};
+        layoutOrder, numHot, BMGen, options.optimizationEnabled};
     litBuilder.generate();
   }
 
@@ -585,68 +769,82 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
   // Allow reusing the debug cache between functions
   FileAndSourceMapIdCache debugCache{};
 
-  // Bytecode generation for each function.
-  for (auto &F : *M) {
-    if (!shouldGenerate(&F)) {
-      continue;
-    }
-
-    std::unique_ptr<BytecodeFunctionGenerator> funcGen;
-
-    if (F.isLazy()) {
-      funcGen = BytecodeFunctionGenerator::create(BMGen, 0);
-    } else {
-      HVMRegisterAllocator RA(&F);
-      ScopeRegisterAnalysis SRA(&F, RA);
-      if (!options.optimizationEnabled) {
-        RA.setFastPassThreshold(kFastRegisterAllocationThreshold);
-        RA.setMemoryLimit(kRegisterAllocationMemoryLimit);
-      }
-      PostOrderAnalysis PO(&F);
-      /// The order of the blocks is reverse-post-order, which is a simply
-      /// topological sort.
-      llvh::SmallVector<BasicBlock *, 16> order(PO.rbegin(), PO.rend());
-      RA.allocate(order);
-
-      if (options.format == DumpRA) {
-        RA.dump();
-      }
-
-      PassManager PM{M->getContext().getCodeGenerationSettings()};
-      PM.addPass<LowerStoreInstrs>(RA);
-      PM.addPass<LowerCalls>(RA);
-      if (options.optimizationEnabled) {
-        PM.addPass<MovElimination>(RA);
-        PM.addPass<RecreateCheapValues>(RA);
-        PM.addPass<LoadConstantValueNumbering>(RA);
-      }
-      PM.addPass<SpillRegisters>(RA);
-      if (options.basicBlockProfiling) {
-        // Insert after all other passes so that it sees final basic block
-        // list.
-        PM.addPass<InsertProfilePoint>();
+  /// Add the generated code of \p F to the module, unless it has an encoding
+  /// error.
+  /// \return false if an encoding error was reported.
+  auto setFunctionGenerator =
+      [M, &BMGen](
+          Function *F, std::unique_ptr<BytecodeFunctionGenerator> funcGen) {
+        if (funcGen->hasEncodingError()) {
+          M->getContext().getSourceErrorManager().error(
+              F->getSourceRange().Start, "Error encoding bytecode");
+          return false;
+        }
+        BMGen.setFunctionGenerator(F, std::move(funcGen));
+        return true;
+      };
+
+  // The register allocation dumps are printed while generating each function,
+  // so several jobs generate the functions one at a time.
+  if (options.jobs <= 1 || options.format == DumpRA ||
+      options.format == DumpLRA || options.format == DumpPostRA) {
+    // Bytecode generation for each function.
+    for (Function *F : functions) {
+      std::unique_ptr<BytecodeFunctionGenerator> funcGen;
+
+      if (F->isLazy()) {
+        funcGen = BytecodeFunctionGenerator::create(BMGen, 0);
+      } else {
+        FunctionCodeGenerator codeGen{
+            F, BMGen, options, scopeAnalysis, debugCache};
+        codeGen.allocateRegisters();
+        codeGen.lowerAndPrepare();
+        codeGen.generateCode();
+        funcGen = codeGen.finish(sourceMapGen);
       }
-      PM.run(&F);
 
-      if (options.format == DumpLRA)
-        RA.dump();
-
-      if (options.format == DumpPostRA)
-        F.dump();
+      if (!setFunctionGenerator(F, std::move(funcGen)))
+        return nullptr;
+    }
+    return BMGen.generate();
+  }
 
-      funcGen =
-          BytecodeFunctionGenerator::create(BMGen, RA.getMaxRegisterUsage());
-      HBCISel hbciSel(
-          &F, funcGen.get(), RA, scopeAnalysis, SRA, options, debugCache);
-      hbciSel.generate(sourceMapGen);
+  // Generate the functions in parallel. Register allocation and code
+  // generation only touch the function being generated, and run on the jobs.
+  // The IR lowering, and everything that adds to the module-level tables, runs
+  // in module order on this thread, so the result is identical to generating
+  // the functions one at a time.
+  std::vector<std::unique_ptr<FunctionCodeGenerator>> codeGens(
+      functions.size());
+  for (size_t i = 0, e = functions.size(); i != e; ++i) {
+    if (!functions[i]->isLazy()) {
+      codeGens[i] = std::make_unique<FunctionCodeGenerator>(
+          functions[i], BMGen, options, scopeAnalysis, debugCache);
     }
+  }
 
-    if (funcGen->hasEncodingError()) {
-      M->getContext().getSourceErrorManager().error(
-          F.getSourceRange().Start, "Error encoding bytecode");
+  parallelFor(options.jobs, codeGens.size(), [&codeGens](size_t i) {
+    if (codeGens[i])
+      codeGens[i]->allocateRegisters();
+  });
+  for (auto &codeGen : codeGens) {
+    if (codeGen)
+      codeGen->lowerAndPrepare();
+  }
+  parallelFor(options.jobs, codeGens.size(), [&codeGens](size_t i) {
+    if (codeGens[i])
+      codeGens[i]->generateCode();
+  });
+
+  for (size_t i = 0, e = functions.size(); i != e; ++i) {
+    std::unique_ptr<BytecodeFunctionGenerator> funcGen = codeGens[i]
+        ? codeGens[i]->finish(sourceMapGen)
+        : BytecodeFunctionGenerator::create(BMGen, 0);
+    // Free the register allocation of the function as soon as possible.
+    codeGens[i].reset();
+
+    if (!setFunctionGenerator(functions[i], std::move(funcGen)))
       return nullptr;
-    }
-    BMGen.setFunctionGenerator(&F, std::move(funcGen));
   }
 
   return BMGen.generate();
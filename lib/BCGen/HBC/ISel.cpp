@@ -921,6 +921,7 @@ void HBCISel::generateCreateRegExpInst(
   auto &ctx = F_->getParent()->getContext();
   auto &regexp = ctx.getCompiledRegExp(
       pattern.getUnderlyingPointer(), flags.getUnderlyingPointer());
+  // prepare() has added the regexp, so this only looks it up.
   uint32_t reBytecodeID = BCFGen_->addRegExp(&regexp);
   auto patternStrID = BCFGen_->getStringID(Inst->getPattern());
   auto flagsStrID = BCFGen_->getStringID(Inst->getFlags());
@@ -1364,6 +1365,7 @@ void HBCISel::generateHBCResolveEnvironment(
   // We statically determine the relative depth delta of the current scope
   // and the scope that the variable belongs to. Such delta is used as
   // the operand to get_scope instruction.
+  // The delta has been checked by prepare().
   ScopeDesc *instScope = Inst->getCreatedScopeDesc();
   Optional<int32_t> instScopeDepth = scopeAnalysis_.getScopeDepth(instScope);
   Optional<int32_t> curScopeDepth =
@@ -1378,10 +1380,6 @@ void HBCISel::generateHBCResolveEnvironment(
       "Cannot access variables in inner scopes");
   int32_t delta = curScopeDepth.getValue() - instScopeDepth.getValue();
   assert(delta > 0 && "HBCResolveEnvironment for current scope");
-  if (std::numeric_limits<uint8_t>::max() < delta) {
-    F_->getContext().getSourceErrorManager().error(
-        Inst->getLocation(), "Variable environment is out-of-reach");
-  }
   BCFGen_->emitGetEnvironment(encodeValue(Inst), delta - 1);
 }
 void HBCISel::generateHBCStoreToEnvironmentInst(
@@ -1464,20 +1462,7 @@ void HBCISel::generateHBCLoadConstInst(
       auto parsedBigInt = bigint::ParsedBigInt::parsedBigIntFromNumericValue(
           cast<LiteralBigInt>(literal)->getValue()->str());
       assert(parsedBigInt && "should be valid");
-      if (bigint::tooManyBytes(parsedBigInt->getBytes().size())) {
-        // TODO: move this to the semantic analysis so we can get a proper
-        // warning (i.e., with the correct location for the literal).
-        std::string sizeStr;
-        {
-          llvh::raw_string_ostream OS(sizeStr);
-          OS << parsedBigInt->getBytes().size();
-        }
-        F_->getContext().getSourceErrorManager().warning(
-            Inst->getLocation(),
-            Twine("BigInt literal has too many bytes (") + sizeStr +
-                ") and a RangeError will be raised at runtime time if it "
-                "is referenced.");
-      }
+      // prepare() has added the bigint, so this only looks it up.
       auto idx = BCFGen_->addBigInt(std::move(*parsedBigInt));
       if (idx <= UINT16_MAX) {
         BCFGen_->emitLoadConstBigInt(output, idx);
@@ -1776,32 +1761,92 @@ void HBCISel::generate(Instruction *ii, BasicBlock *next) {
   }
 }
 
-void HBCISel::generate(SourceMapGenerator *outSourceMap) {
+void HBCISel::prepare() {
   PostOrderAnalysis PO(F_);
 
   /// The order of the blocks is reverse-post-order, which is a simply
   /// topological sort.
-  llvh::SmallVector<BasicBlock *, 16> order(PO.rbegin(), PO.rend());
+  order_.assign(PO.rbegin(), PO.rend());
+
+  auto &ctx = F_->getContext();
+  Optional<int32_t> curScopeDepth =
+      scopeAnalysis_.getScopeDepth(F_->getFunctionScopeDesc());
+
+  // Visit the instructions in the order in which they are generated, so that
+  // the tables are identical to the ones built while generating the code.
+  for (BasicBlock *BB : order_) {
+    for (Instruction &I : *BB) {
+      if (auto *CFI = llvh::dyn_cast<CreateFunctionInst>(&I)) {
+        BCFGen_->addFunction(CFI->getFunctionCode());
+      } else if (auto *CDI = llvh::dyn_cast<HBCCallDirectInst>(&I)) {
+        BCFGen_->addFunction(CDI->getFunctionCode());
+      } else if (auto *CRI = llvh::dyn_cast<CreateRegExpInst>(&I)) {
+        BCFGen_->addRegExp(&ctx.getCompiledRegExp(
+            CRI->getPattern()->getValue().getUnderlyingPointer(),
+            CRI->getFlags()->getValue().getUnderlyingPointer()));
+      } else if (auto *RE = llvh::dyn_cast<HBCResolveEnvironment>(&I)) {
+        Optional<int32_t> instScopeDepth =
+            scopeAnalysis_.getScopeDepth(RE->getCreatedScopeDesc());
+        if (instScopeDepth && curScopeDepth &&
+            std::numeric_limits<uint8_t>::max() <
+                *curScopeDepth - *instScopeDepth) {
+          ctx.getSourceErrorManager().error(
+              RE->getLocation(), "Variable environment is out-of-reach");
+        }
+      } else if (auto *LCI = llvh::dyn_cast<HBCLoadConstInst>(&I)) {
+        auto *literal = llvh::dyn_cast<LiteralBigInt>(LCI->getConst());
+        if (!literal)
+          continue;
+        auto parsedBigInt = bigint::ParsedBigInt::parsedBigIntFromNumericValue(
+            literal->getValue()->str());
+        assert(parsedBigInt && "should be valid");
+        if (bigint::tooManyBytes(parsedBigInt->getBytes().size())) {
+          // TODO: move this to the semantic analysis so we can get a proper
+          // warning (i.e., with the correct location for the literal).
+          std::string sizeStr;
+          {
+            llvh::raw_string_ostream OS(sizeStr);
+            OS << parsedBigInt->getBytes().size();
+          }
+          ctx.getSourceErrorManager().warning(
+              LCI->getLocation(),
+              Twine("BigInt literal has too many bytes (") + sizeStr +
+                  ") and a RangeError will be raised at runtime time if it "
+                  "is referenced.");
+        }
+        BCFGen_->addBigInt(std::move(*parsedBigInt));
+      }
+    }
+  }
+}
+
+void HBCISel::generateCode() {
+  assert(!order_.empty() && "prepare() must be called first");
 
   // If we are compiling with debugger or otherwise need async break checks,
   // decide which blocks need runtime async break checks: blocks with backwards
   // jumps, and the first block if this is a function (i.e. not the
-  // global scope).
+  // global scope).
   if (F_->getContext().getDebugInfoSetting() == DebugInfoSetting::ALL ||
       F_->getContext().getEmitAsyncBreakCheck()) {
-    asyncBreakChecks_ = basicBlocksWithBackwardSuccessors(order);
-    asyncBreakChecks_.insert(order.front());
+    asyncBreakChecks_ = basicBlocksWithBackwardSuccessors(order_);
+    asyncBreakChecks_.insert(order_.front());
   }
 
-  for (int i = 0, e = order.size(); i < e; ++i) {
-    BasicBlock *BB = order[i];
-    BasicBlock *next = ((i + 1) == e) ? nullptr : order[i + 1];
+  for (int i = 0, e = order_.size(); i < e; ++i) {
+    BasicBlock *BB = order_[i];
+    BasicBlock *next = ((i + 1) == e) ? nullptr : order_[i + 1];
     LLVM_DEBUG(dbgs() << "Generating bytecode for basic block " << BB << "\n");
     generate(BB, next);
   }
 
   resolveRelocations();
+  if (F_->getContext().getOptimizationSettings().fuseInstructions)
+    BCFGen_->fuseInstructions();
   resolveExceptionHandlers();
+}
+
+void HBCISel::finishGeneration(SourceMapGenerator *outSourceMap) {
   addDebugSourceLocationInfo(outSourceMap);
   addDebugTextifiedCalleeInfo();
   generateJumpTable();
@@ -1809,6 +1854,12 @@ void HBCISel::generate(SourceMapGenerator *outSourceMap) {
   BCFGen_->bytecodeGenerationComplete();
 }
 
+void HBCISel::generate(SourceMapGenerator *outSourceMap) {
+  prepare();
+  generateCode();
+  finishGeneration(outSourceMap);
+}
+
 uint8_t HBCISel::acquirePropertyReadCacheIndex(unsigned id) {
   const bool reuse = F_->getContext().getOptimizationSettings().reusePropCache;
   // Zero is reserved for indicating no-cache, so cannot be a value in the map.
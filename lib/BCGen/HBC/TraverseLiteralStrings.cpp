@@ -104,14 +104,20 @@ void traverseLiteralStrings(
       continue;
     }
 
-    for (auto &BB : F) {
-      // Walk instruction operands.
-      for (auto &I : BB) {
-        for (int i = 0, e = I.getNumOperands(); i < e; i++) {
-          auto *op = I.getOperand(i);
-          if (auto *str = llvh::dyn_cast<LiteralString>(op)) {
-            traversal(str->getValue().str(), isIdOperand(&I, i));
-          }
+    traverseFunctionLiteralStrings(&F, traversal);
+  }
+}
+
+void traverseFunctionLiteralStrings(
+    Function *F,
+    const std::function<void(llvh::StringRef, bool)> &traversal) {
+  for (auto &BB : *F) {
+    // Walk instruction operands.
+    for (auto &I : BB) {
+      for (int i = 0, e = I.getNumOperands(); i < e; i++) {
+        auto *op = I.getOperand(i);
+        if (auto *str = llvh::dyn_cast<LiteralString>(op)) {
+          traversal(str->getValue().str(), isIdOperand(&I, i));
         }
       }
     }
@@ -7,6 +7,9 @@
 
 #include "hermes/BCGen/HBC/UniquingStringLiteralTable.h"
 
+#include "llvh/ADT/DenseMap.h"
+
+#include <algorithm>
 #include <cassert>
 
 namespace hermes {
@@ -67,7 +70,8 @@ std::vector<StringKind::Entry> StringLiteralTable::getStringKinds() const {
 
 /* static */ StringLiteralTable UniquingStringLiteralAccumulator::toTable(
     UniquingStringLiteralAccumulator accum,
-    bool optimize) {
+    bool optimize,
+    llvh::ArrayRef<llvh::StringRef> hotStrings) {
   auto &storage = accum.storage_;
   auto &strings = accum.strings_;
   auto &isIdentifier = accum.isIdentifier_;
@@ -167,7 +171,7 @@ std::vector<StringKind::Entry> StringLiteralTable::getStringKinds() const {
   std::sort(indicesFrom(UINT8_MAX), indicesFrom(UINT16_MAX));
   std::sort(indicesFrom(UINT16_MAX), indicesFrom(SIZE_MAX));
 
-  { // Add the new strings to the storage.
+  if (hotStrings.empty()) { // Add the new strings to the storage.
     std::vector<llvh::StringRef> refs;
     refs.reserve(newStrings);
     for (auto &i : indices) {
@@ -175,6 +179,46 @@ std::vector<StringKind::Entry> StringLiteralTable::getStringKinds() const {
     }
     ConsecutiveStringStorage newStrings(refs, optimize);
     storage.appendStorage(std::move(newStrings));
+  } else {
+    // Store the hot strings first, in their order, and the remaining strings
+    // after them. Each part is packed on its own, so that the hot strings stay
+    // together.
+    llvh::DenseMap<llvh::StringRef, size_t> hotRank;
+    for (llvh::StringRef str : hotStrings)
+      hotRank.try_emplace(str, hotRank.size());
+    const auto rank = [&hotRank, &indices](size_t i) {
+      auto it = hotRank.find(indices[i].str);
+      return it == hotRank.end() ? SIZE_MAX : it->second;
+    };
+
+    // Order in which the indices are stored.
+    std::vector<size_t> storageOrder(newStrings);
+    for (size_t i = 0; i < newStrings; ++i)
+      storageOrder[i] = i;
+    std::stable_sort(
+        storageOrder.begin(), storageOrder.end(), [&rank](size_t a, size_t b) {
+          return rank(a) < rank(b);
+        });
+
+    std::vector<llvh::StringRef> refs;
+    refs.reserve(newStrings);
+    size_t numHot = 0;
+    for (size_t i : storageOrder) {
+      refs.emplace_back(indices[i].str);
+      numHot += rank(i) != SIZE_MAX;
+    }
+    llvh::ArrayRef<llvh::StringRef> allRefs{refs};
+    ConsecutiveStringStorage newStorage(allRefs.take_front(numHot), optimize);
+    newStorage.appendStorage(
+        ConsecutiveStringStorage(allRefs.drop_front(numHot), optimize));
+    storage.appendStorage(std::move(newStorage));
+
+    // Put the entries back in the order of the indices.
+    auto tableView = storage.getStringTableView();
+    std::vector<StringTableEntry> entries(
+        tableView.begin() + existingStrings, tableView.end());
+    for (size_t k = 0; k < newStrings; ++k)
+      tableView[existingStrings + storageOrder[k]] = entries[k];
   }
 
   // Associate the new string table index entries with their string kind.
@@ -13,6 +13,7 @@
 #include "hermes/AST/SemValidate.h"
 #include "hermes/AST2JS/AST2JS.h"
 #include "hermes/BCGen/HBC/BytecodeDisassembler.h"
+#include "hermes/BCGen/HBC/FunctionOrderProfile.h"
 #include "hermes/BCGen/HBC/HBC.h"
 #include "hermes/BCGen/RegAlloc.h"
 #include "hermes/ConsoleHost/ConsoleHost.h"
@@ -43,6 +44,7 @@
 #include "llvh/Support/CommandLine.h"
 #include "llvh/Support/Debug.h"
 #include "llvh/Support/FileSystem.h"
+#include "llvh/Support/Format.h"
 #include "llvh/Support/MemoryBuffer.h"
 #include "llvh/Support/Path.h"
 #include "llvh/Support/Process.h"
@@ -51,6 +53,7 @@
 
 #include "zip/src/zip.h"
 
+#include <chrono>
 #include <sstream>
 
 #define DEBUG_TYPE "hermes"
@@ -476,16 +479,12 @@ static opt<bool> GenerateNamesForAnonymousFunctions(
          "functions"),
     cat(CompilerCategory));
 
-#ifndef NDEBUG
-
 static opt<bool> LexerOnly(
     "Xlexer-only",
-    desc("Only run the lexer on the input (debug builds only)"),
+    desc("Only run the lexer on the input and report its throughput"),
     Hidden,
     cat(CompilerCategory));
 
-#endif
-
 static opt<int> MaxDiagnosticWidth(
     "max-diagnostic-width",
     llvh::cl::desc("Preferred diagnostic maximum width"),
@@ -579,6 +578,13 @@ static opt<bool> ReusePropCache(
 static CLFlag
     Inline('f', "inline", true, "inlining of functions", CompilerCategory);
 
+static CLFlag FuseInstructions(
+    'f',
+    "fuse-instructions",
+    true,
+    "fusion of common instruction pairs into superinstructions",
+    CompilerCategory);
+
 static CLFlag StripFunctionNames(
     'f',
     "strip-function-names",
@@ -605,6 +611,22 @@ static opt<unsigned> PadFunctionBodiesPercent(
     Hidden,
     cat(CompilerCategory));
 
+static opt<std::string> FunctionOrderProfile(
+    "function-order-profile",
+    desc(
+        "Lay out the bytecode of the functions in the order in which they "
+        "were first executed, as recorded by hvm -record-function-order"),
+    init(""),
+    cat(CompilerCategory));
+
+static opt<unsigned> Jobs(
+    "jobs",
+    desc(
+        "Number of threads used to generate the bytecode of the functions. "
+        "The output does not depend on it."),
+    init(1),
+    cat(CompilerCategory));
+
 static opt<bool> InstrumentIR(
     "instrument",
     desc("Instrument code for dynamic analysis"),
@@ -670,6 +692,33 @@ std::unique_ptr<llvh::MemoryBuffer> memoryBufferFromFile(
   return std::move(*fileBuf);
 }
 
+/// Read the function order profile at \p path, which should have been recorded
+/// from bytecode compiled from the source with hash \p sourceHash.
+/// \return the IDs of the profiled functions, empty if the profile is for a
+/// different source, or None on error, in which case an error message will
+/// have been printed to llvh::errs().
+llvh::Optional<std::vector<uint32_t>> readFunctionOrderProfile(
+    llvh::StringRef path,
+    const SHA1 &sourceHash) {
+  auto fileBuf = memoryBufferFromFile(path);
+  if (!fileBuf)
+    return llvh::None;
+  std::string error;
+  auto profile =
+      hbc::FunctionOrderProfile::parse(fileBuf->getBuffer(), error);
+  if (!profile) {
+    llvh::errs() << "Error reading function order profile " << path << ": "
+                 << error << '\n';
+    return llvh::None;
+  }
+  if (profile->sourceHash != sourceHash) {
+    llvh::errs() << "Warning: function order profile " << path
+                 << " was recorded for a different source, ignoring it\n";
+    return std::vector<uint32_t>{};
+  }
+  return std::move(profile->functionIDs);
+}
+
 /// Read a file from \p path relative to the root of the zip file \p zip
 /// into a memory buffer. Print error messages to llvh::errs().
 /// \param zip the zip file to read from (must not be null).
@@ -1140,6 +1189,10 @@ std::shared_ptr<Context> createContext(
 
   optimizationOpts.reusePropCache = cl::ReusePropCache;
 
+  optimizationOpts.fuseInstructions =
+      cl::OptimizationLevel != cl::OptLevel::O0 &&
+      cl::BytecodeFormat == cl::BytecodeFormatKind::HBC && cl::FuseInstructions;
+
   // When the setting is auto-detect, we will set the correct value after
   // parsing.
   optimizationOpts.staticBuiltins =
@@ -1884,11 +1937,13 @@ CompileResult processSourceFiles(
   assert(
       rawFinalHash.size() == SHA1_NUM_BYTES && "Incorrect length of SHA1 hash");
   std::copy(rawFinalHash.begin(), rawFinalHash.end(), sourceHash.begin());
-#ifndef NDEBUG
   if (cl::LexerOnly) {
     unsigned count = 0;
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
     for (auto &entry : fileBufs) {
       for (auto &fileAndMap : entry.second) {
+        bytes += fileAndMap.file->getBufferSize();
         parser::JSLexer jsLexer(
             std::move(fileAndMap.file),
             context->getSourceErrorManager(),
@@ -1897,10 +1952,16 @@ CompileResult processSourceFiles(
           ++count;
       }
     }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
     llvh::outs() << count << " tokens lexed\n";
+    llvh::outs() << bytes << " bytes lexed in "
+                 << llvh::format("%.3f", elapsed.count() * 1000) << " ms ("
+                 << llvh::format(
+                        "%.1f", bytes / 1e6 / std::max(elapsed.count(), 1e-9))
+                 << " MB/s)\n";
     return Success;
   }
-#endif
 
   // A list of parsed global definition files.
   DeclarationFileListTy declFileList;
@@ -2053,6 +2114,7 @@ CompileResult processSourceFiles(
   // options parsing and js parsing. Set the bytecode header flag here.
   genOptions.staticBuiltinsEnabled = context->getStaticBuiltinOptimization();
   genOptions.padFunctionBodiesPercent = cl::PadFunctionBodiesPercent;
+  genOptions.jobs = cl::Jobs;
 
   // If the user requests to output a source map, then do not also emit debug
   // info into the bytecode.
@@ -2061,6 +2123,20 @@ CompileResult processSourceFiles(
 
   genOptions.stripFunctionNames = cl::StripFunctionNames;
 
+  if (!cl::FunctionOrderProfile.empty()) {
+    // The function IDs of a profile only match a single segment.
+    if (context->getSegments().size() > 1) {
+      llvh::errs() << "Warning: function order profiles are not supported "
+                      "with multiple segments, ignoring it\n";
+    } else if (
+        auto functionIDs =
+            readFunctionOrderProfile(cl::FunctionOrderProfile, sourceHash)) {
+      genOptions.functionLayoutOrder = std::move(*functionIDs);
+    } else {
+      return InputFileError;
+    }
+  }
+
   // If the dump target is None, return bytecode in an executable form.
   if (cl::DumpTarget == Execute) {
     assert(
@@ -7,6 +7,7 @@
 
 #include "hermes/ConsoleHost/ConsoleHost.h"
 
+#include "hermes/BCGen/HBC/FunctionOrderProfile.h"
 #include "hermes/CompilerDriver/CompilerDriver.h"
 #include "hermes/Support/MemoryBuffer.h"
 #include "hermes/Support/UTF8.h"
@@ -14,6 +15,7 @@
 #include "hermes/VM/Domain.h"
 #include "hermes/VM/JSObject.h"
 #include "hermes/VM/NativeArgs.h"
+#include "hermes/VM/Profiler/CodeCoverageProfiler.h"
 #include "hermes/VM/Profiler/SamplingProfiler.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/StringPrimitive.h"
@@ -62,14 +64,18 @@ createHeapSnapshot(void *, vm::Runtime &runtime, vm::NativeArgs args) {
     convertUTF16ToUTF8WithReplacements(fileName, jsFileName.getUTF16Ref(buf));
   }
 
+  // A name ending with ".gz" is compressed.
+  llvh::StringRef uncompressedName{fileName};
+  uncompressedName.consume_back(".gz");
   if (fileName.empty()) {
     // "-" is recognized as stdout.
     fileName = "-";
   } else if (
-      !llvh::StringRef{fileName}.endswith(".heapsnapshot") &&
-      !llvh::StringRef{fileName}.endswith(".heaptimeline")) {
+      !uncompressedName.endswith(".heapsnapshot") &&
+      !uncompressedName.endswith(".heaptimeline")) {
     return runtime.raiseTypeError(
-        "Filename must end in .heapsnapshot or .heaptimeline");
+        "Filename must end in .heapsnapshot or .heaptimeline, optionally "
+        "followed by .gz");
   }
   if (auto err = runtime.getHeap().createSnapshotToFile(fileName)) {
     // This isn't a TypeError, but no other built-in can express file errors,
@@ -253,6 +259,34 @@ auto maybeCatchException(const F &f) -> decltype(f()) {
 #endif
 }
 
+/// Write the order in which the functions of \p bytecode were first executed
+/// in \p runtime to the file \p path.
+/// \return false if the file could not be written.
+bool writeFunctionOrderProfile(
+    vm::Runtime &runtime,
+    hbc::BCProvider *bytecode,
+    llvh::StringRef path) {
+  hbc::FunctionOrderProfile profile;
+  profile.sourceHash = bytecode->getSourceHash();
+  for (auto &module : runtime.getRuntimeModules()) {
+    if (module.getBytecode() == bytecode) {
+      profile.functionIDs =
+          runtime.getCodeCoverageProfiler().getFirstExecutionOrder(&module);
+      break;
+    }
+  }
+
+  std::error_code EC;
+  llvh::raw_fd_ostream OS(path, EC, llvh::sys::fs::F_Text);
+  if (EC) {
+    llvh::errs() << "Failed to write function order profile " << path << ": "
+                 << EC.message() << '\n';
+    return false;
+  }
+  profile.write(OS);
+  return true;
+}
+
 bool executeHBCBytecodeImpl(
     std::shared_ptr<hbc::BCProvider> &&bytecode,
     const ExecuteOptions &options,
@@ -286,6 +320,15 @@ bool executeHBCBytecodeImpl(
 #endif
   }
 
+  if (!options.heapSamplingSites.empty()) {
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    runtime->enableSamplingHeapProfiler(options.heapSamplingInterval);
+#else
+    llvh::errs() << "Failed to sample heap allocations; build does not "
+                    "include memory instrumentation\n";
+#endif
+  }
+
   vm::GCScope scope(*runtime);
   ConsoleHostContext ctx{*runtime};
 
@@ -313,10 +356,27 @@ bool executeHBCBytecodeImpl(
 
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
   if (options.sampleProfiling) {
-    vm::SamplingProfiler::enable();
+    vm::SamplingProfiler::enable(100, options.sampleProfilingCounters);
   }
 #endif // HERMESVM_SAMPLING_PROFILER_AVAILABLE
 
+  if (!options.interpreterProfile.empty()) {
+    auto kinds =
+        vm::InterpreterProfiler::parseKinds(options.interpreterProfile);
+    if (!kinds) {
+      llvh::errs() << "Invalid -profile-interpreter value: "
+                   << options.interpreterProfile << "\n";
+      return false;
+    }
+    runtime->getInterpreterProfiler().enable(*kinds);
+  }
+
+  // Record the order in which the functions are first executed.
+  hbc::BCProvider *mainBytecode = bytecode.get();
+  if (!options.functionOrderProfile.empty()) {
+    vm::CodeCoverageProfiler::enableGlobal();
+  }
+
   llvh::StringRef sourceURL{};
   if (filename)
     sourceURL = *filename;
@@ -366,17 +426,38 @@ bool executeHBCBytecodeImpl(
     }
   }
 
-#ifdef HERMESVM_PROFILER_OPCODE
-  runtime->dumpOpcodeStats(llvh::outs());
-#endif
+  if (!options.functionOrderProfile.empty()) {
+    vm::CodeCoverageProfiler::disableGlobal();
+    if (!writeFunctionOrderProfile(
+            *runtime, mainBytecode, options.functionOrderProfile)) {
+      return false;
+    }
+  }
 
-#ifdef HERMESVM_PROFILER_JSFUNCTION
-  runtime->dumpJSFunctionStats();
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  if (!options.heapSamplingSites.empty()) {
+    // Free what is no longer reachable, so that only what is retained is
+    // reported as alive.
+    runtime->collect("heap sampling sites");
+    std::error_code EC;
+    llvh::raw_fd_ostream OS(
+        options.heapSamplingSites, EC, llvh::sys::fs::F_Text);
+    if (EC) {
+      llvh::errs() << "Failed to write heap sampling sites "
+                   << options.heapSamplingSites << ": " << EC.message()
+                   << '\n';
+      return false;
+    }
+    runtime->getHeap().writeSamplingHeapProfileSites(OS);
+    runtime->disableSamplingHeapProfiler(llvh::nulls());
+  }
 #endif
 
-#ifdef HERMESVM_PROFILER_NATIVECALL
-  runtime->dumpNativeCallStats(llvh::outs());
-#endif
+  if (!options.interpreterProfile.empty()) {
+    runtime->getInterpreterProfiler().disable();
+    llvh::outs().flush();
+    runtime->getInterpreterProfiler().dump(llvh::errs());
+  }
 
   if (shouldRecordGCStats) {
     llvh::errs() << "Process stats:\n";
@@ -391,6 +472,7 @@ bool executeHBCBytecodeImpl(
 #ifdef HERMESVM_PROFILER_BB
   if (options.basicBlockProfiling) {
     runtime->getBasicBlockExecutionInfo().dump(llvh::errs());
+    runtime->getInlineCacheProfilerInfo(llvh::errs());
   }
 #endif
 
@@ -14,7 +14,6 @@ namespace hermes {
 static const char *builtinName[] = {
 #define BUILTIN_METHOD(object, name) #object "." #name,
 #define PRIVATE_BUILTIN(name) BUILTIN_METHOD(HermesBuiltin, name)
-#define JS_BUILTIN(name) BUILTIN_METHOD(HermesBuiltin, name)
 #include "hermes/FrontEndDefs/Builtins.def"
 };
 
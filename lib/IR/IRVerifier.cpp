@@ -503,8 +503,8 @@ void Verifier::visitHBCCallNInst(const HBCCallNInst &Inst) {
 
 void Verifier::visitCallBuiltinInst(CallBuiltinInst const &Inst) {
   assert(
-      isNativeBuiltin(Inst.getBuiltinIndex()) &&
-      "CallBuiltin must take a native builtin.");
+      Inst.getBuiltinIndex() < BuiltinMethod::_count &&
+      "Out of bound BuiltinMethod index.");
   visitCallInst(Inst);
 }
 
@@ -835,7 +835,7 @@ class ESTreeIRGen {
       ESTree::BlockStatementNode *bodyBlock);
 
   /// Generate the IR for an async function: it desugars async function to a
-  /// generator function wrapped in a call to the JS builtin `spawnAsync` and
+  /// generator function wrapped in a call to the builtin `spawnAsync` and
   /// return the result. To visualize it,
   ///   async function<name>(<args>)<body>
   /// is effectively lowered to
@@ -12,6 +12,6 @@
 
   // This object will be returned as the completion value of executing internal
   // bytecode (this IIFE). It provides a way to return JS values to native code.
-  // E.g. the only use currently is to register JSFunctions as JS builtins that
-  // "CallBuiltin" opcode can call.
+  // E.g. the only use currently is to hand the promise rejection tracker to
+  // the runtime.
   var internalBytecodeResult = {};
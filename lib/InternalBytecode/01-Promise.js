@@ -1,261 +1,15 @@
-/* @nolint */var initPromise = (function () {
-  'use strict';
-  var useEngineQueue = HermesInternal.useEngineQueue();
-  function noop() {}
-
-  // States:
-  //
-  // 0 - pending
-  // 1 - fulfilled with _value
-  // 2 - rejected with _value
-  // 3 - adopted the state of another promise, _value
-  //
-  // once the state is no longer pending (0) it is immutable
-
-  // All `_` prefixed properties will be reduced to `_{random number}`
-  // at build time to obfuscate them and discourage their use.
-  // We don't use symbols or Object.defineProperty to fully hide them
-  // because the performance isn't good enough.
-
-
-  // to avoid using try/catch inside critical functions, we
-  // extract them to here.
-  var LAST_ERROR = null;
-  var IS_ERROR = {};
-  function getThen(obj) {
-    try {
-      return obj.then;
-    } catch (ex) {
-      LAST_ERROR = ex;
-      return IS_ERROR;
-    }
-  }
-
-  function tryCallOne(fn, a) {
-    try {
-      return fn(a);
-    } catch (ex) {
-      LAST_ERROR = ex;
-      return IS_ERROR;
-    }
-  }
-  function tryCallTwo(fn, a, b) {
-    try {
-      fn(a, b);
-    } catch (ex) {
-      LAST_ERROR = ex;
-      return IS_ERROR;
-    }
-  }
-
-  var core = Promise;
-
-  function Promise(fn) {
-    if (typeof this !== 'object') {
-      throw new TypeError('Promises must be constructed via new');
-    }
-    if (typeof fn !== 'function') {
-      throw new TypeError('Promise constructor\'s argument is not a function');
-    }
-    this._h = 0;
-    this._i = 0;
-    this._j = null;
-    this._k = null;
-    if (fn === noop) return;
-    doResolve(fn, this);
-  }
-  Promise._l = null;
-  Promise._m = null;
-  Promise._n = noop;
-
-  Promise.prototype.then = function(onFulfilled, onRejected) {
-    if (this.constructor !== Promise) {
-      return safeThen(this, onFulfilled, onRejected);
-    }
-    var res = new Promise(noop);
-    handle(this, new Handler(onFulfilled, onRejected, res));
-    return res;
-  };
-
-  function safeThen(self, onFulfilled, onRejected) {
-    return new self.constructor(function (resolve, reject) {
-      var res = new Promise(noop);
-      res.then(resolve, reject);
-      handle(self, new Handler(onFulfilled, onRejected, res));
-    });
-  }
-  function handle(self, deferred) {
-    while (self._i === 3) {
-      self = self._j;
-    }
-    if (Promise._l) {
-      Promise._l(self);
-    }
-    if (self._i === 0) {
-      if (self._h === 0) {
-        self._h = 1;
-        self._k = deferred;
-        return;
-      }
-      if (self._h === 1) {
-        self._h = 2;
-        self._k = [self._k, deferred];
-        return;
-      }
-      self._k.push(deferred);
-      return;
-    }
-    handleResolved(self, deferred);
-  }
-
-  function handleResolved(self, deferred) {
-    (useEngineQueue ? HermesInternal.enqueueJob : setImmediate)(function() {
-      var cb = self._i === 1 ? deferred.onFulfilled : deferred.onRejected;
-      if (cb === null) {
-        if (self._i === 1) {
-          resolve(deferred.promise, self._j);
-        } else {
-          reject(deferred.promise, self._j);
-        }
-        return;
-      }
-      var ret = tryCallOne(cb, self._j);
-      if (ret === IS_ERROR) {
-        reject(deferred.promise, LAST_ERROR);
-      } else {
-        resolve(deferred.promise, ret);
-      }
-    });
-  }
-  function resolve(self, newValue) {
-    // Promise Resolution Procedure: https://github.com/promises-aplus/promises-spec#the-promise-resolution-procedure
-    if (newValue === self) {
-      return reject(
-        self,
-        new TypeError('A promise cannot be resolved with itself.')
-      );
-    }
-    if (
-      newValue &&
-      (typeof newValue === 'object' || typeof newValue === 'function')
-    ) {
-      var then = getThen(newValue);
-      if (then === IS_ERROR) {
-        return reject(self, LAST_ERROR);
-      }
-      if (
-        then === self.then &&
-        newValue instanceof Promise
-      ) {
-        self._i = 3;
-        self._j = newValue;
-        finale(self);
-        return;
-      } else if (typeof then === 'function') {
-        doResolve(then.bind(newValue), self);
-        return;
-      }
-    }
-    self._i = 1;
-    self._j = newValue;
-    finale(self);
-  }
-
-  function reject(self, newValue) {
-    self._i = 2;
-    self._j = newValue;
-    if (Promise._m) {
-      Promise._m(self, newValue);
-    }
-    finale(self);
-  }
-  function finale(self) {
-    if (self._h === 1) {
-      handle(self, self._k);
-      self._k = null;
-    }
-    if (self._h === 2) {
-      for (var i = 0; i < self._k.length; i++) {
-        handle(self, self._k[i]);
-      }
-      self._k = null;
-    }
-  }
-
-  function Handler(onFulfilled, onRejected, promise){
-    this.onFulfilled = typeof onFulfilled === 'function' ? onFulfilled : null;
-    this.onRejected = typeof onRejected === 'function' ? onRejected : null;
-    this.promise = promise;
-  }
-
-  /**
-   * Take a potentially misbehaving resolver function and make sure
-   * onFulfilled and onRejected are only called once.
-   *
-   * Makes no guarantees about asynchrony.
-   */
-  function doResolve(fn, promise) {
-    var done = false;
-    var res = tryCallTwo(fn, function (value) {
-      if (done) return;
-      done = true;
-      resolve(promise, value);
-    }, function (reason) {
-      if (done) return;
-      done = true;
-      reject(promise, reason);
-    });
-    if (!done && res === IS_ERROR) {
-      done = true;
-      reject(promise, LAST_ERROR);
-    }
-  }
-
-  //This file contains the ES6 extensions to the core Promises/A+ API
-
-
-
-  var es6Extensions = core;
-
-  /* Static Functions */
-
-  var TRUE = valuePromise(true);
-  var FALSE = valuePromise(false);
-  var NULL = valuePromise(null);
-  var UNDEFINED = valuePromise(undefined);
-  var ZERO = valuePromise(0);
-  var EMPTYSTRING = valuePromise('');
-
-  function valuePromise(value) {
-    var p = new core(core._n);
-    p._i = 1;
-    p._j = value;
-    return p;
-  }
-  core.resolve = function (value) {
-    if (value instanceof core) return value;
-
-    if (value === null) return NULL;
-    if (value === undefined) return UNDEFINED;
-    if (value === true) return TRUE;
-    if (value === false) return FALSE;
-    if (value === 0) return ZERO;
-    if (value === '') return EMPTYSTRING;
-
-    if (typeof value === 'object' || typeof value === 'function') {
-      try {
-        var then = value.then;
-        if (typeof then === 'function') {
-          return new core(then.bind(value));
-        }
-      } catch (ex) {
-        return new core(function (resolve, reject) {
-          reject(ex);
-        });
-      }
-    }
-    return valuePromise(value);
-  };
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// The Promise constructor, then, catch, resolve and reject are native (see
+// lib/VM/JSLib/Promise.cpp). This file adds the rest of the ES6 API on top of
+// them, and the promise rejection tracking used by React Native.
+/* @nolint */ var initPromise = function () {
+  var Promise = globalThis.Promise;
 
   var iterableToArray = function (iterable) {
     if (typeof Array.from === 'function') {
@@ -269,43 +23,44 @@
     return Array.prototype.slice.call(iterable);
   };
 
-  core.all = function (arr) {
+  function isThenable(val) {
+    return (
+      !!val &&
+      (typeof val === 'object' || typeof val === 'function') &&
+      typeof val.then === 'function'
+    );
+  }
+
+  // Chain off a thenable, skipping the allocation of a wrapper promise for native
+  // promises using the intrinsic then.
+  function then(val, onFulfilled, onRejected) {
+    if (val instanceof Promise && val.then === Promise.prototype.then) {
+      return val.then(onFulfilled, onRejected);
+    }
+    return Promise.resolve(val).then(onFulfilled, onRejected);
+  }
+
+  Promise.all = function (arr) {
     var args = iterableToArray(arr);
 
-    return new core(function (resolve, reject) {
+    return new Promise(function (resolve, reject) {
       if (args.length === 0) return resolve([]);
       var remaining = args.length;
       function res(i, val) {
-        if (val && (typeof val === 'object' || typeof val === 'function')) {
-          if (val instanceof core && val.then === core.prototype.then) {
-            while (val._i === 3) {
-              val = val._j;
-            }
-            if (val._i === 1) return res(i, val._j);
-            if (val._i === 2) reject(val._j);
-            val.then(function (val) {
-              res(i, val);
-            }, reject);
-            return;
-          } else {
-            var then = val.then;
-            if (typeof then === 'function') {
-              var p = new core(then.bind(val));
-              p.then(function (val) {
-                res(i, val);
-              }, reject);
-              return;
-            }
-          }
-        }
         args[i] = val;
         if (--remaining === 0) {
           resolve(args);
         }
       }
-      for (var i = 0; i < args.length; i++) {
-        res(i, args[i]);
-      }
+      args.forEach(function (val, i) {
+        if (isThenable(val)) {
+          then(val, function (val) {
+            res(i, val);
+          }, reject);
+          return;
+        }
+        res(i, val);
+      });
     });
   };
 
@@ -316,42 +71,24 @@
     return { status: 'rejected', reason: reason };
   }
   function mapAllSettled(item) {
-    if(item && (typeof item === 'object' || typeof item === 'function')){
-      if(item instanceof core && item.then === core.prototype.then){
-        return item.then(onSettledFulfill, onSettledReject);
-      }
-      var then = item.then;
-      if (typeof then === 'function') {
-        return new core(then.bind(item)).then(onSettledFulfill, onSettledReject)
-      }
+    if (isThenable(item)) {
+      return then(item, onSettledFulfill, onSettledReject);
     }
 
     return onSettledFulfill(item);
   }
-  core.allSettled = function (iterable) {
-    return core.all(iterableToArray(iterable).map(mapAllSettled));
-  };
-
-  core.reject = function (value) {
-    return new core(function (resolve, reject) {
-      reject(value);
-    });
+  Promise.allSettled = function (iterable) {
+    return Promise.all(iterableToArray(iterable).map(mapAllSettled));
   };
 
-  core.race = function (values) {
-    return new core(function (resolve, reject) {
+  Promise.race = function (values) {
+    return new Promise(function (resolve, reject) {
       iterableToArray(values).forEach(function(value){
-        core.resolve(value).then(resolve, reject);
+        Promise.resolve(value).then(resolve, reject);
       });
     });
   };
 
-  /* Prototype Methods */
-
-  core.prototype['catch'] = function (onRejected) {
-    return this.then(null, onRejected);
-  };
-
   function getAggregateError(errors){
     if(typeof AggregateError === 'function'){
       return new AggregateError(errors,'All promises were rejected');
@@ -365,8 +102,8 @@
     return error;
   }
 
-  core.any = function promiseAny(values) {
-    return new core(function(resolve, reject) {
+  Promise.any = function promiseAny(values) {
+    return new Promise(function(resolve, reject) {
       var promises = iterableToArray(values);
       var hasResolved = false;
       var rejectionReasons = [];
@@ -390,39 +127,44 @@
         reject(getAggregateError(rejectionReasons));
       } else {
         promises.forEach(function(value){
-          core.resolve(value).then(resolveOnce, rejectionCheck);
+          Promise.resolve(value).then(resolveOnce, rejectionCheck);
         });
       }
     });
   };
 
-  core.prototype.finally = function (f) {
+  Promise.prototype.finally = function (f) {
     return this.then(function (value) {
-      return core.resolve(f()).then(function () {
+      return Promise.resolve(f()).then(function () {
         return value;
       });
     }, function (err) {
-      return core.resolve(f()).then(function () {
+      return Promise.resolve(f()).then(function () {
         throw err;
       });
     });
   };
 
+  // Rejection tracking. The runtime calls the tracker registered below when a
+  // promise is rejected without any handler, and when a handler is added to
+  // such a promise later.
+
   var DEFAULT_WHITELIST = [
     ReferenceError,
     TypeError,
     RangeError
   ];
 
+  var onHandle = null;
+  var onReject = null;
+
   var enabled = false;
-  var disable_1 = disable;
   function disable() {
     enabled = false;
-    core._l = null;
-    core._m = null;
+    onHandle = null;
+    onReject = null;
   }
 
-  var enable_1 = enable;
   function enable(options) {
     options = options || {};
     if (enabled) disable();
@@ -430,11 +172,8 @@
     var id = 0;
     var displayId = 0;
     var rejections = {};
-    core._l = function (promise) {
-      if (
-        promise._i === 2 && // IS REJECTED
-        rejections[promise._o]
-      ) {
+    onHandle = function (promise) {
+      if (rejections[promise._o]) {
         if (rejections[promise._o].logged) {
           onHandled(promise._o);
         } else {
@@ -443,25 +182,23 @@
         delete rejections[promise._o];
       }
     };
-    core._m = function (promise, err) {
-      if (promise._h === 0) { // not yet handled
-        promise._o = id++;
-        rejections[promise._o] = {
-          displayId: null,
-          error: err,
-          timeout: setTimeout(
-            onUnhandled.bind(null, promise._o),
-            // For reference errors and type errors, this almost always
-            // means the programmer made a mistake, so log them after just
-            // 100ms
-            // otherwise, wait 2 seconds to see if they get handled
-            matchWhitelist(err, DEFAULT_WHITELIST)
-              ? 100
-              : 2000
-          ),
-          logged: false
-        };
-      }
+    onReject = function (promise, err) {
+      promise._o = id++;
+      rejections[promise._o] = {
+        displayId: null,
+        error: err,
+        timeout: setTimeout(
+          onUnhandled.bind(null, promise._o),
+          // For reference errors and type errors, this almost always
+          // means the programmer made a mistake, so log them after just
+          // 100ms
+          // otherwise, wait 2 seconds to see if they get handled
+          matchWhitelist(err, DEFAULT_WHITELIST)
+            ? 100
+            : 2000
+        ),
+        logged: false
+      };
     };
     function onUnhandled(id) {
       if (
@@ -518,34 +255,25 @@
     });
   }
 
-  var rejectionTracking = {
-  	disable: disable_1,
-  	enable: enable_1
+  // Called by the runtime with isReject set when a promise without handlers
+  // is rejected, and unset when a handler is added to that promise.
+  internalBytecodeResult.promiseRejectionTracker = function (
+    promise,
+    isReject,
+    reason
+  ) {
+    if (isReject) {
+      if (onReject) onReject(promise, reason);
+    } else if (onHandle) {
+      onHandle(promise);
+    }
   };
 
-  // @nolint
-  // This file is used to generate InternalBytecode/Promise.js
-  // See InternalBytecode/README.md for more details.
-
-
-
-
-
-  // expose Promise to global.
-  globalThis.Promise = es6Extensions;
-
   // register the JavaScript implemented `enable` function into
   // the Hermes' internal promise rejection tracker.
-  var enableHook = rejectionTracking.enable;
-  HermesInternal?.setPromiseRejectionTrackingHook?.(enableHook);
-
-  var promise = {
-
-  };
-
-  return promise;
+  HermesInternal?.setPromiseRejectionTrackingHook?.(enable);
+};
 
-});
 if (HermesInternal?.hasPromise?.()) {
   initPromise();
 }
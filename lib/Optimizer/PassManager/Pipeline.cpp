@@ -83,6 +83,10 @@ void hermes::runFullOptimizationPasses(Module &M) {
   PM.addFuncSigOpts();
   PM.addDCE();
   PM.addSimplifyCFG();
+  // Hoist loop invariants once CSE has merged identical computations, and
+  // dead code and unreachable blocks are gone. Otherwise instructions hoisted
+  // out of blocks that are removed later would be left unused.
+  PM.addLICM();
   PM.addMem2Reg();
   PM.addAuditor();
 
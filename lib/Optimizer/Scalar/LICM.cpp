@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#define DEBUG_TYPE "licm"
+#include "hermes/Optimizer/Scalar/LICM.h"
+#include "hermes/IR/Analysis.h"
+#include "hermes/IR/CFG.h"
+#include "hermes/IR/Instrs.h"
+#include "hermes/Optimizer/Scalar/Utils.h"
+#include "hermes/Support/Statistic.h"
+
+#include "llvh/ADT/SmallPtrSet.h"
+#include "llvh/Support/Debug.h"
+
+#include <algorithm>
+
+using namespace hermes;
+using llvh::dbgs;
+
+STATISTIC(NumHoisted, "Number of instructions hoisted out of loops");
+STATISTIC(NumHoistedLoads, "Number of variable loads hoisted out of loops");
+
+namespace {
+
+using BlockSet = llvh::SmallPtrSet<BasicBlock *, 16>;
+
+/// A natural loop with a single entry edge, from its preheader.
+struct Loop {
+  BasicBlock *header;
+  BasicBlock *preheader;
+  /// The header and every block that reaches a back edge to it without going
+  /// through it.
+  BlockSet blocks{};
+  /// Variables stored to in the loop.
+  llvh::SmallPtrSet<Variable *, 8> storedVars{};
+  /// Whether the loop may run code we can't see, like calls and accessors,
+  /// which could store to any variable.
+  bool mayRunUnknownCode = false;
+};
+
+/// \return true if \p I reads the length of a string, which cannot change and
+/// has no side effects.
+static bool isStringLength(Instruction *I) {
+  auto *LPI = llvh::dyn_cast<LoadPropertyInst>(I);
+  if (!LPI || LPI->getKind() != ValueKind::LoadPropertyInstKind)
+    return false;
+  auto *prop = llvh::dyn_cast<LiteralString>(LPI->getProperty());
+  return prop && prop->getValue().str() == "length" &&
+      LPI->getObject()->getType().isStringType();
+}
+
+/// \return true if \p var can only be stored to by code that cannot run while
+/// a loop in \p F runs, except for code in the loop itself. That is the case
+/// when every store is in the function owning \p var, and that function is
+/// either \p F, or a plain function that cannot be suspended and resumed while
+/// \p F runs. A new invocation of the owning function creates a new scope, so
+/// its stores don't affect the scope that \p F is reading from.
+static bool isStoredOnlyByOwner(Variable *var, Function *F) {
+  ScopeDesc *scope = var->getParent();
+  if (!scope->hasFunction() || scope->getDynamic())
+    return false;
+  Function *owner = scope->getFunction();
+  if (owner != F && owner->getKind() != ValueKind::FunctionKind)
+    return false;
+  for (Instruction *U : var->getUsers()) {
+    if (llvh::isa<StoreFrameInst>(U) && U->getParent()->getParent() != owner)
+      return false;
+  }
+  return true;
+}
+
+/// Find the loops of \p F that have a preheader through which they are always
+/// entered, and summarize the stores in them.
+static std::vector<Loop> findLoops(
+    Function *F,
+    const DominanceInfo &dominance,
+    const LoopAnalysis &loopAnalysis) {
+  std::vector<Loop> loops{};
+  for (BasicBlock &BB : *F) {
+    if (!loopAnalysis.isBlockHeader(&BB))
+      continue;
+    BasicBlock *preheader = loopAnalysis.getLoopPreheader(&BB);
+    if (!preheader)
+      continue;
+
+    Loop loop{&BB, preheader};
+    loop.blocks.insert(&BB);
+    llvh::SmallVector<BasicBlock *, 8> worklist{};
+    for (BasicBlock *pred : predecessors(&BB)) {
+      if (pred != preheader)
+        worklist.push_back(pred);
+    }
+    bool singleEntry = true;
+    while (!worklist.empty()) {
+      BasicBlock *cur = worklist.pop_back_val();
+      if (!dominance.isReachableFromEntry(cur))
+        continue;
+      if (!dominance.dominates(&BB, cur)) {
+        // Another edge enters the loop, which could bypass anything hoisted
+        // to the preheader.
+        singleEntry = false;
+        break;
+      }
+      if (!loop.blocks.insert(cur).second)
+        continue;
+      for (BasicBlock *pred : predecessors(cur))
+        worklist.push_back(pred);
+    }
+    if (!singleEntry)
+      continue;
+
+    for (BasicBlock *loopBB : loop.blocks) {
+      for (Instruction &I : *loopBB) {
+        if (auto *SFI = llvh::dyn_cast<StoreFrameInst>(&I)) {
+          loop.storedVars.insert(SFI->getVariable());
+        } else if (llvh::isa<StoreStackInst>(&I)) {
+          // Stack locations are not visible to other functions.
+        } else if (I.mayWriteMemory()) {
+          loop.mayRunUnknownCode |= !isStringLength(&I);
+        }
+      }
+    }
+    loops.push_back(std::move(loop));
+  }
+
+  // Process inner loops first, so that what they hoist into their preheader
+  // can be hoisted again from the enclosing loop. An enclosing loop always has
+  // more blocks than the loops it contains.
+  std::stable_sort(loops.begin(), loops.end(), [](const Loop &a, const Loop &b) {
+    return a.blocks.size() < b.blocks.size();
+  });
+  return loops;
+}
+
+/// \return true if \p I computes the same value in every iteration of \p loop,
+/// and can be executed before the loop is entered, even if the loop would have
+/// not executed it. Hoisting is speculative: \p I may be in a block that only
+/// some iterations run, and the preheader may branch around the loop. This is
+/// safe because none of the accepted instructions can throw or write memory.
+/// Operators are only accepted when the types of their operands rule out
+/// calls and exceptions, and loads only read a variable or the length of a
+/// string.
+static bool isLoopInvariant(
+    Function *F,
+    Instruction *I,
+    const Loop &loop,
+    Instruction *insertionPoint,
+    const DominanceInfo &dominance) {
+  if (auto *LFI = llvh::dyn_cast<LoadFrameInst>(I)) {
+    Variable *var = LFI->getLoadVariable();
+    if (loop.storedVars.count(var))
+      return false;
+    if (loop.mayRunUnknownCode && !isStoredOnlyByOwner(var, F))
+      return false;
+  } else if (!isSimpleSideEffectFreeInstruction(I) && !isStringLength(I)) {
+    return false;
+  }
+
+  for (unsigned i = 0, e = I->getNumOperands(); i < e; ++i) {
+    auto *operand = llvh::dyn_cast<Instruction>(I->getOperand(i));
+    if (operand && !dominance.properlyDominates(operand, insertionPoint))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+bool LICM::runOnFunction(Function *F) {
+  DominanceInfo dominance(F);
+  LoopAnalysis loopAnalysis(F, dominance);
+  std::vector<Loop> loops = findLoops(F, dominance, loopAnalysis);
+  if (loops.empty())
+    return false;
+
+  // Visit the blocks of each loop in reverse post order, so that operands are
+  // hoisted before the instructions using them.
+  PostOrderAnalysis PO(F);
+  llvh::SmallVector<BasicBlock *, 16> RPO(PO.rbegin(), PO.rend());
+
+  bool changed = false;
+  for (const Loop &loop : loops) {
+    Instruction *insertionPoint = loop.preheader->getTerminator();
+    for (BasicBlock *BB : RPO) {
+      if (!loop.blocks.count(BB))
+        continue;
+      for (auto it = BB->begin(), e = BB->end(); it != e;) {
+        Instruction *I = &*it++;
+        if (!isLoopInvariant(F, I, loop, insertionPoint, dominance))
+          continue;
+        LLVM_DEBUG(
+            dbgs() << "Hoisting " << I->getKindStr() << " out of the loop in "
+                   << F->getInternalNameStr() << "\n");
+        I->moveBefore(insertionPoint);
+        changed = true;
+        ++NumHoisted;
+        if (llvh::isa<LoadFrameInst>(I))
+          ++NumHoistedLoads;
+      }
+    }
+  }
+  return changed;
+}
+
+std::unique_ptr<Pass> hermes::createLICM() {
+  return std::make_unique<LICM>();
+}
+
+#undef DEBUG_TYPE
@@ -10,6 +10,7 @@
 
 #include "dtoa/dtoa.h"
 #include "hermes/Support/Conversions.h"
+#include "hermes/Support/SIMD.h"
 
 #include "llvh/ADT/ScopeExit.h"
 #include "llvh/ADT/StringSwitch.h"
@@ -33,6 +34,79 @@ inline bool matchUnicodeLineTerminatorOffset1(const char *curCharPtr_) {
       ((unsigned char)curCharPtr_[2] == 0xa8 ||
        (unsigned char)curCharPtr_[2] == 0xa9);
 }
+
+#ifdef HERMES_SIMD_VECTOR
+/// \return a pointer to the first byte in [cur, end) for which \p stop
+/// returns a mask with its bit set, scanning whole vectors only. If no such
+/// byte is found, the result is the start of the last partial vector, which
+/// the caller must examine byte by byte.
+template <typename StopFn>
+inline const char *skipUntil(const char *cur, const char *end, StopFn stop) {
+  using V = CodeUnitVector<char>;
+  for (; end - cur >= (ptrdiff_t)V::kLanes; cur += V::kLanes) {
+    if (uint64_t mask = stop(V::load(cur)))
+      return cur + firstLane<char>(mask);
+  }
+  return cur;
+}
+#endif // HERMES_SIMD_VECTOR
+
+/// Skip the bytes of a comment body starting at \p cur that can be consumed
+/// without looking at them individually: everything except line terminators,
+/// non-ASCII bytes and, if \p Block, '*'. The buffer ends at \p end.
+/// \return a pointer to the first byte that was not skipped.
+template <bool Block>
+inline const char *skipCommentChars(const char *cur, const char *end) {
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<char>;
+  cur = skipUntil(cur, end, [](V::Vec v) {
+    V::Vec stop = V::either(
+        V::either(V::eq(v, '\n'), V::eq(v, '\r')), V::nonASCII(v));
+    if (Block)
+      stop = V::either(stop, V::eq(v, '*'));
+    return V::toMask(stop);
+  });
+#endif
+  return cur;
+}
+
+/// Skip the bytes of a string literal body starting at \p cur that are copied
+/// unchanged into the string: everything except \p quoteCh, line terminators,
+/// non-ASCII bytes, and '\\' (JS) or '&' (JSX). The buffer ends at \p end.
+/// \return a pointer to the first byte that was not skipped.
+template <bool JSX>
+inline const char *
+skipStringChars(const char *cur, const char *end, char quoteCh) {
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<char>;
+  cur = skipUntil(cur, end, [quoteCh](V::Vec v) {
+    return V::toMask(V::either(
+        V::either(V::eq(v, quoteCh), V::eq(v, JSX ? '&' : '\\')),
+        V::either(
+            V::either(V::eq(v, '\n'), V::eq(v, '\r')), V::nonASCII(v))));
+  });
+#endif
+  return cur;
+}
+
+/// Skip the ASCII identifier part bytes starting at \p cur, i.e.
+/// [A-Za-z0-9_$] and \p extraCh. The buffer ends at \p end.
+/// \return a pointer to the first byte that was not skipped.
+inline const char *
+skipIdentifierChars(const char *cur, const char *end, char extraCh) {
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<char>;
+  cur = skipUntil(cur, end, [extraCh](V::Vec v) {
+    V::Vec letter = V::inRange(V::toLower(v), 'a', 'z');
+    V::Vec ident = V::either(
+        V::either(letter, V::inRange(v, '0', '9')),
+        V::either(
+            V::either(V::eq(v, '_'), V::eq(v, '$')), V::eq(v, extraCh)));
+    return ~V::toMask(ident) & V::kAllLanes;
+  });
+#endif
+  return cur;
+}
 } // namespace
 
 const char *tokenKindStr(TokenKind kind) {
@@ -1310,6 +1384,7 @@ llvh::StringRef JSLexer::lineCommentHelper(const char *start) {
   const char *cur = start + 2;
 
   for (;;) {
+    cur = skipCommentChars<false>(cur, bufferEnd_);
     switch ((unsigned char)*cur) {
       case 0:
         if (cur == bufferEnd_) {
@@ -1390,6 +1465,7 @@ const char *JSLexer::skipBlockComment(const char *start) {
   const char *cur = start + 2;
 
   for (;;) {
+    cur = skipCommentChars<true>(cur, bufferEnd_);
     switch ((unsigned char)*cur) {
       case 0:
         if (cur == bufferEnd_) {
@@ -1752,16 +1828,20 @@ TokenKind JSLexer::scanReservedWord(const char *start, unsigned length) {
 
 template <JSLexer::IdentifierMode Mode>
 void JSLexer::scanIdentifierFastPath(const char *start) {
-  const char *end = start;
-
-  // Quickly consume the ASCII identifier part.
-  char ch;
-  do
-    ch = (unsigned char)*++end;
+  // The identifier part character allowed by Mode in addition to those of JS.
+  constexpr char extraCh = Mode == IdentifierMode::JSX ? '-'
+      : Mode == IdentifierMode::Flow                   ? '@'
+                                                       : '_';
+
+  // Quickly consume the ASCII identifier part, a vector at a time while the
+  // buffer allows it.
+  const char *end = skipIdentifierChars(start + 1, bufferEnd_, extraCh);
+  char ch = (unsigned char)*end;
   while (ch == '_' || ch == '$' || ((ch | 32) >= 'a' && (ch | 32) <= 'z') ||
          (ch >= '0' && ch <= '9') ||
          (Mode == IdentifierMode::JSX && ch == '-') ||
-         (Mode == IdentifierMode::Flow && ch == '@'));
+         (Mode == IdentifierMode::Flow && ch == '@'))
+    ch = (unsigned char)*++end;
 
   // Check whether a slow part of the identifier follows.
   if (LLVM_UNLIKELY(ch == '\\')) {
@@ -1850,6 +1930,12 @@ void JSLexer::scanString() {
   tmpStorage_.clear();
 
   for (;;) {
+    // Copy the run of characters that need no processing all at once.
+    const char *plainEnd =
+        skipStringChars<JSX>(curCharPtr_, bufferEnd_, quoteCh);
+    tmpStorage_.append(curCharPtr_, plainEnd);
+    curCharPtr_ = plainEnd;
+
     if (*curCharPtr_ == quoteCh) {
       ++curCharPtr_;
       break;
@@ -8,6 +8,7 @@
 #include "hermes/Regex/Executor.h"
 #include "hermes/Regex/RegexTraits.h"
 #include "hermes/Support/OptValue.h"
+#include "hermes/Support/StringSearch.h"
 
 #include "llvh/ADT/ScopeExit.h"
 #include "llvh/ADT/SmallVector.h"
@@ -406,6 +407,14 @@ struct Context {
   /// checking or call depth counter checking.
   StackOverflowGuard overflowGuard_;
 
+  /// If it has more than one code unit, every match starts with matchPrefix_.
+  llvh::SmallVector<CodeUnit, constants::kMaxMatchPrefixLength> matchPrefix_;
+
+  /// If non-empty and matchPrefix_ has at most one code unit, every match
+  /// starts with one of matchFirstCodeUnits_.
+  llvh::SmallVector<CodeUnit, constants::kMaxMatchFirstCodeUnits>
+      matchFirstCodeUnits_;
+
   Context(
       llvh::ArrayRef<uint8_t> bytecodeStream,
       constants::MatchFlagType flags,
@@ -437,6 +446,23 @@ struct Context {
       State<Traits> *state,
       bool onlyAtStart);
 
+  /// Set up the code units that every match starts with from the bytecode
+  /// \p header, so that match() can skip positions where no match can start.
+  /// \return false if the code units cannot occur in the input, so that no
+  /// match is possible.
+  bool initMatchStart(const RegexBytecodeHeader &header);
+
+  /// \return whether initMatchStart() found code units that every match
+  /// starts with.
+  bool hasMatchStart() const {
+    return !matchFirstCodeUnits_.empty();
+  }
+
+  /// \return the first index at or after \p index in the \p length code units
+  /// at \p start where a match may start, or kStringSearchNotFound.
+  size_t findMatchStart(const CodeUnit *start, size_t index, size_t length)
+      const;
+
   /// Backtrack the given state \p s with the backtrack stack \p bts.
   /// \return true if we backtracked, false if we exhausted the stack.
   LLVM_NODISCARD
@@ -966,6 +992,37 @@ inline size_t Context<Traits>::advanceStringIndex(
   return index + 2;
 }
 
+template <class Traits>
+bool Context<Traits>::initMatchStart(const RegexBytecodeHeader &header) {
+  // An ASCII input can only contain ASCII code units.
+  constexpr char16_t maxCodeUnit = sizeof(CodeUnit) == 1 ? 0x7F : 0xFFFF;
+  for (uint8_t i = 0; i < header.prefixLength; ++i) {
+    if (header.prefix[i] > maxCodeUnit)
+      return false;
+    matchPrefix_.push_back(header.prefix[i]);
+  }
+  if (!matchPrefix_.empty()) {
+    matchFirstCodeUnits_.push_back(matchPrefix_.front());
+    return true;
+  }
+  for (uint8_t i = 0; i < header.firstCodeUnitCount; ++i) {
+    if (header.firstCodeUnits[i] <= maxCodeUnit)
+      matchFirstCodeUnits_.push_back(header.firstCodeUnits[i]);
+  }
+  return header.firstCodeUnitCount == 0 || !matchFirstCodeUnits_.empty();
+}
+
+template <class Traits>
+size_t Context<Traits>::findMatchStart(
+    const CodeUnit *start,
+    size_t index,
+    size_t length) const {
+  llvh::ArrayRef<CodeUnit> haystack{start, length};
+  if (matchPrefix_.size() > 1)
+    return stringSearch(haystack, matchPrefix_, index);
+  return stringSearchAnyOf(haystack, matchFirstCodeUnits_, index);
+}
+
 template <class Traits>
 auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
     -> ExecutorResult<const CodeUnit *> {
@@ -1021,8 +1078,17 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
     goto backtrackingExhausted;                \
   } while (0)
 
+  // If every match starts with known code units, skip to the next position
+  // where they occur instead of attempting a match at every position.
+  const bool skipToMatchStart = !onlyAtStart && hasMatchStart();
+
   for (size_t locIndex = 0; locIndex < locsToCheckCount;
        locIndex = advanceStringIndex(startLoc, locIndex, charsToRight)) {
+    if (skipToMatchStart) {
+      locIndex = findMatchStart(startLoc, locIndex, charsToRight);
+      if (locIndex == kStringSearchNotFound)
+        break;
+    }
     const CodeUnit *potentialMatchLocation = startLoc + locIndex;
     c.setCurrentPointer(potentialMatchLocation);
     s->ip_ = startIp;
@@ -1569,6 +1635,9 @@ MatchRuntimeResult searchWithBytecodeImpl(
   bool onlyAtStart = (header->constraints & MatchConstraintAnchoredAtStart) ||
       (matchFlags & constants::matchOnlyAtStart);
 
+  if (!ctx.initMatchStart(*header))
+    return MatchRuntimeResult::NoMatch;
+
   auto res = ctx.match(&state, onlyAtStart);
   if (!res) {
     assert(res.getStatus() == ExecutionStatus::STACK_OVERFLOW);
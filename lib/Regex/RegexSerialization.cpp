@@ -73,6 +73,19 @@ uint32_t instructionWidth<regex::MatchNCharICase8Insn>(
   return insn->totalWidth();
 }
 
+/// Print the code units \p codeUnits as a quoted string, escaping any that are
+/// not printable ASCII.
+void dumpCodeUnits(llvh::ArrayRef<char16_t> codeUnits, llvh::raw_ostream &OS) {
+  OS << '"';
+  for (char16_t c : codeUnits) {
+    if (c < 128 && std::isprint(c) && c != '"' && c != '\\')
+      OS << (char)c;
+    else
+      OS << llvh::format("\\u%04x", (unsigned)c);
+  }
+  OS << '"';
+}
+
 void dumpInstruction(const regex::MatchChar8Insn *insn, llvh::raw_ostream &OS) {
   OS << "MatchChar8: ";
   char c = insn->c;
@@ -284,11 +297,26 @@ void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
   auto *header =
       reinterpret_cast<const regex::RegexBytecodeHeader *>(bytes.data());
   OS << llvh::format(
-      "  Header: marked: %u loops: %u flags: %u constraints: %u\n",
+      "  Header: marked: %u loops: %u flags: %u constraints: %u",
       aligner(header->markedCount),
       aligner(header->loopCount),
       aligner(header->syntaxFlags),
       header->constraints);
+  if (header->prefixLength) {
+    OS << " prefix: ";
+    dumpCodeUnits(
+        llvh::SmallVector<char16_t, 8>(
+            header->prefix, header->prefix + header->prefixLength),
+        OS);
+  } else if (header->firstCodeUnitCount) {
+    OS << " first: ";
+    dumpCodeUnits(
+        llvh::SmallVector<char16_t, 8>(
+            header->firstCodeUnits,
+            header->firstCodeUnits + header->firstCodeUnitCount),
+        OS);
+  }
+  OS << '\n';
   bytes = bytes.slice(sizeof *header);
   uint32_t cursor = 0;
   while (cursor < bytes.size()) {
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/GzipOStream.h"
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "zip/src/miniz.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace hermes {
+
+GzipOStream::GzipOStream(llvh::raw_ostream &os, int level)
+    : os_(os),
+      stream_(std::make_unique<mz_stream>()),
+      outBuffer_(std::make_unique<char[]>(kBufferSize)) {
+  memset(stream_.get(), 0, sizeof(mz_stream));
+  // Negative window bits produce raw deflate data, which is wrapped in the
+  // gzip header and trailer here.
+  int status = mz_deflateInit2(
+      stream_.get(),
+      level,
+      MZ_DEFLATED,
+      -MZ_DEFAULT_WINDOW_BITS,
+      9,
+      MZ_DEFAULT_STRATEGY);
+  (void)status;
+  assert(status == MZ_OK && "Invalid compression parameters");
+
+  // Magic number, deflate, no flags, no modification time, no extra flags,
+  // unknown OS.
+  static const char header[] = {
+      '\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff'};
+  os_.write(header, sizeof(header));
+  SetBufferSize(kBufferSize);
+}
+
+GzipOStream::~GzipOStream() {
+  flush();
+  deflate(nullptr, 0, MZ_FINISH);
+  mz_deflateEnd(stream_.get());
+
+  // The CRC-32 and the size modulo 2^32 of the uncompressed data, in little
+  // endian.
+  char trailer[8];
+  for (unsigned i = 0; i < 4; ++i) {
+    trailer[i] = (char)(crc_ >> (8 * i));
+    trailer[4 + i] = (char)(inputSize_ >> (8 * i));
+  }
+  os_.write(trailer, sizeof(trailer));
+  os_.flush();
+}
+
+void GzipOStream::write_impl(const char *ptr, size_t size) {
+  crc_ = mz_crc32(crc_, (const unsigned char *)ptr, size);
+  inputSize_ += size;
+  deflate(ptr, size, MZ_NO_FLUSH);
+}
+
+void GzipOStream::deflate(const char *ptr, size_t size, int flush) {
+  do {
+    // The compressor takes at most UINT_MAX bytes at a time.
+    size_t chunk = std::min<size_t>(size, UINT_MAX);
+    stream_->next_in = (const unsigned char *)ptr;
+    stream_->avail_in = chunk;
+    int status;
+    do {
+      stream_->next_out = (unsigned char *)outBuffer_.get();
+      stream_->avail_out = kBufferSize;
+      status = mz_deflate(stream_.get(), chunk == size ? flush : MZ_NO_FLUSH);
+      os_.write(outBuffer_.get(), kBufferSize - stream_->avail_out);
+      // Keep going while the output buffer fills up, since the compressor may
+      // have more output for it, and until the end of the stream when
+      // finishing.
+    } while (
+        (status == MZ_OK || status == MZ_BUF_ERROR) &&
+        (stream_->avail_out == 0 ||
+         (flush == MZ_FINISH && chunk == size && status != MZ_BUF_ERROR)));
+    ptr += chunk;
+    size -= chunk;
+  } while (size);
+}
+
+} // namespace hermes
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringSearch.h"
+
+#include "hermes/Support/SIMD.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace hermes {
+
+namespace {
+
+/// Needles up to this length are searched with the vector filter, longer
+/// ones with Boyer-Moore-Horspool.
+constexpr size_t kMaxShortNeedle = 32;
+
+/// Sets of up to this many code units are searched with the vector scan.
+constexpr size_t kMaxVectorAnyOf = 4;
+
+/// \return the index of the first \p c in [hay + from, hay + n), or
+/// kStringSearchNotFound.
+inline size_t findCodeUnit(const char *hay, size_t n, char c, size_t from) {
+  const void *found = std::memchr(hay + from, c, n - from);
+  return found ? static_cast<const char *>(found) - hay
+               : kStringSearchNotFound;
+}
+
+inline size_t
+findCodeUnit(const char16_t *hay, size_t n, char16_t c, size_t from) {
+  size_t i = from;
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<char16_t>;
+  const V::Vec vc = V::splat(c);
+  for (; i + V::kLanes <= n; i += V::kLanes) {
+    if (uint64_t mask = V::toMask(V::eq(V::load(hay + i), vc)))
+      return i + firstLane<char16_t>(mask);
+  }
+#endif
+  for (; i < n; ++i) {
+    if (hay[i] == c)
+      return i;
+  }
+  return kStringSearchNotFound;
+}
+
+/// Search for a needle of length 2 <= m <= kMaxShortNeedle by comparing the
+/// first and the last code units of kLanes candidate positions at a time,
+/// and verifying only the positions where both match.
+template <typename T>
+size_t findShort(const T *hay, size_t n, const T *needle, size_t m, size_t i) {
+  const T first = needle[0];
+  const T last = needle[m - 1];
+  // The last possible start of a match.
+  const size_t end = n - m;
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<T>;
+  const typename V::Vec vFirst = V::splat(first);
+  const typename V::Vec vLast = V::splat(last);
+  for (; i + V::kLanes <= end + 1; i += V::kLanes) {
+    uint64_t mask = V::toMask(V::eq(V::load(hay + i), vFirst)) &
+        V::toMask(V::eq(V::load(hay + i + m - 1), vLast));
+    for (; mask; mask &= mask - 1) {
+      size_t candidate = i + firstLane<T>(mask);
+      if (std::memcmp(
+              hay + candidate + 1, needle + 1, (m - 2) * sizeof(T)) == 0)
+        return candidate;
+    }
+  }
+#endif
+  for (; i <= end; ++i) {
+    if (hay[i] == first && hay[i + m - 1] == last &&
+        std::memcmp(hay + i + 1, needle + 1, (m - 2) * sizeof(T)) == 0)
+      return i;
+  }
+  return kStringSearchNotFound;
+}
+
+/// Search for a needle of length m > kMaxShortNeedle with
+/// Boyer-Moore-Horspool. UTF-16 code units are hashed to their low byte for
+/// the shift table, which can only make the shifts shorter.
+template <typename T>
+size_t findLong(const T *hay, size_t n, const T *needle, size_t m, size_t i) {
+  size_t shift[256];
+  std::fill(std::begin(shift), std::end(shift), m);
+  for (size_t j = 0; j + 1 < m; ++j)
+    shift[(uint8_t)needle[j]] = m - 1 - j;
+
+  const T last = needle[m - 1];
+  const size_t end = n - m;
+  while (i <= end) {
+    T c = hay[i + m - 1];
+    if (c == last && std::memcmp(hay + i, needle, (m - 1) * sizeof(T)) == 0)
+      return i;
+    i += shift[(uint8_t)c];
+  }
+  return kStringSearchNotFound;
+}
+
+template <typename T>
+size_t
+search(llvh::ArrayRef<T> haystack, llvh::ArrayRef<T> needle, size_t from) {
+  const size_t n = haystack.size();
+  const size_t m = needle.size();
+  if (from > n || m > n - from)
+    return kStringSearchNotFound;
+  if (m == 0)
+    return from;
+  if (m == 1)
+    return findCodeUnit(haystack.data(), n, needle[0], from);
+  if (m <= kMaxShortNeedle)
+    return findShort(haystack.data(), n, needle.data(), m, from);
+  return findLong(haystack.data(), n, needle.data(), m, from);
+}
+
+template <typename T>
+size_t searchLast(
+    llvh::ArrayRef<T> haystack,
+    llvh::ArrayRef<T> needle,
+    size_t maxStart) {
+  const size_t n = haystack.size();
+  const size_t m = needle.size();
+  if (m > n)
+    return kStringSearchNotFound;
+  if (m == 0)
+    return std::min(maxStart, n);
+  const T *hay = haystack.data();
+  // Candidates are visited backwards, with a filter on the first and the last
+  // code units.
+  for (size_t i = std::min(maxStart, n - m) + 1; i-- != 0;) {
+    if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1] &&
+        std::memcmp(hay + i, needle.data(), m * sizeof(T)) == 0)
+      return i;
+  }
+  return kStringSearchNotFound;
+}
+
+template <typename T>
+size_t searchAnyOf(
+    llvh::ArrayRef<T> haystack,
+    llvh::ArrayRef<T> codeUnits,
+    size_t from) {
+  const size_t n = haystack.size();
+  if (from >= n || codeUnits.empty())
+    return kStringSearchNotFound;
+  if (codeUnits.size() == 1)
+    return findCodeUnit(haystack.data(), n, codeUnits[0], from);
+  const T *hay = haystack.data();
+  size_t i = from;
+#ifdef HERMES_SIMD_VECTOR
+  if (codeUnits.size() <= kMaxVectorAnyOf) {
+    using V = CodeUnitVector<T>;
+    const size_t count = codeUnits.size();
+    typename V::Vec splats[kMaxVectorAnyOf];
+    for (size_t k = 0; k < count; ++k)
+      splats[k] = V::splat(codeUnits[k]);
+    for (; i + V::kLanes <= n; i += V::kLanes) {
+      const typename V::Vec v = V::load(hay + i);
+      typename V::Vec found = V::eq(v, splats[0]);
+      for (size_t k = 1; k < count; ++k)
+        found = V::either(found, V::eq(v, splats[k]));
+      if (uint64_t mask = V::toMask(found))
+        return i + firstLane<T>(mask);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (std::find(codeUnits.begin(), codeUnits.end(), hay[i]) !=
+        codeUnits.end())
+      return i;
+  }
+  return kStringSearchNotFound;
+}
+
+} // namespace
+
+size_t stringSearch(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> needle,
+    size_t from) {
+  return search(haystack, needle, from);
+}
+
+size_t stringSearch(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> needle,
+    size_t from) {
+  return search(haystack, needle, from);
+}
+
+size_t stringSearchLast(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> needle,
+    size_t maxStart) {
+  return searchLast(haystack, needle, maxStart);
+}
+
+size_t stringSearchLast(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> needle,
+    size_t maxStart) {
+  return searchLast(haystack, needle, maxStart);
+}
+
+size_t stringSearchAnyOf(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char> codeUnits,
+    size_t from) {
+  return searchAnyOf(haystack, codeUnits, from);
+}
+
+size_t stringSearchAnyOf(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> codeUnits,
+    size_t from) {
+  return searchAnyOf(haystack, codeUnits, from);
+}
+
+} // namespace hermes
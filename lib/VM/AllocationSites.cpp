@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/AllocationSites.h"
+
+#include "hermes/Support/JSONEmitter.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Runtime.h"
+#include "hermes/VM/SlotAcceptor.h"
+#include "hermes/VM/WeakRoot-inline.h"
+
+#include <algorithm>
+
+namespace hermes {
+namespace vm {
+
+AllocationSites::Decision AllocationSites::decide(
+    CodeBlock *codeBlock,
+    uint32_t offset) {
+  auto &siteIndices = codeBlock->allocationSites();
+  auto it = siteIndices.find(offset);
+  uint32_t index;
+  if (LLVM_LIKELY(it != siteIndices.end())) {
+    index = it->second;
+  } else {
+    index = sites_.size() < kMaxSites ? sites_.size() : kNoSite;
+    if (index != kNoSite)
+      sites_.emplace_back();
+    siteIndices[offset] = index;
+  }
+  if (LLVM_UNLIKELY(index == kNoSite))
+    return {index, LongLived::No, false};
+
+  Site &site = sites_[index];
+  if (LLVM_LIKELY(--site.untilSample))
+    return {index, site.pretenured ? LongLived::Yes : LongLived::No, false};
+  site.untilSample = site.sampleInterval;
+  // Samples are allocated in the YG even for pretenured sites, since that is
+  // where their lifetime can be observed.
+  return {index, LongLived::No, true};
+}
+
+void AllocationSites::addSample(Runtime &runtime, uint32_t site, GCCell *cell) {
+  GC &gc = runtime.getHeap();
+  // Objects outside of the YG don't have a YG lifetime, which happens when
+  // the GC has no YG.
+  if (!gc.inYoungGen(cell))
+    return;
+  // A YG collection resolves every pending sample, including the oldest.
+  if (!samples_.empty()) {
+    GCCell *const oldest = samples_.front().cell.getNoBarrierUnsafe(runtime);
+    if (!oldest || !gc.inYoungGen(oldest))
+      resolveSamples(runtime);
+  }
+  if (samples_.size() == kMaxSamples)
+    return;
+  samples_.push_back({WeakRoot<GCCell>{cell, runtime}, site});
+}
+
+void AllocationSites::resolveSamples(Runtime &runtime) {
+  GC &gc = runtime.getHeap();
+  size_t numPending = 0;
+  for (Sample &sample : samples_) {
+    // The weak root is cleared if the object died, and updated if the object
+    // was moved out of the YG. Neither needs a read barrier, since the object
+    // is not used.
+    GCCell *const cell = sample.cell.getNoBarrierUnsafe(runtime);
+    if (cell && gc.inYoungGen(cell)) {
+      Sample &pending = samples_[numPending++];
+      pending.cell = sample.cell.getNoBarrierUnsafe();
+      pending.site = sample.site;
+    } else {
+      recordLifetime(sites_[sample.site], cell);
+    }
+  }
+  samples_.resize(numPending);
+}
+
+void AllocationSites::recordLifetime(Site &site, bool survived) {
+  ++site.numSamples;
+  site.numSurvivors += survived;
+  if (site.numSamples < kSamplesPerDecision)
+    return;
+  const uint32_t survivorPercent = site.numSurvivors * 100 / site.numSamples;
+  if (!site.pretenured) {
+    if (survivorPercent >= kPretenurePercent) {
+      site.pretenured = true;
+      site.sampleInterval = kPretenuredSampleInterval;
+      ++numPretenured_;
+    } else {
+      site.sampleInterval =
+          std::min(site.sampleInterval * 2, kMaxSampleInterval);
+    }
+  } else if (survivorPercent < kRevertPercent) {
+    site.pretenured = false;
+    site.sampleInterval = kMinSampleInterval;
+    ++numReverted_;
+  }
+  site.untilSample = std::min(site.untilSample, site.sampleInterval);
+  site.numSamples = 0;
+  site.numSurvivors = 0;
+}
+
+void AllocationSites::markWeakRoots(WeakRootAcceptor &acceptor) {
+  for (Sample &sample : samples_)
+    acceptor.acceptWeak(sample.cell);
+}
+
+void AllocationSites::printStats(JSONEmitter &json) const {
+  json.emitKey("allocationSites");
+  json.openDict();
+  json.emitKeyValue("sites", sites_.size());
+  json.emitKeyValue(
+      "pretenuredSites",
+      std::count_if(sites_.begin(), sites_.end(), [](const Site &site) {
+        return site.pretenured;
+      }));
+  json.emitKeyValue("pretenureDecisions", numPretenured_);
+  json.emitKeyValue("revertDecisions", numReverted_);
+  json.closeDict();
+}
+
+} // namespace vm
+} // namespace hermes
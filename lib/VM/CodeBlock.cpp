@@ -378,9 +378,9 @@ void CodeBlock::markCachedHiddenClasses(
     WeakRootAcceptor &acceptor) {
   for (auto &prop :
        llvh::makeMutableArrayRef(propertyCache(), propertyCacheSize_)) {
-    if (prop.clazz) {
-      acceptor.acceptWeak(prop.clazz);
-    }
+    prop.forEachClass([&acceptor](WeakRoot<HiddenClass> &clazz) {
+      acceptor.acceptWeak(clazz);
+    });
   }
 }
 
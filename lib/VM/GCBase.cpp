@@ -11,12 +11,14 @@
 #include "hermes/Platform/Logging.h"
 #include "hermes/Public/JSOutOfMemoryError.h"
 #include "hermes/Support/ErrorHandling.h"
+#include "hermes/Support/GzipOStream.h"
 #include "hermes/Support/OSCompat.h"
 #include "hermes/VM/CellKind.h"
 #include "hermes/VM/JSWeakMapImpl.h"
 #include "hermes/VM/RootAndSlotAcceptorDefault.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/SmallHermesValue-inline.h"
+#include "hermes/VM/StackTracesTree.h"
 #include "hermes/VM/VTable.h"
 
 #include "llvh/Support/Debug.h"
@@ -26,7 +28,9 @@
 #include "llvh/Support/raw_ostream.h"
 
 #include <inttypes.h>
+#include <algorithm>
 #include <clocale>
+#include <cmath>
 #include <stdexcept>
 #include <system_error>
 #pragma GCC diagnostic push
@@ -130,13 +134,20 @@ void GCBase::runtimeWillExecute() {
 }
 
 #ifdef HERMES_MEMORY_INSTRUMENTATION
-std::error_code GCBase::createSnapshotToFile(const std::string &fileName) {
+std::error_code GCBase::createSnapshotToFile(
+    const std::string &fileName,
+    bool captureNumericValue) {
   std::error_code code;
   llvh::raw_fd_ostream os(fileName, code, llvh::sys::fs::FileAccess::FA_Write);
   if (code) {
     return code;
   }
-  createSnapshot(os, true);
+  if (GzipOStream::isGzipFileName(fileName)) {
+    GzipOStream gzip{os};
+    createSnapshot(gzip, captureNumericValue);
+  } else {
+    createSnapshot(os, captureNumericValue);
+  }
   return std::error_code{};
 }
 
@@ -587,6 +598,13 @@ void GCBase::createSnapshotImpl(
   primitiveAcceptor.writeAllNodes();
   snap.endSection(HeapSnapshot::Section::Nodes);
 
+  if (snap.isCountOnly()) {
+    // The edges were counted along with their nodes, only the trace functions
+    // are left to count.
+    snap.emitAllocationTraceInfo();
+    return;
+  }
+
   snap.beginSection(HeapSnapshot::Section::Edges);
   rootScan();
   // No need to run the primitive scan again, as it only adds nodes, not edges.
@@ -616,12 +634,12 @@ void GCBase::createSnapshot(
   }
   // Chrome 125 requires correct node count and edge count in the "snapshot"
   // field, which is at the beginning of the heap snapshot. We do two passes to
-  // populate the correct node/edge count. First, we create a dummy HeapSnapshot
-  // instance with a no-op JSON emitter, and invoke createSnapshotImpl() with
-  // it. From that instance we can get the node count and edge count, and use
-  // them to create a HeapSnapShot instance in the second pass.
-  JSONEmitter dummyJSON{llvh::nulls()};
-  HeapSnapshot dummySnap{dummyJSON, 0, 0, 0, gcCallbacks_.getStackTracesTree()};
+  // populate the correct node/edge count. First, we create a HeapSnapshot that
+  // only counts, and invoke createSnapshotImpl() with it, which only walks the
+  // heap once and keeps no table. From that instance we can get the node count
+  // and edge count, and use them to create a HeapSnapShot instance in the
+  // second pass.
+  HeapSnapshot dummySnap{gcCallbacks_.getStackTracesTree()};
   // Array for saving the number of edges for each root section. We set the
   // value the first time we visit a root section, and make sure the same number
   // of edges are added in a single call of this function.
@@ -685,6 +703,14 @@ void GCBase::enableSamplingHeapProfiler(size_t samplingInterval, int64_t seed) {
 void GCBase::disableSamplingHeapProfiler(llvh::raw_ostream &os) {
   getSamplingAllocationTracker().disable(os);
 }
+
+void GCBase::writeSamplingHeapProfile(llvh::raw_ostream &os) {
+  getSamplingAllocationTracker().writeProfile(os);
+}
+
+void GCBase::writeSamplingHeapProfileSites(llvh::raw_ostream &os) {
+  getSamplingAllocationTracker().writeSites(os);
+}
 #endif // HERMES_MEMORY_INSTRUMENTATION
 
 void GCBase::checkTripwire(size_t dataSize) {
@@ -1539,11 +1565,23 @@ void GCBase::SamplingAllocationLocationTracker::enable(
     seed = std::random_device()();
   }
   randomEngine_.seed(seed);
-  dist_ = llvh::make_unique<std::poisson_distribution<>>(samplingInterval);
+  samplingInterval_ = std::max<size_t>(samplingInterval, 1);
+  dist_ = llvh::make_unique<std::exponential_distribution<>>(
+      1.0 / samplingInterval_);
   limit_ = nextSample();
 }
 
 void GCBase::SamplingAllocationLocationTracker::disable(llvh::raw_ostream &os) {
+  writeProfile(os);
+  std::lock_guard<Mutex> lk{mtx_};
+  dist_.reset();
+  samples_.clear();
+  freedSites_.clear();
+  limit_ = 0;
+}
+
+void GCBase::SamplingAllocationLocationTracker::writeProfile(
+    llvh::raw_ostream &os) {
   JSONEmitter json{os};
   ChromeSamplingMemoryProfile profile{json};
   std::lock_guard<Mutex> lk{mtx_};
@@ -1565,9 +1603,59 @@ void GCBase::SamplingAllocationLocationTracker::disable(llvh::raw_ostream &os) {
     profile.emitSample(sample.size, sample.node, sample.id);
   }
   profile.endSamples();
-  dist_.reset();
-  samples_.clear();
-  limit_ = 0;
+}
+
+void GCBase::SamplingAllocationLocationTracker::writeSites(
+    llvh::raw_ostream &os) {
+  const StringSetVector &strings =
+      *gc_->gcCallbacks_.getStackTracesTree()->getStringTable();
+  std::lock_guard<Mutex> lk{mtx_};
+  llvh::DenseMap<StackTracesTreeNode *, Site> sites{freedSites_};
+  for (const auto &s : samples_) {
+    const Sample &sample = s.second;
+    Site &site = sites[sample.node];
+    site.liveCount++;
+    site.liveBytes += sample.size;
+    site.estimatedLiveBytes += sample.size * sample.weight;
+  }
+
+  // Identify each site by its stack, from the outermost frame, which is the
+  // same from one build to the next as long as the code doesn't change.
+  std::vector<std::pair<std::string, const Site *>> lines;
+  lines.reserve(sites.size());
+  for (const auto &site : sites) {
+    llvh::SmallVector<const StackTracesTreeNode *, 16> frames;
+    for (const StackTracesTreeNode *node = site.first; node->parent;
+         node = node->parent) {
+      frames.push_back(node);
+    }
+    std::string stack;
+    llvh::raw_string_ostream stackOS{stack};
+    for (auto it = frames.rbegin(), e = frames.rend(); it != e; ++it) {
+      if (it != frames.rbegin())
+        stackOS << ';';
+      stackOS << strings[(*it)->name] << ' '
+              << strings[(*it)->sourceLoc.scriptName] << ':'
+              << (*it)->sourceLoc.lineNo << ':' << (*it)->sourceLoc.columnNo;
+    }
+    stackOS.flush();
+    lines.emplace_back(std::move(stack), &site.second);
+  }
+  std::sort(lines.begin(), lines.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  os << "# Sampling interval: " << samplingInterval_ << " bytes\n"
+     << "# live_bytes\tlive_count\tfreed_bytes\tfreed_count\t"
+     << "estimated_live_bytes\testimated_freed_bytes\tstack\n";
+  for (const auto &line : lines) {
+    const Site &site = *line.second;
+    os << site.liveBytes << '\t' << site.liveCount << '\t' << site.freedBytes
+       << '\t' << site.freedCount << '\t'
+       << (uint64_t)std::llround(site.estimatedLiveBytes) << '\t'
+       << (uint64_t)std::llround(site.estimatedFreedBytes) << '\t'
+       << line.first << '\n';
+  }
 }
 
 void GCBase::SamplingAllocationLocationTracker::newAlloc(
@@ -1587,10 +1675,14 @@ void GCBase::SamplingAllocationLocationTracker::newAlloc(
   const auto id = gc_->getObjectID(ptr);
   if (StackTracesTreeNode *node =
           gc_->gcCallbacks_.getCurrentStackTracesTreeNode(ip)) {
+    // An allocation of sz bytes is sampled with a probability of
+    // 1 - e^(-sz / samplingInterval_), so each sampled byte stands for the
+    // inverse of that.
+    double weight = -1 / std::expm1(-(double)sz / samplingInterval_);
     // Hold a lock while modifying samples_.
     std::lock_guard<Mutex> lk{mtx_};
     auto sampleItAndDidInsert =
-        samples_.try_emplace(id, Sample{sz, node, nextSampleID_++});
+        samples_.try_emplace(id, Sample{sz, node, nextSampleID_++, weight});
     assert(sampleItAndDidInsert.second && "Failed to create a sample");
     (void)sampleItAndDidInsert;
   }
@@ -1612,7 +1704,17 @@ void GCBase::SamplingAllocationLocationTracker::freeAlloc(
   const auto id = gc_->getObjectIDMustExist(ptr);
   // Hold a lock while modifying samples_.
   std::lock_guard<Mutex> lk{mtx_};
-  samples_.erase(id);
+  auto it = samples_.find(id);
+  if (it == samples_.end()) {
+    return;
+  }
+  // Remember the freed sample with its allocation site.
+  const Sample &sample = it->second;
+  Site &site = freedSites_[sample.node];
+  site.freedCount++;
+  site.freedBytes += sample.size;
+  site.estimatedFreedBytes += sample.size * sample.weight;
+  samples_.erase(it);
 }
 
 void GCBase::SamplingAllocationLocationTracker::updateSize(
@@ -1637,7 +1739,7 @@ void GCBase::SamplingAllocationLocationTracker::updateSize(
 }
 
 size_t GCBase::SamplingAllocationLocationTracker::nextSample() {
-  return (*dist_)(randomEngine_);
+  return static_cast<size_t>((*dist_)(randomEngine_));
 }
 #endif // HERMES_MEMORY_INSTRUMENTATION
 
@@ -1892,9 +1994,13 @@ void GCBase::sizeDiagnosticCensus(size_t allocatedBytes) {
     // We include ExternalStringPrimitives because we're including external
     // memory in the overall heap size. We do not include
     // BufferedStringPrimitives because they just store a pointer to an
-    // ExternalStringPrimitive (which is already tracked).
+    // ExternalStringPrimitive (which is already tracked), nor ropes and sliced
+    // strings, whose characters belong to the strings they refer to.
     auto *strprim = dyn_vmcast<StringPrimitive>(cell);
-    if (strprim && !isBufferedStringPrimitive(cell)) {
+    if (strprim && !isBufferedStringPrimitive(cell) &&
+        !isConcatStringPrimitive(cell) &&
+        !vmisa<SlicedASCIIStringPrimitive>(cell) &&
+        !vmisa<SlicedUTF16StringPrimitive>(cell)) {
       auto &stat = strprim->isASCII()
           ? acceptor.diagnostic.stats.breakdown["StringPrimitive (ASCII)"]
           : acceptor.diagnostic.stats.breakdown["StringPrimitive (UTF-16)"];
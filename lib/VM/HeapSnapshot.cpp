@@ -51,11 +51,29 @@ HeapSnapshot::HeapSnapshot(
       stringTable_(
           stackTracesTree ? stackTracesTree->getStringTable()
                           : std::make_shared<StringSetVector>()) {
+  // Nodes and edges are written as they are added, the indices of the nodes
+  // are the only thing kept for all of them. Reserve them upfront, rather than
+  // growing the map while the heap is being walked.
+  nodeToIndex_.reserve(nodeCount);
   json_.openDict();
   emitMeta(nodeCount, edgeCount, traceFunctionCount);
 }
 
+HeapSnapshot::HeapSnapshot(StackTracesTree *stackTracesTree)
+    : countOnly_(true),
+      nullJSON_(std::make_unique<JSONEmitter>(llvh::nulls())),
+      json_(*nullJSON_),
+      stackTracesTree_(stackTracesTree),
+      stringTable_(
+          stackTracesTree ? stackTracesTree->getStringTable()
+                          : std::make_shared<StringSetVector>()) {
+  // Sections are still opened and closed, as keys of the top level dict.
+  json_.openDict();
+}
+
 HeapSnapshot::~HeapSnapshot() {
+  if (countOnly_)
+    return;
   assert(edgeCount_ == expectedEdges_ && "Unexpected edges count");
   emitStrings();
   json_.closeDict(); // top level
@@ -79,6 +97,11 @@ void HeapSnapshot::beginSection(Section section) {
 
   json_.emitKey(kSectionLabels[i]);
   json_.openArray();
+  assert(
+      (!countOnly_ || section == Section::Nodes ||
+       section == Section::TraceFunctionInfos ||
+       section == Section::TraceTree) &&
+      "A snapshot that only counts doesn't need this section");
 
   nextSection_ = section;
   sectionOpened_ = true;
@@ -112,6 +135,11 @@ void HeapSnapshot::endNode(
     // If the edges are being emitted, ignore node output.
     return;
   }
+  if (countOnly_) {
+    nodeCount_++;
+    edgeCount_ += currEdgeCount_;
+    return;
+  }
   auto &nodeStats = traceNodeStats_[traceNodeID];
   nodeStats.count++;
   nodeStats.size += selfSize;
@@ -384,6 +412,8 @@ void HeapSnapshot::emitAllocationTraceInfo() {
   // Save the trace function count (which is essentially the number of nodes
   // on the tree with unique SourceLocs.
   traceFunctionCount_ = sourceLocToFuncIdxMap.size();
+  if (countOnly_)
+    return;
 
   beginSection(Section::TraceTree);
   nodeStack.push(stackTracesTree_->getRootNode());
@@ -120,6 +120,7 @@ void HiddenClassBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   mb.addField("parent", &self->parent_);
   mb.addField("propertyMap", &self->propertyMap_);
   mb.addField("forInCache", &self->forInCache_);
+  mb.addField("jsonCache", &self->jsonCache_);
 }
 
 void HiddenClass::_finalizeImpl(GCCell *cell, GC &gc) {
@@ -317,11 +317,8 @@ ExecutionStatus Interpreter::implCallBuiltin(
     uint32_t op3) {
   const Inst *ip = runtime.getCurrentIP();
   uint8_t methodIndex = ip->iCallBuiltin.op2;
-  Callable *callable = runtime.getBuiltinCallable(methodIndex);
-  assert(
-      isNativeBuiltin(methodIndex) &&
-      "CallBuiltin must take a native builtin.");
-  NativeFunction *nf = vmcast<NativeFunction>(callable);
+  NativeFunction *nf =
+      vmcast<NativeFunction>(runtime.getBuiltinCallable(methodIndex));
 
   auto newFrame = StackFramePtr::initFrame(
       runtime.stackPointer_, FRAME, ip, curCodeBlock, op3 - 1, nf, false);
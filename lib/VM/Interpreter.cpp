@@ -24,7 +24,6 @@
 #include "hermes/VM/JSRegExp.h"
 #include "hermes/VM/JSTypedArray.h"
 #include "hermes/VM/Operations.h"
-#include "hermes/VM/Profiler.h"
 #include "hermes/VM/Profiler/CodeCoverageProfiler.h"
 #include "hermes/VM/PropertyAccessor.h"
 #include "hermes/VM/RuntimeModule-inline.h"
@@ -53,9 +52,15 @@ HERMES_SLOW_STATISTIC(
 HERMES_SLOW_STATISTIC(
     NumGetByIdCacheHits,
     "NumGetByIdCacheHits: Number of property 'read by id' cache hits");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdPolyHits,
+    "NumGetByIdPolyHits: Number of property 'read by id' polymorphic cache hits");
 HERMES_SLOW_STATISTIC(
     NumGetByIdProtoHits,
     "NumGetByIdProtoHits: Number of property 'read by id' cache hits for the prototype");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdAccessorHits,
+    "NumGetByIdAccessorHits: Number of property 'read by id' cache hits for accessors");
 HERMES_SLOW_STATISTIC(
     NumGetByIdCacheEvicts,
     "NumGetByIdCacheEvicts: Number of property 'read by id' cache evictions");
@@ -87,6 +92,9 @@ HERMES_SLOW_STATISTIC(
 HERMES_SLOW_STATISTIC(
     NumPutByIdCacheHits,
     "NumPutByIdCacheHits: Number of property 'write by id' cache hits");
+HERMES_SLOW_STATISTIC(
+    NumPutByIdPolyHits,
+    "NumPutByIdPolyHits: Number of property 'write by id' polymorphic cache hits");
 HERMES_SLOW_STATISTIC(
     NumPutByIdCacheEvicts,
     "NumPutByIdCacheEvicts: Number of property 'write by id' cache evictions");
@@ -550,9 +558,30 @@ static Handle<HiddenClass> getHiddenClassForBuffer(
   return {clazz};
 }
 
+/// \return where the allocation site at \p ip in \p codeBlock allocates its
+/// next object. Without pretenuring, everything is allocated in the YG.
+static inline AllocationSites::Decision
+decideAllocation(Runtime &runtime, CodeBlock *codeBlock, const Inst *ip) {
+  AllocationSites *sites = runtime.getAllocationSites();
+  if (LLVM_LIKELY(!sites))
+    return {0, LongLived::No, false};
+  return sites->decide(codeBlock, codeBlock->getOffsetOf(ip));
+}
+
+/// Record \p cell as a sample of the lifetime of the objects of its
+/// allocation site, if \p decision asks for it.
+static inline void sampleAllocation(
+    Runtime &runtime,
+    const AllocationSites::Decision &decision,
+    GCCell *cell) {
+  if (LLVM_UNLIKELY(decision.sample))
+    runtime.getAllocationSites()->addSample(runtime, decision.site, cell);
+}
+
 CallResult<PseudoHandle<>> Interpreter::createObjectFromBuffer(
     Runtime &runtime,
     CodeBlock *curCodeBlock,
+    const Inst *ip,
     unsigned numLiterals,
     unsigned keyBufferIndex,
     unsigned valBufferIndex) {
@@ -561,7 +590,10 @@ CallResult<PseudoHandle<>> Interpreter::createObjectFromBuffer(
   // call it.
   auto clazz = getHiddenClassForBuffer(
       runtime, curCodeBlock, numLiterals, keyBufferIndex);
-  auto obj = runtime.makeHandle(JSObject::create(runtime, clazz));
+  const auto decision = decideAllocation(runtime, curCodeBlock, ip);
+  auto obj =
+      runtime.makeHandle(JSObject::create(runtime, clazz, decision.longLived));
+  sampleAllocation(runtime, decision, *obj);
 
   auto valGen =
       curCodeBlock->getObjectBufferValueIter(valBufferIndex, numLiterals);
@@ -624,15 +656,19 @@ CallResult<PseudoHandle<>> Interpreter::createObjectFromBuffer(
 CallResult<PseudoHandle<>> Interpreter::createArrayFromBuffer(
     Runtime &runtime,
     CodeBlock *curCodeBlock,
+    const Inst *ip,
     unsigned numElements,
     unsigned numLiterals,
     unsigned bufferIndex) {
   // Create a new array using the built-in constructor, and initialize
   // the elements from a literal array buffer.
-  auto arrRes = JSArray::create(runtime, numElements, numElements);
+  const auto decision = decideAllocation(runtime, curCodeBlock, ip);
+  auto arrRes =
+      JSArray::create(runtime, numElements, numElements, decision.longLived);
   if (arrRes == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
+  sampleAllocation(runtime, decision, **arrRes);
   // Resize the array storage in advance.
   auto arr = *arrRes;
   JSArray::setStorageEndIndex(arr, runtime, numElements);
@@ -804,11 +840,20 @@ CallResult<HermesValue> Runtime::interpretFunctionImpl(
 #endif
 
   InterpreterState state{newCodeBlock, 0};
-  if (HERMESVM_CRASH_TRACE &&
-      (getVMExperimentFlags() & experiments::CrashTrace)) {
-    return Interpreter::interpretFunction<false, true>(*this, state);
+  bool crashTrace = HERMESVM_CRASH_TRACE &&
+      (getVMExperimentFlags() & experiments::CrashTrace);
+  // The interpreter loop that doesn't report to the profiler only checks
+  // whether it was turned on when calling a JS function.
+  if (LLVM_UNLIKELY(interpreterProfiler_.isEnabled(
+          InterpreterProfiler::Opcodes | InterpreterProfiler::Functions))) {
+    return crashTrace
+        ? Interpreter::interpretFunction<false, true, true>(*this, state)
+        : Interpreter::interpretFunction<false, false, true>(*this, state);
+  }
+  if (crashTrace) {
+    return Interpreter::interpretFunction<false, true, false>(*this, state);
   } else {
-    return Interpreter::interpretFunction<false, false>(*this, state);
+    return Interpreter::interpretFunction<false, false, false>(*this, state);
   }
 }
 
@@ -823,14 +868,15 @@ CallResult<HermesValue> Runtime::interpretFunction(CodeBlock *newCodeBlock) {
 ExecutionStatus Runtime::stepFunction(InterpreterState &state) {
   if (HERMESVM_CRASH_TRACE &&
       (getVMExperimentFlags() & experiments::CrashTrace))
-    return Interpreter::interpretFunction<true, true>(*this, state).getStatus();
+    return Interpreter::interpretFunction<true, true, false>(*this, state)
+        .getStatus();
   else
-    return Interpreter::interpretFunction<true, false>(*this, state)
+    return Interpreter::interpretFunction<true, false, false>(*this, state)
         .getStatus();
 }
 #endif
 
-template <bool SingleStep, bool EnableCrashTrace>
+template <bool SingleStep, bool EnableCrashTrace, bool EnableProfiler>
 CallResult<HermesValue> Interpreter::interpretFunction(
     Runtime &runtime,
     InterpreterState &state) {
@@ -960,10 +1006,29 @@ CallResult<HermesValue> Interpreter::interpretFunction(
       gcScope.getHandleCountDbg() == KEEP_HANDLES &&
       "scope has unexpected number of handles");
 
-  INIT_OPCODE_PROFILER;
+  InterpreterProfiler &profiler = runtime.getInterpreterProfiler();
+  // Time spent outside of this activation of the interpreter is not spent
+  // in the opcode it executed last.
+  struct PauseOpcodeTimingOnExit {
+    InterpreterProfiler *profiler;
+    ~PauseOpcodeTimingOnExit() {
+      if (EnableProfiler)
+        profiler->pauseOpcodeTiming();
+    }
+  } pauseOpcodeTimingOnExit{&profiler};
 
 tailCall:
-  PROFILER_ENTER_FUNCTION(curCodeBlock);
+  if (!EnableProfiler && !SingleStep &&
+      LLVM_UNLIKELY(profiler.isEnabled(
+          InterpreterProfiler::Opcodes | InterpreterProfiler::Functions))) {
+    // A native function called from here turned the profiler on. Run the rest
+    // of this activation, starting with the call, in the instantiation that
+    // reports to it. It returns to native code where this one would have.
+    state.codeBlock = curCodeBlock;
+    state.offset = 0;
+    return interpretFunction<false, EnableCrashTrace, true>(runtime, state);
+  }
+
 
 #ifdef HERMES_ENABLE_DEBUGGER
   runtime.getDebugger().willEnterCodeBlock(curCodeBlock);
@@ -1034,11 +1099,15 @@ tailCall:
 
   assert((const uint8_t *)ip < curCodeBlock->end() && "CodeBlock is empty");
 
+  // Only record the call once the frame has been set up, since a stack
+  // overflow above returns to the caller without a matching exit.
+  if (EnableProfiler)
+    profiler.enterFunction(runtime, curCodeBlock);
+
   INIT_STATE_FOR_CODEBLOCK(curCodeBlock);
 
 #define BEFORE_OP_CODE                                                       \
   {                                                                          \
-    UPDATE_OPCODE_TIME_SPENT;                                                \
     HERMES_SLOW_ASSERT(                                                      \
         curCodeBlock->contains(ip) && "curCodeBlock must contain ip");       \
     HERMES_SLOW_ASSERT((printDebugInfo(curCodeBlock, frameRegs, ip), true)); \
@@ -1046,8 +1115,9 @@ tailCall:
         gcScope.getHandleCountDbg() == KEEP_HANDLES &&                       \
         "unaccounted handles were created");                                 \
     HERMES_SLOW_ASSERT(tmpHandle->isUndefined() && "tmpHandle not cleared"); \
-    RECORD_OPCODE_START_TIME;                                                \
-    INC_OPCODE_COUNT;                                                        \
+    if (EnableProfiler) {                                                    \
+      profiler.recordOpcode(ip->opCode);                                     \
+    }                                                                        \
     if (EnableCrashTrace) {                                                  \
       runtime.crashTrace_.recordInst(                                        \
           (uint32_t)((const uint8_t *)ip - bytecodeFileStart), ip->opCode);  \
@@ -1404,6 +1474,31 @@ tailCall:
       NEXTINST(JNot##name##Long),       \
       IPADD(ip->iJNot##name##Long.op1));
 
+/// Execute the second instruction of a superinstruction, which ip now points
+/// to, if it takes its fast path. Otherwise it is left to be dispatched
+/// normally, which is also the case when it was replaced by a breakpoint, or
+/// when single stepping.
+#define FUSED_ADD                                         \
+  if (!SingleStep && ip->opCode == OpCode::Add &&         \
+      O2REG(Add).isNumber() && O3REG(Add).isNumber()) {   \
+    O1REG(Add) = HermesValue::encodeTrustedNumberValue(   \
+        O2REG(Add).getNumber() + O3REG(Add).getNumber()); \
+    ip = NEXTINST(Add);                                   \
+  }
+#define FUSED_INC                                                             \
+  if (!SingleStep && ip->opCode == OpCode::Inc && O2REG(Inc).isNumber()) {    \
+    O1REG(Inc) =                                                              \
+        HermesValue::encodeTrustedNumberValue(doInc(O2REG(Inc).getNumber())); \
+    ip = NEXTINST(Inc);                                                       \
+  }
+#define FUSED_JLESS                                          \
+  if (!SingleStep && ip->opCode == OpCode::JLess &&          \
+      O2REG(JLess).isNumber() && O3REG(JLess).isNumber()) {  \
+    ip = O2REG(JLess).getNumber() < O3REG(JLess).getNumber() \
+        ? IPADD(ip->iJLess.op1)                              \
+        : NEXTINST(JLess);                                   \
+  }
+
 /// Load a constant.
 /// \param value is the value to store in the output register.
 #define LOAD_CONST(name, value) \
@@ -1426,6 +1521,13 @@ tailCall:
         DISPATCH;
       }
 
+      CASE(MovJLess) {
+        O1REG(Mov) = O2REG(Mov);
+        ip = NEXTINST(Mov);
+        FUSED_JLESS;
+        DISPATCH;
+      }
+
       CASE(MovLong) {
         O1REG(MovLong) = O2REG(MovLong);
         ip = NEXTINST(MovLong);
@@ -1777,7 +1879,9 @@ tailCall:
         }
 #endif
 
-        PROFILER_EXIT_FUNCTION(curCodeBlock);
+        if (EnableProfiler) {
+          profiler.exitFunction(curCodeBlock);
+        }
 
 #ifdef HERMES_MEMORY_INSTRUMENTATION
         runtime.popCallStack();
@@ -2230,10 +2334,21 @@ tailCall:
               gcScope.getHandleCountDbg() == KEEP_HANDLES &&
               "unaccounted handles were created");
           auto objHandle = runtime.makeHandle(obj);
-          auto cacheHCPtr = vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
-              cacheEntry->clazz.get(runtime, runtime.getHeap())));
+          // A hit in any of the polymorphic entries or in the prototype
+          // chain entry counts as a hit.
+          auto cacheHCPtr = cacheEntry->contains(obj->getClassGCPtr()) ||
+                  cacheEntry->hasProtoEntry(obj->getClassGCPtr())
+              ? obj->getClass(runtime)
+              : vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
+                    cacheEntry->clazz.get(runtime, runtime.getHeap())));
           CAPTURE_IP(runtime.recordHiddenClass(
-              curCodeBlock, ip, ID(idVal), obj->getClass(runtime), cacheHCPtr));
+              curCodeBlock,
+              ip,
+              ID(idVal),
+              obj->getClass(runtime),
+              cacheHCPtr,
+              cacheEntry->isPolymorphic(),
+              cacheEntry->megamorphic));
           // obj may be moved by GC due to recordHiddenClass
           obj = objHandle.get();
         }
@@ -2259,6 +2374,51 @@ tailCall:
           ip = nextIP;
           DISPATCH;
         }
+        // Otherwise, check the remaining polymorphic entries.
+        if (const SlotIndex *polySlot = cacheEntry->findPoly(clazzPtr)) {
+          ++NumGetByIdPolyHits;
+          CAPTURE_IP(
+              O1REG(GetById) =
+                  JSObject::getNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+                      obj, runtime, *polySlot)
+                      .unboxToHV(runtime));
+          ip = nextIP;
+          DISPATCH;
+        }
+        // Then check whether the property was cached on the prototype chain
+        // of objects with this class, or as an accessor.
+        if (cacheEntry->hasProtoEntry(clazzPtr)) {
+          if (JSObject *holder =
+                  JSObject::getCachedPropertyHolder(obj, runtime, *cacheEntry)) {
+            SmallHermesValue shv = JSObject::getNamedSlotValueUnsafe(
+                holder, runtime, cacheEntry->protoSlot);
+            if (LLVM_LIKELY(!cacheEntry->protoAccessor)) {
+              ++NumGetByIdProtoHits;
+              O1REG(GetById) = shv.unboxToHV(runtime);
+              ip = nextIP;
+              DISPATCH;
+            }
+            ++NumGetByIdAccessorHits;
+            auto *accessor = vmcast<PropertyAccessor>(shv.getPointer(runtime));
+            if (!accessor->getter) {
+              O1REG(GetById) = HermesValue::encodeUndefinedValue();
+              ip = nextIP;
+              DISPATCH;
+            }
+            CAPTURE_IP(
+                resPH = Callable::executeCall0(
+                    runtime.makeHandle(accessor->getter),
+                    runtime,
+                    Handle<>(&O2REG(GetById))));
+            if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION)) {
+              goto exception;
+            }
+            O1REG(GetById) = resPH->get();
+            gcScope.flushToSmallCount(KEEP_HANDLES);
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
         auto id = ID(idVal);
         NamedPropertyDescriptor desc;
         CAPTURE_IP_ASSIGN(
@@ -2276,14 +2436,13 @@ tailCall:
           if (LLVM_LIKELY(!clazz->isDictionaryNoCache()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
 #ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazzPtr)
+            if (cacheEntry->megamorphic)
               ++NumGetByIdCacheEvicts;
 #else
             (void)NumGetByIdCacheEvicts;
 #endif
             // Cache the class, id and property slot.
-            cacheEntry->clazz = clazzPtr;
-            cacheEntry->slot = desc.slot;
+            cacheEntry->update(clazzPtr, desc.slot);
           }
 
           assert(
@@ -2297,29 +2456,6 @@ tailCall:
           DISPATCH;
         }
 
-        // The cache may also be populated via the prototype of the object.
-        // This value is only reliable if the fast path was a definite
-        // not-found.
-        if (fastPathResult.hasValue() && !fastPathResult.getValue() &&
-            LLVM_LIKELY(!obj->isProxyObject())) {
-          CAPTURE_IP_ASSIGN(JSObject * parent, obj->getParent(runtime));
-          // TODO: This isLazy check is because a lazy object is reported as
-          // having no properties and therefore cannot contain the property.
-          // This check does not belong here, it should be merged into
-          // tryGetOwnNamedDescriptorFast().
-          if (parent && cacheEntry->clazz == parent->getClassGCPtr() &&
-              LLVM_LIKELY(!obj->isLazy())) {
-            ++NumGetByIdProtoHits;
-            // We've already checked that this isn't a Proxy.
-            CAPTURE_IP(
-                O1REG(GetById) = JSObject::getNamedSlotValueUnsafe(
-                                     parent, runtime, cacheEntry->slot)
-                                     .unboxToHV(runtime));
-            ip = nextIP;
-            DISPATCH;
-          }
-        }
-
 #ifdef HERMES_SLOW_DEBUG
         // Call to getNamedDescriptorUnsafe is safe because `id` is kept alive
         // by the IdentifierTable.
@@ -2421,10 +2557,19 @@ tailCall:
               "unaccounted handles were created");
           auto shvHandle = runtime.makeHandle(shv.toHV(runtime));
           auto objHandle = runtime.makeHandle(obj);
-          auto cacheHCPtr = vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
-              cacheEntry->clazz.get(runtime, runtime.getHeap())));
+          // A hit in any of the polymorphic entries counts as a hit.
+          auto cacheHCPtr = cacheEntry->contains(obj->getClassGCPtr())
+              ? obj->getClass(runtime)
+              : vmcast_or_null<HiddenClass>(static_cast<GCCell *>(
+                    cacheEntry->clazz.get(runtime, runtime.getHeap())));
           CAPTURE_IP(runtime.recordHiddenClass(
-              curCodeBlock, ip, ID(idVal), obj->getClass(runtime), cacheHCPtr));
+              curCodeBlock,
+              ip,
+              ID(idVal),
+              obj->getClass(runtime),
+              cacheHCPtr,
+              cacheEntry->isPolymorphic(),
+              cacheEntry->megamorphic));
           // shv/obj may be invalidated by recordHiddenClass
           if (shv.isPointer())
             shv.unsafeUpdatePointer(
@@ -2444,6 +2589,15 @@ tailCall:
           ip = nextIP;
           DISPATCH;
         }
+        // Otherwise, check the remaining polymorphic entries.
+        if (const SlotIndex *polySlot = cacheEntry->findPoly(clazzPtr)) {
+          ++NumPutByIdPolyHits;
+          CAPTURE_IP(
+              JSObject::setNamedSlotValueUnsafe<PropStorage::Inline::Yes>(
+                  obj, runtime, *polySlot, shv));
+          ip = nextIP;
+          DISPATCH;
+        }
         auto id = ID(idVal);
         NamedPropertyDescriptor desc;
         CAPTURE_IP_ASSIGN(
@@ -2461,14 +2615,13 @@ tailCall:
           if (LLVM_LIKELY(!clazz->isDictionary()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
 #ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazzPtr)
+            if (cacheEntry->megamorphic)
               ++NumPutByIdCacheEvicts;
 #else
             (void)NumPutByIdCacheEvicts;
 #endif
             // Cache the class and property slot.
-            cacheEntry->clazz = clazzPtr;
-            cacheEntry->slot = desc.slot;
+            cacheEntry->update(clazzPtr, desc.slot);
           }
 
           // This must be valid because an own property was already found.
@@ -2510,6 +2663,25 @@ tailCall:
       DISPATCH;
     }
 
+      CASE(GetByValAdd) {
+        // Other cases fall through to GetByVal, without fusing the Add.
+        if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
+          CAPTURE_IP(
+              resPH = JSObject::getComputed_RJS(
+                  Handle<JSObject>::vmcast(&O2REG(GetByVal)),
+                  runtime,
+                  Handle<>(&O3REG(GetByVal))));
+          if (LLVM_UNLIKELY(resPH == ExecutionStatus::EXCEPTION)) {
+            goto exception;
+          }
+          gcScope.flushToSmallCount(KEEP_HANDLES);
+          O1REG(GetByVal) = resPH->get();
+          ip = NEXTINST(GetByVal);
+          FUSED_ADD;
+          DISPATCH;
+        }
+        INTERPRETER_FALLTHROUGH;
+      }
       CASE(GetByVal) {
         if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
           CAPTURE_IP(
@@ -2762,8 +2934,28 @@ tailCall:
           ip = NEXTINST(JmpUndefinedLong);
         DISPATCH;
       }
+      CASE(IncJLess) {
+        if (LLVM_LIKELY(O2REG(Inc).isNumber())) {
+          O1REG(Inc) = HermesValue::encodeTrustedNumberValue(
+              doInc(O2REG(Inc).getNumber()));
+          ip = NEXTINST(Inc);
+          FUSED_JLESS;
+          DISPATCH;
+        }
+        INTERPRETER_FALLTHROUGH;
+      }
       INCDECOP(Inc)
       INCDECOP(Dec)
+      CASE(AddInc) {
+        if (LLVM_LIKELY(O2REG(Add).isNumber() && O3REG(Add).isNumber())) {
+          O1REG(Add) = HermesValue::encodeTrustedNumberValue(
+              O2REG(Add).getNumber() + O3REG(Add).getNumber());
+          ip = NEXTINST(Add);
+          FUSED_INC;
+          DISPATCH;
+        }
+        INTERPRETER_FALLTHROUGH;
+      }
       CASE(Add) {
         if (LLVM_LIKELY(
                 O2REG(Add).isNumber() &&
@@ -2889,8 +3081,20 @@ tailCall:
         // Create a new object using the built-in constructor. Note that the
         // built-in constructor is empty, so we don't actually need to call
         // it.
-        CAPTURE_IP(
-            O1REG(NewObject) = JSObject::create(runtime).getHermesValue());
+        {
+          const auto decision = decideAllocation(runtime, curCodeBlock, ip);
+          CAPTURE_IP(
+              O1REG(NewObject) =
+                  JSObject::create(
+                      runtime,
+                      Handle<JSObject>::vmcast(&runtime.objectPrototype),
+                      decision.longLived)
+                      .getHermesValue());
+          sampleAllocation(
+              runtime,
+              decision,
+              static_cast<GCCell *>(O1REG(NewObject).getObject()));
+        }
         assert(
             gcScope.getHandleCountDbg() == KEEP_HANDLES &&
             "Should not create handles.");
@@ -2920,6 +3124,7 @@ tailCall:
             resPH = Interpreter::createObjectFromBuffer(
                 runtime,
                 curCodeBlock,
+                ip,
                 ip->iNewObjectWithBuffer.op3,
                 ip->iNewObjectWithBuffer.op4,
                 ip->iNewObjectWithBuffer.op5));
@@ -2937,6 +3142,7 @@ tailCall:
             resPH = Interpreter::createObjectFromBuffer(
                 runtime,
                 curCodeBlock,
+                ip,
                 ip->iNewObjectWithBufferLong.op3,
                 ip->iNewObjectWithBufferLong.op4,
                 ip->iNewObjectWithBufferLong.op5));
@@ -2954,12 +3160,18 @@ tailCall:
         // built-in constructor is empty, so we don't actually need to call
         // it.
         {
+          const auto decision = decideAllocation(runtime, curCodeBlock, ip);
           CAPTURE_IP_ASSIGN(
               auto createRes,
-              JSArray::create(runtime, ip->iNewArray.op2, ip->iNewArray.op2));
+              JSArray::create(
+                  runtime,
+                  ip->iNewArray.op2,
+                  ip->iNewArray.op2,
+                  decision.longLived));
           if (createRes == ExecutionStatus::EXCEPTION) {
             goto exception;
           }
+          sampleAllocation(runtime, decision, **createRes);
           O1REG(NewArray) = createRes->getHermesValue();
         }
         gcScope.flushToSmallCount(KEEP_HANDLES);
@@ -2972,6 +3184,7 @@ tailCall:
             resPH = Interpreter::createArrayFromBuffer(
                 runtime,
                 curCodeBlock,
+                ip,
                 ip->iNewArrayWithBuffer.op2,
                 ip->iNewArrayWithBuffer.op3,
                 ip->iNewArrayWithBuffer.op4));
@@ -2990,6 +3203,7 @@ tailCall:
             resPH = Interpreter::createArrayFromBuffer(
                 runtime,
                 curCodeBlock,
+                ip,
                 ip->iNewArrayWithBufferLong.op2,
                 ip->iNewArrayWithBufferLong.op3,
                 ip->iNewArrayWithBufferLong.op4));
@@ -3614,7 +3828,6 @@ tailCall:
 
   // Handle the exception.
   exception:
-    UPDATE_OPCODE_TIME_SPENT;
     assert(
         !runtime.thrownValue_.isEmpty() &&
         "thrownValue unavailable at exception");
@@ -3689,7 +3902,9 @@ tailCall:
     while (((handlerOffset = curCodeBlock->findCatchTargetOffset(CUROFFSET)) ==
             -1) ||
            !catchable) {
-      PROFILER_EXIT_FUNCTION(curCodeBlock);
+      if (EnableProfiler) {
+        profiler.exitFunction(curCodeBlock);
+      }
 
 #ifdef HERMES_MEMORY_INSTRUMENTATION
       runtime.popCallStack();
@@ -543,17 +543,29 @@ CallResult<Handle<JSArray>> JSArray::createNoAllocPropStorage(
     Handle<JSObject> prototypeHandle,
     Handle<HiddenClass> classHandle,
     size_type capacity,
-    size_type length) {
+    size_type length,
+    LongLived longLived) {
   assert(length <= capacity && "length must be <= capacity");
 
   assert(
       classHandle->getNumProperties() >= jsArrayPropertyCount() &&
       "invalid number of properties in JSArray hidden class");
 
+  // An array in the old generation needs write barriers, since its parent may
+  // be in the young generation.
   auto self = JSObjectInit::initToHandle(
       runtime,
-      runtime.makeAFixed<JSArray>(
-          runtime, prototypeHandle, classHandle, GCPointerBase::NoBarriers()));
+      LLVM_UNLIKELY(longLived == LongLived::Yes)
+          ? runtime.makeAFixed<JSArray, HasFinalizer::No, LongLived::Yes>(
+                runtime,
+                prototypeHandle,
+                classHandle,
+                GCPointerBase::YesBarriers())
+          : runtime.makeAFixed<JSArray>(
+                runtime,
+                prototypeHandle,
+                classHandle,
+                GCPointerBase::NoBarriers()));
 
   // Only allocate the storage if capacity is not zero.
   if (capacity) {
@@ -592,14 +604,18 @@ CallResult<Handle<JSArray>> JSArray::createAndAllocPropStorage(
   return arr;
 }
 
-CallResult<Handle<JSArray>>
-JSArray::create(Runtime &runtime, size_type capacity, size_type length) {
+CallResult<Handle<JSArray>> JSArray::create(
+    Runtime &runtime,
+    size_type capacity,
+    size_type length,
+    LongLived longLived) {
   return JSArray::createNoAllocPropStorage(
       runtime,
       Handle<JSObject>::vmcast(&runtime.arrayPrototype),
       Handle<HiddenClass>::vmcast(&runtime.arrayClass),
       capacity,
-      length);
+      length,
+      longLived);
 }
 
 CallResult<bool> JSArray::setLength(
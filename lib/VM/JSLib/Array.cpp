@@ -13,6 +13,7 @@
 #include "JSLibInternal.h"
 
 #include "hermes/ADT/SafeInt.h"
+#include "hermes/Support/Conversions.h"
 #include "hermes/VM/HandleRootOwner-inline.h"
 #include "hermes/VM/JSLib/Sorting.h"
 #include "hermes/VM/Operations.h"
@@ -21,6 +22,10 @@
 #include "hermes/VM/StringView.h"
 
 #include "llvh/ADT/ScopeExit.h"
+
+#include <cmath>
+#include <cstring>
+
 #pragma GCC diagnostic push
 
 #ifdef HERMES_COMPILER_SUPPORTS_WSHORTEN_64_TO_32
@@ -1051,7 +1056,7 @@ namespace {
 /// handles every time we want to compare different elements.
 /// Usage example:
 ///   StandardSortModel sm{runtime, obj, compareFn};
-///   quickSort(sm, 0, length);
+///   timSort(sm, 0, length);
 /// Note that this is generic and does nothing different if passed a JSArray.
 class StandardSortModel : public SortModel {
  private:
@@ -1425,7 +1430,7 @@ CallResult<HermesValue> sortSparse(
   {
     StandardSortModel sm(runtime, array, compareFn);
     if (LLVM_UNLIKELY(
-            quickSort(&sm, 0u, numProps) == ExecutionStatus::EXCEPTION))
+            timSort(&sm, 0u, numProps) == ExecutionStatus::EXCEPTION))
       return ExecutionStatus::EXCEPTION;
   }
 
@@ -1450,6 +1455,241 @@ CallResult<HermesValue> sortSparse(
 
   return O.getHermesValue();
 }
+
+/// \return the number of decimal digits in \p v.
+unsigned numDecimalDigits(uint32_t v) {
+  unsigned digits = 1;
+  for (; v >= 10; v /= 10)
+    ++digits;
+  return digits;
+}
+
+/// Compare the decimal representations of \p a and \p b as strings.
+/// \return negative, zero or positive like strcmp().
+int compareDecimalDigits(uint32_t a, uint32_t b) {
+  unsigned aDigits = numDecimalDigits(a);
+  unsigned bDigits = numDecimalDigits(b);
+  // Pad the shorter number with zeros on the right so that both have the
+  // same number of digits, and compare them numerically. If they are equal,
+  // the shorter one is a prefix of the longer one.
+  uint64_t aScaled = a;
+  uint64_t bScaled = b;
+  for (unsigned i = aDigits; i < bDigits; ++i)
+    aScaled *= 10;
+  for (unsigned i = bDigits; i < aDigits; ++i)
+    bScaled *= 10;
+  if (aScaled != bScaled)
+    return aScaled < bScaled ? -1 : 1;
+  return (int)aDigits - (int)bDigits;
+}
+
+/// Compare \p a and \p b as if they were converted to strings, which is the
+/// default sort order, without allocating the strings.
+/// \return negative, zero or positive like strcmp().
+int compareNumbersAsStrings(double a, double b) {
+  // Integers up to 2^32 in magnitude are compared digit by digit. Note that
+  // -0 is converted to "0".
+  if (std::fabs(a) <= UINT32_MAX && std::fabs(b) <= UINT32_MAX &&
+      std::trunc(a) == a && std::trunc(b) == b) {
+    bool aNegative = a < 0;
+    bool bNegative = b < 0;
+    // '-' is ordered before all the digits.
+    if (aNegative != bNegative)
+      return aNegative ? -1 : 1;
+    return compareDecimalDigits(
+        (uint32_t)std::fabs(a), (uint32_t)std::fabs(b));
+  }
+
+  char aBuf[NUMBER_TO_STRING_BUF_SIZE];
+  char bBuf[NUMBER_TO_STRING_BUF_SIZE];
+  numberToString(a, aBuf, sizeof(aBuf));
+  numberToString(b, bBuf, sizeof(bBuf));
+  return std::strcmp(aBuf, bBuf);
+}
+
+/// Sort the elements [0, len) of the dense array \p arr, without invoking
+/// [[Get]] and [[Put]] for every comparison and swap. As in
+/// SortIndexedProperties (ES2023 23.1.3.30.1), the values are copied out,
+/// sorted, and written back, with all the undefined values at the end.
+/// Numbers sorted with the default order are compared without converting
+/// them to strings, and strings are converted only once.
+/// \return false, without any observable side effects, if \p arr has holes,
+///   can't be written directly, or contains values whose conversion to string
+///   could be observable, in which case the generic path must be used.
+CallResult<bool> sortDenseArray(
+    Runtime &runtime,
+    Handle<JSArray> arr,
+    Handle<Callable> compareFn,
+    uint64_t len) {
+  if (!arr->isExtensible() || !arr->hasFastIndexProperties() ||
+      arr->getBeginIndex() != 0 || len > arr->getEndIndex()) {
+    return false;
+  }
+
+  uint32_t numUndefined = 0;
+  bool allNumbers = true;
+  for (uint32_t i = 0; i != len; ++i) {
+    SmallHermesValue shv = arr->at(runtime, i);
+    if (shv.isEmpty())
+      return false;
+    if (shv.isUndefined()) {
+      ++numUndefined;
+    } else if (!shv.isNumber()) {
+      allNumbers = false;
+      if (!compareFn && !shv.isString())
+        return false;
+    }
+  }
+  const uint32_t count = len - numUndefined;
+
+  if (!compareFn && allNumbers) {
+    // Nothing in here can allocate or run JS, so the values can be sorted
+    // and written back directly.
+    NoAllocScope noAlloc{runtime};
+    struct NumberElement {
+      double num;
+      uint32_t index;
+    };
+    std::vector<NumberElement> elements;
+    elements.reserve(count);
+    for (uint32_t i = 0; i != len; ++i) {
+      SmallHermesValue shv = arr->at(runtime, i);
+      if (!shv.isUndefined())
+        elements.push_back({shv.getNumber(runtime), i});
+    }
+    auto less = [](const NumberElement &a,
+                   const NumberElement &b) -> CallResult<bool> {
+      return compareNumbersAsStrings(a.num, b.num) < 0;
+    };
+    (void)timSort(llvh::MutableArrayRef<NumberElement>(elements), less);
+    // Collect the values before overwriting them, which preserves their
+    // encoding.
+    JSArray *self = *arr;
+    std::vector<SmallHermesValue> sorted;
+    sorted.reserve(count);
+    for (const NumberElement &elem : elements)
+      sorted.push_back(self->at(runtime, elem.index));
+    for (uint32_t i = 0; i != count; ++i)
+      JSArray::unsafeSetExistingElementAt(self, runtime, i, sorted[i]);
+    for (uint32_t i = count; i != len; ++i)
+      JSArray::unsafeSetExistingElementAt(
+          self, runtime, i, SmallHermesValue::encodeUndefinedValue());
+    return true;
+  }
+
+  GCScope gcScope{runtime};
+
+  // Copy the values into an array that is never exposed to JS, so the
+  // comparator can't affect them.
+  auto crValues = JSArray::create(runtime, count, count);
+  if (LLVM_UNLIKELY(crValues == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<JSArray> values = *crValues;
+  if (LLVM_UNLIKELY(
+          JSArray::setStorageEndIndex(values, runtime, count) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  for (uint32_t i = 0, j = 0; i != len; ++i) {
+    SmallHermesValue shv = arr->at(runtime, i);
+    if (!shv.isUndefined())
+      JSArray::unsafeSetExistingElementAt(*values, runtime, j++, shv);
+  }
+
+  // Sort the indices of the values.
+  std::vector<uint32_t> order(count);
+  for (uint32_t i = 0; i != count; ++i)
+    order[i] = i;
+
+  if (compareFn) {
+    auto less = [&runtime, compareFn, values](
+                    uint32_t a, uint32_t b) -> CallResult<bool> {
+      GCScopeMarkerRAII marker{runtime};
+      auto callRes = Callable::executeCall2(
+          compareFn,
+          runtime,
+          Runtime::getUndefinedValue(),
+          values->at(runtime, a).unboxToHV(runtime),
+          values->at(runtime, b).unboxToHV(runtime));
+      if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      auto numRes =
+          toNumber_RJS(runtime, runtime.makeHandle(std::move(*callRes)));
+      if (LLVM_UNLIKELY(numRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      // NaN is treated as equal.
+      return numRes->getNumber() < 0;
+    };
+    if (LLVM_UNLIKELY(
+            timSort(llvh::MutableArrayRef<uint32_t>(order), less) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  } else {
+    // Convert every value to a string once.
+    auto crKeys = JSArray::create(runtime, count, count);
+    if (LLVM_UNLIKELY(crKeys == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    Handle<JSArray> keys = *crKeys;
+    if (LLVM_UNLIKELY(
+            JSArray::setStorageEndIndex(keys, runtime, count) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    MutableHandle<> value{runtime};
+    GCScopeMarkerRAII marker{runtime};
+    for (uint32_t i = 0; i != count; ++i) {
+      marker.flush();
+      value = values->at(runtime, i).unboxToHV(runtime);
+      auto strRes = toString_RJS(runtime, value);
+      if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      JSArray::unsafeSetExistingElementAt(
+          *keys,
+          runtime,
+          i,
+          SmallHermesValue::encodeStringValue(strRes->get(), runtime));
+    }
+    auto less = [&runtime, keys](uint32_t a, uint32_t b) -> CallResult<bool> {
+      return keys->at(runtime, a).getString(runtime)->compare(
+                 keys->at(runtime, b).getString(runtime)) < 0;
+    };
+    (void)timSort(llvh::MutableArrayRef<uint32_t>(order), less);
+  }
+
+  // Write the values back. The comparator may have modified the array, in
+  // which case we switch to [[Set]] for the remaining elements.
+  MutableHandle<> indexHandle{runtime};
+  MutableHandle<> valueHandle{runtime};
+  GCScopeMarkerRAII marker{runtime};
+  bool direct = true;
+  for (uint32_t i = 0; i != len; ++i) {
+    const SmallHermesValue shv = i < count
+        ? values->at(runtime, order[i])
+        : SmallHermesValue::encodeUndefinedValue();
+    direct = direct && arr->isExtensible() && arr->hasFastIndexProperties() &&
+        arr->getBeginIndex() == 0 && i < arr->getEndIndex() &&
+        !arr->at(runtime, i).isEmpty();
+    if (direct) {
+      JSArray::unsafeSetExistingElementAt(*arr, runtime, i, shv);
+      continue;
+    }
+    marker.flush();
+    indexHandle = HermesValue::encodeTrustedNumberValue(i);
+    valueHandle = shv.unboxToHV(runtime);
+    if (LLVM_UNLIKELY(
+            JSObject::putComputed_RJS(
+                arr,
+                runtime,
+                indexHandle,
+                valueHandle,
+                PropOpFlags().plusThrowOnError()) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return true;
+}
 } // anonymous namespace
 
 /// ES5.1 15.4.4.11.
@@ -1484,13 +1724,23 @@ arrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
   if (!O->isProxyObject() && !O->isHostObject() && !O->hasFastIndexProperties())
     return sortSparse(runtime, O, compareFn, len);
 
+  // Dense arrays without holes can be sorted without going through [[Get]] and
+  // [[Put]] for every element access.
+  if (auto arr = Handle<JSArray>::dyn_vmcast(O)) {
+    auto sortRes = sortDenseArray(runtime, arr, compareFn, len);
+    if (LLVM_UNLIKELY(sortRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*sortRes)
+      return O.getHermesValue();
+  }
+
   // This is the "fast" path. We are sorting an array with indexed storage.
   StandardSortModel sm(runtime, O, compareFn);
 
   // Use our custom sort routine. We can't use std::sort because it performs
   // optimizations that allow it to bypass calls to std::swap, but our swap
   // function is special, since it needs to use the internal Object functions.
-  if (LLVM_UNLIKELY(quickSort(&sm, 0u, len) == ExecutionStatus::EXCEPTION))
+  if (LLVM_UNLIKELY(timSort(&sm, 0u, len) == ExecutionStatus::EXCEPTION))
     return ExecutionStatus::EXCEPTION;
 
   return O.getHermesValue();
@@ -528,6 +528,11 @@ void initGlobalObject(Runtime &runtime, const JSLibFlags &jsLibFlags) {
     runtime.weakRefPrototype = JSObject::create(runtime).getHermesValue();
   }
 
+  if (LLVM_LIKELY(runtime.hasES6Promise())) {
+    // "Forward declaration" of Promise.prototype.
+    runtime.promisePrototype = JSObject::create(runtime).getHermesValue();
+  }
+
   // "Forward declaration" of %ArrayIteratorPrototype%.
   runtime.arrayIteratorPrototype =
       JSObject::create(
@@ -649,6 +654,12 @@ void initGlobalObject(Runtime &runtime, const JSLibFlags &jsLibFlags) {
     createWeakRefConstructor(runtime);
   }
 
+  if (LLVM_LIKELY(runtime.hasES6Promise())) {
+    // Promise constructor.
+    runtime.promiseConstructor =
+        createPromiseConstructor(runtime).getHermesValue();
+  }
+
   // Symbol constructor.
   createSymbolConstructor(runtime);
 
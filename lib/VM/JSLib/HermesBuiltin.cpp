@@ -13,7 +13,9 @@
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/JSArray.h"
 #include "hermes/VM/JSArrayBuffer.h"
+#include "hermes/VM/JSGenerator.h"
 #include "hermes/VM/JSLib.h"
+#include "hermes/VM/JSPromise.h"
 #include "hermes/VM/JSRegExp.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/PrimitiveBox.h"
@@ -845,6 +847,207 @@ CallResult<HermesValue> hermesBuiltinGetOriginalNativeErrorConstructor(
   }
 }
 
+namespace {
+
+/// Await \p value in the async function driven by \p gen, whose promise is
+/// \p promise: queue a job resuming \p gen once \p value settles. A native
+/// promise created by %Promise% (\p isNativePromise) is awaited directly,
+/// without wrapping it in another promise.
+ExecutionStatus asyncFunctionAwait(
+    Runtime &runtime,
+    Handle<GeneratorInnerFunction> gen,
+    Handle<JSPromise> promise,
+    Handle<> value,
+    bool isNativePromise) {
+  Handle<NativeFunction> reaction = JSPromise::createReactionRecord(
+      runtime, hermesBuiltinAsyncFunctionResume);
+  NativeFunction::setAdditionalSlotValue(
+      *reaction,
+      runtime,
+      JSPromise::OnFulfilled,
+      SmallHermesValue::encodeObjectValue(*gen, runtime));
+  NativeFunction::setAdditionalSlotValue(
+      *reaction,
+      runtime,
+      JSPromise::Capability,
+      SmallHermesValue::encodeObjectValue(*promise, runtime));
+
+  if (isNativePromise) {
+    return JSPromise::addReaction(
+        Handle<JSPromise>::vmcast(value), runtime, reaction);
+  }
+  if (!value->isObject()) {
+    // A primitive is the result of the await as is, one job later.
+    auto shv = SmallHermesValue::encodeHermesValue(*value, runtime);
+    NativeFunction::setAdditionalSlotValue(
+        *reaction, runtime, JSPromise::Settled, shv);
+    return JSPromise::enqueueReaction(runtime, reaction);
+  }
+  auto awaited = runtime.makeHandle(JSPromise::create(runtime));
+  if (LLVM_UNLIKELY(
+          JSPromise::resolve(awaited, runtime, value) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return JSPromise::addReaction(awaited, runtime, reaction);
+}
+
+/// Resume the generator \p gen compiled from the body of an async function
+/// with \p value, and run it until it awaits or completes. \p action is Next
+/// for the result of an await, and Throw for its rejection. The completion of
+/// the generator settles \p promise, the promise of the async function.
+ExecutionStatus asyncFunctionStep(
+    Runtime &runtime,
+    Handle<GeneratorInnerFunction> gen,
+    Handle<JSPromise> promise,
+    Handle<> value,
+    GeneratorInnerFunction::Action action) {
+  GCScope gcScope{runtime};
+  MutableHandle<> arg{runtime, *value};
+  auto marker = gcScope.createMarker();
+  for (;;) {
+    gcScope.flushToMarker(marker);
+    auto valueRes =
+        GeneratorInnerFunction::callInnerFunction(gen, runtime, arg, action);
+    if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+      gen->setState(GeneratorInnerFunction::State::Completed);
+      if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+        return ExecutionStatus::EXCEPTION;
+      Handle<> reason = runtime.makeHandle(runtime.getThrownValue());
+      runtime.clearThrownValue();
+      return JSPromise::reject(promise, runtime, reason);
+    }
+    Handle<> result = runtime.makeHandle(std::move(*valueRes));
+    if (gen->getState() == GeneratorInnerFunction::State::Completed)
+      return JSPromise::resolve(promise, runtime, result);
+
+    // Await uses PromiseResolve(%Promise%, result), which returns a native
+    // promise as is if its constructor is %Promise%. An exception thrown while
+    // checking that is thrown at the await.
+    bool isNativePromise = false;
+    if (vmisa<JSPromise>(*result)) {
+      auto ctorRes = JSObject::getNamed_RJS(
+          Handle<JSObject>::vmcast(result),
+          runtime,
+          Predefined::getSymbolID(Predefined::constructor));
+      if (LLVM_UNLIKELY(ctorRes == ExecutionStatus::EXCEPTION)) {
+        if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+          return ExecutionStatus::EXCEPTION;
+        arg = runtime.getThrownValue();
+        runtime.clearThrownValue();
+        action = GeneratorInnerFunction::Action::Throw;
+        continue;
+      }
+      isNativePromise = ctorRes->get().isObject() &&
+          ctorRes->get().getObject() ==
+              runtime.promiseConstructor.getObject();
+    }
+    return asyncFunctionAwait(runtime, gen, promise, result, isNativePromise);
+  }
+}
+
+} // namespace
+
+/// \code
+///   HermesBuiltin.spawnAsync = function (genFunc, thisArg, args) {}
+/// \endcode
+/// Call \p genFunc, the generator function compiled from the body of an async
+/// function, with \p thisArg and the arguments in \p args. The generator runs
+/// until its first await.
+/// \return the promise of the async function.
+CallResult<HermesValue>
+hermesBuiltinSpawnAsync(void *, Runtime &runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  if (LLVM_UNLIKELY(!runtime.hasES6Promise())) {
+    return runtime.raiseError(
+        "async function cannot be used with Promise disabled.");
+  }
+  auto genFunc = args.dyncastArg<Callable>(0);
+  auto argList = args.dyncastArg<JSObject>(2);
+  if (LLVM_UNLIKELY(!genFunc || !argList)) {
+    return runtime.raiseTypeError(
+        "spawnAsync requires a generator function and an argument list");
+  }
+
+  auto promise = runtime.makeHandle(JSPromise::create(runtime));
+  auto genRes = Callable::executeCall(
+      genFunc,
+      runtime,
+      Runtime::getUndefinedValue(),
+      args.getArgHandle(1),
+      argList);
+  if (LLVM_UNLIKELY(genRes == ExecutionStatus::EXCEPTION)) {
+    if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+      return ExecutionStatus::EXCEPTION;
+    Handle<> reason = runtime.makeHandle(runtime.getThrownValue());
+    runtime.clearThrownValue();
+    if (LLVM_UNLIKELY(
+            JSPromise::reject(promise, runtime, reason) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return promise.getHermesValue();
+  }
+  auto *gen = dyn_vmcast<JSGenerator>(genRes->get());
+  if (LLVM_UNLIKELY(!gen)) {
+    return runtime.raiseTypeError(
+        "spawnAsync requires a generator function and an argument list");
+  }
+
+  if (LLVM_UNLIKELY(
+          asyncFunctionStep(
+              runtime,
+              runtime.makeHandle(JSGenerator::getInnerFunction(runtime, gen)),
+              promise,
+              Runtime::getUndefinedValue(),
+              GeneratorInnerFunction::Action::Next) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return promise.getHermesValue();
+}
+
+/// The job resuming an async function when the value it awaits settles. It is
+/// a reaction record whose OnFulfilled slot holds the generator, and whose
+/// Capability slot holds the promise of the async function.
+CallResult<HermesValue>
+hermesBuiltinAsyncFunctionResume(void *, Runtime &runtime, NativeArgs) {
+  GCScope gcScope{runtime};
+  auto reaction = Handle<NativeFunction>::vmcast(
+      runtime.getCurrentFrame()->getCalleeClosureHandleUnsafe());
+  // A host could run a job queued with setImmediate more than once.
+  HermesValue promiseHV =
+      NativeFunction::getAdditionalSlotValue(
+          *reaction, runtime, JSPromise::Capability)
+          .unboxToHV(runtime);
+  if (LLVM_UNLIKELY(promiseHV.isUndefined()))
+    return HermesValue::encodeUndefinedValue();
+  auto promise = runtime.makeHandle(vmcast<JSPromise>(promiseHV));
+  NativeFunction::setAdditionalSlotValue(
+      *reaction,
+      runtime,
+      JSPromise::Capability,
+      SmallHermesValue::encodeUndefinedValue());
+
+  auto gen = runtime.makeHandle(vmcast<GeneratorInnerFunction>(
+      NativeFunction::getAdditionalSlotValue(
+          *reaction, runtime, JSPromise::OnFulfilled)
+          .getObject(runtime)));
+  MutableHandle<> value{
+      runtime,
+      NativeFunction::getAdditionalSlotValue(
+          *reaction, runtime, JSPromise::Settled)
+          .unboxToHV(runtime)};
+  auto action = GeneratorInnerFunction::Action::Next;
+  if (auto *settled = dyn_vmcast<JSPromise>(*value)) {
+    if (settled->getState() == JSPromise::State::Rejected)
+      action = GeneratorInnerFunction::Action::Throw;
+    value = settled->getResult();
+  }
+  if (LLVM_UNLIKELY(
+          asyncFunctionStep(runtime, gen, promise, value, action) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return HermesValue::encodeUndefinedValue();
+}
+
 void createHermesBuiltins(
     Runtime &runtime,
     llvh::MutableArrayRef<Callable *> builtins) {
@@ -925,6 +1128,8 @@ void createHermesBuiltins(
       B::HermesBuiltin_getOriginalNativeErrorConstructor,
       P::getOriginalNativeErrorConstructor,
       hermesBuiltinGetOriginalNativeErrorConstructor);
+  defineInternMethod(
+      B::HermesBuiltin_spawnAsync, P::spawnAsync, hermesBuiltinSpawnAsync, 3);
 
   // Define the 'requireFast' function, which takes a number argument.
   defineInternMethod(
@@ -14,6 +14,7 @@
 #include "hermes/VM/JSArray.h"
 #include "hermes/VM/JSArrayBuffer.h"
 #include "hermes/VM/JSLib.h"
+#include "hermes/VM/JSPromise.h"
 #include "hermes/VM/JSTypedArray.h"
 #include "hermes/VM/JSWeakMapImpl.h"
 #include "hermes/VM/Operations.h"
@@ -362,12 +363,89 @@ hermesInternalTTRCReached(void *, Runtime &runtime, NativeArgs args) {
   return HermesValue::encodeUndefinedValue();
 }
 
+/// HermesInternal.enableInterpreterProfiler(kinds = "all")
+/// Start profiling the interpreter. \p kinds is a comma separated list of
+/// "opcodes", "functions", "native" and "all". Only the functions called after
+/// this are profiled.
+CallResult<HermesValue> hermesInternalEnableInterpreterProfiler(
+    void *,
+    Runtime &runtime,
+    NativeArgs args) {
+  std::string kinds = "all";
+  if (!args.getArg(0).isUndefined()) {
+    auto strRes = toString_RJS(runtime, args.getArgHandle(0));
+    if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    auto view = StringPrimitive::createStringView(
+        runtime, runtime.makeHandle(std::move(*strRes)));
+    SmallU16String<32> allocator;
+    kinds.clear();
+    convertUTF16ToUTF8WithReplacements(kinds, view.getUTF16Ref(allocator));
+  }
+  auto parsed = InterpreterProfiler::parseKinds(kinds);
+  if (!parsed)
+    return runtime.raiseRangeError("Invalid interpreter profiler kinds");
+  runtime.getInterpreterProfiler().enable(*parsed);
+  return HermesValue::encodeUndefinedValue();
+}
+
+/// HermesInternal.disableInterpreterProfiler()
+/// Stop profiling the interpreter, keeping the profile recorded so far.
+CallResult<HermesValue> hermesInternalDisableInterpreterProfiler(
+    void *,
+    Runtime &runtime,
+    NativeArgs args) {
+  runtime.getInterpreterProfiler().disable();
+  return HermesValue::encodeUndefinedValue();
+}
+
+/// HermesInternal.getInterpreterProfile()
+/// \return the interpreter profile recorded so far, as a human readable
+/// report.
+CallResult<HermesValue>
+hermesInternalGetInterpreterProfile(void *, Runtime &runtime, NativeArgs args) {
+  std::string report;
+  llvh::raw_string_ostream os(report);
+  runtime.getInterpreterProfiler().dump(os);
+  os.flush();
+  return StringPrimitive::createEfficient(
+      runtime,
+      UTF8Ref((const uint8_t *)report.data(), report.size()),
+      /* IgnoreInputErrors */ true);
+}
+
 CallResult<HermesValue>
 hermesInternalIsProxy(void *, Runtime &runtime, NativeArgs args) {
   Handle<JSObject> obj = args.dyncastArg<JSObject>(0);
   return HermesValue::encodeBoolValue(obj && obj->isProxyObject());
 }
 
+/// HermesInternal.getPromiseState(promise)
+/// \return [state, result] for a native promise, where state is 0 when
+/// pending, 1 when fulfilled, 2 when rejected, and 3 when it follows the
+/// promise in result; or undefined for any other value. Used by the REPL to
+/// print promises.
+CallResult<HermesValue>
+hermesInternalGetPromiseState(void *, Runtime &runtime, NativeArgs args) {
+  Handle<JSPromise> promise = args.dyncastArg<JSPromise>(0);
+  if (!promise)
+    return HermesValue::encodeUndefinedValue();
+
+  auto arrRes = JSArray::create(runtime, 2, 2);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<JSArray> arr = *arrRes;
+  JSArray::setElementAt(
+      arr,
+      runtime,
+      0,
+      runtime.makeHandle(
+          HermesValue::encodeUntrustedNumberValue((int)promise->getState())));
+  JSArray::setElementAt(
+      arr, runtime, 1, runtime.makeHandle(promise->getResult()));
+  return arr.getHermesValue();
+}
+
 CallResult<HermesValue>
 hermesInternalHasPromise(void *, Runtime &runtime, NativeArgs args) {
   return HermesValue::encodeBoolValue(runtime.hasES6Promise());
@@ -793,6 +871,14 @@ Handle<JSObject> createHermesInternalObject(
   defineInternMethod(P::ttiReached, hermesInternalTTIReached);
   defineInternMethod(P::ttrcReached, hermesInternalTTRCReached);
   defineInternMethod(P::getFunctionLocation, hermesInternalGetFunctionLocation);
+  defineInternMethodAndSymbol(
+      "enableInterpreterProfiler", hermesInternalEnableInterpreterProfiler);
+  defineInternMethodAndSymbol(
+      "disableInterpreterProfiler", hermesInternalDisableInterpreterProfiler);
+  defineInternMethodAndSymbol(
+      "getInterpreterProfile", hermesInternalGetInterpreterProfile);
+  defineInternMethodAndSymbol(
+      "getPromiseState", hermesInternalGetPromiseState, 1);
 
   if (LLVM_UNLIKELY(runtime.traceMode != SynthTraceMode::None)) {
     // Use getNewNonEnumerableFlags() so that getInstrumentedStats can be
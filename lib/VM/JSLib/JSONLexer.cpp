@@ -7,6 +7,7 @@
 
 #include "JSONLexer.h"
 
+#include "hermes/Support/SIMD.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "llvh/ADT/ScopeExit.h"
 
@@ -24,19 +25,123 @@ static bool isJSONWhiteSpace(char16_t ch) {
   return (ch == u'\t' || ch == u'\r' || ch == u'\n' || ch == u' ');
 }
 
-ExecutionStatus JSONLexer::advance() {
+/// \return whether \p ch ends a run of string characters that are copied
+/// unchanged: a quote, a backslash or a control character.
+static bool isJSONStringSpecial(char16_t ch) {
+  return ch == u'"' || ch == u'\\' || ch <= u'\u001F';
+}
+
+namespace {
+
+#ifdef HERMES_SIMD_VECTOR
+/// \return the mask of the lanes of \p v that end a run of plain string
+/// characters, see isJSONStringSpecial().
+template <typename T>
+inline uint64_t specialMask(typename CodeUnitVector<T>::Vec v) {
+  using V = CodeUnitVector<T>;
+  return V::toMask(V::either(
+      V::either(V::eq(v, '"'), V::eq(v, '\\')), V::lessEqual(v, 0x1F)));
+}
+
+/// \return the mask of the lanes of \p v that are JSON whitespace.
+template <typename T>
+inline uint64_t whiteSpaceMask(typename CodeUnitVector<T>::Vec v) {
+  using V = CodeUnitVector<T>;
+  return V::toMask(V::either(
+      V::either(V::eq(v, ' '), V::eq(v, '\n')),
+      V::either(V::eq(v, '\r'), V::eq(v, '\t'))));
+}
+#endif // HERMES_SIMD_VECTOR
+
+/// \return the number of code units at the start of \p str that are copied
+/// unchanged into a string, i.e. the index of the first quote, backslash or
+/// control character, or str.size(). Clears \p allAscii if any of those code
+/// units is not ASCII.
+template <typename T>
+size_t scanPlainChars(llvh::ArrayRef<T> str, bool &allAscii) {
+  const T *p = str.data();
+  const size_t n = str.size();
+  size_t i = 0;
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<T>;
+  for (; i + V::kLanes <= n; i += V::kLanes) {
+    auto v = V::load(p + i);
+    if (uint64_t mask = specialMask<T>(v)) {
+      // Only the lanes before the special one belong to the run.
+      size_t end = i + firstLane<T>(mask);
+      for (; i < end; ++i)
+        allAscii &= isASCII(p[i]);
+      return end;
+    }
+    if (V::toMask(V::nonASCII(v)))
+      allAscii = false;
+  }
+#endif
+  for (; i < n && !isJSONStringSpecial(p[i]); ++i)
+    allAscii &= isASCII(p[i]);
+  return i;
+}
+
+/// \return the number of JSON whitespace code units at the start of \p str.
+template <typename T>
+size_t scanWhiteSpaceChars(llvh::ArrayRef<T> str) {
+  const T *p = str.data();
+  const size_t n = str.size();
+  size_t i = 0;
+#ifdef HERMES_SIMD_VECTOR
+  using V = CodeUnitVector<T>;
+  for (; i + V::kLanes <= n; i += V::kLanes) {
+    uint64_t mask = ~whiteSpaceMask<T>(V::load(p + i)) & V::kAllLanes;
+    if (mask)
+      return i + firstLane<T>(mask);
+  }
+#endif
+  for (; i < n && isJSONWhiteSpace(p[i]); ++i) {
+  }
+  return i;
+}
+
+/// Create a StringPrimitive from the ASCII string \p str.
+inline CallResult<HermesValue>
+createString(Runtime &runtime, ASCIIRef str, bool /* allAscii */) {
+  return StringPrimitive::create(runtime, str);
+}
+
+/// Create a StringPrimitive from \p str, which is ASCII if \p allAscii.
+inline CallResult<HermesValue>
+createString(Runtime &runtime, UTF16Ref str, bool allAscii) {
+  return StringPrimitive::createWithKnownEncoding(runtime, str, allAscii);
+}
+
+} // namespace
+
+template <typename Stream>
+ExecutionStatus JSONLexer<Stream>::advance() {
   return advanceHelper(false);
 }
 
-ExecutionStatus JSONLexer::advanceStrAsSymbol() {
-  return advanceHelper(true);
+template <typename Stream>
+ExecutionStatus JSONLexer<Stream>::advanceStrAsSymbol(SymbolID expectedKey) {
+  return advanceHelper(true, expectedKey);
 }
 
-ExecutionStatus JSONLexer::advanceHelper(bool forKey) {
-  // Skip whitespaces.
+template <typename Stream>
+void JSONLexer<Stream>::skipWhiteSpace() {
+  // Compact JSON has no whitespace, so check for it before scanning vectors.
   while (curCharPtr_.hasChar() && isJSONWhiteSpace(*curCharPtr_)) {
-    ++curCharPtr_;
+    llvh::ArrayRef<CharT> chunk = curCharPtr_.chunk();
+    size_t n = scanWhiteSpaceChars(chunk);
+    curCharPtr_.skip(n);
+    if (n < chunk.size())
+      return;
   }
+}
+
+template <typename Stream>
+ExecutionStatus JSONLexer<Stream>::advanceHelper(
+    bool forKey,
+    SymbolID expectedKey) {
+  skipWhiteSpace();
 
   // End of buffer.
   if (!curCharPtr_.hasChar()) {
@@ -76,7 +181,7 @@ ExecutionStatus JSONLexer::advanceHelper(bool forKey) {
 
     case u'"':
       if (forKey) {
-        return scanString<StrAsSymbol>();
+        return scanString<StrAsSymbol>(expectedKey);
       } else {
         return scanString<StrAsValue>();
       }
@@ -86,7 +191,8 @@ ExecutionStatus JSONLexer::advanceHelper(bool forKey) {
   }
 }
 
-CallResult<char16_t> JSONLexer::consumeUnicode() {
+template <typename Stream>
+CallResult<char16_t> JSONLexer<Stream>::consumeUnicode() {
   uint16_t val = 0;
   for (unsigned i = 0; i < 4; ++i) {
     if (!curCharPtr_.hasChar()) {
@@ -107,7 +213,8 @@ CallResult<char16_t> JSONLexer::consumeUnicode() {
   return static_cast<char16_t>(val);
 }
 
-ExecutionStatus JSONLexer::scanNumber() {
+template <typename Stream>
+ExecutionStatus JSONLexer<Stream>::scanNumber() {
   llvh::SmallVector<char, 32> str8;
   while (curCharPtr_.hasChar()) {
     auto ch = *curCharPtr_;
@@ -137,8 +244,9 @@ ExecutionStatus JSONLexer::scanNumber() {
   return ExecutionStatus::RETURNED;
 }
 
+template <typename Stream>
 template <typename ForKey>
-ExecutionStatus JSONLexer::scanString() {
+ExecutionStatus JSONLexer<Stream>::scanString(SymbolID expectedKey) {
   assert(*curCharPtr_ == '"');
   ++curCharPtr_;
   bool hasEscape = false;
@@ -151,99 +259,121 @@ ExecutionStatus JSONLexer::scanString() {
   auto ensureCaptureClosed =
       llvh::make_scope_exit([this] { curCharPtr_.cancelCapture(); });
   bool allAscii = true;
-  hermes::JenkinsHash hash = hermes::JenkinsHashInit;
 
   while (curCharPtr_.hasChar()) {
+    // Skip the characters that are copied unchanged, a vector at a time.
+    llvh::ArrayRef<CharT> chunk = curCharPtr_.chunk();
+    llvh::ArrayRef<CharT> plain =
+        chunk.take_front(scanPlainChars(chunk, allAscii));
+    if (hasEscape)
+      tmpStorage.append(plain.begin(), plain.end());
+    curCharPtr_.skip(plain.size());
+    // The whole chunk was plain, the string goes on in the next one, if any.
+    if (plain.size() == chunk.size())
+      continue;
+
     if (*curCharPtr_ == '"') {
       // End of string.
-      llvh::ArrayRef<char16_t> strRef =
-          hasEscape ? tmpStorage.arrayRef() : curCharPtr_.endCapture();
-      ++curCharPtr_;
-      if constexpr (ForKey::value) {
-        auto symRes = runtime_.getIdentifierTable().getSymbolHandle(
-            runtime_, strRef, hash);
-        if (symRes == ExecutionStatus::EXCEPTION)
-          return ExecutionStatus::EXCEPTION;
-        token_.setSymbol(*symRes);
-        return ExecutionStatus::RETURNED;
-      }
-      auto strRes =
-          StringPrimitive::createWithKnownEncoding(runtime_, strRef, allAscii);
-      if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
+      if (hasEscape) {
+        ++curCharPtr_;
+        return setStringToken<ForKey>(
+            tmpStorage.arrayRef(), allAscii, expectedKey);
       }
-      token_.setString(runtime_.makeHandle<StringPrimitive>(*strRes));
-      return ExecutionStatus::RETURNED;
+      llvh::ArrayRef<CharT> strRef = curCharPtr_.endCapture();
+      ++curCharPtr_;
+      return setStringToken<ForKey>(strRef, allAscii, expectedKey);
     } else if (*curCharPtr_ <= '\u001F') {
       return error(u"U+0000 thru U+001F is not allowed in string");
     }
-    char16_t scannedChar = -1;
-    if (*curCharPtr_ == u'\\') {
-      if (!hasEscape) {
-        // This is the first escape character encountered, so append everything
-        // we've seen so far to tmpStorage.
-        tmpStorage.append(curCharPtr_.endCapture());
-      }
-      hasEscape = true;
-      ++curCharPtr_;
-      if (!curCharPtr_.hasChar()) {
-        return error("Unexpected end of input");
-      }
-      switch (*curCharPtr_) {
+    assert(*curCharPtr_ == u'\\' && "unexpected end of plain characters");
+    if (!hasEscape) {
+      // This is the first escape character encountered, so append everything
+      // we've seen so far to tmpStorage.
+      llvh::ArrayRef<CharT> captured = curCharPtr_.endCapture();
+      tmpStorage.append(captured.begin(), captured.end());
+    }
+    hasEscape = true;
+    ++curCharPtr_;
+    if (!curCharPtr_.hasChar()) {
+      return error("Unexpected end of input");
+    }
+    switch (*curCharPtr_) {
 #define CONSUME_VAL(v)     \
   tmpStorage.push_back(v); \
   ++curCharPtr_;
 
-        case u'"':
-        case u'/':
-        case u'\\':
-          CONSUME_VAL(*curCharPtr_)
-          break;
-        case 'b':
-          CONSUME_VAL(8)
-          break;
-        case 'f':
-          CONSUME_VAL(12)
-          break;
-        case 'n':
-          CONSUME_VAL(10)
-          break;
-        case 'r':
-          CONSUME_VAL(13)
-          break;
-        case 't':
-          CONSUME_VAL(9)
-          break;
-        case 'u': {
-          ++curCharPtr_;
-          CallResult<char16_t> cr = consumeUnicode();
-          if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
-            return ExecutionStatus::EXCEPTION;
-          }
-          tmpStorage.push_back(*cr);
-          break;
+      case u'"':
+      case u'/':
+      case u'\\':
+        CONSUME_VAL(*curCharPtr_)
+        break;
+      case 'b':
+        CONSUME_VAL(8)
+        break;
+      case 'f':
+        CONSUME_VAL(12)
+        break;
+      case 'n':
+        CONSUME_VAL(10)
+        break;
+      case 'r':
+        CONSUME_VAL(13)
+        break;
+      case 't':
+        CONSUME_VAL(9)
+        break;
+      case 'u': {
+        ++curCharPtr_;
+        CallResult<char16_t> cr = consumeUnicode();
+        if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
         }
-
-        default:
-          return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
+        tmpStorage.push_back(*cr);
+        break;
       }
-      scannedChar = tmpStorage.back();
-    } else {
-      scannedChar = *curCharPtr_;
-      if (hasEscape)
-        tmpStorage.push_back(scannedChar);
-      ++curCharPtr_;
-    }
-    if constexpr (ForKey::value) {
-      hash = hermes::updateJenkinsHash(hash, scannedChar);
-    } else {
-      allAscii &= isASCII(scannedChar);
+
+      default:
+        return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
     }
+    allAscii &= isASCII(tmpStorage.back());
   }
   return error("Unexpected end of input");
 }
 
-ExecutionStatus JSONLexer::scanWord(const char *word, JSONTokenKind kind) {
+template <typename Stream>
+template <typename ForKey, typename T>
+ExecutionStatus JSONLexer<Stream>::setStringToken(
+    llvh::ArrayRef<T> str,
+    bool allAscii,
+    SymbolID expectedKey) {
+  if constexpr (ForKey::value) {
+    // Objects parsed from the same document usually have the same keys, so
+    // comparing with the expected key is cheaper than a table lookup.
+    if (expectedKey.isValid() &&
+        runtime_.getIdentifierTable()
+            .getStringView(runtime_, expectedKey)
+            .equals(str)) {
+      token_.setSymbol(expectedKey);
+      return ExecutionStatus::RETURNED;
+    }
+    auto symRes = runtime_.getIdentifierTable().getSymbolHandle(runtime_, str);
+    if (symRes == ExecutionStatus::EXCEPTION)
+      return ExecutionStatus::EXCEPTION;
+    token_.setSymbol(*symRes);
+    return ExecutionStatus::RETURNED;
+  }
+  auto strRes = createString(runtime_, str, allAscii);
+  if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  token_.setString(runtime_.makeHandle<StringPrimitive>(*strRes));
+  return ExecutionStatus::RETURNED;
+}
+
+template <typename Stream>
+ExecutionStatus JSONLexer<Stream>::scanWord(
+    const char *word,
+    JSONTokenKind kind) {
   while (*word && curCharPtr_.hasChar()) {
     if (*curCharPtr_ != *word) {
       return errorWithChar(u"Unexpected character: ", *curCharPtr_);
@@ -258,5 +388,8 @@ ExecutionStatus JSONLexer::scanWord(const char *word, JSONTokenKind kind) {
   return ExecutionStatus::RETURNED;
 }
 
+template class JSONLexer<UTF16Stream>;
+template class JSONLexer<ASCIIStream>;
+
 } // namespace vm
 } // namespace hermes
@@ -108,11 +108,80 @@ class JSONToken {
     kind_ = JSONTokenKind::String;
     symbolValue_ = sym;
   }
+
+  void setSymbol(SymbolID sym) {
+    kind_ = JSONTokenKind::String;
+    symbolValue_ = sym;
+  }
 };
 
+/// A stream of 7-bit ASCII code units with the interface of UTF16Stream, for
+/// JSON text that is known to be ASCII. The text is scanned in place, so it
+/// must not move while the stream is in use.
+class ASCIIStream {
+ public:
+  using CharT = char;
+
+  explicit ASCIIStream(ASCIIRef str) : cur_(str.begin()), end_(str.end()) {}
+
+  bool hasChar() const {
+    return cur_ != end_;
+  }
+
+  char operator*() const {
+    assert(cur_ != end_ && "must check hasChar");
+    return *cur_;
+  }
+
+  ASCIIStream &operator++() {
+    assert(cur_ != end_ && "must check hasChar");
+    ++cur_;
+    return *this;
+  }
+
+  /// \return the rest of the text.
+  ASCIIRef chunk() const {
+    return {cur_, end_};
+  }
+
+  void skip(size_t n) {
+    assert(n <= (size_t)(end_ - cur_) && "skipping past the end");
+    cur_ += n;
+  }
+
+  void beginCapture() {
+    assert(!beginCapture_ && "there is already an active capture");
+    beginCapture_ = cur_;
+  }
+
+  ASCIIRef endCapture() {
+    assert(beginCapture_ && "no active capture");
+    ASCIIRef captured{beginCapture_, cur_};
+    beginCapture_ = nullptr;
+    return captured;
+  }
+
+  void cancelCapture() {
+    beginCapture_ = nullptr;
+  }
+
+ private:
+  const char *cur_;
+  const char *end_;
+
+  /// The beginning of the active capture, or nullptr.
+  const char *beginCapture_{nullptr};
+};
+
+/// Scans JSON tokens from a Stream, which is either a UTF16Stream or an
+/// ASCIIStream. Strings are scanned a vector of code units at a time when
+/// SSE2 or NEON is available.
+template <typename Stream>
 class JSONLexer {
  private:
-  UTF16Stream curCharPtr_;
+  using CharT = typename Stream::CharT;
+
+  Stream curCharPtr_;
 
   Runtime &runtime_;
 
@@ -121,7 +190,7 @@ class JSONLexer {
   using StrAsValue = std::false_type;
 
  public:
-  JSONLexer(Runtime &runtime, UTF16Stream &&stream)
+  JSONLexer(Runtime &runtime, Stream &&stream)
       : curCharPtr_(std::move(stream)), runtime_(runtime), token_(runtime) {}
 
   /// \return the current token.
@@ -138,8 +207,11 @@ class JSONLexer {
   LLVM_NODISCARD ExecutionStatus advance();
 
   /// Same as advance, except if a string is encountered, it will parse it into
-  /// the current token's symbol field.
-  LLVM_NODISCARD ExecutionStatus advanceStrAsSymbol();
+  /// the current token's symbol field. If the string is the name of
+  /// \p expectedKey, \p expectedKey is used without looking the string up in
+  /// the identifier table.
+  LLVM_NODISCARD ExecutionStatus
+  advanceStrAsSymbol(SymbolID expectedKey = SymbolID{});
 
   /// Raise a JSON parse exception with message \p msg.
   /// token_ will also be invalidated.
@@ -167,17 +239,31 @@ class JSONLexer {
 
  private:
   /// Advance the lexer by a single token. The parameter forKey determines how
-  /// strings are stored in the lexer.
-  LLVM_NODISCARD ExecutionStatus advanceHelper(bool forKey);
+  /// strings are stored in the lexer, and \p expectedKey is the key that is
+  /// likely to be scanned when forKey is true.
+  LLVM_NODISCARD ExecutionStatus
+  advanceHelper(bool forKey, SymbolID expectedKey = SymbolID{});
 
   /// Parse a JSONNumber.
   LLVM_NODISCARD ExecutionStatus scanNumber();
 
   /// Parse a JSONString. If ForKey is std::true_type, then the string will be
   /// parsed into a symbol. If ForKey is std::false_type, the scanned string
-  /// will be turned into a new StringPrimitive.
+  /// will be turned into a new StringPrimitive. \p expectedKey is only used
+  /// for keys.
   template <typename ForKey>
-  LLVM_NODISCARD ExecutionStatus scanString();
+  LLVM_NODISCARD ExecutionStatus scanString(SymbolID expectedKey = SymbolID{});
+
+  /// Store the scanned string \p str in the current token, as a symbol if
+  /// ForKey is std::true_type. \p allAscii tells whether \p str is ASCII.
+  template <typename ForKey, typename T>
+  LLVM_NODISCARD ExecutionStatus setStringToken(
+      llvh::ArrayRef<T> str,
+      bool allAscii,
+      SymbolID expectedKey);
+
+  /// Skip the JSON whitespace at the current position.
+  void skipWhiteSpace();
 
   /// Parse a reserved keyword.
   LLVM_NODISCARD ExecutionStatus scanWord(const char *word, JSONTokenKind kind);
@@ -187,6 +273,9 @@ class JSONLexer {
   CallResult<char16_t> consumeUnicode();
 };
 
+extern template class JSONLexer<UTF16Stream>;
+extern template class JSONLexer<ASCIIStream>;
+
 } // namespace vm
 } // namespace hermes
 
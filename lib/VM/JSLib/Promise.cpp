@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+//===----------------------------------------------------------------------===//
+/// \file
+/// ES2023 27.2 Promise Objects.
+/// The combinators (all, allSettled, any, race) and finally are implemented on
+/// top of these in the internal bytecode.
+//===----------------------------------------------------------------------===//
+
+#include "JSLibInternal.h"
+
+#include "hermes/VM/JSPromise.h"
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/StackFrame-inline.h"
+
+namespace hermes {
+namespace vm {
+
+Handle<JSObject> createPromiseConstructor(Runtime &runtime) {
+  auto promisePrototype = Handle<JSObject>::vmcast(&runtime.promisePrototype);
+
+  auto cons = defineSystemConstructor<JSPromise>(
+      runtime,
+      Predefined::getSymbolID(Predefined::Promise),
+      promiseConstructor,
+      promisePrototype,
+      1,
+      CellKind::JSPromiseKind);
+
+  defineMethod(
+      runtime,
+      cons,
+      Predefined::getSymbolID(Predefined::resolve),
+      nullptr,
+      promiseResolve,
+      1);
+  defineMethod(
+      runtime,
+      cons,
+      Predefined::getSymbolID(Predefined::reject),
+      nullptr,
+      promiseReject,
+      1);
+
+  defineMethod(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::then),
+      nullptr,
+      promisePrototypeThen,
+      2);
+  defineMethod(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::catchStr),
+      nullptr,
+      promisePrototypeCatch,
+      1);
+
+  DefinePropertyFlags dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
+  dpf.writable = 0;
+  dpf.enumerable = 0;
+  dpf.configurable = 1;
+
+  // 27.2.5.5 Promise.prototype [ @@toStringTag ]
+  defineProperty(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::SymbolToStringTag),
+      runtime.getPredefinedStringHandle(Predefined::Promise),
+      dpf);
+
+  return cons;
+}
+
+// 27.2.3.1 Promise ( executor )
+CallResult<HermesValue>
+promiseConstructor(void *, Runtime &runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+
+  if (LLVM_UNLIKELY(!args.isConstructorCall())) {
+    return runtime.raiseTypeError("Promise must be called as a constructor");
+  }
+  auto executor = args.dyncastArg<Callable>(0);
+  if (LLVM_UNLIKELY(!executor)) {
+    return runtime.raiseTypeError(
+        "Promise constructor's argument is not a function");
+  }
+
+  auto self = args.dyncastThis<JSPromise>();
+  auto fns = JSPromise::createResolvingFunctions(self, runtime);
+  if (LLVM_UNLIKELY(
+          Callable::executeCall2(
+              executor,
+              runtime,
+              Runtime::getUndefinedValue(),
+              fns.first.getHermesValue(),
+              fns.second.getHermesValue()) == ExecutionStatus::EXCEPTION)) {
+    if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+      return ExecutionStatus::EXCEPTION;
+    HermesValue reason = runtime.getThrownValue();
+    runtime.clearThrownValue();
+    if (LLVM_UNLIKELY(
+            Callable::executeCall1(
+                fns.second, runtime, Runtime::getUndefinedValue(), reason) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return self.getHermesValue();
+}
+
+// 27.2.5.4 Promise.prototype.then ( onFulfilled, onRejected )
+CallResult<HermesValue>
+promisePrototypeThen(void *, Runtime &runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+
+  auto self = args.dyncastThis<JSPromise>();
+  if (LLVM_UNLIKELY(!self)) {
+    return runtime.raiseTypeError(
+        "Promise.prototype.then called on a non-promise");
+  }
+
+  // The derived promise is created by the constructor of self, which is
+  // %Promise% unless self is an instance of a subclass.
+  auto ctorRes = JSObject::getNamed_RJS(
+      self, runtime, Predefined::getSymbolID(Predefined::constructor));
+  if (LLVM_UNLIKELY(ctorRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  MutableHandle<> C{runtime, ctorRes->get()};
+  if (C->isUndefined()) {
+    C = runtime.promiseConstructor;
+  } else if (LLVM_UNLIKELY(!C->isObject())) {
+    return runtime.raiseTypeError(
+        "Constructor must be an object if it is not undefined");
+  }
+
+  auto capabilityRes = JSPromise::newPromiseCapability(runtime, C);
+  if (LLVM_UNLIKELY(capabilityRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<NativeFunction> reaction = JSPromise::createReaction(
+      runtime, args.getArgHandle(0), args.getArgHandle(1), *capabilityRes);
+  if (LLVM_UNLIKELY(
+          JSPromise::addReaction(self, runtime, reaction) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return JSPromise::getCapabilityPromise(runtime, *capabilityRes);
+}
+
+// 27.2.5.1 Promise.prototype.catch ( onRejected )
+CallResult<HermesValue>
+promisePrototypeCatch(void *, Runtime &runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+
+  auto objRes = toObject(runtime, args.getThisHandle());
+  if (LLVM_UNLIKELY(objRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto thenRes = JSObject::getNamed_RJS(
+      runtime.makeHandle<JSObject>(*objRes),
+      runtime,
+      Predefined::getSymbolID(Predefined::then));
+  if (LLVM_UNLIKELY(thenRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto then =
+      Handle<Callable>::dyn_vmcast(runtime.makeHandle(std::move(*thenRes)));
+  if (LLVM_UNLIKELY(!then)) {
+    return runtime.raiseTypeError("Property 'then' is not a function");
+  }
+  return Callable::executeCall2(
+             then,
+             runtime,
+             args.getThisHandle(),
+             HermesValue::encodeUndefinedValue(),
+             args.getArg(0))
+      .toCallResultHermesValue();
+}
+
+/// Settle a new promise created by the constructor in `this` with the first
+/// argument. Promise.resolve and Promise.reject don't require `this` to be a
+/// constructor, and fall back to %Promise% when it isn't an object.
+static CallResult<HermesValue>
+promiseResolveOrReject(Runtime &runtime, NativeArgs args, bool isReject) {
+  GCScope gcScope{runtime};
+
+  MutableHandle<> C{runtime, args.getThisArg()};
+  if (!C->isObject())
+    C = runtime.promiseConstructor;
+  Handle<> x = args.getArgHandle(0);
+
+  // 27.2.4.7.1 PromiseResolve ( C, x ), step 1.
+  if (!isReject && vmisa<JSPromise>(*x)) {
+    auto ctorRes = JSObject::getNamed_RJS(
+        Handle<JSObject>::vmcast(x),
+        runtime,
+        Predefined::getSymbolID(Predefined::constructor));
+    if (LLVM_UNLIKELY(ctorRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (ctorRes->get().isObject() &&
+        ctorRes->get().getObject() == C->getObject())
+      return *x;
+  }
+
+  auto capabilityRes = JSPromise::newPromiseCapability(runtime, C);
+  if (LLVM_UNLIKELY(capabilityRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (LLVM_UNLIKELY(
+          JSPromise::settleCapability(runtime, *capabilityRes, x, isReject) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return JSPromise::getCapabilityPromise(runtime, *capabilityRes);
+}
+
+// 27.2.4.7 Promise.resolve ( x )
+CallResult<HermesValue>
+promiseResolve(void *, Runtime &runtime, NativeArgs args) {
+  return promiseResolveOrReject(runtime, args, false);
+}
+
+// 27.2.4.6 Promise.reject ( r )
+CallResult<HermesValue>
+promiseReject(void *, Runtime &runtime, NativeArgs args) {
+  return promiseResolveOrReject(runtime, args, true);
+}
+
+} // namespace vm
+} // namespace hermes
@@ -12,6 +12,7 @@
 #include "hermes/Support/Compiler.h"
 #include "hermes/Support/JSON.h"
 #include "hermes/Support/UTF16Stream.h"
+#include "hermes/Support/UTF8.h"
 #include "hermes/VM/ArrayLike.h"
 #include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/Callable.h"
@@ -30,8 +31,10 @@ namespace vm {
 namespace {
 
 /// This class wraps the functionality required to parse a JSON string into
-/// a VM runtime value. It expects a UTF8 string as input, and returns a
-/// HermesValue when parse is called.
+/// a VM runtime value. It reads the string from a Stream, which is either a
+/// UTF16Stream or an ASCIIStream, and returns a HermesValue when parse is
+/// called.
+template <typename Stream>
 class RuntimeJSONParser {
  public:
   static constexpr int32_t MAX_RECURSION_DEPTH =
@@ -47,7 +50,7 @@ class RuntimeJSONParser {
   Runtime &runtime_;
 
   /// The lexer.
-  JSONLexer lexer_;
+  JSONLexer<Stream> lexer_;
 
   /// Stores the optional reviver parameter.
   /// https://es5.github.io/#x15.12.2
@@ -63,15 +66,27 @@ class RuntimeJSONParser {
   /// If it drops below 0 while parsing, raise a stack overflow.
   int32_t remainingDepth_{MAX_RECURSION_DEPTH};
 
+  /// The HiddenClass of the last object parsed at each nesting level, or empty
+  /// if there is none. The next object at the same level, typically the next
+  /// element of an array of records, is predicted to have the same keys in the
+  /// same order, and is then allocated directly with this class.
+  /// Null until the first object is parsed.
+  MutableHandle<PropStorage> shapeClasses_;
+
+  /// The keys of each class in shapeClasses_, in slot order. They are kept
+  /// alive by their class.
+  std::vector<llvh::SmallVector<SymbolID, 8>> shapeKeys_;
+
  public:
   explicit RuntimeJSONParser(
       Runtime &runtime,
-      UTF16Stream &&jsonString,
+      Stream &&jsonString,
       Handle<Callable> reviver)
       : runtime_(runtime),
         lexer_(runtime, std::move(jsonString)),
         reviver_(reviver),
-        tmpHandle_(runtime) {}
+        tmpHandle_(runtime),
+        shapeClasses_(runtime) {}
 
   /// Parse JSON string through lexer_, create objects using runtime_.
   /// If errors occur, this function will return undefined, and the error
@@ -92,6 +107,22 @@ class RuntimeJSONParser {
   /// When this function is finished, the current token must be "}".
   CallResult<HermesValue> parseObject();
 
+  /// Create an ordinary object with the properties \p keys of \p predicted,
+  /// which is an object of a predicted class whose first slots hold the
+  /// values of \p keys. Used when an object turns out not to have the
+  /// predicted keys.
+  Handle<JSObject> copyMatchedProperties(
+      Handle<JSObject> predicted,
+      llvh::ArrayRef<SymbolID> keys);
+
+  /// Make the class of \p object, whose properties are \p keys in insertion
+  /// order, the prediction for the next object at nesting level \p level.
+  /// Classes whose slots can't be filled in key order are not recorded.
+  ExecutionStatus recordShape(
+      uint32_t level,
+      Handle<JSObject> object,
+      llvh::ArrayRef<SymbolID> keys);
+
   /// Use reviver to filter the result.
   CallResult<HermesValue> revive(Handle<> value);
 
@@ -107,6 +138,87 @@ class RuntimeJSONParser {
   ExecutionStatus filter(Handle<JSObject> val, Handle<> key);
 };
 
+/// The output buffer of JSONStringifyer. It stores 8-bit code units while
+/// everything appended is ASCII, and switches to UTF16 at the first non-ASCII
+/// code unit, so that ASCII output never needs to be narrowed.
+class JSONOutput {
+  /// The output while it is all ASCII.
+  llvh::SmallVector<char, 32> ascii_{};
+
+  /// The output once it contains a non-ASCII code unit.
+  llvh::SmallVector<char16_t, 32> utf16_{};
+
+  /// Whether the output is still stored in ascii_.
+  bool isASCII_{true};
+
+ public:
+  void push_back(char16_t ch) {
+    if (LLVM_LIKELY(isASCII_ && isASCII(ch))) {
+      ascii_.push_back(static_cast<char>(ch));
+    } else {
+      widen();
+      utf16_.push_back(ch);
+    }
+  }
+
+  void append(std::initializer_list<char16_t> chars) {
+    for (char16_t ch : chars)
+      push_back(ch);
+  }
+
+  void append(ASCIIRef str) {
+    if (LLVM_LIKELY(isASCII_))
+      ascii_.append(str.begin(), str.end());
+    else
+      utf16_.append(str.begin(), str.end());
+  }
+
+  void append(UTF16Ref str) {
+    if (isASCII_ && isAllASCII(str.begin(), str.end())) {
+      ascii_.append(str.begin(), str.end());
+    } else {
+      widen();
+      utf16_.append(str.begin(), str.end());
+    }
+  }
+
+  size_t size() const {
+    return isASCII_ ? ascii_.size() : utf16_.size();
+  }
+
+  /// Truncate the output to \p size code units.
+  void resize(size_t size) {
+    assert(size <= this->size() && "can only truncate the output");
+    if (isASCII_)
+      ascii_.resize(size);
+    else
+      utf16_.resize(size);
+  }
+
+  void clear() {
+    ascii_.clear();
+    utf16_.clear();
+    isASCII_ = true;
+  }
+
+  /// \return a new StringPrimitive with the contents of the output.
+  CallResult<HermesValue> toString(Runtime &runtime) const {
+    if (isASCII_)
+      return StringPrimitive::create(runtime, ASCIIRef(ascii_));
+    return StringPrimitive::create(runtime, UTF16Ref(utf16_));
+  }
+
+ private:
+  /// Move the output to utf16_, if it is not there already.
+  void widen() {
+    if (!isASCII_)
+      return;
+    utf16_.append(ascii_.begin(), ascii_.end());
+    ascii_.clear();
+    isASCII_ = false;
+  }
+};
+
 /// This class wraps the functionality required to stringify an object
 /// as JSON.
 class JSONStringifyer {
@@ -149,6 +261,10 @@ class JSONStringifyer {
   /// Handle used by operationJO to store K.
   MutableHandle<JSArray> operationJOK_;
 
+  /// Handle used by operationStr and operationJO to store the JSON cache of
+  /// the class of the value, if the value is a plain data object.
+  MutableHandle<ArrayStorage> jsonCache_;
+
   /// The holder argument passed to operationStr.
   /// We define a member variable here to avoid creating a new handle
   /// each time we are calling operationStr.
@@ -162,10 +278,10 @@ class JSONStringifyer {
   /// The max amount that depthCount_ is allowed to reach. Once it's reached, an
   /// exception will be thrown.
   static constexpr uint32_t MAX_RECURSION_DEPTH{
-      RuntimeJSONParser::MAX_RECURSION_DEPTH};
+      RuntimeJSONParser<UTF16Stream>::MAX_RECURSION_DEPTH};
 
   /// The output buffer. The serialization process will append into it.
-  llvh::SmallVector<char16_t, 32> output_{};
+  JSONOutput output_{};
 
  public:
   explicit JSONStringifyer(Runtime &runtime)
@@ -179,6 +295,7 @@ class JSONStringifyer {
         tmpHandle2_(runtime),
         operationStrValue_(runtime),
         operationJOK_(runtime),
+        jsonCache_(runtime),
         operationStrHolder_(runtime) {}
 
   LLVM_NODISCARD ExecutionStatus init(Handle<> replacer, Handle<> space) {
@@ -219,8 +336,31 @@ class JSONStringifyer {
   /// we don't want to convert every index into string.
   /// Hence we leave the key as it is, and convert them to string if needed.
   /// The holder is always stored in operationStrHolder_ by caller.
+  /// If \p value is not empty, it is the value of holder[key], which the
+  /// caller has already loaded.
   /// \return whether the result is not undefined.
-  CallResult<bool> operationStr(HermesValue key);
+  CallResult<bool> operationStr(
+      HermesValue key,
+      HermesValue value = HermesValue::encodeEmptyValue());
+
+  /// If \p obj is a plain data object or array, i.e. an ordinary object whose
+  /// class has no accessors and no index-like properties, and which has no
+  /// toJSON property on itself or its prototype chain, store the JSON cache of
+  /// its class in jsonCache_, creating it if needed. Otherwise, set jsonCache_
+  /// to null. Always sets it to null if there is a replacer.
+  ExecutionStatus lookupJSONCache(Handle<JSObject> obj);
+
+  /// Create the JSON cache for the class of \p obj and attach it to the
+  /// class, then store it in jsonCache_ if \p obj is a plain data object.
+  /// Sets jsonCache_ to null if \p obj or its prototypes are not suitable for
+  /// caching, e.g. because one of them is a dictionary.
+  ExecutionStatus createJSONCache(Handle<JSObject> obj);
+
+  /// Implement JO.8 for the plain data object on top of stackValue_, whose
+  /// class has the JSON cache in jsonCache_. The quoted keys are taken from
+  /// the cache, and the values are read directly from their slots.
+  /// \return whether any property was serialized.
+  CallResult<bool> operationJOFromCache();
 
   /// Implement the abstract operation Quote(value).
   /// It wraps a String value in double quotes and escapes characters within it.
@@ -257,7 +397,8 @@ class JSONStringifyer {
 };
 } // namespace
 
-CallResult<HermesValue> RuntimeJSONParser::parse() {
+template <typename Stream>
+CallResult<HermesValue> RuntimeJSONParser<Stream>::parse() {
   // parseValue() requires one token to start with.
   if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
@@ -280,7 +421,8 @@ CallResult<HermesValue> RuntimeJSONParser::parse() {
   return parRes;
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseValue() {
+template <typename Stream>
+CallResult<HermesValue> RuntimeJSONParser<Stream>::parseValue() {
   llvh::SaveAndRestore<decltype(remainingDepth_)> oldDepth{
       remainingDepth_, remainingDepth_ - 1};
   if (remainingDepth_ <= 0) {
@@ -333,7 +475,8 @@ CallResult<HermesValue> RuntimeJSONParser::parseValue() {
   return returnValue.getHermesValue();
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseArray() {
+template <typename Stream>
+CallResult<HermesValue> RuntimeJSONParser<Stream>::parseArray() {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::LSquare &&
       "Wrong entrance to parseArray");
@@ -386,22 +529,44 @@ CallResult<HermesValue> RuntimeJSONParser::parseArray() {
   return array.getHermesValue();
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseObject() {
+template <typename Stream>
+CallResult<HermesValue> RuntimeJSONParser<Stream>::parseObject() {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace &&
       "Wrong entrance to parseObject");
-  auto object = runtime_.makeHandle(JSObject::create(runtime_));
+  // Objects at the same nesting level share a predicted shape.
+  const uint32_t level = MAX_RECURSION_DEPTH - remainingDepth_;
+  const bool hasPrediction =
+      level < shapeKeys_.size() && !shapeKeys_[level].empty();
 
   // If the lexer encounters a string in this context, it should treat it as a
   // key string, which means it will store the string as a symbol.
   if (LLVM_UNLIKELY(
-          lexer_.advanceStrAsSymbol() == ExecutionStatus::EXCEPTION)) {
+          lexer_.advanceStrAsSymbol(
+              hasPrediction ? shapeKeys_[level][0] : SymbolID{}) ==
+          ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
   if (lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace) {
-    return object.getHermesValue();
+    return JSObject::create(runtime_).getHermesValue();
   }
 
+  // While the keys match the predicted keys, the object has the predicted
+  // class, and the value of the N-th key is stored directly in slot N.
+  bool matching = hasPrediction &&
+      lexer_.getCurToken()->getKind() == JSONTokenKind::String &&
+      lexer_.getCurToken()->getStrAsSymbol().get() == shapeKeys_[level][0];
+  MutableHandle<JSObject> object{runtime_};
+  if (matching) {
+    auto clazz = runtime_.makeHandle(
+        vmcast<HiddenClass>(shapeClasses_->at(level).getObject(runtime_)));
+    object = JSObject::create(runtime_, clazz).get();
+  } else {
+    object = JSObject::create(runtime_).get();
+  }
+  // The keys parsed so far. They are kept alive by the class of object.
+  llvh::SmallVector<SymbolID, 8> keys;
+
   MutableHandle<SymbolID> key{runtime_};
   GCScope gcScope{runtime_};
   auto marker = gcScope.createMarker();
@@ -414,6 +579,19 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
     }
     key = lexer_.getCurToken()->getStrAsSymbol().get();
 
+    if (matching) {
+      const auto &predictedKeys = shapeKeys_[level];
+      if (LLVM_UNLIKELY(
+              keys.size() == predictedKeys.size() ||
+              key.get() != predictedKeys[keys.size()])) {
+        // If every predicted key matched, the object is complete and only
+        // has additional keys. Otherwise it must lose the unmatched slots.
+        if (keys.size() < predictedKeys.size())
+          object = copyMatchedProperties(object, keys).get();
+        matching = false;
+      }
+    }
+
     if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
@@ -431,16 +609,28 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
       return ExecutionStatus::EXCEPTION;
     }
 
-    (void)JSObject::defineOwnComputedPrimitive(
-        object,
-        runtime_,
-        key,
-        DefinePropertyFlags::getDefaultNewPropertyFlags(),
-        runtime_.makeHandle(*parRes));
+    if (matching) {
+      // Encode the value before reading object, since encoding may allocate.
+      auto shv = SmallHermesValue::encodeHermesValue(*parRes, runtime_);
+      // We made this object, it's not a Proxy.
+      JSObject::setNamedSlotValueUnsafe(*object, runtime_, keys.size(), shv);
+    } else {
+      (void)JSObject::defineOwnComputedPrimitive(
+          object,
+          runtime_,
+          key,
+          DefinePropertyFlags::getDefaultNewPropertyFlags(),
+          runtime_.makeHandle(*parRes));
+    }
+    keys.push_back(key.get());
 
     if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
+      SymbolID expectedKey{};
+      if (matching && keys.size() < shapeKeys_[level].size())
+        expectedKey = shapeKeys_[level][keys.size()];
       if (LLVM_UNLIKELY(
-              lexer_.advanceStrAsSymbol() == ExecutionStatus::EXCEPTION)) {
+              lexer_.advanceStrAsSymbol(expectedKey) ==
+              ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
       continue;
@@ -453,10 +643,78 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace &&
       "Unexpected stop for object parse");
+
+  if (matching) {
+    if (LLVM_LIKELY(keys.size() == shapeKeys_[level].size()))
+      return object.getHermesValue();
+    object = copyMatchedProperties(object, keys).get();
+  }
+  if (LLVM_UNLIKELY(
+          recordShape(level, object, keys) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return object.getHermesValue();
 }
 
-CallResult<HermesValue> RuntimeJSONParser::revive(Handle<> value) {
+template <typename Stream>
+Handle<JSObject> RuntimeJSONParser<Stream>::copyMatchedProperties(
+    Handle<JSObject> predicted,
+    llvh::ArrayRef<SymbolID> keys) {
+  auto object = runtime_.makeHandle(JSObject::create(runtime_));
+  GCScopeMarkerRAII marker{runtime_};
+  MutableHandle<> value{runtime_};
+  for (uint32_t slot = 0; slot < keys.size(); ++slot) {
+    value = JSObject::getNamedSlotValueUnsafe(*predicted, runtime_, slot)
+                .unboxToHV(runtime_);
+    (void)JSObject::defineOwnProperty(
+        object,
+        runtime_,
+        keys[slot],
+        DefinePropertyFlags::getDefaultNewPropertyFlags(),
+        value);
+  }
+  return object;
+}
+
+template <typename Stream>
+ExecutionStatus RuntimeJSONParser<Stream>::recordShape(
+    uint32_t level,
+    Handle<JSObject> object,
+    llvh::ArrayRef<SymbolID> keys) {
+  // The slots of a class that was built by adding distinct named keys one by
+  // one are in insertion order. A dictionary class may not be shared, and
+  // duplicate keys leave the class with fewer properties than keys.
+  const HiddenClass *clazz = object->getClass(runtime_);
+  if (clazz->isDictionary() || clazz->getHasIndexLikeProperties() ||
+      clazz->getNumProperties() != keys.size()) {
+    return ExecutionStatus::RETURNED;
+  }
+
+  if (LLVM_UNLIKELY(!shapeClasses_)) {
+    auto arrRes = PropStorage::create(runtime_, 4);
+    if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    shapeClasses_ = vmcast<PropStorage>(*arrRes);
+  }
+  if (shapeClasses_->size() <= level) {
+    if (LLVM_UNLIKELY(
+            PropStorage::resize(shapeClasses_, runtime_, level + 1) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    shapeKeys_.resize(level + 1);
+  }
+  shapeClasses_->set(
+      level,
+      SmallHermesValue::encodeObjectValue(object->getClass(runtime_), runtime_),
+      runtime_.getHeap());
+  shapeKeys_[level].assign(keys.begin(), keys.end());
+  return ExecutionStatus::RETURNED;
+}
+
+template <typename Stream>
+CallResult<HermesValue> RuntimeJSONParser<Stream>::revive(Handle<> value) {
   auto root = runtime_.makeHandle(JSObject::create(runtime_));
   auto status = JSObject::defineOwnProperty(
       root,
@@ -472,7 +730,8 @@ CallResult<HermesValue> RuntimeJSONParser::revive(Handle<> value) {
       root, runtime_.getPredefinedStringHandle(Predefined::emptyString));
 }
 
-CallResult<HermesValue> RuntimeJSONParser::operationWalk(
+template <typename Stream>
+CallResult<HermesValue> RuntimeJSONParser<Stream>::operationWalk(
     Handle<JSObject> holder,
     Handle<> property) {
   // The operation is recursive so it needs a GCScope.
@@ -542,7 +801,10 @@ CallResult<HermesValue> RuntimeJSONParser::operationWalk(
       .toCallResultHermesValue();
 }
 
-ExecutionStatus RuntimeJSONParser::filter(Handle<JSObject> val, Handle<> key) {
+template <typename Stream>
+ExecutionStatus RuntimeJSONParser<Stream>::filter(
+    Handle<JSObject> val,
+    Handle<> key) {
   auto jsonRes = operationWalk(val, key);
   if (LLVM_UNLIKELY(jsonRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
@@ -572,11 +834,26 @@ CallResult<HermesValue> runtimeJSONParse(
     Runtime &runtime,
     Handle<StringPrimitive> jsonString,
     Handle<Callable> reviver) {
-  // Our parser requires UTF16 data that does not move during GCs, so
-  // in most cases we'll need to copy, except for external 16-bit strings.
+  // Our parser requires data that does not move during GCs, so in most cases
+  // we'll need to copy, except for external strings. ASCII strings are parsed
+  // as 8-bit code units, without widening them to UTF16.
+  if (jsonString->isASCII()) {
+    ASCIIRef ref;
+    llvh::SmallVector<char, 32> storage;
+    if (LLVM_UNLIKELY(jsonString->isExternal())) {
+      ref = jsonString->getStringRef<char>();
+    } else {
+      ASCIIRef str = jsonString->getStringRef<char>();
+      storage.append(str.begin(), str.end());
+      ref = storage;
+    }
+    RuntimeJSONParser<ASCIIStream> parser{runtime, ASCIIStream(ref), reviver};
+    return parser.parse();
+  }
+
   UTF16Ref ref;
   SmallU16String<32> storage;
-  if (LLVM_UNLIKELY(jsonString->isExternal() && !jsonString->isASCII())) {
+  if (LLVM_UNLIKELY(jsonString->isExternal())) {
     ref = jsonString->getStringRef<char16_t>();
   } else {
     StringPrimitive::createStringView(runtime, jsonString)
@@ -584,18 +861,34 @@ CallResult<HermesValue> runtimeJSONParse(
     ref = storage;
   }
 
-  RuntimeJSONParser parser{runtime, UTF16Stream(ref), reviver};
+  RuntimeJSONParser<UTF16Stream> parser{runtime, UTF16Stream(ref), reviver};
   return parser.parse();
 }
 
 CallResult<HermesValue> runtimeJSONParseRef(
     Runtime &runtime,
     UTF16Stream &&stream) {
-  RuntimeJSONParser parser{
+  RuntimeJSONParser<UTF16Stream> parser{
       runtime, std::move(stream), Runtime::makeNullHandle<Callable>()};
   return parser.parse();
 }
 
+CallResult<HermesValue> runtimeJSONParseUTF8(
+    Runtime &runtime,
+    llvh::ArrayRef<uint8_t> utf8) {
+  // JSON documents are usually ASCII, which is also valid UTF8 and can be
+  // scanned in place. Otherwise, the UTF8 is converted in chunks.
+  if (isAllASCII(utf8.begin(), utf8.end())) {
+    RuntimeJSONParser<ASCIIStream> parser{
+        runtime,
+        ASCIIStream(ASCIIRef(
+            reinterpret_cast<const char *>(utf8.data()), utf8.size())),
+        Runtime::makeNullHandle<Callable>()};
+    return parser.parse();
+  }
+  return runtimeJSONParseRef(runtime, UTF16Stream(utf8));
+}
+
 ExecutionStatus JSONStringifyer::initializeReplacer(Handle<> replacer) {
   if (!vmisa<JSObject>(*replacer))
     return ExecutionStatus::RETURNED;
@@ -729,17 +1022,177 @@ ExecutionStatus JSONStringifyer::initializeSpace(Handle<> space) {
   return ExecutionStatus::RETURNED;
 }
 
-CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
+// Layout of an ArrayStorage stored in the JSON cache of a class:
+// [class(proto(obj)), class(proto(proto(obj))), ..., null, plain,
+//  name0, quotedName0, slot0, name1, quotedName1, slot1, ...]
+// where plain is a bool telling whether objects of the class are plain data
+// objects, and the names are the enumerable string-named properties of the
+// class in order, each followed by its quoted form and its slot index.
+// Since any change to the properties of a non-dictionary object gives it a new
+// class, the cache is valid for an object of the class as long as its
+// prototypes still have the recorded classes.
+
+/// Verifies that the classes of the prototype chain of \p obj still match
+/// those recorded in \p cache.
+/// \return the index of the plain flag in \p cache if they match, otherwise
+///   0.
+static uint32_t
+matchJSONCacheProtos(Runtime &runtime, JSObject *obj, ArrayStorage *cache) {
+  uint32_t i = 0;
+  for (JSObject *head = obj->getParent(runtime); head;
+       head = head->getParent(runtime)) {
+    HermesValue protoCls = cache->at(i++);
+    if (!protoCls.isObject() ||
+        protoCls.getObject() != head->getClass(runtime) ||
+        head->isProxyObject() || head->isHostObject() || head->isLazy()) {
+      return 0;
+    }
+  }
+  // The chains must both end at the same point.
+  return cache->at(i++).isNull() ? i : 0;
+}
+
+ExecutionStatus JSONStringifyer::lookupJSONCache(Handle<JSObject> obj) {
+  jsonCache_ = nullptr;
+  // A replacer can observe and change every value, so it needs the generic
+  // path.
+  if (replacerFunction_ || propertyList_)
+    return ExecutionStatus::RETURNED;
+  CellKind kind = obj->getKind();
+  if (kind != CellKind::JSObjectKind && kind != CellKind::JSArrayKind)
+    return ExecutionStatus::RETURNED;
+  HiddenClass *clazz = obj->getClass(runtime_);
+  if (clazz->isDictionary())
+    return ExecutionStatus::RETURNED;
+
+  if (ArrayStorage *cache = clazz->getJSONCache(runtime_)) {
+    if (uint32_t plainIndex = matchJSONCacheProtos(runtime_, *obj, cache)) {
+      if (cache->at(plainIndex).getBool())
+        jsonCache_ = cache;
+      return ExecutionStatus::RETURNED;
+    }
+    // Invalid for this object. We choose to clear the cache since the changes
+    // to the prototype chain probably affect other objects too.
+    clazz->clearJSONCache(runtime_);
+  }
+  return createJSONCache(obj);
+}
+
+ExecutionStatus JSONStringifyer::createJSONCache(Handle<JSObject> obj) {
   GCScopeMarkerRAII marker{runtime_};
-  tmpHandle_ = key;
+  const SymbolID toJSON = Predefined::getSymbolID(Predefined::toJSON);
+  Handle<HiddenClass> clazz = runtime_.makeHandle(obj->getClass(runtime_));
+  NamedPropertyDescriptor desc;
+
+  // Check the prototypes, which must all be cacheable, for toJSON.
+  bool plain = !clazz->getHasIndexLikeProperties() &&
+      !clazz->getMayHaveAccessor() &&
+      !JSObject::getOwnNamedDescriptor(obj, runtime_, toJSON, desc);
+  uint32_t numProtos = 0;
+  MutableHandle<JSObject> head{runtime_, obj->getParent(runtime_)};
+  for (; head; head = head->getParent(runtime_), ++numProtos) {
+    if (head->isProxyObject() || head->isHostObject() || head->isLazy() ||
+        head->getClass(runtime_)->isDictionary()) {
+      return ExecutionStatus::RETURNED;
+    }
+    if (plain && JSObject::getOwnNamedDescriptor(head, runtime_, toJSON, desc))
+      plain = false;
+  }
 
-  // Str.1: access holder[key].
-  auto propRes =
-      JSObject::getComputed_RJS(operationStrHolder_, runtime_, tmpHandle_);
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+  // Collect the properties that getOwnPropertyNames would return, in the same
+  // order.
+  llvh::SmallVector<std::pair<SymbolID, SlotIndex>, 8> props;
+  if (plain) {
+    HiddenClass::forEachProperty(
+        clazz, runtime_, [&](SymbolID id, NamedPropertyDescriptor desc) {
+          if (!isPropertyNamePrimitive(id) || !desc.flags.enumerable)
+            return;
+          if (desc.flags.accessor || desc.flags.hostObject ||
+              desc.flags.proxyObject || desc.flags.internalSetter) {
+            plain = false;
+          }
+          props.push_back({id, desc.slot});
+        });
+    if (!plain)
+      props.clear();
+  }
+
+  auto arrRes =
+      ArrayStorage::createLongLived(runtime_, numProtos + 2 + 3 * props.size());
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  MutableHandle<ArrayStorage> cache{
+      runtime_, vmcast<ArrayStorage>(*arrRes)};
+  MutableHandle<> tmp{runtime_};
+  auto pushBack = [&](HermesValue hv) {
+    tmp = hv;
+    return ArrayStorage::push_back(cache, runtime_, tmp);
+  };
+  for (head = obj->getParent(runtime_); head;
+       head = head->getParent(runtime_)) {
+    if (LLVM_UNLIKELY(
+            pushBack(HermesValue::encodeObjectValue(
+                head->getClass(runtime_))) == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  if (LLVM_UNLIKELY(
+          pushBack(HermesValue::encodeNullValue()) ==
+              ExecutionStatus::EXCEPTION ||
+          pushBack(HermesValue::encodeBoolValue(plain)) ==
+              ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  operationStrValue_.set(propRes->get());
+  for (const auto &prop : props) {
+    JSONOutput quoted;
+    StringView name =
+        runtime_.getIdentifierTable().getStringView(runtime_, prop.first);
+    if (name.isASCII()) {
+      quoteStringForJSON(
+          quoted, ASCIIRef{name.castToCharPtr(), name.length()});
+    } else {
+      quoteStringForJSON(
+          quoted, UTF16Ref{name.castToChar16Ptr(), name.length()});
+    }
+    auto quotedRes = quoted.toString(runtime_);
+    if (LLVM_UNLIKELY(quotedRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (LLVM_UNLIKELY(
+            pushBack(HermesValue::encodeStringValue(
+                runtime_.getStringPrimFromSymbolID(prop.first))) ==
+                ExecutionStatus::EXCEPTION ||
+            pushBack(*quotedRes) == ExecutionStatus::EXCEPTION ||
+            pushBack(HermesValue::encodeTrustedNumberValue(prop.second)) ==
+                ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+
+  clazz->setJSONCache(*cache, runtime_);
+  if (plain)
+    jsonCache_ = *cache;
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<bool> JSONStringifyer::operationStr(
+    HermesValue key,
+    HermesValue value) {
+  GCScopeMarkerRAII marker{runtime_};
+  tmpHandle_ = key;
+
+  if (!value.isEmpty()) {
+    operationStrValue_ = value;
+  } else {
+    // Str.1: access holder[key].
+    auto propRes =
+        JSObject::getComputed_RJS(operationStrHolder_, runtime_, tmpHandle_);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    operationStrValue_.set(propRes->get());
+  }
 
   // Str.2. If Type(value) is Object or BigInt, then
   MutableHandle<> hValueHV{runtime_, *operationStrValue_};
@@ -753,15 +1206,23 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
     hValueHV = std::move(*hObjRes);
   }
 
-  if (auto valueObj = Handle<JSObject>::dyn_vmcast(hValueHV)) {
+  // jsonCache_ is only set for plain data objects, which are known to have no
+  // toJSON, so the lookup can be skipped for them.
+  jsonCache_ = nullptr;
+  auto valueObj = Handle<JSObject>::dyn_vmcast(hValueHV);
+  if (valueObj &&
+      LLVM_UNLIKELY(lookupJSONCache(valueObj) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (valueObj && !jsonCache_) {
     // Str.2.
     // Str.2.a: check if toJSON exists in value.
-    if (LLVM_UNLIKELY(
-            (propRes = JSObject::getNamedWithReceiver_RJS(
-                 valueObj,
-                 runtime_,
-                 Predefined::getSymbolID(Predefined::toJSON),
-                 operationStrValue_)) == ExecutionStatus::EXCEPTION)) {
+    auto propRes = JSObject::getNamedWithReceiver_RJS(
+        valueObj,
+        runtime_,
+        Predefined::getSymbolID(Predefined::toJSON),
+        operationStrValue_);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
     // Str.2.b: check if toJSON is a Callable.
@@ -958,9 +1419,18 @@ ExecutionStatus JSONStringifyer::operationJA() {
     // JA.8.a.
     operationStrHolder_ = vmcast<JSObject>(
         stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+    // The elements of an array without index-like named properties are in
+    // its indexed storage, unless they are holes.
+    auto *arr = dyn_vmcast<JSArray>(*operationStrHolder_);
+    HermesValue value = arr &&
+            LLVM_LIKELY(!arr->getClass(runtime_)->getHasIndexLikeProperties())
+        ? arr->at(runtime_, static_cast<JSArray::size_type>(index))
+              .unboxToHV(runtime_)
+        : HermesValue::encodeEmptyValue();
     // Flush just before the recursion in case any handles were created.
     marker.flush();
-    auto status = operationStr(HermesValue::encodeUntrustedNumberValue(index));
+    auto status =
+        operationStr(HermesValue::encodeUntrustedNumberValue(index), value);
     if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
@@ -993,47 +1463,146 @@ ExecutionStatus JSONStringifyer::operationJO() {
   auto beginningLoc = output_.size();
   indent();
 
-  if (propertyList_) {
-    // JO.5.
-    operationJOK_ = propertyList_.get();
+  bool hasElement = false;
+  if (jsonCache_) {
+    // JO.5, 6, 8 for a plain data object, whose keys are cached in its class.
+    auto hasElementRes = operationJOFromCache();
+    if (LLVM_UNLIKELY(hasElementRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    hasElement = *hasElementRes;
   } else {
-    // JO.6.
-    tmpHandle_ = HermesValue::encodeObjectValue(
-        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
-    if (LLVM_LIKELY(!Handle<JSObject>::vmcast(tmpHandle_)->isProxyObject())) {
-      // enumerableOwnProperties_RJS is the spec definition, and is
-      // used below on proxies so the correct traps get called.  In
-      // the common case of a non-proxy object, we can do less work by
-      // calling getOwnPropertyNames.
-      auto cr = JSObject::getOwnPropertyNames(
-          Handle<JSObject>::vmcast(tmpHandle_), runtime_, true);
-      if (cr == ExecutionStatus::EXCEPTION) {
+    if (propertyList_) {
+      // JO.5.
+      operationJOK_ = propertyList_.get();
+    } else {
+      // JO.6.
+      tmpHandle_ = HermesValue::encodeObjectValue(
+          stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+      if (LLVM_LIKELY(
+              !Handle<JSObject>::vmcast(tmpHandle_)->isProxyObject())) {
+        // enumerableOwnProperties_RJS is the spec definition, and is
+        // used below on proxies so the correct traps get called.  In
+        // the common case of a non-proxy object, we can do less work by
+        // calling getOwnPropertyNames.
+        auto cr = JSObject::getOwnPropertyNames(
+            Handle<JSObject>::vmcast(tmpHandle_), runtime_, true);
+        if (cr == ExecutionStatus::EXCEPTION) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        operationJOK_ = **cr;
+      } else {
+        CallResult<HermesValue> ownPropRes = enumerableOwnProperties_RJS(
+            runtime_,
+            Handle<JSObject>::vmcast(tmpHandle_),
+            EnumerableOwnPropertiesKind::Key);
+        if (ownPropRes == ExecutionStatus::EXCEPTION) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        operationJOK_ = vmcast<JSArray>(*ownPropRes);
+      }
+    }
+
+    marker.flush();
+
+    // JO.8.
+    for (uint32_t index = 0, len = operationJOK_->getEndIndex(); index < len;
+         ++index) {
+      // JO.8.a.
+      // We are speculating that the Str operation will not return undefined,
+      // and just append the key/value pair to the output. If it turns out
+      // that the Str operation does return undefined, we roll back to
+      // curLocation.
+      auto savedLocation = output_.size();
+
+      if (hasElement) {
+        // JO.10.
+        output_.push_back(u',');
+        indent();
+      }
+
+      tmpHandle_ = operationJOK_->at(runtime_, index).unboxToHV(runtime_);
+      if (LLVM_UNLIKELY(!tmpHandle_->isString())) {
+        // property may come from getOwnPropertyNames, which may contain
+        // numbers. getOwnPropertyNames and propertyList_ are both only
+        // populated with strings, numbers, and undefined only.
+        // None of them are objects, so toString cannot throw.
+        assert(!tmpHandle_->isObject() && "property name is an object");
+        auto status = toString_RJS(runtime_, tmpHandle_);
+        assert(
+            status != ExecutionStatus::EXCEPTION &&
+            "toString on a property cannot fail");
+        tmpHandle_ = status->getHermesValue();
+      }
+      // tmpHandle now contains property as string.
+      // JO.8.b.i
+      operationQuote(StringPrimitive::createStringView(
+          runtime_, Handle<StringPrimitive>::vmcast(tmpHandle_)));
+      // JO.8.b.ii
+      output_.push_back(u':');
+      // JO.8.b.iii
+      if (gap_.get()) {
+        output_.push_back(u' ');
+      }
+
+      // JO.9.a.
+      operationStrHolder_ = vmcast<JSObject>(
+          stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+
+      tmpHandle2_ = operationJOK_.getHermesValue();
+      if (PropStorage::push_back(stackJO_, runtime_, tmpHandle2_) ==
+          ExecutionStatus::EXCEPTION) {
         return ExecutionStatus::EXCEPTION;
       }
-      operationJOK_ = **cr;
-    } else {
-      CallResult<HermesValue> ownPropRes = enumerableOwnProperties_RJS(
-          runtime_,
-          Handle<JSObject>::vmcast(tmpHandle_),
-          EnumerableOwnPropertiesKind::Key);
-      if (ownPropRes == ExecutionStatus::EXCEPTION) {
+
+      // Flush just before recursion (propStoragePushBack may create handles).
+      marker.flush();
+      auto result = operationStr(*tmpHandle_);
+
+      operationJOK_ =
+          vmcast<JSArray>(stackJO_->pop_back(runtime_).getObject(runtime_));
+
+      if (LLVM_UNLIKELY(result == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
-      operationJOK_ = vmcast<JSArray>(*ownPropRes);
+
+      if (LLVM_UNLIKELY(!result.getValue())) {
+        // Str returns undefined, we need to roll back.
+        output_.resize(savedLocation);
+      } else {
+        hasElement = true;
+      }
     }
   }
+  // It's important to reset depthCount_ first, because the last
+  // indent before } should be the old indent.
+  depthCount_ = stepBack;
+
+  if (hasElement) {
+    indent();
+  } else {
+    // If the object is empty, we need to roll back the first indent.
+    output_.resize(beginningLoc);
+  }
+  output_.push_back(u'}');
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<bool> JSONStringifyer::operationJOFromCache() {
+  GCScopeMarkerRAII marker{runtime_};
 
-  marker.flush();
+  // Skip the prototype classes, the null and the plain flag.
+  uint32_t begin = 0;
+  while (!jsonCache_->at(begin).isNull())
+    ++begin;
+  begin += 2;
 
   // JO.8.
   bool hasElement = false;
-  for (uint32_t index = 0, len = operationJOK_->getEndIndex(); index < len;
-       ++index) {
-    // JO.8.a.
-    // We are speculating that the Str operation will not return undefined,
-    // and just append the key/value pair to the output. If it turns out
-    // that the Str operation does return undefined, we roll back to
-    // curLocation.
+  for (uint32_t index = begin, len = jsonCache_->size(); index < len;
+       index += 3) {
+    // JO.8.a, speculating that Str will not return undefined as in
+    // operationJO.
     auto savedLocation = output_.size();
 
     if (hasElement) {
@@ -1042,23 +1611,8 @@ ExecutionStatus JSONStringifyer::operationJO() {
       indent();
     }
 
-    tmpHandle_ = operationJOK_->at(runtime_, index).unboxToHV(runtime_);
-    if (LLVM_UNLIKELY(!tmpHandle_->isString())) {
-      // property may come from getOwnPropertyNames, which may contain numbers.
-      // getOwnPropertyNames and propertyList_ are both only populated
-      // with strings, numbers, and undefined only.
-      // None of them are objects, so toString cannot throw.
-      assert(!tmpHandle_->isObject() && "property name is an object");
-      auto status = toString_RJS(runtime_, tmpHandle_);
-      assert(
-          status != ExecutionStatus::EXCEPTION &&
-          "toString on a property cannot fail");
-      tmpHandle_ = status->getHermesValue();
-    }
-    // tmpHandle now contains property as string.
-    // JO.8.b.i
-    operationQuote(StringPrimitive::createStringView(
-        runtime_, Handle<StringPrimitive>::vmcast(tmpHandle_)));
+    // JO.8.b.i, with the key quoted in advance.
+    appendToOutput(jsonCache_->at(index + 1).getString());
     // JO.8.b.ii
     output_.push_back(u':');
     // JO.8.b.iii
@@ -1066,22 +1620,31 @@ ExecutionStatus JSONStringifyer::operationJO() {
       output_.push_back(u' ');
     }
 
-    // JO.9.a.
-    operationStrHolder_ = vmcast<JSObject>(
-        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
-
-    tmpHandle2_ = operationJOK_.getHermesValue();
+    tmpHandle2_ = jsonCache_.getHermesValue();
     if (PropStorage::push_back(stackJO_, runtime_, tmpHandle2_) ==
         ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
     }
 
+    // JO.9.a.
+    operationStrHolder_ = vmcast<JSObject>(
+        stackValue_->at(stackValue_->size() - 1).getObject(runtime_));
+    // The value is in its slot as long as the object still has the class of
+    // the cache, which a toJSON called for a previous value may have changed.
+    JSObject *holder = *operationStrHolder_;
+    auto slot = static_cast<SlotIndex>(jsonCache_->at(index + 2).getNumber());
+    HermesValue value =
+        holder->getClass(runtime_)->getJSONCache(runtime_) == *jsonCache_
+        ? JSObject::getNamedSlotValueUnsafe(holder, runtime_, slot)
+              .unboxToHV(runtime_)
+        : HermesValue::encodeEmptyValue();
+
     // Flush just before recursion (propStoragePushBack may create handles).
     marker.flush();
-    auto result = operationStr(*tmpHandle_);
+    auto result = operationStr(jsonCache_->at(index), value);
 
-    operationJOK_ =
-        vmcast<JSArray>(stackJO_->pop_back(runtime_).getObject(runtime_));
+    jsonCache_ =
+        vmcast<ArrayStorage>(stackJO_->pop_back(runtime_).getObject(runtime_));
 
     if (LLVM_UNLIKELY(result == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
@@ -1094,18 +1657,7 @@ ExecutionStatus JSONStringifyer::operationJO() {
       hasElement = true;
     }
   }
-  // It's important to reset depthCount_ first, because the last
-  // indent before } should be the old indent.
-  depthCount_ = stepBack;
-
-  if (hasElement) {
-    indent();
-  } else {
-    // If the object is empty, we need to roll back the first indent.
-    output_.resize(beginningLoc);
-  }
-  output_.push_back(u'}');
-  return ExecutionStatus::RETURNED;
+  return hasElement;
 }
 
 void JSONStringifyer::indent() {
@@ -1144,7 +1696,10 @@ void JSONStringifyer::appendToOutput(SymbolID identifierID) {
 }
 
 void JSONStringifyer::appendToOutput(const StringPrimitive *str) {
-  str->appendUTF16String(output_);
+  if (str->isASCII())
+    output_.append(str->getStringRef<char>());
+  else
+    output_.append(str->getStringRef<char16_t>());
 }
 
 CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
@@ -1172,7 +1727,7 @@ CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
     return ExecutionStatus::EXCEPTION;
   }
   if (status.getValue()) {
-    return StringPrimitive::create(runtime_, output_);
+    return output_.toString(runtime_);
   } else {
     return HermesValue::encodeUndefinedValue();
   }
@@ -13,6 +13,7 @@
 #include "JSLibInternal.h"
 
 #include "hermes/Platform/Unicode/PlatformUnicode.h"
+#include "hermes/Support/StringSearch.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/PrimitiveBox.h"
 #include "hermes/VM/SmallXString.h"
@@ -746,6 +747,9 @@ stringPrototypeConcat(void *, Runtime &runtime, NativeArgs args) {
   auto S = runtime.makeHandle(std::move(*strRes));
   // Track the total characters in the result.
   SafeUInt32 size(S->getStringLength());
+  // Whether any of the strings is long enough to be worth not copying.
+  bool hasLongString =
+      S->getStringLength() >= StringPrimitive::CONCAT_STRING_MIN_SIZE;
   uint32_t argCount = args.getArgCount();
 
   // Store the results of toStrings and concat them at the end.
@@ -770,6 +774,7 @@ stringPrototypeConcat(void *, Runtime &runtime, NativeArgs args) {
         SmallHermesValue::encodeStringValue(strRes->get(), runtime),
         runtime.getHeap());
     uint32_t strLength = strRes->get()->getStringLength();
+    hasLongString |= strLength >= StringPrimitive::CONCAT_STRING_MIN_SIZE;
 
     size.add(strLength);
     if (LLVM_UNLIKELY(size.isOverflowed())) {
@@ -779,6 +784,25 @@ stringPrototypeConcat(void *, Runtime &runtime, NativeArgs args) {
     gcScope.flushToMarker(marker);
   }
 
+  if (hasLongString) {
+    // Concatenate the strings in turn, so that long strings become part of a
+    // rope or a concatenation buffer instead of being copied. This is the
+    // common case of template literals substituting a long string.
+    MutableHandle<StringPrimitive> result{runtime, S.get()};
+    MutableHandle<StringPrimitive> element{runtime};
+    auto concatMarker = gcScope.createMarker();
+    for (uint32_t i = 0; i < argCount; i++) {
+      element = strings->at(i).getString(runtime);
+      auto concatRes = StringPrimitive::concat(runtime, result, element);
+      if (LLVM_UNLIKELY(concatRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      result = concatRes->getString();
+      gcScope.flushToMarker(concatMarker);
+    }
+    return result.getHermesValue();
+  }
+
   // Allocate the complete result.
   auto builder = StringBuilder::createStringBuilder(runtime, size);
   if (builder == ExecutionStatus::EXCEPTION) {
@@ -1415,6 +1439,53 @@ stringPrototypeMatchAll(void *, Runtime &runtime, NativeArgs args) {
       .toCallResultHermesValue();
 }
 
+/// Search \p haystack for \p needle with hermes::stringSearch() (when \p Last
+/// is false) or hermes::stringSearchLast() (when \p Last is true), passing
+/// \p pos along. A needle with a different representation from the haystack
+/// is converted first: a UTF-16 needle containing non-ASCII characters can't
+/// occur in an ASCII haystack.
+/// \return the index of the match, or None.
+template <bool Last>
+static OptValue<uint32_t> stringViewSearch(
+    const StringView &haystack,
+    const StringView &needle,
+    uint32_t pos) {
+  size_t res;
+  if (haystack.isASCII()) {
+    llvh::ArrayRef<char> hayRef{haystack.castToCharPtr(), haystack.length()};
+    llvh::SmallVector<char, 32> narrowed;
+    llvh::ArrayRef<char> needleRef;
+    if (needle.isASCII()) {
+      needleRef = {needle.castToCharPtr(), needle.length()};
+    } else {
+      for (char16_t c : needle) {
+        if (c > 0x7f)
+          return llvh::None;
+        narrowed.push_back((char)c);
+      }
+      needleRef = narrowed;
+    }
+    res = Last ? stringSearchLast(hayRef, needleRef, pos)
+               : stringSearch(hayRef, needleRef, pos);
+  } else {
+    llvh::ArrayRef<char16_t> hayRef{
+        haystack.castToChar16Ptr(), haystack.length()};
+    llvh::SmallVector<char16_t, 32> widened;
+    llvh::ArrayRef<char16_t> needleRef;
+    if (needle.isASCII()) {
+      widened.append(needle.begin(), needle.end());
+      needleRef = widened;
+    } else {
+      needleRef = {needle.castToChar16Ptr(), needle.length()};
+    }
+    res = Last ? stringSearchLast(hayRef, needleRef, pos)
+               : stringSearch(hayRef, needleRef, pos);
+  }
+  if (res == kStringSearchNotFound)
+    return llvh::None;
+  return (uint32_t)res;
+}
+
 /// This provides a shared implementation of three operations in ES2021:
 /// 6.1.4.1 Runtime Semantics: StringIndexOf ( string, searchValue, fromIndex )
 ///   when clampPostion=false,
@@ -1515,35 +1586,15 @@ static CallResult<HermesValue> stringDirectedIndexOf(
   // Let start be min(max(pos, 0), len).
   uint32_t start = static_cast<uint32_t>(std::min(std::max(pos, 0.), len));
 
-  // TODO: good candidate for Boyer-Moore on large needles/haystacks
-  // TODO: good candidate for memchr on length-1 needles
   auto SView = StringPrimitive::createStringView(runtime, S);
   auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
-  double ret = -1;
-  if (reverse) {
-    // lastIndexOf
-    uint32_t lastPossibleMatchEnd =
-        std::min(SView.length(), start + searchStrView.length());
-    auto foundIter = std::search(
-        SView.rbegin() + (SView.length() - lastPossibleMatchEnd),
-        SView.rend(),
-        searchStrView.rbegin(),
-        searchStrView.rend());
-    if (foundIter != SView.rend() || searchStrView.empty()) {
-      ret = SView.rend() - foundIter - searchStrView.length();
-    }
-  } else {
-    // indexOf
-    auto foundIter = std::search(
-        SView.begin() + start,
-        SView.end(),
-        searchStrView.begin(),
-        searchStrView.end());
-    if (foundIter != SView.end() || searchStrView.empty()) {
-      ret = foundIter - SView.begin();
-    }
-  }
-  return HermesValue::encodeUntrustedNumberValue(ret);
+  // lastIndexOf finds the last match starting at or before start, indexOf the
+  // first match starting at or after it.
+  OptValue<uint32_t> found = reverse
+      ? stringViewSearch<true>(SView, searchStrView, start)
+      : stringViewSearch<false>(SView, searchStrView, start);
+  return HermesValue::encodeUntrustedNumberValue(
+      found.hasValue() ? (double)*found : -1.0);
 }
 
 /// ES12 6.1.4.1 Runtime Semantics: StringIndexOf ( string, searchValue,
@@ -2023,11 +2074,10 @@ stringPrototypeReplace(void *, Runtime &runtime, NativeArgs args) {
   auto strView = StringPrimitive::createStringView(runtime, string);
   if (!strView.empty()) {
     auto searchView = StringPrimitive::createStringView(runtime, searchString);
-    auto searchResult = std::search(
-        strView.begin(), strView.end(), searchView.begin(), searchView.end());
+    auto searchResult = stringViewSearch<false>(strView, searchView, 0);
 
-    if (searchResult != strView.end()) {
-      pos = searchResult - strView.begin();
+    if (searchResult.hasValue()) {
+      pos = *searchResult;
     } else {
       return string.getHermesValue();
     }
@@ -2331,12 +2381,9 @@ static OptValue<uint32_t> splitMatch(
   auto SStr = StringPrimitive::createStringView(runtime, S);
   auto RStr = StringPrimitive::createStringView(runtime, R);
 
-  auto sliced = SStr.slice(q);
-  auto searchResult =
-      std::search(sliced.begin(), sliced.end(), RStr.begin(), RStr.end());
-
-  if (searchResult != sliced.end()) {
-    return q + (searchResult - sliced.begin()) + r;
+  auto searchResult = stringViewSearch<false>(SStr, RStr, q);
+  if (searchResult.hasValue()) {
+    return *searchResult + r;
   }
   return llvh::None;
 }
@@ -2642,15 +2689,9 @@ CallResult<HermesValue> stringPrototypeIncludesOrStartsWith(
   // k, return false.
   auto SView = StringPrimitive::createStringView(runtime, S);
   auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
-  auto foundIter = std::search(
-      SView.begin() + start,
-      SView.end(),
-      searchStrView.begin(),
-      searchStrView.end());
-  // Note: searchStrView.empty check is needed in the special case that S is
-  // empty, searchStr is empty, and start = 0
   return HermesValue::encodeBoolValue(
-      foundIter != SView.end() || searchStrView.empty());
+      stringViewSearch<false>(SView, searchStrView, (uint32_t)start)
+          .hasValue());
 }
 
 CallResult<HermesValue>
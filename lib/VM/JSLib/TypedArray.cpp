@@ -342,10 +342,9 @@ CallResult<HermesValue> mapFilterLoop(
   return HermesValue::encodeUntrustedNumberValue(insert);
 }
 
-/// This is the sort model for use with TypedArray.prototype.sort.
-/// template param \p WithCompareFn should be true if the compare function is
-/// a valid callback to call, and false if it is null or undefined.
-template <bool WithCompareFn>
+/// This is the sort model for use with TypedArray.prototype.sort with a
+/// compare function, for arrays whose elements can't be copied out into
+/// numbers (see sortTypedArray()).
 class TypedArraySortModel : public SortModel {
  protected:
   /// Runtime to sort in.
@@ -355,7 +354,6 @@ class TypedArraySortModel : public SortModel {
   GCScope gcScope_;
 
   /// JS comparison function, return -1 for less, 0 for equal, 1 for greater.
-  /// If null, then use the built in < operator.
   Handle<Callable> compareFn_;
 
   /// Object to sort.
@@ -406,8 +404,6 @@ class TypedArraySortModel : public SortModel {
     {
       Handle<> aValHandle = runtime_.makeHandle(JSObject::getOwnIndexed(
           createPseudoHandle(self_.get()), runtime_, a));
-      // To avoid the need to create a handle for bVal a NoAllocScope is created
-      // below, to ensure no memory allocation will happen.
       HermesValue bVal =
           JSObject::getOwnIndexed(createPseudoHandle(self_.get()), runtime_, b);
 
@@ -415,26 +411,6 @@ class TypedArraySortModel : public SortModel {
       // after no more allocations are expected for a while.
       HermesValue aVal = *aValHandle;
 
-      {
-        NoAllocScope noAllocs{runtime_};
-        if (!WithCompareFn) {
-          if (LLVM_UNLIKELY(aVal.isBigInt())) {
-            return aVal.getBigInt()->compare(bVal.getBigInt());
-          } else {
-            double a = aVal.getNumber();
-            double b = bVal.getNumber();
-            if (LLVM_UNLIKELY(a == 0) && LLVM_UNLIKELY(b == 0) &&
-                LLVM_UNLIKELY(std::signbit(a)) &&
-                LLVM_UNLIKELY(!std::signbit(b))) {
-              // -0 < +0, according to the spec.
-              return -1;
-            }
-            return (a < b) ? -1 : (a > b ? 1 : 0);
-          }
-          assert(
-              compareFn_ && "Cannot use this version if the compareFn is null");
-        }
-      }
       // ES7 22.2.3.26 2a.
       // Let v be toNumber_RJS(Call(comparefn, undefined, x, y)).
       callRes = Callable::executeCall2(
@@ -460,6 +436,81 @@ class TypedArraySortModel : public SortModel {
   }
 };
 
+/// The default sort order of TypedArray elements (ES2023 23.2.4.7
+/// TypedArraySortCompare): numeric, with -0 before +0 and NaN last.
+template <typename T>
+bool typedArrayLess(T a, T b) {
+  if constexpr (std::is_floating_point<T>::value) {
+    if (LLVM_UNLIKELY(std::isnan(a)))
+      return false;
+    if (LLVM_UNLIKELY(std::isnan(b)))
+      return true;
+    if (LLVM_UNLIKELY(a == 0 && b == 0))
+      return std::signbit(a) && !std::signbit(b);
+  }
+  return a < b;
+}
+
+/// Sort the typed array \p self, whose elements are of type \p T, in place.
+/// Without a compare function this sorts the raw storage, since nothing can
+/// observe the order of the comparisons. With a compare function, the
+/// elements are copied out, sorted with timSort(), and copied back, unless
+/// they are BigInts, which would have to be allocated for every call; these
+/// use TypedArraySortModel.
+template <typename T, CellKind C>
+ExecutionStatus sortTypedArray(
+    Runtime &runtime,
+    Handle<JSTypedArrayBase> selfBase,
+    Handle<Callable> compareFn) {
+  auto self = Handle<JSTypedArray<T, C>>::vmcast(selfBase);
+  const JSTypedArrayBase::size_type len = self->getLength();
+  if (len < 2)
+    return ExecutionStatus::RETURNED;
+
+  if (!compareFn) {
+    T *begin = self->begin(runtime);
+    std::sort(begin, begin + len, typedArrayLess<T>);
+    return ExecutionStatus::RETURNED;
+  }
+
+  if (C == CellKind::BigInt64ArrayKind || C == CellKind::BigUint64ArrayKind) {
+    TypedArraySortModel sm(runtime, self, compareFn);
+    return timSort(&sm, 0, len);
+  }
+
+  std::vector<T> elements(self->begin(runtime), self->begin(runtime) + len);
+  auto less = [&runtime, self, compareFn](T a, T b) -> CallResult<bool> {
+    GCScopeMarkerRAII marker{runtime};
+    // ES7 22.2.3.26 2a.
+    // Let v be toNumber_RJS(Call(comparefn, undefined, x, y)).
+    auto callRes = Callable::executeCall2(
+        compareFn,
+        runtime,
+        Runtime::getUndefinedValue(),
+        HermesValue::encodeUntrustedNumberValue(a),
+        HermesValue::encodeUntrustedNumberValue(b));
+    if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    auto numRes =
+        toNumber_RJS(runtime, runtime.makeHandle(std::move(*callRes)));
+    if (LLVM_UNLIKELY(numRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    // ES7 22.2.3.26 2b.
+    // If IsDetachedBuffer(buffer) is true, throw a TypeError exception.
+    if (LLVM_UNLIKELY(!self->attached(runtime)))
+      return runtime.raiseTypeError("Callback to sort() detached the array");
+    // NaN is treated as equal.
+    return numRes->getNumber() < 0;
+  };
+  if (LLVM_UNLIKELY(
+          timSort(llvh::MutableArrayRef<T>(elements), less) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  std::copy(elements.begin(), elements.end(), self->begin(runtime));
+  return ExecutionStatus::RETURNED;
+}
+
 // ES7 22.2.3.23.1
 CallResult<HermesValue> typedArrayPrototypeSetObject(
     Runtime &runtime,
@@ -1496,7 +1547,6 @@ typedArrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   auto self = args.vmcastThis<JSTypedArrayBase>();
-  const JSTypedArrayBase::size_type len = self->getLength();
 
   // Null if not a callable compareFn.
   auto compareFn = Handle<Callable>::dyn_vmcast(args.getArgHandle(0));
@@ -1504,17 +1554,17 @@ typedArrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
     return runtime.raiseTypeError("TypedArray sort argument must be callable");
   }
 
-  // Use our custom sort routine. We can't use std::sort because it performs
-  // optimizations that allow it to bypass calls to std::swap, but our swap
-  // function is special, since it needs to use the internal Object functions.
-  if (compareFn) {
-    TypedArraySortModel<true> sm(runtime, self, compareFn);
-    if (LLVM_UNLIKELY(quickSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
-      return ExecutionStatus::EXCEPTION;
-  } else {
-    TypedArraySortModel<false> sm(runtime, self, compareFn);
-    if (LLVM_UNLIKELY(quickSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
-      return ExecutionStatus::EXCEPTION;
+  switch (self->getKind()) {
+#define TYPED_ARRAY(name, type)                                            \
+  case CellKind::name##ArrayKind:                                          \
+    if (LLVM_UNLIKELY(                                                     \
+            (sortTypedArray<type, CellKind::name##ArrayKind>(              \
+                runtime, self, compareFn)) == ExecutionStatus::EXCEPTION)) \
+      return ExecutionStatus::EXCEPTION;                                   \
+    break;
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray after ValidateTypedArray call");
   }
   return self.getHermesValue();
 }
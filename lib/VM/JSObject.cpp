@@ -78,7 +78,19 @@ void JSObjectBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
 
 PseudoHandle<JSObject> JSObject::create(
     Runtime &runtime,
-    Handle<JSObject> parentHandle) {
+    Handle<JSObject> parentHandle,
+    LongLived longLived) {
+  if (LLVM_UNLIKELY(longLived == LongLived::Yes)) {
+    // An object in the old generation needs write barriers, since its parent
+    // may be in the young generation.
+    auto *cell = runtime.makeAFixed<JSObject, HasFinalizer::No, LongLived::Yes>(
+        runtime,
+        parentHandle,
+        runtime.getHiddenClassForPrototype(
+            *parentHandle, numOverlapSlots<JSObject>()),
+        GCPointerBase::YesBarriers());
+    return JSObjectInit::initToPseudoHandle(runtime, cell);
+  }
   auto *cell = runtime.makeAFixed<JSObject>(
       runtime,
       parentHandle,
@@ -103,8 +115,15 @@ PseudoHandle<JSObject> JSObject::create(
 
 PseudoHandle<JSObject> JSObject::create(
     Runtime &runtime,
-    Handle<HiddenClass> clazz) {
-  auto obj = JSObject::create(runtime, clazz->getNumProperties());
+    Handle<HiddenClass> clazz,
+    LongLived longLived) {
+  auto obj = runtime.ignoreAllocationFailure(JSObject::allocatePropStorage(
+      create(
+          runtime,
+          Handle<JSObject>::vmcast(&runtime.objectPrototype),
+          longLived),
+      runtime,
+      clazz->getNumProperties()));
   obj->clazz_.setNonNull(runtime, *clazz, runtime.getHeap());
   // If the hidden class has index like property, we need to clear the fast path
   // flag.
@@ -1036,6 +1055,45 @@ ExecutionStatus JSObject::getComputedDescriptor(
       selfHandle, runtime, *converted, propObj, tmpSymbolStorage, desc);
 }
 
+void JSObject::cachePrototypeChainLookup(
+    JSObject *self,
+    PointerBase &base,
+    JSObject *propObj,
+    NamedPropertyDescriptor desc,
+    PropertyCacheEntry *cacheEntry) {
+  assert(
+      !desc.flags.hostObject && !desc.flags.proxyObject &&
+      "cannot cache host or proxy lookups");
+  // First validate the chain and compute the depth of the holder.
+  unsigned depth = 0;
+  for (JSObject *curr = self;; curr = curr->parent_.get(base), ++depth) {
+    if (!curr || depth > PropertyCacheEntry::kMaxProtoDepth ||
+        curr->flags_.lazyObject || curr->flags_.hostObject ||
+        curr->flags_.proxyObject) {
+      return;
+    }
+    HiddenClass *clazz = curr->clazz_.getNonNull(base);
+    if (curr == propObj) {
+      // The holder may be a dictionary, as long as its slots are stable.
+      if (clazz->isDictionaryNoCache())
+        return;
+      break;
+    }
+    // A dictionary class can gain properties without changing, so it can't
+    // be used to prove that the property is absent from this object.
+    if (clazz->isDictionary())
+      return;
+  }
+
+  cacheEntry->clearProtoEntry();
+  JSObject *curr = self;
+  for (unsigned i = 0; i <= depth; ++i, curr = curr->parent_.get(base))
+    cacheEntry->protoChain[i] = curr->clazz_;
+  cacheEntry->protoDepth = depth;
+  cacheEntry->protoSlot = desc.slot;
+  cacheEntry->protoAccessor = desc.flags.accessor;
+}
+
 CallResult<PseudoHandle<>> JSObject::getNamedWithReceiver_RJS(
     Handle<JSObject> selfHandle,
     Runtime &runtime,
@@ -1060,16 +1118,24 @@ CallResult<PseudoHandle<>> JSObject::getNamedWithReceiver_RJS(
   if (LLVM_LIKELY(
           !desc.flags.accessor && !desc.flags.hostObject &&
           !desc.flags.proxyObject)) {
-    // Populate the cache if requested.
-    if (cacheEntry && !propObj->getClass(runtime)->isDictionaryNoCache()) {
-      cacheEntry->clazz = propObj->getClassGCPtr();
-      cacheEntry->slot = desc.slot;
+    // Populate the cache if requested. Own properties go into the
+    // polymorphic entries, inherited ones into the prototype chain entry.
+    if (cacheEntry) {
+      if (propObj == *selfHandle) {
+        if (!propObj->getClass(runtime)->isDictionaryNoCache())
+          cacheEntry->update(propObj->getClassGCPtr(), desc.slot);
+      } else {
+        cachePrototypeChainLookup(
+            *selfHandle, runtime, propObj, desc, cacheEntry);
+      }
     }
     return createPseudoHandle(
         getNamedSlotValueUnsafe(propObj, runtime, desc).unboxToHV(runtime));
   }
 
   if (desc.flags.accessor) {
+    if (cacheEntry)
+      cachePrototypeChainLookup(*selfHandle, runtime, propObj, desc, cacheEntry);
     auto *accessor = vmcast<PropertyAccessor>(
         getNamedSlotValueUnsafe(propObj, runtime, desc).getPointer(runtime));
     if (!accessor->getter)
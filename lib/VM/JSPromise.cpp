@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/JSPromise.h"
+
+#include "hermes/VM/ArrayStorage.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/JSNativeFunctions.h"
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/Runtime-inline.h"
+#include "hermes/VM/StackFrame-inline.h"
+
+namespace hermes {
+namespace vm {
+
+namespace {
+
+/// Internal slots of the resolving functions of a promise.
+enum ResolvingSlot {
+  /// The promise to settle, cleared once either function was called.
+  ResolvingPromise,
+  /// The other resolving function of the pair.
+  ResolvingPartner,
+  ResolvingSlotCount
+};
+
+/// Internal slots of a capability created by newPromiseCapability(), which is
+/// the executor passed to the constructor.
+enum CapabilitySlot {
+  CapabilityResolve,
+  CapabilityReject,
+  CapabilityPromise,
+  CapabilitySlotCount
+};
+
+/// Create a native function with \p slotCount internal slots, which are all
+/// initialized to undefined.
+Handle<NativeFunction> createWithSlots(
+    Runtime &runtime,
+    NativeFunctionPtr functionPtr,
+    unsigned paramCount,
+    unsigned slotCount) {
+  Handle<NativeFunction> fn = NativeFunction::createWithoutPrototype(
+      runtime,
+      nullptr,
+      functionPtr,
+      Predefined::getSymbolID(Predefined::emptyString),
+      paramCount,
+      slotCount);
+  // Slots past the direct property slots aren't initialized to undefined.
+  for (unsigned i = 0; i < slotCount; ++i) {
+    NativeFunction::setAdditionalSlotValue(
+        *fn, runtime, i, SmallHermesValue::encodeUndefinedValue());
+  }
+  return fn;
+}
+
+HermesValue getSlot(NativeFunction *fn, Runtime &runtime, unsigned index) {
+  return NativeFunction::getAdditionalSlotValue(fn, runtime, index)
+      .unboxToHV(runtime);
+}
+
+void setSlot(
+    Handle<NativeFunction> fn,
+    Runtime &runtime,
+    unsigned index,
+    Handle<> value) {
+  auto shv = SmallHermesValue::encodeHermesValue(*value, runtime);
+  NativeFunction::setAdditionalSlotValue(*fn, runtime, index, shv);
+}
+
+void clearSlot(NativeFunction *fn, Runtime &runtime, unsigned index) {
+  NativeFunction::setAdditionalSlotValue(
+      fn, runtime, index, SmallHermesValue::encodeUndefinedValue());
+}
+
+/// Reject \p promise with the value thrown by the last operation, unless it
+/// can't be caught.
+ExecutionStatus rejectWithThrownValue(
+    Handle<JSPromise> promise,
+    Runtime &runtime) {
+  if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+    return ExecutionStatus::EXCEPTION;
+  Handle<> reason = runtime.makeHandle(runtime.getThrownValue());
+  runtime.clearThrownValue();
+  return JSPromise::reject(promise, runtime, reason);
+}
+
+/// Tell the rejection tracker registered by the internal bytecode that
+/// \p promise was rejected without a handler, or was handled after that.
+ExecutionStatus trackRejection(
+    Runtime &runtime,
+    Handle<JSPromise> promise,
+    bool isReject,
+    HermesValue reason) {
+  auto tracker = Handle<Callable>::dyn_vmcast(
+      Handle<>(&runtime.promiseRejectionTracker_));
+  if (!tracker)
+    return ExecutionStatus::RETURNED;
+  return Callable::executeCall3(
+             tracker,
+             runtime,
+             Runtime::getUndefinedValue(),
+             promise.getHermesValue(),
+             HermesValue::encodeBoolValue(isReject),
+             reason)
+      .getStatus();
+}
+
+/// \return the promise settled by the resolving function \p fn, clearing it
+/// from \p fn and its partner so that later calls have no effect, or nullptr
+/// if either of them was called already.
+JSPromise *takeResolvingPromise(NativeFunction *fn, Runtime &runtime) {
+  HermesValue promise = getSlot(fn, runtime, ResolvingPromise);
+  if (promise.isUndefined())
+    return nullptr;
+  auto *partner =
+      vmcast<NativeFunction>(getSlot(fn, runtime, ResolvingPartner));
+  clearSlot(fn, runtime, ResolvingPromise);
+  clearSlot(partner, runtime, ResolvingPromise);
+  return vmcast<JSPromise>(promise);
+}
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// class JSPromise
+
+const ObjectVTable JSPromise::vt{
+    VTable(CellKind::JSPromiseKind, cellSize<JSPromise>()),
+    JSPromise::_getOwnIndexedRangeImpl,
+    JSPromise::_haveOwnIndexedImpl,
+    JSPromise::_getOwnIndexedPropertyFlagsImpl,
+    JSPromise::_getOwnIndexedImpl,
+    JSPromise::_setOwnIndexedImpl,
+    JSPromise::_deleteOwnIndexedImpl,
+    JSPromise::_checkAllOwnIndexedImpl,
+};
+
+void JSPromiseBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  mb.addJSObjectOverlapSlots(JSObject::numOverlapSlots<JSPromise>());
+  JSObjectBuildMeta(cell, mb);
+  const auto *self = static_cast<const JSPromise *>(cell);
+  mb.setVTable(&JSPromise::vt);
+  mb.addField("result", &self->result_);
+  mb.addField("reactions", &self->reactions_);
+}
+
+PseudoHandle<JSPromise> JSPromise::create(
+    Runtime &runtime,
+    Handle<JSObject> parentHandle) {
+  auto *cell = runtime.makeAFixed<JSPromise>(
+      runtime,
+      parentHandle,
+      runtime.getHiddenClassForPrototype(
+          *parentHandle, numOverlapSlots<JSPromise>()));
+  return JSObjectInit::initToPseudoHandle(runtime, cell);
+}
+
+JSPromise *JSPromise::getTarget(JSPromise *self) {
+  while (self->state_ == State::Adopted)
+    self = vmcast<JSPromise>(self->result_);
+  return self;
+}
+
+bool JSPromise::isIntrinsicThen(HermesValue value) {
+  auto *fn = dyn_vmcast<NativeFunction>(value);
+  return fn && fn->getFunctionPtr() == promisePrototypeThen;
+}
+
+ExecutionStatus JSPromise::resolve(
+    Handle<JSPromise> self,
+    Runtime &runtime,
+    Handle<> resolution) {
+  if (!resolution->isObject())
+    return settle(self, runtime, State::Fulfilled, resolution);
+  if (LLVM_UNLIKELY(resolution->getObject() == self.get())) {
+    (void)runtime.raiseTypeError("A promise cannot be resolved with itself.");
+    return rejectWithThrownValue(self, runtime);
+  }
+
+  auto thenRes = JSObject::getNamed_RJS(
+      Handle<JSObject>::vmcast(resolution),
+      runtime,
+      Predefined::getSymbolID(Predefined::then));
+  if (LLVM_UNLIKELY(thenRes == ExecutionStatus::EXCEPTION))
+    return rejectWithThrownValue(self, runtime);
+
+  if (vmisa<JSPromise>(*resolution) && isIntrinsicThen(thenRes->get())) {
+    // Adopt the state of the native promise without going through a job.
+    Handle<JSPromise> target =
+        runtime.makeHandle(getTarget(vmcast<JSPromise>(*resolution)));
+    if (LLVM_UNLIKELY(target.get() == self.get())) {
+      (void)runtime.raiseTypeError("Chaining cycle detected for promise");
+      return rejectWithThrownValue(self, runtime);
+    }
+    self->state_ = State::Adopted;
+    self->result_.set(*resolution, runtime.getHeap());
+    return moveReactions(self, runtime, target);
+  }
+
+  auto then = Handle<Callable>::dyn_vmcast(runtime.makeHandle(thenRes->get()));
+  if (!then)
+    return settle(self, runtime, State::Fulfilled, resolution);
+
+  // Any other thenable is resolved by calling its then method right away.
+  auto fns = createResolvingFunctions(self, runtime);
+  if (LLVM_UNLIKELY(
+          Callable::executeCall2(
+              then,
+              runtime,
+              resolution,
+              fns.first.getHermesValue(),
+              fns.second.getHermesValue()) == ExecutionStatus::EXCEPTION)) {
+    if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+      return ExecutionStatus::EXCEPTION;
+    if (!takeResolvingPromise(*fns.second, runtime)) {
+      // The promise was resolved before the exception, which is ignored.
+      runtime.clearThrownValue();
+      return ExecutionStatus::RETURNED;
+    }
+    return rejectWithThrownValue(self, runtime);
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus
+JSPromise::reject(Handle<JSPromise> self, Runtime &runtime, Handle<> reason) {
+  return settle(self, runtime, State::Rejected, reason);
+}
+
+ExecutionStatus JSPromise::settle(
+    Handle<JSPromise> self,
+    Runtime &runtime,
+    State state,
+    Handle<> result) {
+  assert(self->state_ == State::Pending && "promise is already resolved");
+  self->state_ = state;
+  self->result_.set(*result, runtime.getHeap());
+  if (state == State::Rejected && !self->isHandled_) {
+    if (LLVM_UNLIKELY(
+            trackRejection(runtime, self, true, *result) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+
+  return moveReactions(self, runtime, self);
+}
+
+ExecutionStatus JSPromise::moveReactions(
+    Handle<JSPromise> self,
+    Runtime &runtime,
+    Handle<JSPromise> target) {
+  Handle<> reactions = runtime.makeHandle(self->reactions_);
+  self->reactions_.setNonPtr(
+      HermesValue::encodeUndefinedValue(), runtime.getHeap());
+  if (reactions->isUndefined())
+    return ExecutionStatus::RETURNED;
+  if (auto *single = dyn_vmcast<NativeFunction>(*reactions))
+    return addReaction(target, runtime, runtime.makeHandle(single));
+  auto storage = Handle<ArrayStorage>::vmcast(reactions);
+  MutableHandle<NativeFunction> reaction{runtime};
+  GCScopeMarkerRAII marker{runtime};
+  for (size_t i = 0, e = storage->size(); i < e; ++i) {
+    marker.flush();
+    reaction = vmcast<NativeFunction>(storage->at(i));
+    if (LLVM_UNLIKELY(
+            addReaction(target, runtime, reaction) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+Handle<NativeFunction> JSPromise::createReactionRecord(
+    Runtime &runtime,
+    NativeFunctionPtr job) {
+  return createWithSlots(runtime, job, 0, ReactionSlotCount);
+}
+
+Handle<NativeFunction> JSPromise::createReaction(
+    Runtime &runtime,
+    Handle<> onFulfilled,
+    Handle<> onRejected,
+    Handle<JSObject> capability) {
+  Handle<NativeFunction> reaction =
+      createReactionRecord(runtime, promiseReactionJob);
+  if (vmisa<Callable>(*onFulfilled))
+    setSlot(reaction, runtime, OnFulfilled, onFulfilled);
+  if (vmisa<Callable>(*onRejected))
+    setSlot(reaction, runtime, OnRejected, onRejected);
+  setSlot(reaction, runtime, Capability, capability);
+  return reaction;
+}
+
+ExecutionStatus JSPromise::addReaction(
+    Handle<JSPromise> self,
+    Runtime &runtime,
+    Handle<NativeFunction> reaction) {
+  Handle<JSPromise> target = self->state_ == State::Adopted
+      ? runtime.makeHandle(getTarget(*self))
+      : self;
+  bool wasHandled = target->isHandled_;
+  target->isHandled_ = true;
+
+  switch (target->state_) {
+    case State::Pending: {
+      if (target->reactions_.isUndefined()) {
+        target->reactions_.set(reaction.getHermesValue(), runtime.getHeap());
+        return ExecutionStatus::RETURNED;
+      }
+      MutableHandle<ArrayStorage> storage{runtime};
+      if (vmisa<ArrayStorage>(target->reactions_)) {
+        storage = vmcast<ArrayStorage>(target->reactions_);
+      } else {
+        auto arrRes = ArrayStorage::create(runtime, 2);
+        if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        storage = vmcast<ArrayStorage>(*arrRes);
+        Handle<> first = runtime.makeHandle(target->reactions_);
+        if (LLVM_UNLIKELY(
+                ArrayStorage::push_back(storage, runtime, first) ==
+                ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+      }
+      if (LLVM_UNLIKELY(
+              ArrayStorage::push_back(storage, runtime, reaction) ==
+              ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      target->reactions_.set(storage.getHermesValue(), runtime.getHeap());
+      return ExecutionStatus::RETURNED;
+    }
+    case State::Rejected:
+      if (!wasHandled &&
+          LLVM_UNLIKELY(
+              trackRejection(
+                  runtime,
+                  target,
+                  false,
+                  HermesValue::encodeUndefinedValue()) ==
+              ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      [[fallthrough]];
+    case State::Fulfilled:
+      setSlot(reaction, runtime, Settled, target);
+      return enqueueReaction(runtime, reaction);
+    case State::Adopted:
+      break;
+  }
+  llvm_unreachable("target of a promise cannot be adopted");
+}
+
+ExecutionStatus JSPromise::enqueueReaction(
+    Runtime &runtime,
+    Handle<NativeFunction> reaction) {
+  if (LLVM_LIKELY(runtime.hasMicrotaskQueue())) {
+    runtime.enqueueJob(*reaction);
+    return ExecutionStatus::RETURNED;
+  }
+  // Without a microtask queue, the host runs the jobs in setImmediate.
+  auto propRes = JSObject::getNamed_RJS(
+      runtime.getGlobal(),
+      runtime,
+      Predefined::getSymbolID(Predefined::setImmediate));
+  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto setImmediate =
+      Handle<Callable>::dyn_vmcast(runtime.makeHandle(std::move(*propRes)));
+  if (LLVM_UNLIKELY(!setImmediate)) {
+    return runtime.raiseTypeError(
+        "setImmediate must be a function to run promise jobs");
+  }
+  return Callable::executeCall1(
+             setImmediate,
+             runtime,
+             Runtime::getUndefinedValue(),
+             reaction.getHermesValue())
+      .getStatus();
+}
+
+std::pair<Handle<NativeFunction>, Handle<NativeFunction>>
+JSPromise::createResolvingFunctions(Handle<JSPromise> self, Runtime &runtime) {
+  Handle<NativeFunction> resolveFn =
+      createWithSlots(runtime, promiseResolveFunction, 1, ResolvingSlotCount);
+  Handle<NativeFunction> rejectFn =
+      createWithSlots(runtime, promiseRejectFunction, 1, ResolvingSlotCount);
+  setSlot(resolveFn, runtime, ResolvingPromise, self);
+  setSlot(resolveFn, runtime, ResolvingPartner, rejectFn);
+  setSlot(rejectFn, runtime, ResolvingPromise, self);
+  setSlot(rejectFn, runtime, ResolvingPartner, resolveFn);
+  return {resolveFn, rejectFn};
+}
+
+CallResult<Handle<JSObject>> JSPromise::newPromiseCapability(
+    Runtime &runtime,
+    Handle<> C) {
+  if (C->isObject() && runtime.promiseConstructor.isObject() &&
+      C->getObject() == runtime.promiseConstructor.getObject()) {
+    return Handle<JSObject>(runtime.makeHandle(JSPromise::create(runtime)));
+  }
+
+  auto ctor = Handle<Callable>::dyn_vmcast(C);
+  auto isCtorRes = isConstructor(runtime, ctor ? *ctor : nullptr);
+  if (LLVM_UNLIKELY(isCtorRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (!*isCtorRes)
+    return runtime.raiseTypeError("Promise capability must be a constructor");
+
+  Handle<NativeFunction> executor = createWithSlots(
+      runtime, promiseCapabilityExecutor, 2, CapabilitySlotCount);
+  auto promiseRes = Callable::executeConstruct1(ctor, runtime, executor);
+  if (LLVM_UNLIKELY(promiseRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<> promise = runtime.makeHandle(std::move(*promiseRes));
+  if (!vmisa<Callable>(getSlot(*executor, runtime, CapabilityResolve)) ||
+      !vmisa<Callable>(getSlot(*executor, runtime, CapabilityReject))) {
+    return runtime.raiseTypeError(
+        "Promise resolve or reject function is not callable");
+  }
+  setSlot(executor, runtime, CapabilityPromise, promise);
+  return Handle<JSObject>(executor);
+}
+
+HermesValue JSPromise::getCapabilityPromise(
+    Runtime &runtime,
+    Handle<JSObject> capability) {
+  if (vmisa<JSPromise>(*capability))
+    return capability.getHermesValue();
+  return getSlot(
+      vmcast<NativeFunction>(*capability), runtime, CapabilityPromise);
+}
+
+ExecutionStatus JSPromise::settleCapability(
+    Runtime &runtime,
+    Handle<JSObject> capability,
+    Handle<> value,
+    bool isReject) {
+  if (auto promise = Handle<JSPromise>::dyn_vmcast(capability)) {
+    return isReject ? reject(promise, runtime, value)
+                    : resolve(promise, runtime, value);
+  }
+  auto fn = runtime.makeHandle(vmcast<Callable>(getSlot(
+      vmcast<NativeFunction>(*capability),
+      runtime,
+      isReject ? CapabilityReject : CapabilityResolve)));
+  return Callable::executeCall1(
+             fn, runtime, Runtime::getUndefinedValue(), *value)
+      .getStatus();
+}
+
+//===----------------------------------------------------------------------===//
+// Native functions created for each promise.
+
+CallResult<HermesValue>
+promiseResolveFunction(void *, Runtime &runtime, NativeArgs args) {
+  auto *self = vmcast<NativeFunction>(
+      runtime.getCurrentFrame()->getCalleeClosureUnsafe());
+  if (JSPromise *promise = takeResolvingPromise(self, runtime)) {
+    if (LLVM_UNLIKELY(
+            JSPromise::resolve(
+                runtime.makeHandle(promise), runtime, args.getArgHandle(0)) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return HermesValue::encodeUndefinedValue();
+}
+
+CallResult<HermesValue>
+promiseRejectFunction(void *, Runtime &runtime, NativeArgs args) {
+  auto *self = vmcast<NativeFunction>(
+      runtime.getCurrentFrame()->getCalleeClosureUnsafe());
+  if (JSPromise *promise = takeResolvingPromise(self, runtime)) {
+    if (LLVM_UNLIKELY(
+            JSPromise::reject(
+                runtime.makeHandle(promise), runtime, args.getArgHandle(0)) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return HermesValue::encodeUndefinedValue();
+}
+
+CallResult<HermesValue>
+promiseCapabilityExecutor(void *, Runtime &runtime, NativeArgs args) {
+  auto self = Handle<NativeFunction>::vmcast(
+      runtime.getCurrentFrame()->getCalleeClosureHandleUnsafe());
+  if (!getSlot(*self, runtime, CapabilityResolve).isUndefined() ||
+      !getSlot(*self, runtime, CapabilityReject).isUndefined()) {
+    return runtime.raiseTypeError("Promise executor was already called");
+  }
+  setSlot(self, runtime, CapabilityResolve, args.getArgHandle(0));
+  setSlot(self, runtime, CapabilityReject, args.getArgHandle(1));
+  return HermesValue::encodeUndefinedValue();
+}
+
+CallResult<HermesValue>
+promiseReactionJob(void *, Runtime &runtime, NativeArgs) {
+  GCScope gcScope{runtime};
+  auto reaction = Handle<NativeFunction>::vmcast(
+      runtime.getCurrentFrame()->getCalleeClosureHandleUnsafe());
+  // A host could run a job queued with setImmediate more than once.
+  HermesValue capabilityHV =
+      getSlot(*reaction, runtime, JSPromise::Capability);
+  if (LLVM_UNLIKELY(capabilityHV.isUndefined()))
+    return HermesValue::encodeUndefinedValue();
+  Handle<JSObject> capability =
+      runtime.makeHandle(vmcast<JSObject>(capabilityHV));
+  clearSlot(*reaction, runtime, JSPromise::Capability);
+
+  auto *settled =
+      vmcast<JSPromise>(getSlot(*reaction, runtime, JSPromise::Settled));
+  bool isReject = settled->getState() == JSPromise::State::Rejected;
+  MutableHandle<> value{runtime, settled->getResult()};
+  auto handler = Handle<Callable>::dyn_vmcast(runtime.makeHandle(getSlot(
+      *reaction,
+      runtime,
+      isReject ? JSPromise::OnRejected : JSPromise::OnFulfilled)));
+  if (handler) {
+    auto callRes = Callable::executeCall1(
+        handler, runtime, Runtime::getUndefinedValue(), *value);
+    if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
+      if (LLVM_UNLIKELY(isUncatchableError(runtime.getThrownValue())))
+        return ExecutionStatus::EXCEPTION;
+      value = runtime.getThrownValue();
+      runtime.clearThrownValue();
+      isReject = true;
+    } else {
+      value = callRes->get();
+      isReject = false;
+    }
+  }
+  if (LLVM_UNLIKELY(
+          JSPromise::settleCapability(runtime, capability, value, isReject) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return HermesValue::encodeUndefinedValue();
+}
+
+} // namespace vm
+} // namespace hermes
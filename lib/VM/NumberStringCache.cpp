@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/NumberStringCache.h"
+
+#include "hermes/VM/SlotAcceptor.h"
+#include "hermes/VM/StringPrimitive.h"
+#include "hermes/VM/WeakRoot-inline.h"
+
+#include "llvh/Support/MathExtras.h"
+
+namespace hermes {
+namespace vm {
+
+/// Fibonacci hashing constant, used to spread keys whose low bits are all
+/// equal, such as small integers as doubles, over the whole cache.
+static constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ull;
+
+uint32_t NumberStringCache::indexOf(double number) {
+  return (llvh::DoubleToBits(number) * kHashMultiplier) >> (64 - kLogSize);
+}
+
+uint32_t NumberStringCache::indexOf(CompressedPointer ptr) {
+  return ((uint64_t)ptr.getRaw() * kHashMultiplier) >> (64 - kLogSize);
+}
+
+StringPrimitive *
+NumberStringCache::getString(PointerBase &base, GC &gc, double number) const {
+  const NumberToStringEntry &entry = numberToString_[indexOf(number)];
+  // NaN never compares equal, and 0 and -0 both convert to "0".
+  if (entry.number != number)
+    return nullptr;
+  return entry.string.get(base, gc);
+}
+
+void NumberStringCache::putString(
+    PointerBase &base,
+    double number,
+    StringPrimitive *str) {
+  NumberToStringEntry &entry = numberToString_[indexOf(number)];
+  entry.number = number;
+  entry.string.set(base, str);
+}
+
+OptValue<double> NumberStringCache::getNumber(
+    PointerBase &base,
+    const StringPrimitive *str) const {
+  // Only the address of the string is compared, so no read barrier is needed.
+  auto *cell = const_cast<StringPrimitive *>(str);
+  CompressedPointer ptr = CompressedPointer::encodeNonNull(cell, base);
+  const StringToNumberEntry &entry = stringToNumber_[indexOf(ptr)];
+  if (entry.string != ptr)
+    return llvh::None;
+  return entry.number;
+}
+
+void NumberStringCache::putNumber(
+    PointerBase &base,
+    const StringPrimitive *str,
+    double number) {
+  auto *cell = const_cast<StringPrimitive *>(str);
+  CompressedPointer ptr = CompressedPointer::encodeNonNull(cell, base);
+  StringToNumberEntry &entry = stringToNumber_[indexOf(ptr)];
+  entry.string = ptr;
+  entry.number = number;
+}
+
+void NumberStringCache::markWeakRoots(WeakRootAcceptor &acceptor) {
+  for (NumberToStringEntry &entry : numberToString_)
+    acceptor.acceptWeak(entry.string);
+  for (StringToNumberEntry &entry : stringToNumber_)
+    acceptor.acceptWeak(entry.string);
+}
+
+} // namespace vm
+} // namespace hermes
@@ -52,9 +52,24 @@ CallResult<Handle<SymbolID>> valueToSymbolID(
   auto res = toString_RJS(runtime, nameValHnd);
   if (res == ExecutionStatus::EXCEPTION)
     return ExecutionStatus::EXCEPTION;
-
-  // Unique the string.
-  return stringToSymbolID(runtime, std::move(*res));
+  if (!nameValHnd->isNumber() || (*res)->isUniqued())
+    return stringToSymbolID(runtime, std::move(*res));
+
+  // Unique the string, and replace the cached string for the number with the
+  // uniqued one, so that the next conversion of the number finds its SymbolID
+  // without allocating or hashing.
+  auto idRes = stringToSymbolID(runtime, std::move(*res));
+  if (LLVM_UNLIKELY(idRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  const double m = nameValHnd->getNumber();
+  if (m != 0 && !std::isnan(m)) {
+    StringPrimitive *uniqued =
+        runtime.getIdentifierTable().getStringPrim(runtime, **idRes);
+    NumberStringCache &cache = runtime.getNumberStringCache();
+    cache.putString(runtime, m, uniqued);
+    cache.putNumber(runtime, uniqued, m);
+  }
+  return idRes;
 }
 
 HermesValue typeOf(Runtime &runtime, Handle<> valueHandle) {
@@ -289,11 +304,11 @@ bool toBoolean(HermesValue value) {
 }
 
 /// ES5.1 9.8.1
-static CallResult<PseudoHandle<StringPrimitive>> numberToString(
+static CallResult<PseudoHandle<StringPrimitive>> numberToStringUncached(
     Runtime &runtime,
     double m) LLVM_NO_SANITIZE("float-cast-overflow");
 
-static CallResult<PseudoHandle<StringPrimitive>> numberToString(
+static CallResult<PseudoHandle<StringPrimitive>> numberToStringUncached(
     Runtime &runtime,
     double m) {
   char buf8[hermes::NUMBER_TO_STRING_BUF_SIZE];
@@ -339,6 +354,29 @@ static CallResult<PseudoHandle<StringPrimitive>> numberToString(
   return createPseudoHandle(vmcast<StringPrimitive>(*result));
 }
 
+/// ES5.1 9.8.1, looking up and recording the result in the Runtime's
+/// NumberStringCache.
+static CallResult<PseudoHandle<StringPrimitive>> numberToString(
+    Runtime &runtime,
+    double m) {
+  // Zero and NaN convert to predefined strings, and -0 would not convert
+  // back to itself.
+  if (m == 0 || std::isnan(m))
+    return numberToStringUncached(runtime, m);
+
+  NumberStringCache &cache = runtime.getNumberStringCache();
+  if (StringPrimitive *cached = cache.getString(runtime, runtime.getHeap(), m))
+    return createPseudoHandle(cached);
+
+  auto res = numberToStringUncached(runtime, m);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  cache.putString(runtime, m, res->get());
+  // The string converts back to the same number.
+  cache.putNumber(runtime, res->get(), m);
+  return res;
+}
+
 CallResult<PseudoHandle<StringPrimitive>> toString_RJS(
     Runtime &runtime,
     Handle<> valueHandle) {
@@ -404,7 +442,7 @@ double parseIntWithRadix(const StringView str, int radix) {
 }
 
 /// ES5.1 9.3.1
-static inline double stringToNumber(
+static double stringToNumberUncached(
     Runtime &runtime,
     Handle<StringPrimitive> strPrim) {
   auto &idTable = runtime.getIdentifierTable();
@@ -509,6 +547,19 @@ static inline double stringToNumber(
   return std::numeric_limits<double>::quiet_NaN();
 }
 
+/// ES5.1 9.3.1, looking up and recording the result in the Runtime's
+/// NumberStringCache.
+static inline double stringToNumber(
+    Runtime &runtime,
+    Handle<StringPrimitive> strPrim) {
+  NumberStringCache &cache = runtime.getNumberStringCache();
+  if (OptValue<double> cached = cache.getNumber(runtime, *strPrim))
+    return *cached;
+  double result = stringToNumberUncached(runtime, strPrim);
+  cache.putNumber(runtime, *strPrim, result);
+  return result;
+}
+
 CallResult<HermesValue> toNumber_RJS(Runtime &runtime, Handle<> valueHandle) {
   auto value = valueHandle.get();
   double result;
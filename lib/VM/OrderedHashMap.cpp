@@ -14,26 +14,6 @@
 
 namespace hermes {
 namespace vm {
-//===----------------------------------------------------------------------===//
-// class HashMapEntry
-
-const VTable HashMapEntry::vt{
-    CellKind::HashMapEntryKind,
-    cellSize<HashMapEntry>()};
-
-void HashMapEntryBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
-  const auto *self = static_cast<const HashMapEntry *>(cell);
-  mb.setVTable(&HashMapEntry::vt);
-  mb.addField("key", &self->key);
-  mb.addField("value", &self->value);
-  mb.addField("prevIterationEntry", &self->prevIterationEntry);
-  mb.addField("nextIterationEntry", &self->nextIterationEntry);
-  mb.addField("nextEntryInBucket", &self->nextEntryInBucket);
-}
-
-CallResult<PseudoHandle<HashMapEntry>> HashMapEntry::create(Runtime &runtime) {
-  return createPseudoHandle(runtime.makeAFixed<HashMapEntry>());
-}
 
 //===----------------------------------------------------------------------===//
 // class OrderedHashMap
@@ -45,183 +25,158 @@ const VTable OrderedHashMap::vt{
 void OrderedHashMapBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   const auto *self = static_cast<const OrderedHashMap *>(cell);
   mb.setVTable(&OrderedHashMap::vt);
-  mb.addField("hashTable", &self->hashTable_);
-  mb.addField("firstIterationEntry", &self->firstIterationEntry_);
-  mb.addField("lastIterationEntry", &self->lastIterationEntry_);
+  mb.addField("table", &self->table_);
 }
 
-OrderedHashMap::OrderedHashMap(
-    Runtime &runtime,
-    Handle<ArrayStorageSmall> hashTableStorage)
-    : hashTable_(runtime, hashTableStorage.get(), runtime.getHeap()) {}
+OrderedHashMap::OrderedHashMap(Runtime &runtime, Handle<SegmentedArray> table)
+    : table_(runtime, table.get(), runtime.getHeap()) {}
 
-CallResult<PseudoHandle<OrderedHashMap>> OrderedHashMap::create(
-    Runtime &runtime) {
-  auto arrRes =
-      ArrayStorageSmall::create(runtime, INITIAL_CAPACITY, INITIAL_CAPACITY);
+CallResult<PseudoHandle<SegmentedArray>> OrderedHashMap::createTable(
+    Runtime &runtime,
+    uint32_t numBuckets) {
+  assert(
+      (numBuckets & (numBuckets - 1)) == 0 && numBuckets <= MAX_NUM_BUCKETS &&
+      "numBuckets must be power of 2");
+  uint32_t size = kHeaderSize + numBuckets * (1 + kLoadFactor * kEntrySize);
+  auto arrRes = SegmentedArray::create(runtime, size, size);
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto hashTableStorage = runtime.makeHandle<ArrayStorageSmall>(*arrRes);
-
-  return createPseudoHandle(
-      runtime.makeAFixed<OrderedHashMap>(runtime, hashTableStorage));
+  // The next table slot, the bucket heads and the entries start out empty.
+  SegmentedArray *table = arrRes->get();
+  setUInt32(table, runtime, kNumBucketsSlot, numBuckets);
+  setUInt32(table, runtime, kNumEntriesSlot, 0);
+  setUInt32(table, runtime, kNumDeletedSlot, 0);
+  return arrRes;
 }
 
-void OrderedHashMap::removeLinkedListNode(
-    Runtime &runtime,
-    HashMapEntry *entry,
-    GC &gc) {
-  assert(
-      entry != lastIterationEntry_.get(runtime) &&
-      "Cannot remove the last entry");
-  if (entry->prevIterationEntry) {
-    entry->prevIterationEntry.getNonNull(runtime)->nextIterationEntry.set(
-        runtime, entry->nextIterationEntry, gc);
-  }
-  if (entry->nextIterationEntry) {
-    entry->nextIterationEntry.getNonNull(runtime)->prevIterationEntry.set(
-        runtime, entry->prevIterationEntry, gc);
-  }
-  if (entry == firstIterationEntry_.get(runtime)) {
-    firstIterationEntry_.set(runtime, entry->nextIterationEntry, gc);
+CallResult<PseudoHandle<OrderedHashMap>> OrderedHashMap::create(
+    Runtime &runtime) {
+  auto tableRes = createTable(runtime, INITIAL_NUM_BUCKETS);
+  if (LLVM_UNLIKELY(tableRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
   }
-  entry->prevIterationEntry.setNull(runtime.getHeap());
-}
+  auto table = runtime.makeHandle(std::move(*tableRes));
 
-static HashMapEntry *castToMapEntry(SmallHermesValue shv, PointerBase &base) {
-  if (shv.isEmpty())
-    return nullptr;
-  return vmcast<HashMapEntry>(shv.getObject(base));
+  return createPseudoHandle(
+      runtime.makeAFixed<OrderedHashMap>(runtime, table));
 }
 
-HashMapEntry *OrderedHashMap::lookupInBucket(
+OptValue<uint32_t> OrderedHashMap::lookupInBucket(
     Runtime &runtime,
     uint32_t bucket,
-    HermesValue key) {
-  assert(
-      hashTable_.getNonNull(runtime)->size() == capacity_ &&
-      "Inconsistent capacity");
-  auto *entry =
-      castToMapEntry(hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  while (entry && !isSameValueZero(entry->key, key)) {
-    entry = entry->nextEntryInBucket.get(runtime);
+    HermesValue key) const {
+  const SegmentedArray *table = table_.getNonNull(runtime);
+  uint32_t entriesStart =
+      kHeaderSize + getUInt32(table, runtime, kNumBucketsSlot);
+  OptValue<uint32_t> entry = getLink(table, runtime, bucket);
+  while (entry) {
+    uint32_t slot = entriesStart + *entry * kEntrySize;
+    HermesValue entryKey = table->at(runtime, slot + kKeyOffset);
+    // Deleted entries stay in their chain with an empty key until the next
+    // rehash, and never match.
+    if (!entryKey.isEmpty() && isSameValueZero(entryKey, key))
+      return slot;
+    entry = getLink(table, runtime, slot + kChainOffset);
   }
-  return entry;
+  return llvh::None;
 }
 
-ExecutionStatus OrderedHashMap::rehashIfNecessary(
+ExecutionStatus OrderedHashMap::rehash(
     Handle<OrderedHashMap> self,
-    Runtime &runtime) {
-  uint32_t newCapacity = self->capacity_;
-  // NOTE: we have ensured that self->capacity_ * 4 never overflows uint32_t by
-  // setting MAX_CAPACITY to the appropriate value. self->size_ is always <=
-  // self->capacity_, so this applies to self->size_ as well.
-  static_assert(
-      MAX_CAPACITY < UINT32_MAX / 4,
-      "Avoid overflow checks on multiplying capacity by 4");
-  if (self->size_ * 4 > self->capacity_ * 3) {
-    // Load factor is more than 0.75, need to increase the capacity.
-    newCapacity = self->capacity_ * 2;
-    if (LLVM_UNLIKELY(newCapacity > MAX_CAPACITY)) {
-      // We maintain the invariant that the capacity_ is a power of two.
-      // Therefore, if doubling would exceed the max, we revert to the
-      // previous value.  (Assert the invariant to make it clear.)
-      assert(
-          (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-          "capacity_ must be power of 2");
-      newCapacity = self->capacity_;
-    }
-  } else if (
-      self->size_ * 4 < self->capacity_ && self->capacity_ > INITIAL_CAPACITY) {
-    // Load factor is less than 0.25, and we are not at initial cap.
-    newCapacity = self->capacity_ / 2;
-  }
-  if (newCapacity == self->capacity_) {
-    // No need to rehash.
-    return ExecutionStatus::RETURNED;
-  }
-  assert(
-      self->size_ && self->firstIterationEntry_ && self->lastIterationEntry_ &&
-      "We should never be rehashing when there are no elements");
-
-  // Set new capacity first to update the hash function.
-  self->capacity_ = newCapacity;
-
-  // Create a new hash table.
-  auto arrRes = ArrayStorageSmall::create(runtime, newCapacity, newCapacity);
-  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    Runtime &runtime,
+    uint32_t numBuckets) {
+  auto tableRes = createTable(runtime, numBuckets);
+  if (LLVM_UNLIKELY(tableRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto newHashTable = runtime.makeHandle<ArrayStorageSmall>(*arrRes);
-
-  // Now re-add all entries to the hash table.
-  MutableHandle<HashMapEntry> entry{runtime};
-  MutableHandle<HashMapEntry> oldNextInBucket{runtime};
+  auto newTable = runtime.makeHandle(std::move(*tableRes));
+  assert(
+      self->size_ <= numBuckets * kLoadFactor &&
+      "New table is too small for the live entries");
+
+  // Copy the live entries in insertion order, and turn each old entry into a
+  // forwarding entry to the index of the next live entry in the new table.
+  SegmentedArray *oldTable = self->table_.getNonNull(runtime);
+  uint32_t oldEntriesStart =
+      kHeaderSize + getUInt32(oldTable, runtime, kNumBucketsSlot);
+  uint32_t oldNumEntries = getUInt32(oldTable, runtime, kNumEntriesSlot);
+  uint32_t newEntriesStart = kHeaderSize + numBuckets;
+  uint32_t newNumEntries = 0;
   MutableHandle<> keyHandle{runtime};
   GCScopeMarkerRAII marker{runtime};
-  for (unsigned i = 0, len = self->hashTable_.getNonNull(runtime)->size();
-       i < len;
-       ++i) {
-    entry =
-        castToMapEntry(self->hashTable_.getNonNull(runtime)->at(i), runtime);
-    while (entry) {
-      marker.flush();
-      keyHandle = entry->key;
-      uint32_t bucket = hashToBucket(self, runtime, keyHandle);
-      oldNextInBucket = entry->nextEntryInBucket.get(runtime);
-      if (newHashTable->at(bucket).isEmpty()) {
-        // Empty bucket.
-        entry->nextEntryInBucket.setNull(runtime.getHeap());
-      } else {
-        // There are already a bucket head.
-        entry->nextEntryInBucket.set(
-            runtime,
-            vmcast<HashMapEntry>(newHashTable->at(bucket).getObject(runtime)),
-            runtime.getHeap());
-      }
-      // Update bucket head to the new entry.
-      newHashTable->set(
-          bucket,
-          SmallHermesValue::encodeObjectValue(*entry, runtime),
-          runtime.getHeap());
-
-      entry = *oldNextInBucket;
+  for (uint32_t i = 0; i < oldNumEntries; ++i) {
+    marker.flush();
+    uint32_t oldSlot = oldEntriesStart + i * kEntrySize;
+    // The entry itself, if it is live, or else the next live entry will be
+    // at this index in the new table.
+    uint32_t forwardIndex = newNumEntries;
+    keyHandle = oldTable->at(runtime, oldSlot + kKeyOffset);
+    if (!keyHandle->isEmpty()) {
+      uint32_t bucket = kHeaderSize +
+          (runtime.gcStableHashHermesValue(keyHandle) & (numBuckets - 1));
+      // Hashing may allocate, reload the old table.
+      oldTable = self->table_.getNonNull(runtime);
+      uint32_t newSlot = newEntriesStart + newNumEntries * kEntrySize;
+      newTable->set(runtime, newSlot + kKeyOffset, *keyHandle);
+      newTable->set(
+          runtime,
+          newSlot + kValueOffset,
+          oldTable->at(runtime, oldSlot + kValueOffset));
+      newTable->setNonPtr(
+          runtime, newSlot + kChainOffset, newTable->at(runtime, bucket));
+      setUInt32(*newTable, runtime, bucket, newNumEntries);
+      ++newNumEntries;
+      // Release the references held by the old table.
+      oldTable->setNonPtr(
+          runtime, oldSlot + kKeyOffset, HermesValue::encodeEmptyValue());
+      oldTable->setNonPtr(
+          runtime, oldSlot + kValueOffset, HermesValue::encodeEmptyValue());
     }
+    setUInt32(oldTable, runtime, oldSlot + kChainOffset, forwardIndex);
   }
+  assert(newNumEntries == self->size_ && "Inconsistent number of entries");
+  setUInt32(*newTable, runtime, kNumEntriesSlot, newNumEntries);
 
-  self->hashTable_.setNonNull(runtime, newHashTable.get(), runtime.getHeap());
-  assert(
-      self->hashTable_.getNonNull(runtime)->size() == self->capacity_ &&
-      "Inconsistent capacity");
+  oldTable->set(
+      runtime, kNextTableSlot, HermesValue::encodeObjectValue(*newTable));
+  self->table_.setNonNull(runtime, *newTable, runtime.getHeap());
   return ExecutionStatus::RETURNED;
 }
 
-bool OrderedHashMap::has(
+ExecutionStatus OrderedHashMap::shrinkIfNecessary(
     Handle<OrderedHashMap> self,
-    Runtime &runtime,
-    Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
+    Runtime &runtime) {
+  uint32_t numBuckets =
+      getUInt32(self->table_.getNonNull(runtime), runtime, kNumBucketsSlot);
+  // Shrink when less than a quarter of the capacity is alive.
+  if (numBuckets > INITIAL_NUM_BUCKETS &&
+      self->size_ * 4 < numBuckets * kLoadFactor) {
+    return rehash(self, runtime, numBuckets / 2);
+  }
+  return ExecutionStatus::RETURNED;
 }
 
-HashMapEntry *OrderedHashMap::find(
+bool OrderedHashMap::has(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
+  return self
+      ->lookupInBucket(
+          runtime, bucketSlot(self, runtime, key), key.getHermesValue())
+      .hasValue();
 }
 
 HermesValue OrderedHashMap::get(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  auto *entry = find(self, runtime, key);
-  if (!entry) {
+  auto slot = self->lookupInBucket(
+      runtime, bucketSlot(self, runtime, key), key.getHermesValue());
+  if (!slot) {
     return HermesValue::encodeUndefinedValue();
   }
-  return entry->value;
+  return self->table_.getNonNull(runtime)->at(runtime, *slot + kValueOffset);
 }
 
 ExecutionStatus OrderedHashMap::insert(
@@ -229,162 +184,138 @@ ExecutionStatus OrderedHashMap::insert(
     Runtime &runtime,
     Handle<> key,
     Handle<> value) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  if (auto *entry =
-          self->lookupInBucket(runtime, bucket, key.getHermesValue())) {
+  uint32_t bucket = bucketSlot(self, runtime, key);
+  if (auto slot = self->lookupInBucket(runtime, bucket, key.getHermesValue())) {
     // Element already exists, update value and return.
-    entry->value.set(value.get(), runtime.getHeap());
+    self->table_.getNonNull(runtime)->set(
+        runtime, *slot + kValueOffset, value.get());
     return ExecutionStatus::RETURNED;
   }
-  // Create a new entry, set the key and value.
-  auto crtRes = HashMapEntry::create(runtime);
-  if (LLVM_UNLIKELY(crtRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto newMapEntry = runtime.makeHandle(std::move(*crtRes));
-  newMapEntry->key.set(key.get(), runtime.getHeap());
-  newMapEntry->value.set(value.get(), runtime.getHeap());
-  auto *curBucketFront =
-      castToMapEntry(self->hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  if (curBucketFront) {
-    // If the bucket we are inserting to is not empty, we maintain the
-    // linked list properly.
-    newMapEntry->nextEntryInBucket.set(
-        runtime, curBucketFront, runtime.getHeap());
-  }
-  // Set the newly inserted entry as the front of this bucket chain.
-  self->hashTable_.getNonNull(runtime)->set(
-      bucket,
-      SmallHermesValue::encodeObjectValue(*newMapEntry, runtime),
-      runtime.getHeap());
-
-  if (!self->firstIterationEntry_) {
-    // If we are inserting the first ever element, update
-    // first iteration entry pointer.
-    self->firstIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-  } else {
-    // Connect the new entry with the last entry.
-    self->lastIterationEntry_.getNonNull(runtime)->nextIterationEntry.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-    newMapEntry->prevIterationEntry.set(
-        runtime, self->lastIterationEntry_, runtime.getHeap());
 
-    HashMapEntry *previousLastEntry = self->lastIterationEntry_.get(runtime);
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-
-    if (previousLastEntry && previousLastEntry->isDeleted()) {
-      // If the last entry was a deleted entry, we no longer need to keep it.
-      self->removeLinkedListNode(runtime, previousLastEntry, runtime.getHeap());
+  SegmentedArray *table = self->table_.getNonNull(runtime);
+  uint32_t numBuckets = getUInt32(table, runtime, kNumBucketsSlot);
+  uint32_t numEntries = getUInt32(table, runtime, kNumEntriesSlot);
+  if (numEntries == numBuckets * kLoadFactor) {
+    // The entries are exhausted. Rehash into a table of the same size if at
+    // least half of them are deleted, otherwise into one twice as large.
+    uint32_t numDeleted = getUInt32(table, runtime, kNumDeletedSlot);
+    uint32_t newNumBuckets = numBuckets;
+    if (numDeleted < numEntries / 2) {
+      if (LLVM_UNLIKELY(numBuckets == MAX_NUM_BUCKETS)) {
+        return runtime.raiseRangeError("Map/Set size exceeds the maximum");
+      }
+      newNumBuckets = numBuckets * 2;
     }
+    if (LLVM_UNLIKELY(
+            rehash(self, runtime, newNumBuckets) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    bucket = bucketSlot(self, runtime, key);
+    table = self->table_.getNonNull(runtime);
+    numBuckets = newNumBuckets;
+    numEntries = getUInt32(table, runtime, kNumEntriesSlot);
   }
 
+  // Append the new entry and make it the head of its bucket.
+  uint32_t slot = kHeaderSize + numBuckets + numEntries * kEntrySize;
+  table->set(runtime, slot + kKeyOffset, key.get());
+  table->set(runtime, slot + kValueOffset, value.get());
+  table->setNonPtr(runtime, slot + kChainOffset, table->at(runtime, bucket));
+  setUInt32(table, runtime, bucket, numEntries);
+  setUInt32(table, runtime, kNumEntriesSlot, numEntries + 1);
   self->size_++;
-  return self->rehashIfNecessary(self, runtime);
+  return ExecutionStatus::RETURNED;
 }
 
 bool OrderedHashMap::erase(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  HashMapEntry *prevEntry = nullptr;
-  auto *entry =
-      castToMapEntry(self->hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  while (entry && !isSameValueZero(entry->key, key.getHermesValue())) {
-    prevEntry = entry;
-    entry = entry->nextEntryInBucket.get(runtime);
-  }
-  if (!entry) {
+  auto slot = self->lookupInBucket(
+      runtime, bucketSlot(self, runtime, key), key.getHermesValue());
+  if (!slot) {
     // Element does not exist.
     return false;
   }
 
-  if (prevEntry) {
-    // The entry we are deleting has a previous entry, update the link.
-    prevEntry->nextEntryInBucket.set(
-        runtime, entry->nextEntryInBucket, runtime.getHeap());
-  } else {
-    // The entry we are erasing is the front entry in the bucket, we need
-    // to update the bucket head to the next entry in the bucket, if not
-    // any, set to empty value.
-    self->hashTable_.getNonNull(runtime)->set(
-        bucket,
-        entry->nextEntryInBucket
-            ? SmallHermesValue::encodeObjectValue(entry->nextEntryInBucket)
-            : SmallHermesValue::encodeEmptyValue(),
-        runtime.getHeap());
-  }
-
-  entry->markDeleted(runtime);
+  // Leave a hole in place of the entry. It stays in its bucket chain, and is
+  // skipped by lookups and iterators until the next rehash.
+  SegmentedArray *table = self->table_.getNonNull(runtime);
+  table->setNonPtr(
+      runtime, *slot + kKeyOffset, HermesValue::encodeEmptyValue());
+  table->setNonPtr(
+      runtime, *slot + kValueOffset, HermesValue::encodeEmptyValue());
+  setUInt32(
+      table,
+      runtime,
+      kNumDeletedSlot,
+      getUInt32(table, runtime, kNumDeletedSlot) + 1);
   self->size_--;
 
-  // Now delete the entry from the iteration linked list.
-  // If we are deleting the last entry, don't remove it from the list yet.
-  // This will ensure that if any iterator out there is currently pointing to
-  // this entry, it will be able to follow on if we add new entries in the
-  // future.
-  if (entry != self->lastIterationEntry_.get(runtime)) {
-    self->removeLinkedListNode(runtime, entry, runtime.getHeap());
-  }
-
-  self->rehashIfNecessary(self, runtime);
+  shrinkIfNecessary(self, runtime);
 
   return true;
 }
 
-HashMapEntry *OrderedHashMap::iteratorNext(
-    Runtime &runtime,
-    HashMapEntry *entry) const {
-  if (entry == nullptr) {
-    // Starting a new iteration from the first entry.
-    entry = firstIterationEntry_.get(runtime);
-  } else {
-    // Advance to the next entry.
-    entry = entry->nextIterationEntry.get(runtime);
+ExecutionStatus OrderedHashMap::clear(
+    Handle<OrderedHashMap> self,
+    Runtime &runtime) {
+  if (getUInt32(self->table_.getNonNull(runtime), runtime, kNumEntriesSlot) ==
+      0) {
+    // Empty table.
+    return ExecutionStatus::RETURNED;
   }
 
-  // Make sure the entry we returned (if not nullptr) must not be deleted.
-  while (entry && entry->isDeleted()) {
-    entry = entry->nextIterationEntry.get(runtime);
+  auto tableRes = createTable(runtime, INITIAL_NUM_BUCKETS);
+  if (LLVM_UNLIKELY(tableRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  SegmentedArray *newTable = tableRes->get();
+
+  // Turn the old table into a forwarding table in which every entry is
+  // deleted, so iterators into it continue from the start of the new table.
+  SegmentedArray *oldTable = self->table_.getNonNull(runtime);
+  uint32_t oldEntriesStart =
+      kHeaderSize + getUInt32(oldTable, runtime, kNumBucketsSlot);
+  uint32_t oldNumEntries = getUInt32(oldTable, runtime, kNumEntriesSlot);
+  for (uint32_t i = 0; i < oldNumEntries; ++i) {
+    uint32_t oldSlot = oldEntriesStart + i * kEntrySize;
+    oldTable->setNonPtr(
+        runtime, oldSlot + kKeyOffset, HermesValue::encodeEmptyValue());
+    oldTable->setNonPtr(
+        runtime, oldSlot + kValueOffset, HermesValue::encodeEmptyValue());
+    setUInt32(oldTable, runtime, oldSlot + kChainOffset, 0);
   }
-  return entry;
+  setUInt32(oldTable, runtime, kNumDeletedSlot, oldNumEntries);
+
+  oldTable->set(
+      runtime, kNextTableSlot, HermesValue::encodeObjectValue(newTable));
+  self->table_.setNonNull(runtime, newTable, runtime.getHeap());
+  self->size_ = 0;
+  return ExecutionStatus::RETURNED;
 }
 
-void OrderedHashMap::clear(Runtime &runtime) {
-  if (!firstIterationEntry_) {
-    // Empty set.
-    return;
+OptValue<uint32_t> OrderedHashMap::iteratorNext(
+    PointerBase &base,
+    SegmentedArray *&table,
+    uint32_t &index) {
+  // Follow the forwarding tables to the table in use.
+  while (!table->at(base, kNextTableSlot).isEmpty()) {
+    uint32_t numEntries = getUInt32(table, base, kNumEntriesSlot);
+    index = index < numEntries
+        ? getUInt32(table, base, keySlot(table, base, index) + kChainOffset)
+        : numEntries - getUInt32(table, base, kNumDeletedSlot);
+    table = vmcast<SegmentedArray>(table->at(base, kNextTableSlot));
   }
 
-  // Clear the hash table.
-  for (unsigned i = 0; i < capacity_; ++i) {
-    auto entry = castToMapEntry(hashTable_.getNonNull(runtime)->at(i), runtime);
-    // Delete every element reachable from the hash table.
-    while (entry) {
-      entry->markDeleted(runtime);
-      entry = entry->nextEntryInBucket.get(runtime);
-    }
-    // Clear every element in the hash table.
-    hashTable_.getNonNull(runtime)->setNonPtr(
-        i, SmallHermesValue::encodeEmptyValue(), runtime.getHeap());
+  // Skip the deleted entries.
+  uint32_t numEntries = getUInt32(table, base, kNumEntriesSlot);
+  for (; index < numEntries; ++index) {
+    if (!table->at(base, keySlot(table, base, index)).isEmpty())
+      return index++;
   }
-  // Resize the hash table to the initial size.
-  ArrayStorageSmall::resizeWithinCapacity(
-      hashTable_.getNonNull(runtime), runtime, INITIAL_CAPACITY);
-  capacity_ = INITIAL_CAPACITY;
-
-  // After clearing, we will still keep the last deleted entry
-  // in case there is an iterator out there
-  // pointing to the middle of the iteration chain. We need it to be
-  // able to merge back eventually.
-  firstIterationEntry_.set(runtime, lastIterationEntry_, runtime.getHeap());
-  firstIterationEntry_.getNonNull(runtime)->prevIterationEntry.setNull(
-      runtime.getHeap());
-  size_ = 0;
+  return llvh::None;
 }
 
 } // namespace vm
@@ -11,6 +11,7 @@
 
 #include "hermes/VM/JSNativeFunctions.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 namespace hermes {
@@ -43,8 +44,9 @@ std::shared_ptr<ChromeStackFrameNode> ChromeStackFrameNode::findOrAddNewChild(
     // get root => leaf represenation.
     for (const auto &frame : llvh::reverse(sample.stack))
       leafNode = leafNode->findOrAddNewChild(frameIdGen, frame);
-    leafNode->addHit();
-    trace.sampleEvents_.emplace_back(sample.tid, sample.timeStamp, leafNode);
+    leafNode->addHit(sample.counters);
+    trace.sampleEvents_.emplace_back(
+        sample.tid, sample.timeStamp, leafNode, sample.counters);
   }
   return trace;
 }
@@ -56,6 +58,29 @@ std::string getJSFunctionName(hbc::BCProvider *bcProvider, uint32_t funcId) {
   return bcProvider->getStringRefFromID(functionHeader.functionName()).str();
 }
 
+/// Emit the hardware \p counters that were read as a dictionary under \p key,
+/// if any were.
+void emitCounters(
+    JSONEmitter &json,
+    const char *key,
+    const HardwareCounters::Values &counters) {
+  if (std::all_of(counters.begin(), counters.end(), [](uint64_t value) {
+        return value == HardwareCounters::kNoValue;
+      })) {
+    return;
+  }
+  json.emitKey(key);
+  json.openDict();
+  for (unsigned i = 0; i < HardwareCounters::NumCounters; ++i) {
+    if (counters[i] != HardwareCounters::kNoValue) {
+      json.emitKeyValue(
+          HardwareCounters::getName((HardwareCounters::Counter)i),
+          counters[i]);
+    }
+  }
+  json.closeDict();
+}
+
 OptValue<hbc::DebugSourceLocation> getSourceLocation(
     hbc::BCProvider *bcProvider,
     uint32_t funcId,
@@ -164,6 +189,7 @@ void ChromeTraceSerializer::serializeSampledEvents(JSONEmitter &json) const {
     double stackId = sample.getLeafNode()->getId();
     assert(stackId > 0 && "Invalid stack id");
     json.emitKeyValue("sf", stackId);
+    emitCounters(json, "args", sample.getCounters());
     json.closeDict();
   }
 }
@@ -262,6 +288,9 @@ void ChromeTraceSerializer::serializeStackFrames(JSONEmitter &json) const {
     json.emitKeyValue("name", frameName);
     json.emitKeyValue("category", categoryName);
     json.emitKeyValue("parent", static_cast<double>(parent->getId()));
+    // The events counted while this frame was the leaf, which tell whether
+    // its time goes to executing instructions or to waiting for memory.
+    emitCounters(json, "counters", node.getCounters());
     json.closeDict();
   });
 }
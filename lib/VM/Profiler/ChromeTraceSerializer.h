@@ -51,6 +51,10 @@ class ChromeStackFrameNode {
   std::vector<std::shared_ptr<ChromeStackFrameNode>> children_;
   /// How many times was this node on the top of the callstack during profiling.
   uint32_t hitCount_ = 0;
+  /// The hardware events counted while this node was on the top of the
+  /// callstack, summed over the samples that read them. A counter is
+  /// HardwareCounters::kNoValue if no sample read it.
+  HardwareCounters::Values counters_ = HardwareCounters::noValues();
 
   /// \p node represents the current visiting node.
   /// \p parent can be nullptr for root node.
@@ -84,9 +88,17 @@ class ChromeStackFrameNode {
     return *frameInfo_;
   }
 
-  /// Increments this node's hit counter by one.
-  void addHit() {
+  /// Increments this node's hit counter by one, and adds the hardware events
+  /// \p counters of the sample to its own.
+  void addHit(const HardwareCounters::Values &counters) {
     ++hitCount_;
+    for (unsigned i = 0; i < HardwareCounters::NumCounters; ++i) {
+      if (counters[i] == HardwareCounters::kNoValue)
+        continue;
+      counters_[i] = counters_[i] == HardwareCounters::kNoValue
+          ? counters[i]
+          : counters_[i] + counters[i];
+    }
   }
 
   /// \return this node's hit counter.
@@ -94,6 +106,12 @@ class ChromeStackFrameNode {
     return hitCount_;
   }
 
+  /// \return the hardware events counted while this node was on the top of
+  /// the callstack.
+  const HardwareCounters::Values &getCounters() const {
+    return counters_;
+  }
+
   /// Find a child node matching \p target, otherwise add \p target
   /// as a new child.
   /// \return the found/added child node.
@@ -124,13 +142,18 @@ class ChromeSampleEvent {
   SamplingProfiler::ThreadId tid_;
   SamplingProfiler::TimeStampType timeStamp_;
   std::shared_ptr<ChromeStackFrameNode> leafNode_;
+  HardwareCounters::Values counters_;
 
  public:
   explicit ChromeSampleEvent(
       SamplingProfiler::ThreadId tid,
       SamplingProfiler::TimeStampType timeStamp,
-      std::shared_ptr<ChromeStackFrameNode> leaf)
-      : tid_(tid), timeStamp_(timeStamp), leafNode_(leaf) {}
+      std::shared_ptr<ChromeStackFrameNode> leaf,
+      const HardwareCounters::Values &counters)
+      : tid_(tid),
+        timeStamp_(timeStamp),
+        leafNode_(leaf),
+        counters_(counters) {}
 
   /// \return CPU id.
   int getCpu() const {
@@ -157,6 +180,11 @@ class ChromeSampleEvent {
   std::shared_ptr<ChromeStackFrameNode> getLeafNode() const {
     return leafNode_;
   }
+
+  /// Hardware events counted on the thread since the previous sample.
+  const HardwareCounters::Values &getCounters() const {
+    return counters_;
+  }
 };
 
 /// Represent all data for a trace session in chrome trace format.
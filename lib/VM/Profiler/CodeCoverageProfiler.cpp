@@ -36,14 +36,26 @@ void CodeCoverageProfiler::markRoots(RootAcceptor &acceptor) {
 
 void CodeCoverageProfiler::markExecutedSlowPath(CodeBlock *codeBlock) {
   std::lock_guard<std::mutex> lk(localMutex_);
-  std::vector<bool> &moduleFuncMap =
-      getModuleFuncMapRef(codeBlock->getRuntimeModule());
+  RuntimeModule *module = codeBlock->getRuntimeModule();
+  std::vector<bool> &moduleFuncMap = getModuleFuncMapRef(module);
 
   const auto funcId = codeBlock->getFunctionID();
   assert(
       funcId < moduleFuncMap.size() &&
       "funcId is out of bound for moduleFuncMap.");
-  moduleFuncMap[funcId] = true;
+  if (!moduleFuncMap[funcId]) {
+    moduleFuncMap[funcId] = true;
+    firstExecutionOrder_[module].push_back(funcId);
+  }
+}
+
+std::vector<uint32_t> CodeCoverageProfiler::getFirstExecutionOrder(
+    RuntimeModule *module) {
+  std::lock_guard<std::mutex> lk(localMutex_);
+  auto it = firstExecutionOrder_.find(module);
+  if (it == firstExecutionOrder_.end())
+    return {};
+  return it->second;
 }
 
 /* static */ std::
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/Profiler/HardwareCounters.h"
+
+#if defined(__linux__) && \
+    (!defined(__ANDROID__) || defined(HERMES_ANDROID_PERF_EVENTS))
+#define HERMESVM_HARDWARE_COUNTERS
+#endif
+
+#ifdef HERMESVM_HARDWARE_COUNTERS
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef ANDROID_LINUX_PERF_PATH
+#include ANDROID_LINUX_PERF_PATH
+#else
+#include <linux/perf_event.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+#endif
+
+namespace hermes {
+namespace vm {
+
+/* static */ const char *HardwareCounters::getName(Counter counter) {
+  switch (counter) {
+    case Cycles:
+      return "cycles";
+    case Instructions:
+      return "instructions";
+    case L1DCacheMisses:
+      return "L1-dcache-load-misses";
+    case LLCMisses:
+      return "LLC-load-misses";
+    case BranchMisses:
+      return "branch-misses";
+    case NumCounters:
+      break;
+  }
+  return "";
+}
+
+#ifdef HERMESVM_HARDWARE_COUNTERS
+
+namespace {
+/// \return the perf_event type and config of \p counter.
+std::pair<uint32_t, uint64_t> getEvent(HardwareCounters::Counter counter) {
+  constexpr uint64_t kReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  switch (counter) {
+    case HardwareCounters::Cycles:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    case HardwareCounters::Instructions:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+    case HardwareCounters::L1DCacheMisses:
+      return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | kReadMiss};
+    case HardwareCounters::LLCMisses:
+      return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | kReadMiss};
+    case HardwareCounters::BranchMisses:
+    case HardwareCounters::NumCounters:
+      break;
+  }
+  return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+}
+} // namespace
+
+bool HardwareCounters::openForCurrentThread() {
+  if (unavailable_)
+    return false;
+  long tid = syscall(SYS_gettid);
+  if (isOpen()) {
+    if (tid == tid_)
+      return true;
+    close();
+  }
+
+  for (unsigned i = 0; i < NumCounters; ++i) {
+    auto event = getEvent((Counter)i);
+    perf_event_attr pe;
+    memset(&pe, 0, sizeof(perf_event_attr));
+    pe.type = event.first;
+    pe.size = sizeof(perf_event_attr);
+    pe.config = event.second;
+    pe.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+        PERF_FORMAT_TOTAL_TIME_RUNNING;
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    // Counters that the CPU doesn't have are left out of the group.
+    fds_[i] = syscall(
+        __NR_perf_event_open,
+        &pe,
+        0, /* this thread */
+        -1, /* any CPU */
+        leaderFD_,
+        0 /* flags */);
+    if (fds_[i] != -1 && leaderFD_ == -1)
+      leaderFD_ = fds_[i];
+  }
+  tid_ = tid;
+  last_.fill(0);
+  lastEnabled_ = 0;
+  lastRunning_ = 0;
+  // Without a PMU, or without the permission to use it, every later attempt
+  // would fail the same way.
+  unavailable_ = !isOpen();
+  return isOpen();
+}
+
+void HardwareCounters::close() {
+  for (int &fd : fds_) {
+    if (fd != -1)
+      ::close(fd);
+    fd = -1;
+  }
+  leaderFD_ = -1;
+}
+
+void HardwareCounters::readDeltas(Values &values) {
+  values.fill(kNoValue);
+  if (!isOpen())
+    return;
+  // The group is read as its size, the times it was enabled and running,
+  // and the value of each member, in the order they were opened.
+  uint64_t buf[3 + NumCounters];
+  ssize_t size = read(leaderFD_, buf, sizeof(buf));
+  if (size < (ssize_t)(3 * sizeof(uint64_t)))
+    return;
+  uint64_t enabled = buf[1] - lastEnabled_;
+  uint64_t running = buf[2] - lastRunning_;
+  lastEnabled_ = buf[1];
+  lastRunning_ = buf[2];
+  uint64_t members =
+      std::min<uint64_t>(buf[0], (size_t)size / sizeof(uint64_t) - 3);
+  for (unsigned i = 0, member = 0; i < NumCounters && member < members; ++i) {
+    if (fds_[i] == -1)
+      continue;
+    uint64_t value = buf[3 + member++];
+    uint64_t delta = value - last_[i];
+    last_[i] = value;
+    // A group that wasn't scheduled since the previous read, e.g. because
+    // other events took the PMU, reads as zeros rather than as failing.
+    if (running == 0)
+      continue;
+    // A group that was multiplexed with other events counted only while it
+    // was running.
+    if (running < enabled)
+      delta = (uint64_t)((double)delta * enabled / running);
+    values[i] = delta;
+  }
+}
+
+#else
+
+bool HardwareCounters::openForCurrentThread() {
+  return false;
+}
+
+void HardwareCounters::close() {}
+
+void HardwareCounters::readDeltas(Values &values) {
+  values.fill(kNoValue);
+}
+
+#endif
+
+} // namespace vm
+} // namespace hermes
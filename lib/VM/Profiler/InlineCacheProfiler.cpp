@@ -68,6 +68,21 @@ bool InlineCacheProfiler::insertICHit(
   return true;
 }
 
+void InlineCacheProfiler::recordCacheState(
+    CodeBlock *codeblock,
+    uint32_t instOffset,
+    bool polymorphic,
+    bool megamorphic) {
+  if (!polymorphic && !megamorphic)
+    return;
+  ICMiss &icMiss = getICMissBySourceLocation(codeblock, instOffset);
+  icMiss.polymorphic |= polymorphic;
+  if (megamorphic && !icMiss.megamorphic) {
+    icMiss.megamorphic = true;
+    ++totalMegamorphic_;
+  }
+}
+
 JSArray *&InlineCacheProfiler::getHiddenClassArray() {
   return cachedHiddenClassesRawPtr_;
 }
@@ -176,7 +191,11 @@ void InlineCacheProfiler::dumpInfoOfSourceLocation(
            << (1. * icMiss.missCount) / (icMiss.missCount + icMiss.hitCount);
     std::string missRatio = stream.str();
     ostream << "total access: " << icMiss.missCount + icMiss.hitCount
-            << ", miss ratio: " << missRatio << "\n";
+            << ", miss ratio: " << missRatio << ", state: "
+            << (icMiss.megamorphic       ? "megamorphic"
+                    : icMiss.polymorphic ? "polymorphic"
+                                         : "monomorphic")
+            << "\n";
   } else {
     ostream << "[No Loc]\n";
   }
@@ -188,7 +207,8 @@ void InlineCacheProfiler::dumpInfoOfSourceLocation(
 /// The source locations are ranked in the descending order of IC misses.
 ///
 /// An example of output for a specific source location is as follows:
-/// [filename:line:column] total access: 2661, miss ratio: 0.3
+/// [filename:line:column] total access: 2661, miss ratio: 0.3, state:
+/// polymorphic
 ///  property: children, inline cache misses: 427
 ///    <type, domNamespace, children, childIndex, context, footer>
 ///    <domNamespace, type, children, childIndex, context, footer>
@@ -204,6 +224,9 @@ void InlineCacheProfiler::dumpRankedInlineCachingMisses(
   std::shared_ptr<InlineCacheProfiler::ICMissList> icInfoList =
       getRankedInlineCachingMisses();
 
+  ostream << "Inline caching: " << totalHits_ << " hits, " << totalMisses_
+          << " misses, " << totalMegamorphic_ << " megamorphic locations\n";
+
   uint64_t recordPrinted = 0;
   // enumerate each source location where inline caching miss happens
   for (auto &cacheMissEntry : *icInfoList) {
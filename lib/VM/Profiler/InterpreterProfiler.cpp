@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/Profiler/InterpreterProfiler.h"
+
+#include "hermes/Inst/InstDecode.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/JSNativeFunctions.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/Support/Format.h"
+
+#include <algorithm>
+
+namespace hermes {
+namespace vm {
+
+/* static */ OptValue<uint8_t> InterpreterProfiler::parseKinds(
+    llvh::StringRef str) {
+  uint8_t kinds = 0;
+  llvh::SmallVector<llvh::StringRef, 4> names;
+  str.split(names, ',', -1, false);
+  for (llvh::StringRef name : names) {
+    name = name.trim();
+    if (name == "opcodes")
+      kinds |= Opcodes;
+    else if (name == "functions")
+      kinds |= Functions;
+    else if (name == "native")
+      kinds |= NativeCalls;
+    else if (name == "all")
+      kinds |= AllKinds;
+    else
+      return llvh::None;
+  }
+  if (!kinds)
+    return llvh::None;
+  return kinds;
+}
+
+void InterpreterProfiler::disable() {
+  kinds_ = 0;
+  lastOpcode_ = kNoOpcode;
+  stack_.clear();
+}
+
+void InterpreterProfiler::reset() {
+  std::fill(std::begin(opcodes_), std::end(opcodes_), Entry{});
+  lastOpcode_ = kNoOpcode;
+  // Keep the names of the functions, since their IDs are stored in their
+  // CodeBlocks.
+  for (auto &function : functions_)
+    function.second = Entry{};
+  nativeIndices_.clear();
+  nativeFunctions_.clear();
+  stack_.clear();
+}
+
+void InterpreterProfiler::enterFunction(
+    Runtime &runtime,
+    CodeBlock *codeBlock) {
+  if (!isEnabled(Functions))
+    return;
+  ProfilerID &id = codeBlock->profilerID;
+  if (id == NO_PROFILER_ID) {
+    id = functions_.size();
+    std::string name =
+        codeBlock->getNameString(runtime.getHeap().getCallbacks());
+    if (name.empty())
+      name = "<anonymous>";
+    if (auto loc = codeBlock->getSourceLocation()) {
+      name += " (" + std::to_string(loc->line) + ":" +
+          std::to_string(loc->column) + ")";
+    } else {
+      name += " (#" + std::to_string(codeBlock->getFunctionID()) + ")";
+    }
+    functions_.emplace_back(std::move(name), Entry{});
+  }
+  ++functions_[id].second.count;
+  push(id, false);
+}
+
+void InterpreterProfiler::exitFunction(CodeBlock *codeBlock) {
+  if (!isEnabled(Functions) || codeBlock->profilerID == NO_PROFILER_ID)
+    return;
+  ProfilerID id = codeBlock->profilerID;
+  pop(id, false, functions_[id].second);
+}
+
+void InterpreterProfiler::enterNativeFunction(void *fn) {
+  if (!isEnabled(NativeCalls))
+    return;
+  auto it = nativeIndices_.try_emplace(fn, nativeFunctions_.size()).first;
+  if (it->second == nativeFunctions_.size())
+    nativeFunctions_.emplace_back(fn, Entry{});
+  ++nativeFunctions_[it->second].second.count;
+  push(it->second, true);
+}
+
+void InterpreterProfiler::exitNativeFunction(void *fn) {
+  if (!isEnabled(NativeCalls))
+    return;
+  auto it = nativeIndices_.find(fn);
+  if (it == nativeIndices_.end())
+    return;
+  pop(it->second, true, nativeFunctions_[it->second].second);
+}
+
+void InterpreterProfiler::push(uint32_t id, bool isNative) {
+  stack_.push_back(Frame{id, isNative, now(), 0});
+}
+
+void InterpreterProfiler::pop(uint32_t id, bool isNative, Entry &entry) {
+  if (stack_.empty() || stack_.back().id != id ||
+      stack_.back().isNative != isNative)
+    return;
+  uint64_t inclusive = now() - stack_.back().start;
+  entry.time += inclusive - std::min(inclusive, stack_.back().childrenTime);
+  stack_.pop_back();
+  if (!stack_.empty())
+    stack_.back().childrenTime += inclusive;
+}
+
+/// Print \p entries, pairs of a name and its stats, to \p os under \p title,
+/// sorted by decreasing time.
+template <typename Name, typename Stats, typename PrintName>
+static void printEntries(
+    llvh::raw_ostream &os,
+    const char *title,
+    const char *countName,
+    std::vector<std::pair<Name, Stats>> entries,
+    PrintName printName) {
+  std::stable_sort(
+      entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+        return a.second.time > b.second.time;
+      });
+  os << title << "\n"
+     << llvh::right_justify(countName, 12) << " "
+     << llvh::right_justify("Time", 16) << " "
+     << llvh::right_justify("Average", 12) << "  Name\n";
+  for (const auto &entry : entries) {
+    os << llvh::format_decimal(entry.second.count, 12) << " "
+       << llvh::format_decimal(entry.second.time, 16) << " "
+       << llvh::format_decimal(entry.second.time / entry.second.count, 12)
+       << "  ";
+    printName(os, entry.first);
+    os << "\n";
+  }
+  os << "\n";
+}
+
+void InterpreterProfiler::dump(llvh::raw_ostream &os) const {
+#ifdef HERMESVM_PROFILER_RDTSC
+  os << "Interpreter profile (time in CPU cycles)\n\n";
+#else
+  os << "Interpreter profile (time in nanoseconds)\n\n";
+#endif
+
+  std::vector<std::pair<inst::OpCode, Entry>> opcodes;
+  for (size_t i = 0; i < kNumOpcodes; ++i) {
+    if (opcodes_[i].count)
+      opcodes.emplace_back((inst::OpCode)i, opcodes_[i]);
+  }
+  printEntries(
+      os,
+      "Opcodes:",
+      "Count",
+      std::move(opcodes),
+      [](llvh::raw_ostream &os, inst::OpCode opCode) {
+        os << inst::getOpCodeString(opCode);
+      });
+
+  std::vector<std::pair<llvh::StringRef, Entry>> functions;
+  for (const auto &function : functions_) {
+    if (function.second.count)
+      functions.emplace_back(function.first, function.second);
+  }
+  printEntries(
+      os,
+      "JS functions:",
+      "Calls",
+      std::move(functions),
+      [](llvh::raw_ostream &os, llvh::StringRef name) { os << name; });
+
+  printEntries(
+      os,
+      "Native functions:",
+      "Calls",
+      nativeFunctions_,
+      [](llvh::raw_ostream &os, void *fn) {
+        os << getFunctionName((NativeFunctionPtr)fn);
+      });
+}
+
+} // namespace vm
+} // namespace hermes
@@ -207,8 +207,9 @@ void SamplingProfiler::serializeInDevToolsFormat(llvh::raw_ostream &OS) {
   clear();
 }
 
-bool SamplingProfiler::enable(double meanHzFreq) {
-  return sampling_profiler::Sampler::get()->enable(meanHzFreq);
+bool SamplingProfiler::enable(double meanHzFreq, bool hardwareCounters) {
+  return sampling_profiler::Sampler::get()->enable(
+      meanHzFreq, hardwareCounters);
 }
 
 bool SamplingProfiler::disable() {
@@ -226,6 +226,7 @@ void SamplerPosix::profilingSignalHandler(int signo) {
       "Why is SamplerPosix::instance_ not initialized yet?");
 
   profilerInstance->walkRuntimeStack(localProfiler);
+  profilerInstance->readHardwareCounters(localProfiler);
 
   // Ensure that writes made in the handler are visible to the timer thread.
   profilerForSig_.store(nullptr);
@@ -73,7 +73,14 @@ bool Sampler::sampleStack(SamplingProfiler *localProfiler) {
       // TODO: fix this for all cases.
       sampledStackDepth_ = 0;
     }
+    // The runtime thread is busy, e.g. with a GC, which the events counted
+    // since the previous sample are attributed to. The counters can be read
+    // from any thread.
+    localProfiler->hardwareCounters_.readDeltas(sampleStorage_.counters);
   } else {
+    // Platforms that don't read hardware counters leave them unset.
+    sampleStorage_.counters = HardwareCounters::noValues();
+
     // Ensure there are no allocations in the signal handler by keeping ample
     // reserved space.
     localProfiler->domains_.reserve(
@@ -110,7 +117,8 @@ bool Sampler::sampleStack(SamplingProfiler *localProfiler) {
       sampleStorage_.tid,
       sampleStorage_.timeStamp,
       sampleStorage_.stack.begin(),
-      sampleStorage_.stack.begin() + sampledStackDepth_);
+      sampleStorage_.stack.begin() + sampledStackDepth_,
+      sampleStorage_.counters);
   return true;
 }
 
@@ -131,6 +139,12 @@ void Sampler::walkRuntimeStack(SamplingProfiler *profiler) {
       profiler->walkRuntimeStack(sampleStorage_, SamplingProfiler::InLoom::No);
 }
 
+void Sampler::readHardwareCounters(SamplingProfiler *profiler) {
+  if (hardwareCounters_)
+    profiler->hardwareCounters_.openForCurrentThread();
+  profiler->hardwareCounters_.readDeltas(sampleStorage_.counters);
+}
+
 void Sampler::timerLoop(double meanHzFreq) {
   oscompat::set_thread_name("hermes-sampling-profiler");
 
@@ -161,7 +175,7 @@ bool Sampler::enabled() {
   return enabled_;
 }
 
-bool Sampler::enable(double meanHzFreq) {
+bool Sampler::enable(double meanHzFreq, bool hardwareCounters) {
   std::lock_guard<std::mutex> lockGuard(profilerLock_);
   if (enabled_) {
     return true;
@@ -170,6 +184,7 @@ bool Sampler::enable(double meanHzFreq) {
     return false;
   }
   enabled_ = true;
+  hardwareCounters_ = hardwareCounters;
   // Start timer thread.
   timerThread_ = std::thread(&Sampler::timerLoop, this, meanHzFreq);
   return true;
@@ -187,6 +202,11 @@ bool Sampler::disable() {
     }
     // Telling timer thread to exit.
     enabled_ = false;
+    // The timer thread isn't sampling, since this thread holds profilerLock_.
+    for (SamplingProfiler *profiler : profilers_) {
+      std::lock_guard<std::mutex> lk(profiler->runtimeDataLock_);
+      profiler->hardwareCounters_.close();
+    }
   }
   // Notify the timer thread that it has been disabled.
   enabledCondVar_.notify_all();
@@ -71,6 +71,10 @@ struct Sampler {
   /// Whether profiler is enabled or not. Protected by profilerLock_.
   bool enabled_{false};
 
+  /// Whether hardware counters are read with each sample. Protected by
+  /// profilerLock_.
+  bool hardwareCounters_{false};
+
   /// Threading: load/store of sampledStackDepth_ and sampleStorage_
   /// are protected by samplingDoneSem_.
   /// Actual sampled stack depth in sampleStorage_.
@@ -98,7 +102,7 @@ struct Sampler {
   void timerLoop(double meanHzFreq);
 
   /// Implementation of SamplingProfiler::enable/disable.
-  bool enable(double meanHzFreq);
+  bool enable(double meanHzFreq, bool hardwareCounters);
   bool disable();
 
   /// \return true if the sampling profiler is enabled, false otherwise.
@@ -121,6 +125,12 @@ struct Sampler {
 
   void walkRuntimeStack(SamplingProfiler *profiler);
 
+  /// Store in sampleStorage_ the hardware events counted on the runtime
+  /// thread of \p profiler since its previous sample. This must run on that
+  /// thread, which is where the counters are opened. Like walkRuntimeStack,
+  /// it must not acquire locks or allocate memory.
+  void readHardwareCounters(SamplingProfiler *profiler);
+
  private:
   /// Sample stack for a profiler.
   bool sampleStack(SamplingProfiler *localProfiler);
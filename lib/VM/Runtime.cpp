@@ -273,6 +273,10 @@ Runtime::Runtime(
       overflowGuard_(StackOverflowGuard::depthCounterGuard(
           Runtime::MAX_NATIVE_CALL_FRAME_DEPTH)),
 #endif
+      allocationSites_(
+          runtimeConfig.getGCConfig().getPretenure()
+              ? std::make_unique<AllocationSites>()
+              : nullptr),
       crashCallbackKey_(
           crashMgr_->registerCallback([this](int fd) { crashCallback(fd); })),
       codeCoverageProfiler_(std::make_unique<CodeCoverageProfiler>(*this)),
@@ -401,11 +405,20 @@ Runtime::Runtime(
 
   codeCoverageProfiler_->disable();
   // Execute our internal bytecode.
-  auto jsBuiltinsObj = runInternalBytecode();
+  auto internalBytecodeResult = runInternalBytecode();
   codeCoverageProfiler_->restore();
 
-  // Populate JS builtins returned from internal bytecode to the builtins table.
-  initJSBuiltins(builtins_, jsBuiltinsObj);
+  // Keep the promise rejection tracker registered by the internal bytecode.
+  if (hasES6Promise_) {
+    auto trackerRes = JSObject::getNamed_RJS(
+        internalBytecodeResult,
+        *this,
+        Predefined::getSymbolID(Predefined::promiseRejectionTracker));
+    assert(
+        trackerRes != ExecutionStatus::EXCEPTION &&
+        "Failed to get the promise rejection tracker");
+    promiseRejectionTracker_ = trackerRes->get();
+  }
 
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
   if (runtimeConfig.getEnableSampleProfiling())
@@ -668,6 +681,12 @@ void Runtime::markWeakRoots(WeakRootAcceptor &acceptor, bool markLongLived) {
     for (auto &rm : runtimeModuleList_)
       rm.markLongLivedWeakRoots(acceptor);
   }
+  // The cached strings may be in the young generation, so they are marked in
+  // every collection.
+  numberStringCache_.markWeakRoots(acceptor);
+  // The samples are in the young generation until the next collection.
+  if (allocationSites_)
+    allocationSites_->markWeakRoots(acceptor);
   for (auto &fn : customMarkWeakRootFuncs_)
     fn(&getHeap(), acceptor);
   acceptor.endRootSection();
@@ -735,6 +754,8 @@ void Runtime::printRuntimeGCStats(JSONEmitter &json) const {
         std::string(markRootsPhaseNames[phaseNum]) + "Time",
         formatSecs(markRootsPhaseTimes_[phaseNum]).secs);
   }
+  if (allocationSites_)
+    allocationSites_->printStats(json);
   json.closeDict();
 }
 
@@ -1627,7 +1648,6 @@ static const struct {
   {(uint16_t)Predefined::object, (uint16_t)Predefined::method},
 #endif
 #define PRIVATE_BUILTIN(name)
-#define JS_BUILTIN(name)
 } publicNativeBuiltins[] = {
 #include "hermes/FrontEndDefs/Builtins.def"
 };
@@ -1720,43 +1740,13 @@ void Runtime::initNativeBuiltins() {
   // Now add the private native builtins.
   createHermesBuiltins(*this, builtins_);
 #ifndef NDEBUG
-  // Make sure native builtins are all defined.
-  for (unsigned i = 0; i < BuiltinMethod::_firstJS; ++i) {
+  // Make sure builtins are all defined.
+  for (unsigned i = 0; i < BuiltinMethod::_count; ++i) {
     assert(builtins_[i] && "native builtin not initialized");
   }
 #endif
 }
 
-static const struct JSBuiltin {
-  uint16_t symID, builtinIndex;
-} jsBuiltins[] = {
-#define BUILTIN_METHOD(object, method)
-#define PRIVATE_BUILTIN(name)
-#define JS_BUILTIN(name)                                \
-  {                                                     \
-    (uint16_t) Predefined::name,                        \
-        (uint16_t)BuiltinMethod::HermesBuiltin##_##name \
-  }
-#include "hermes/FrontEndDefs/Builtins.def"
-};
-
-void Runtime::initJSBuiltins(
-    llvh::MutableArrayRef<Callable *> builtins,
-    Handle<JSObject> jsBuiltinsObj) {
-  for (const JSBuiltin &jsBuiltin : jsBuiltins) {
-    auto symID = jsBuiltin.symID;
-    auto builtinIndex = jsBuiltin.builtinIndex;
-
-    // Try to get the JS function from jsBuiltinsObj.
-    auto getRes = JSObject::getNamed_RJS(
-        jsBuiltinsObj, *this, Predefined::getSymbolID((Predefined::Str)symID));
-    assert(getRes == ExecutionStatus::RETURNED && "Failed to get JS builtin.");
-    JSFunction *jsFunc = vmcast<JSFunction>(getRes->getHermesValue());
-
-    builtins[builtinIndex] = jsFunc;
-  }
-}
-
 ExecutionStatus Runtime::assertBuiltinsUnmodified() {
   assert(!builtinsFrozen_ && "Builtins are already frozen.");
   GCScope gcScope(*this);
@@ -2154,8 +2144,12 @@ void Runtime::recordHiddenClass(
     const Inst *cacheMissInst,
     SymbolID symbolID,
     HiddenClass *objectHiddenClass,
-    HiddenClass *cachedHiddenClass) {
+    HiddenClass *cachedHiddenClass,
+    bool polymorphic,
+    bool megamorphic) {
   auto offset = codeBlock->getOffsetOf(cacheMissInst);
+  inlineCacheProfiler_.recordCacheState(
+      codeBlock, offset, polymorphic, megamorphic);
 
   // inline caching hit
   if (objectHiddenClass == cachedHiddenClass) {
@@ -2234,6 +2228,10 @@ StackTracesTreeNode *Runtime::getCurrentStackTracesTreeNode(
   }
   const CodeBlock *codeBlock;
   std::tie(codeBlock, ip) = getCurrentInterpreterLocation(ip);
+  if (!trackingCallStack_) {
+    // Calls and returns aren't followed, find the callers on the stack.
+    stackTracesTree_->syncWithRuntimeStack(*this);
+  }
   return stackTracesTree_->getStackTrace(*this, codeBlock, ip);
 }
 
@@ -2247,11 +2245,13 @@ void Runtime::enableAllocationLocationTracker(
     stackTracesTree_ = std::make_unique<StackTracesTree>();
   }
   stackTracesTree_->syncWithRuntimeStack(*this);
+  trackingCallStack_ = true;
   getHeap().enableHeapProfiler(std::move(fragmentCallback));
 }
 
 void Runtime::disableAllocationLocationTracker(bool clearExistingTree) {
   getHeap().disableHeapProfiler();
+  trackingCallStack_ = false;
   if (clearExistingTree) {
     stackTracesTree_.reset();
   }
@@ -2263,13 +2263,15 @@ void Runtime::enableSamplingHeapProfiler(
   if (!stackTracesTree_) {
     stackTracesTree_ = std::make_unique<StackTracesTree>();
   }
-  stackTracesTree_->syncWithRuntimeStack(*this);
   getHeap().enableSamplingHeapProfiler(samplingInterval, seed);
 }
 
 void Runtime::disableSamplingHeapProfiler(llvh::raw_ostream &os) {
   getHeap().disableSamplingHeapProfiler(os);
-  stackTracesTree_.reset();
+  // The allocation location tracker may still be using the tree.
+  if (!trackingCallStack_) {
+    stackTracesTree_.reset();
+  }
 }
 
 void Runtime::popCallStackImpl() {
@@ -250,10 +250,17 @@ void RuntimeModule::importStringIDMapMayAllocate() {
       hashes.size() <= strTableSize &&
       "Should not have more strings than identifiers");
 
+  // The identifiers of a persistent module can be registered without
+  // allocating, so they are registered the first time they are used. This
+  // keeps most of them out of the identifier table on startup.
+  const bool lazyIdentifiers = flags_.persistent;
+  identifierRuns_.clear();
+
   // Preallocate enough space to store all identifiers to prevent
   // unnecessary allocations. NOTE: If this module is not the first module,
   // then this is an underestimate.
-  runtime_.getIdentifierTable().reserve(hashes.size());
+  if (!lazyIdentifiers)
+    runtime_.getIdentifierTable().reserve(hashes.size());
   {
     StringID strID = 0;
     uint32_t hashID = 0;
@@ -265,6 +272,12 @@ void RuntimeModule::importStringIDMapMayAllocate() {
           break;
 
         case StringKind::Identifier:
+          if (lazyIdentifiers) {
+            identifierRuns_.push_back({strID, entry.count(), hashID});
+            strID += entry.count();
+            hashID += entry.count();
+            break;
+          }
           for (uint32_t i = 0; i < entry.count(); ++i, ++strID, ++hashID) {
             createSymbolFromStringIDMayAllocate(
                 strID, bcProvider_->getStringTableEntry(strID), hashes[hashID]);
@@ -297,6 +310,31 @@ void RuntimeModule::importStringIDMapMayAllocate() {
   }
 }
 
+OptValue<uint32_t> RuntimeModule::getIdentifierHash(StringID stringID) const {
+  // Find the last run starting at or before stringID.
+  auto it = std::upper_bound(
+      identifierRuns_.begin(),
+      identifierRuns_.end(),
+      stringID,
+      [](StringID id, const IdentifierRun &run) { return id < run.firstID; });
+  if (it == identifierRuns_.begin())
+    return llvh::None;
+  --it;
+  if (stringID - it->firstID >= it->count)
+    return llvh::None;
+  return bcProvider_->getIdentifierHashes()[it->firstHash + stringID -
+                                            it->firstID];
+}
+
+SymbolID RuntimeModule::importIdentifier(StringID stringID) {
+  OptValue<uint32_t> hash = getIdentifierHash(stringID);
+  assert(
+      hash && flags_.persistent &&
+      "Only identifiers of persistent modules are imported on first use");
+  return createSymbolFromStringIDMayAllocate(
+      stringID, bcProvider_->getStringTableEntry(stringID), hash);
+}
+
 void RuntimeModule::initializeFunctionMap() {
   assert(bcProvider_ && "Uninitialized RuntimeModule");
   assert(
@@ -438,6 +476,7 @@ void RuntimeModule::tryCacheLiteralHiddenClass(
 
 size_t RuntimeModule::additionalMemorySize() const {
   return stringIDMap_.capacity() * sizeof(SymbolID) +
+      identifierRuns_.capacity() * sizeof(IdentifierRun) +
       objectLiteralHiddenClasses_.getMemorySize() +
       templateMap_.getMemorySize();
 }
@@ -59,6 +59,40 @@ void ExternalUTF16StringPrimitiveBuildMeta(
   mb.setVTable(&ExternalUTF16StringPrimitive::vt);
 }
 
+void ConcatASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const ConcatASCIIStringPrimitive *>(cell);
+  mb.setVTable(&ConcatASCIIStringPrimitive::vt);
+  mb.addField("left", &self->left_);
+  mb.addField("right", &self->right_);
+}
+
+void ConcatUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const ConcatUTF16StringPrimitive *>(cell);
+  mb.setVTable(&ConcatUTF16StringPrimitive::vt);
+  mb.addField("left", &self->left_);
+  mb.addField("right", &self->right_);
+}
+
+void SlicedASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedASCIIStringPrimitive *>(cell);
+  mb.setVTable(&SlicedASCIIStringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+
+void SlicedUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedUTF16StringPrimitive *>(cell);
+  mb.setVTable(&SlicedUTF16StringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+
 template <typename T>
 CallResult<HermesValue> StringPrimitive::createEfficientImpl(
     Runtime &runtime,
@@ -331,6 +365,21 @@ CallResult<HermesValue> StringPrimitive::slice(
   assert(
       start + length <= str->getStringLength() && "Invalid length for slice");
 
+  if (start == 0 && length == str->getStringLength()) {
+    return str.getHermesValue();
+  }
+
+  if (length >= SLICED_STRING_MIN_SIZE) {
+    // Refer to the characters of the string instead of copying them.
+    str = ensureFlat(runtime, str);
+    if (str->isASCII()) {
+      return SlicedASCIIStringPrimitive::create(runtime, str, start, length)
+          .getHermesValue();
+    }
+    return SlicedUTF16StringPrimitive::create(runtime, str, start, length)
+        .getHermesValue();
+  }
+
   SafeUInt32 safeLen(length);
 
   auto builder =
@@ -355,6 +404,40 @@ StringView StringPrimitive::createStringView(
   return createStringViewMustBeFlat(self);
 }
 
+void StringPrimitive::flattenRope(
+    Runtime &runtime,
+    Handle<StringPrimitive> self) {
+  if (self->isASCII()) {
+    vmcast<ConcatASCIIStringPrimitive>(*self)->flatten(runtime);
+  } else {
+    vmcast<ConcatUTF16StringPrimitive>(*self)->flatten(runtime);
+  }
+}
+
+template <typename F>
+void StringPrimitive::forEachFlatPart(const StringPrimitive *str, F visit) {
+  // Walk the ropes with an explicit stack instead of recursing. Ropes are at
+  // most MAX_ROPE_DEPTH deep, which bounds the size of the stack.
+  llvh::SmallVector<const StringPrimitive *, 16> pending{str};
+  while (!pending.empty()) {
+    const StringPrimitive *cur = pending.pop_back_val();
+    if (auto *rope = dyn_vmcast<ConcatASCIIStringPrimitive>(cur)) {
+      if (!rope->flat_) {
+        pending.push_back(vmcast<StringPrimitive>(rope->right_));
+        pending.push_back(vmcast<StringPrimitive>(rope->left_));
+        continue;
+      }
+    } else if (auto *rope = dyn_vmcast<ConcatUTF16StringPrimitive>(cur)) {
+      if (!rope->flat_) {
+        pending.push_back(vmcast<StringPrimitive>(rope->right_));
+        pending.push_back(vmcast<StringPrimitive>(rope->left_));
+        continue;
+      }
+    }
+    visit(cur);
+  }
+}
+
 void StringPrimitive::appendUTF16String(
     llvh::SmallVectorImpl<char16_t> &str) const {
   if (isASCII()) {
@@ -631,20 +714,26 @@ template <>
 void BufferedStringPrimitive<char>::appendToCopyableString(
     CopyableBasicString<char> &res,
     const StringPrimitive *str) {
-  auto it = str->castToASCIIPointer();
-  res.append(it, it + str->getStringLength());
+  // Copy the parts of a rope directly, without flattening it first.
+  forEachFlatPart(str, [&res](const StringPrimitive *part) {
+    auto it = part->castToASCIIPointer();
+    res.append(it, it + part->getStringLength());
+  });
 }
 template <>
 void BufferedStringPrimitive<char16_t>::appendToCopyableString(
     CopyableBasicString<char16_t> &res,
     const StringPrimitive *str) {
-  if (str->isASCII()) {
-    auto it = (const uint8_t *)str->castToASCIIPointer();
-    res.append(it, it + str->getStringLength());
-  } else {
-    auto it = str->castToUTF16Pointer();
-    res.append(it, it + str->getStringLength());
-  }
+  // Copy the parts of a rope directly, without flattening it first.
+  forEachFlatPart(str, [&res](const StringPrimitive *part) {
+    if (part->isASCII()) {
+      auto it = (const uint8_t *)part->castToASCIIPointer();
+      res.append(it, it + part->getStringLength());
+    } else {
+      auto it = part->castToUTF16Pointer();
+      res.append(it, it + part->getStringLength());
+    }
+  });
 }
 
 template <typename T>
@@ -715,25 +804,58 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
 
   assertValidLength(left, right);
 
+  // Appending to the end of a concatenation chain continues the chain, in a
+  // new UTF16 buffer if necessary. Appending a shorter string to a flat string
+  // starts a new chain, so that the appends that usually follow are cheap.
+  // Anything else refers to both strings from a rope instead of copying them,
+  // unless the rope would be too deep.
+  bool leftIsBuffered = false;
+  bool leftEndsChain = false;
+  if (auto *bufLeft = dyn_vmcast<BufferedASCIIStringPrimitive>(left)) {
+    leftIsBuffered = true;
+    leftEndsChain = bufLeft->getStringLength() ==
+        bufLeft->getConcatBuffer()->contents_.size();
+  } else if (auto *bufLeft = dyn_vmcast<BufferedUTF16StringPrimitive>(left)) {
+    leftIsBuffered = true;
+    leftEndsChain = bufLeft->getStringLength() ==
+        bufLeft->getConcatBuffer()->contents_.size();
+  }
+  auto ropeDepth = [](const StringPrimitive *str) -> uint32_t {
+    if (auto *rope = dyn_vmcast<ConcatASCIIStringPrimitive>(str))
+      return rope->getDepth();
+    if (auto *rope = dyn_vmcast<ConcatUTF16StringPrimitive>(str))
+      return rope->getDepth();
+    return 0;
+  };
+  uint32_t leftDepth = ropeDepth(left);
+  uint32_t depth = std::max(leftDepth, ropeDepth(right)) + 1;
+  bool startsChain = !leftIsBuffered && leftDepth == 0 &&
+      right->getStringLength() < left->getStringLength();
+  bool useRope =
+      !leftEndsChain && !startsChain && depth <= StringPrimitive::MAX_ROPE_DEPTH;
+
   if (left->isASCII() && right->isASCII()) {
-    if (auto *bufLeft = dyn_vmcast<BufferedASCIIStringPrimitive>(left)) {
-      if (bufLeft->getStringLength() ==
-          bufLeft->getConcatBuffer()->contents_.size())
-        return BufferedASCIIStringPrimitive::append(
-            Handle<BufferedASCIIStringPrimitive>::vmcast(leftHnd),
-            runtime,
-            rightHnd);
+    if (useRope) {
+      return ConcatASCIIStringPrimitive::create(
+          runtime, leftHnd, rightHnd, depth);
+    }
+    if (leftEndsChain) {
+      return BufferedASCIIStringPrimitive::append(
+          Handle<BufferedASCIIStringPrimitive>::vmcast(leftHnd),
+          runtime,
+          rightHnd);
     }
     return BufferedASCIIStringPrimitive::create(runtime, leftHnd, rightHnd);
   } else {
-    if (auto *bufLeft = dyn_vmcast<BufferedUTF16StringPrimitive>(left)) {
-      if (bufLeft->getStringLength() ==
-          bufLeft->getConcatBuffer()->contents_.size()) {
-        return BufferedUTF16StringPrimitive::append(
-            Handle<BufferedUTF16StringPrimitive>::vmcast(leftHnd),
-            runtime,
-            rightHnd);
-      }
+    if (useRope) {
+      return ConcatUTF16StringPrimitive::create(
+          runtime, leftHnd, rightHnd, depth);
+    }
+    if (leftEndsChain && !left->isASCII()) {
+      return BufferedUTF16StringPrimitive::append(
+          Handle<BufferedUTF16StringPrimitive>::vmcast(leftHnd),
+          runtime,
+          rightHnd);
     }
     return BufferedUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
   }
@@ -755,5 +877,164 @@ void BufferedStringPrimitive<T>::_snapshotAddNodesImpl(
 
 template class BufferedStringPrimitive<char16_t>;
 template class BufferedStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// ConcatStringPrimitive<T>
+
+template <typename T>
+PseudoHandle<StringPrimitive> ConcatStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> left,
+    Handle<StringPrimitive> right,
+    uint32_t depth) {
+  assertValidLength(left.get(), right.get());
+  assert(
+      (std::is_same<T, char16_t>::value ||
+       (left->isASCII() && right->isASCII())) &&
+      "cannot concatenate UTF16 into an ASCII rope");
+  assert(depth <= MAX_ROPE_DEPTH && "rope is too deep");
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because ConcatStringPrimitive is derived from
+  // VariableSizeRuntimeCell.
+  auto *cell =
+      runtime.makeAVariable<ConcatStringPrimitive<T>, HasFinalizer::Yes>(
+          sizeof(ConcatStringPrimitive<T>), runtime, left, right, depth);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+template <typename T>
+void ConcatStringPrimitive<T>::flattenContents() const {
+  assert(!flat_ && "rope is already flattened");
+  T *buf = static_cast<T *>(checkedMalloc2(getStringLength(), sizeof(T)));
+  T *dst = buf;
+  forEachFlatPart(this, [&dst](const StringPrimitive *part) {
+    uint32_t len = part->getStringLength();
+    if (part->isASCII()) {
+      const char *src = part->castToASCIIPointer();
+      dst = std::copy(src, src + len, dst);
+    } else {
+      assert(
+          (std::is_same<T, char16_t>::value) &&
+          "cannot copy UTF16 into an ASCII rope");
+      const char16_t *src = part->castToUTF16Pointer();
+      dst = std::copy(src, src + len, dst);
+    }
+  });
+  assert(dst == buf + getStringLength() && "rope length mismatch");
+  flat_ = buf;
+}
+
+template <typename T>
+void ConcatStringPrimitive<T>::flatten(Runtime &runtime) {
+  if (released_) {
+    return;
+  }
+  if (!flat_) {
+    flattenContents();
+  }
+  runtime.getHeap().creditExternalMemory(this, calcExternalMemorySize());
+  released_ = true;
+  left_.setNonPtr(HermesValue::encodeUndefinedValue(), runtime.getHeap());
+  right_.setNonPtr(HermesValue::encodeUndefinedValue(), runtime.getHeap());
+}
+
+template <typename T>
+void ConcatStringPrimitive<T>::_finalizeImpl(GCCell *cell, GC &gc) {
+  auto *self = vmcast<ConcatStringPrimitive<T>>(cell);
+  if (self->flat_) {
+    // Remove the flattened buffer from the snapshot tracking system if it's
+    // being tracked.
+    gc.getIDTracker().untrackNative(self->flat_);
+    if (self->released_) {
+      gc.debitExternalMemory(self, self->calcExternalMemorySize());
+    }
+    free(self->flat_);
+  }
+  self->~ConcatStringPrimitive<T>();
+}
+
+template <typename T>
+size_t ConcatStringPrimitive<T>::_mallocSizeImpl(GCCell *cell) {
+  return vmcast<ConcatStringPrimitive<T>>(cell)->calcExternalMemorySize();
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+template <typename T>
+void ConcatStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {
+  auto *const self = vmcast<ConcatStringPrimitive<T>>(cell);
+  if (!self->flat_)
+    return;
+  snap.addNamedEdge(
+      HeapSnapshot::EdgeType::Internal,
+      "flattenedString",
+      gc.getNativeID(self->flat_));
+}
+
+template <typename T>
+void ConcatStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {
+  auto *const self = vmcast<ConcatStringPrimitive<T>>(cell);
+  if (!self->flat_)
+    return;
+  snap.beginNode();
+  snap.endNode(
+      HeapSnapshot::NodeType::Native,
+      "ConcatStringPrimitive",
+      gc.getNativeID(self->flat_),
+      self->calcExternalMemorySize(),
+      0);
+}
+#endif
+
+template class ConcatStringPrimitive<char16_t>;
+template class ConcatStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// SlicedStringPrimitive<T>
+
+template <typename T>
+PseudoHandle<StringPrimitive> SlicedStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> parent,
+    uint32_t offset,
+    uint32_t length) {
+  assert(parent->isFlat() && "cannot slice a rope");
+  assert(
+      parent->isASCII() == (std::is_same<T, char>::value) &&
+      "sliced string must have the same type");
+  if (auto *sliced = dyn_vmcast<SlicedStringPrimitive<T>>(parent.get())) {
+    // Don't build chains of sliced strings.
+    offset += sliced->offset_;
+    parent = runtime.makeHandle(vmcast<StringPrimitive>(sliced->parentHV_));
+  }
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because SlicedStringPrimitive is derived from
+  // VariableSizeRuntimeCell.
+  auto *cell = runtime.makeAVariable<SlicedStringPrimitive<T>>(
+      sizeof(SlicedStringPrimitive<T>), runtime, parent, offset, length);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+template <typename T>
+void SlicedStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+
+template <typename T>
+void SlicedStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+#endif
+
+template class SlicedStringPrimitive<char16_t>;
+template class SlicedStringPrimitive<char>;
 } // namespace vm
 } // namespace hermes
@@ -19,8 +19,9 @@
 #include "hermes/VM/SmallHermesValue-inline.h"
 
 #include <array>
+#include <chrono>
+#include <deque>
 #include <functional>
-#include <stack>
 
 #pragma GCC diagnostic push
 
@@ -297,6 +298,11 @@ class HadesGC::CollectionStats final {
     endTime_ = Clock::now();
   }
 
+  /// \return the time between the begin and end times of the collection.
+  Duration getDuration() const {
+    return std::chrono::duration_cast<Duration>(endTime_ - beginTime_);
+  }
+
   std::chrono::milliseconds getElapsedTime() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
         Clock::now() - beginTime_);
@@ -398,15 +404,290 @@ template <>
   return CompressedPointer::encodeNonNull(a, base);
 }
 
+/// The stack of cells that a GC thread has found but not yet scanned: marked
+/// cells in parallel marking, or evacuated cells in parallel evacuation. The
+/// owning thread shares some of its cells with idle threads by moving them to a
+/// separate buffer, protected by a lock, from which the other threads steal.
+/// The owner pushes and pops the stack itself without synchronization.
+class MarkStack {
+ public:
+  bool empty() const {
+    return stack_.empty();
+  }
+
+  void push(GCCell *cell) {
+    stack_.push_back(cell);
+  }
+
+  GCCell *pop() {
+    GCCell *const cell = stack_.back();
+    stack_.pop_back();
+    return cell;
+  }
+
+  /// \return true if some cells are available for stealing.
+  bool hasSharedCells() const {
+    return sharedSize_.load(std::memory_order_relaxed) != 0;
+  }
+
+  /// If the shared buffer is empty, move up to half of the cells of the stack
+  /// to it. The oldest cells are shared, since they tend to lead to the most
+  /// work.
+  void shareSurplus() {
+    if (hasSharedCells())
+      return;
+    const size_t numShared = std::min(stack_.size() / 2, kMaxSharedCells);
+    if (!numShared)
+      return;
+    std::lock_guard<std::mutex> lk{sharedMtx_};
+    shared_.insert(shared_.end(), stack_.begin(), stack_.begin() + numShared);
+    stack_.erase(stack_.begin(), stack_.begin() + numShared);
+    sharedSize_.store(shared_.size(), std::memory_order_relaxed);
+  }
+
+  /// Move half of the shared cells of \p victim, which may be this stack, to
+  /// this stack.
+  /// \return true if any cells were moved.
+  bool stealFrom(MarkStack &victim) {
+    if (!victim.hasSharedCells())
+      return false;
+    std::lock_guard<std::mutex> lk{victim.sharedMtx_};
+    const size_t numAvailable = victim.shared_.size();
+    if (!numAvailable)
+      return false;
+    const size_t numStolen = (numAvailable + 1) / 2;
+    stack_.insert(
+        stack_.end(), victim.shared_.end() - numStolen, victim.shared_.end());
+    victim.shared_.resize(numAvailable - numStolen);
+    victim.sharedSize_.store(victim.shared_.size(), std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Move all the cells of \p other, including its shared cells, to this
+  /// stack. \p other may be this stack.
+  /// WARN: This can only be called when no other thread accesses either stack.
+  void takeAll(MarkStack &other) {
+    stack_.insert(stack_.end(), other.shared_.begin(), other.shared_.end());
+    other.shared_.clear();
+    other.sharedSize_.store(0, std::memory_order_relaxed);
+    if (&other == this)
+      return;
+    stack_.insert(stack_.end(), other.stack_.begin(), other.stack_.end());
+    other.stack_.clear();
+  }
+
+ private:
+  /// The maximum number of cells to share at once.
+  static constexpr size_t kMaxSharedCells = 256;
+
+  std::deque<GCCell *> stack_;
+
+  /// Protects shared_.
+  std::mutex sharedMtx_;
+
+  /// Cells that other threads may steal.
+  std::vector<GCCell *> shared_;
+
+  /// The size of shared_, readable without holding the lock.
+  std::atomic<size_t> sharedSize_{0};
+};
+
+/// The state shared by the threads of a parallel YG evacuation. The evacuation
+/// happens in two steps:
+/// 1. The threads scan the dirty cards, each taking one segment at a time, and
+///    record the slots that point into the YG or the compactee. Nothing is
+///    evacuated yet, because a thread cannot safely walk the cells of a segment
+///    while another thread allocates into it.
+/// 2. The first thread evacuates the roots, while all the threads evacuate the
+///    cells pointed to by the slots they recorded. Then they visit the slots of
+///    the evacuated cells, stealing cells from each other to balance the work.
+/// Each thread copies cells into its own promotion buffer in the OG, and only
+/// takes promotionMutex_ to get a new buffer.
+class HadesGC::ParallelEvacuation {
+ public:
+  /// A slot found while scanning the dirty cards.
+  struct RecordedSlot {
+    enum class Kind : uint8_t { Pointer, HermesValue, SmallHermesValue };
+    void *loc;
+    Kind kind;
+  };
+
+  /// Records the slots that point into the YG or the compactee.
+  class SlotRecorder final : public SlotAcceptor {
+   public:
+    SlotRecorder(HadesGC &gc, std::vector<RecordedSlot> &slots)
+        : gc{gc}, slots_{slots} {}
+
+    void accept(GCPointerBase &ptr) override {
+      if (gc.inYoungGen(ptr) || gc.compactee_.contains(ptr))
+        slots_.push_back({&ptr, RecordedSlot::Kind::Pointer});
+    }
+
+    void accept(GCHermesValue &hv) override {
+      if (hv.isPointer() &&
+          (gc.inYoungGen(hv.getPointer()) ||
+           gc.compactee_.contains(hv.getPointer())))
+        slots_.push_back({&hv, RecordedSlot::Kind::HermesValue});
+    }
+
+    void accept(GCSmallHermesValue &hv) override {
+      if (hv.isPointer() &&
+          (gc.inYoungGen(hv.getPointer()) ||
+           gc.compactee_.contains(hv.getPointer())))
+        slots_.push_back({&hv, RecordedSlot::Kind::SmallHermesValue});
+    }
+
+    void accept(const GCSymbolID &sym) override {}
+
+   private:
+    HadesGC &gc;
+    std::vector<RecordedSlot> &slots_;
+  };
+
+  /// A region of the OG that one thread copies cells into. The cells occupy
+  /// the first \c used bytes of the region.
+  struct PromotionBuffer {
+    char *start{nullptr};
+    uint32_t size{0};
+    uint32_t used{0};
+  };
+
+  ParallelEvacuation(HadesGC &gc, unsigned numThreads)
+      : slots(numThreads), numActive{numThreads}, gc_{gc} {}
+
+  /// Allocate \p sz bytes from \p buf, replacing it with a new buffer if it
+  /// is too small.
+  /// \return the allocated memory, or null if the OG ran out of memory.
+  GCCell *alloc(PromotionBuffer &buf, uint32_t sz) {
+    const uint32_t available = buf.size - buf.used;
+    // The rest of the buffer must be empty or large enough to go back on the
+    // freelist.
+    if (LLVM_LIKELY(
+            sz + minAllocationSize() <= available || sz == available)) {
+      GCCell *const cell = reinterpret_cast<GCCell *>(buf.start + buf.used);
+      buf.used += sz;
+      return cell;
+    }
+    return refill(buf, sz);
+  }
+
+  /// Undo the allocation of \p cell, of size \p sz, which was the last one
+  /// from \p buf.
+  void undoAlloc(PromotionBuffer &buf, GCCell *cell, uint32_t sz) {
+    assert(
+        reinterpret_cast<char *>(cell) + sz == buf.start + buf.used &&
+        "Can only undo the last allocation from a buffer");
+    buf.used -= sz;
+  }
+
+  /// Stop using \p buf. Its cells are finished by \c finish().
+  void retire(PromotionBuffer &buf) {
+    std::lock_guard<Mutex> lk{gc_.promotionMutex_};
+    if (buf.start)
+      retired_.push_back(buf);
+    buf = PromotionBuffer{};
+  }
+
+  /// Set the cell heads and the mark bits of the cells copied into the retired
+  /// buffers, which are skipped while copying because several threads may
+  /// update the same words, and put the unused rest of the buffers back on the
+  /// freelist.
+  /// WARN: This can only be called once all the threads are done.
+  void finish() {
+    for (const PromotionBuffer &buf : retired_) {
+      char *const end = buf.start + buf.used;
+      for (char *cur = buf.start; cur < end;) {
+        GCCell *const cell = reinterpret_cast<GCCell *>(cur);
+        const uint32_t sz = cell->getAllocatedSize();
+        HeapSegment::setCellHead(cell, sz);
+        HeapSegment::setCellMarkBit(cell);
+        cur += sz;
+      }
+      if (buf.used != buf.size)
+        gc_.oldGen_.returnToFreelist(end, buf.size - buf.used);
+    }
+    retired_.clear();
+  }
+
+  /// \return true if a thread could not allocate a promotion buffer.
+  bool failed() const {
+    return failed_.load(std::memory_order_relaxed);
+  }
+
+  /// \return the reason the OG ran out of memory.
+  /// WARN: This can only be called once all the threads are done.
+  std::error_code oomReason() const {
+    return oomReason_;
+  }
+
+  /// The slots recorded by each thread.
+  std::vector<std::vector<RecordedSlot>> slots;
+
+  /// The index of the next segment to scan for dirty cards.
+  std::atomic<size_t> nextSegment{0};
+
+  /// The number of threads that have not run out of work.
+  std::atomic<size_t> numActive;
+
+ private:
+  /// Retire \p buf, and replace it with a new buffer to allocate \p sz bytes
+  /// from.
+  GCCell *refill(PromotionBuffer &buf, uint32_t sz) {
+    // The preferred size of a buffer. Smaller buffers are taken from the
+    // freelist before growing the heap.
+    constexpr uint32_t kBufferSize = 32 * 1024;
+    std::lock_guard<Mutex> lk{gc_.promotionMutex_};
+    if (buf.start)
+      retired_.push_back(buf);
+    buf = PromotionBuffer{};
+    uint32_t bufSize = kBufferSize;
+    GCCell *start = nullptr;
+    for (; bufSize >= sz + minAllocationSize(); bufSize /= 2) {
+      if ((start = gc_.oldGen_.search(bufSize)))
+        break;
+    }
+    if (!start) {
+      llvh::ErrorOr<GCCell *> res = gc_.oldGen_.allocOrError(sz);
+      if (!res) {
+        if (!failed_.exchange(true, std::memory_order_relaxed))
+          oomReason_ = res.getError();
+        return nullptr;
+      }
+      start = res.get();
+      bufSize = sz;
+    }
+    buf.start = reinterpret_cast<char *>(start);
+    buf.size = bufSize;
+    buf.used = sz;
+    return start;
+  }
+
+  HadesGC &gc_;
+
+  /// The buffers that are not used anymore. Protected by promotionMutex_.
+  std::vector<PromotionBuffer> retired_;
+
+  /// Set when the OG runs out of memory, to stop all the threads.
+  std::atomic<bool> failed_{false};
+  std::error_code oomReason_;
+};
+
 template <bool CompactionEnabled>
 class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
                                     public WeakRootAcceptor {
  public:
-  EvacAcceptor(HadesGC &gc)
+  /// Create an acceptor for a serial evacuation, or for one of the threads of
+  /// \p evacuation.
+  EvacAcceptor(HadesGC &gc, ParallelEvacuation *evacuation = nullptr)
       : gc{gc},
         pointerBase_{gc.getPointerBase()},
         copyListHead_{nullptr},
-        isTrackingIDs_{gc.isTrackingIDs()} {}
+        isTrackingIDs_{gc.isTrackingIDs()},
+        evacuation_{evacuation} {
+    assert(
+        !(evacuation && isTrackingIDs_) &&
+        "Moving tracked objects requires a serial evacuation");
+  }
 
   ~EvacAcceptor() override {}
 
@@ -464,6 +745,8 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   LLVM_NODISCARD T forwardCell(GCCell *const cell) {
     assert(
         HeapSegment::getCellMarkBit(cell) && "Cannot forward unmarked object");
+    if (evacuation_)
+      return forwardCellParallel<T>(cell);
     if (cell->hasMarkedForwardingPointer()) {
       // Get the forwarding pointer from the header of the object.
       CompressedPointer forwardedCell = cell->getMarkedForwardingPointer();
@@ -497,6 +780,37 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
     return convertPtr<T>(pointerBase_, newCell);
   }
 
+  /// Same as forwardCell, but other threads may forward \p cell concurrently.
+  /// The copy is done before trying to install the forwarding pointer, and
+  /// undone if another thread installed one first.
+  template <typename T>
+  LLVM_NODISCARD T forwardCellParallel(GCCell *const cell) {
+    uint32_t cellSize;
+    const CompressedPointer forwardedCell =
+        cell->getMarkedForwardingPointerAtomic(cellSize);
+    if (forwardedCell)
+      return convertPtr<T>(pointerBase_, forwardedCell);
+    GCCell *const newCell = evacuation_->alloc(promotionBuffer_, cellSize);
+    // Leave the pointer as is if the OG is out of memory, the evacuation is
+    // about to report OOM.
+    if (LLVM_UNLIKELY(!newCell))
+      return convertPtr<T>(pointerBase_, cell);
+    std::memcpy(newCell, cell, cellSize);
+    const CompressedPointer newCellCP =
+        CompressedPointer::encodeNonNull(newCell, pointerBase_);
+    const CompressedPointer installedCell =
+        cell->setMarkedForwardingPointerAtomic(newCellCP);
+    if (installedCell != newCellCP) {
+      // Another thread evacuated the cell first.
+      evacuation_->undoAlloc(promotionBuffer_, newCell, cellSize);
+      return convertPtr<T>(pointerBase_, installedCell);
+    }
+    assert(newCell->isValid() && "Cell was copied incorrectly");
+    evacuatedBytes_ += cellSize;
+    stack_.push(newCell);
+    return convertPtr<T>(pointerBase_, newCell);
+  }
+
   void accept(GCCell *&ptr) override {
     ptr = acceptRoot(ptr);
   }
@@ -560,6 +874,71 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
     return evacuatedBytes_;
   }
 
+  /// Evacuate the cells pointed to by \p slots, found by the dirty card
+  /// scanning of a parallel evacuation.
+  void acceptRecordedSlots(
+      llvh::ArrayRef<ParallelEvacuation::RecordedSlot> slots) {
+    using Kind = ParallelEvacuation::RecordedSlot::Kind;
+    for (const ParallelEvacuation::RecordedSlot &slot : slots) {
+      switch (slot.kind) {
+        case Kind::Pointer:
+          accept(*static_cast<GCPointerBase *>(slot.loc));
+          break;
+        case Kind::HermesValue:
+          accept(*static_cast<GCHermesValue *>(slot.loc));
+          break;
+        case Kind::SmallHermesValue:
+          accept(*static_cast<GCSmallHermesValue *>(slot.loc));
+          break;
+      }
+    }
+  }
+
+  /// Visit the slots of the cells evacuated by this thread, and of cells
+  /// stolen from \p acceptors, until all the threads of the parallel
+  /// evacuation run out of work.
+  void drainWithStealing(llvh::ArrayRef<EvacAcceptor *> acceptors) {
+    // Check whether other threads need work after visiting this many cells.
+    constexpr size_t kBatchSize = 64;
+    while (true) {
+      size_t numVisited = 0;
+      while (!stack_.empty()) {
+        if (evacuation_->failed())
+          return;
+        gc.markCell(stack_.pop(), *this);
+        if (++numVisited % kBatchSize == 0 &&
+            evacuation_->numActive.load(std::memory_order_relaxed) <
+                acceptors.size())
+          stack_.shareSurplus();
+      }
+      if (stealWork(acceptors))
+        continue;
+      // Nothing to steal. Wait until some thread shares cells, or all threads
+      // run out of work, as in MarkAcceptor::drainWithStealing.
+      evacuation_->numActive.fetch_sub(1, std::memory_order_acq_rel);
+      while (true) {
+        if (evacuation_->numActive.load(std::memory_order_acquire) == 0 ||
+            evacuation_->failed())
+          return;
+        if (std::any_of(
+                acceptors.begin(),
+                acceptors.end(),
+                [](const EvacAcceptor *acceptor) {
+                  return acceptor->stack_.hasSharedCells();
+                })) {
+          evacuation_->numActive.fetch_add(1, std::memory_order_acq_rel);
+          break;
+        }
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /// \return the buffer this thread copies cells into.
+  ParallelEvacuation::PromotionBuffer &promotionBuffer() {
+    return promotionBuffer_;
+  }
+
   CopyListCell *pop() {
     if (!copyListHead_) {
       return nullptr;
@@ -580,10 +959,39 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   const bool isTrackingIDs_;
   uint64_t evacuatedBytes_{0};
 
+  /// The parallel evacuation this acceptor is a thread of, or null if the
+  /// evacuation is serial.
+  ParallelEvacuation *const evacuation_;
+
+  /// In a parallel evacuation, the buffer that this thread copies cells into.
+  ParallelEvacuation::PromotionBuffer promotionBuffer_;
+
+  /// In a parallel evacuation, the evacuated cells whose slots have not been
+  /// visited yet. This replaces the copy list, which cannot be shared.
+  MarkStack stack_;
+
+  /// The index of the next thread to try stealing cells from.
+  size_t stealCursor_{0};
+
   void push(CopyListCell *cell) {
     cell->next_ = copyListHead_;
     copyListHead_ = CompressedPointer::encodeNonNull(cell, pointerBase_);
   }
+
+  /// Move some of the cells shared by this or another thread to the stack.
+  /// \return true if any cells were stolen.
+  bool stealWork(llvh::ArrayRef<EvacAcceptor *> acceptors) {
+    if (stack_.stealFrom(stack_))
+      return true;
+    const size_t numAcceptors = acceptors.size();
+    for (size_t i = 0; i < numAcceptors; ++i) {
+      EvacAcceptor *victim = acceptors[stealCursor_];
+      stealCursor_ = (stealCursor_ + 1) % numAcceptors;
+      if (victim != this && stack_.stealFrom(victim->stack_))
+        return true;
+    }
+    return false;
+  }
 };
 
 class MarkWorklist {
@@ -700,7 +1108,39 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
       : gc{gc},
         pointerBase_{gc.getPointerBase()},
         markedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
-        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()} {}
+        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
+        parallel_{gc.markWorkers_ != nullptr} {}
+
+  /// The state shared by the mark threads during a round of parallel marking.
+  struct ParallelRound {
+    ParallelRound(llvh::ArrayRef<MarkAcceptor *> markers, int64_t byteLimit)
+        : markers{markers}, numActive{markers.size()}, bytesLeft{byteLimit} {}
+
+    /// The markers of all the threads.
+    const llvh::ArrayRef<MarkAcceptor *> markers;
+
+    /// The number of threads that have not run out of work.
+    std::atomic<size_t> numActive;
+
+    /// The number of bytes left to mark in the round.
+    std::atomic<int64_t> bytesLeft;
+
+    /// \return true if the threads should stop marking, either because the
+    /// round has marked enough, or because the mutator is waiting for the
+    /// background thread to pause.
+    bool shouldStop(HadesGC &gc) const {
+      return bytesLeft.load(std::memory_order_relaxed) <= 0 ||
+          gc.ogPaused_.load(std::memory_order_relaxed);
+    }
+
+    /// \return true if any thread has shared cells for stealing.
+    bool hasSharedCells() const {
+      for (const MarkAcceptor *marker : markers)
+        if (marker->localWorklist_.hasSharedCells())
+          return true;
+      return false;
+    }
+  };
 
   void acceptHeap(GCCell *cell, const void *heapLoc) {
     assert(cell && "Cannot pass null pointer to acceptHeap");
@@ -825,6 +1265,24 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
     assert(localWorklist_.empty() && "Some work left that wasn't completed");
   }
 
+  /// Move the cells on the global worklist to the local worklist.
+  void pullGlobalWork() {
+    auto cells = globalWorklist_.drain();
+    for (GCCell *cell : cells) {
+      assert(
+          cell->isValid() && "Invalid cell received off the global worklist");
+      assert(
+          !gc.inYoungGen(cell) &&
+          "Shouldn't ever traverse a YG object in this loop");
+      HERMES_SLOW_ASSERT(
+          gc.dbgContains(cell) && "Non-heap cell found in global worklist");
+      if (!HeapSegment::getCellMarkBit(cell)) {
+        // Cell has not yet been marked.
+        push(cell);
+      }
+    }
+  }
+
   /// Drains some of the worklist, using a drain rate specified by
   /// \c setDrainRate or kConcurrentMarkLimit.
   /// \return true if there is any remaining work in the local worklist.
@@ -846,39 +1304,65 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
   bool drainSomeWork(const size_t markLimit) {
     assert(gc.gcMutex_ && "Must hold the GC lock while accessing mark bits.");
     // Pull any new items off the global worklist.
-    auto cells = globalWorklist_.drain();
-    for (GCCell *cell : cells) {
-      assert(
-          cell->isValid() && "Invalid cell received off the global worklist");
-      assert(
-          !gc.inYoungGen(cell) &&
-          "Shouldn't ever traverse a YG object in this loop");
-      HERMES_SLOW_ASSERT(
-          gc.dbgContains(cell) && "Non-heap cell found in global worklist");
-      if (!HeapSegment::getCellMarkBit(cell)) {
-        // Cell has not yet been marked.
-        push(cell);
+    pullGlobalWork();
+    assert(markLimit && "markLimit must be non-zero!");
+    markedBytes_ += drainLocalWork(markLimit);
+    return !localWorklist_.empty();
+  }
+
+  /// Mark cells as one of the threads of \p round, stealing cells from the
+  /// other threads when the local worklist runs out, until none of the threads
+  /// has any work left or the round should stop. The other threads may steal
+  /// cells from this marker meanwhile.
+  void drainWithStealing(ParallelRound &round) {
+    // Check the state of the round after marking this many bytes.
+    constexpr size_t kMarkBatchSize = 4096;
+    while (true) {
+      while (!localWorklist_.empty()) {
+        if (round.shouldStop(gc))
+          return;
+        const size_t numMarkedBytes = drainLocalWork(kMarkBatchSize);
+        markedBytes_ += numMarkedBytes;
+        round.bytesLeft.fetch_sub(numMarkedBytes, std::memory_order_relaxed);
+        // Some threads ran out of work, give them some.
+        if (round.numActive.load(std::memory_order_relaxed) <
+            round.markers.size())
+          localWorklist_.shareSurplus();
+      }
+      if (stealWork(round))
+        continue;
+      // Nothing to steal. Wait until some thread shares cells, or all threads
+      // run out of work. No thread goes idle with shared cells left, so there
+      // is no work left anywhere once all of them are idle.
+      round.numActive.fetch_sub(1, std::memory_order_acq_rel);
+      while (true) {
+        if (round.numActive.load(std::memory_order_acquire) == 0 ||
+            round.shouldStop(gc))
+          return;
+        if (round.hasSharedCells()) {
+          round.numActive.fetch_add(1, std::memory_order_acq_rel);
+          break;
+        }
+        std::this_thread::yield();
       }
     }
+  }
 
-    size_t numMarkedBytes = 0;
-    assert(markLimit && "markLimit must be non-zero!");
-    while (!localWorklist_.empty() && numMarkedBytes < markLimit) {
-      GCCell *const cell = localWorklist_.top();
-      localWorklist_.pop();
-      assert(cell->isValid() && "Invalid cell in marking");
-      assert(HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
-      assert(
-          !gc.inYoungGen(cell) &&
-          "Shouldn't ever traverse a YG object in this loop");
-      HERMES_SLOW_ASSERT(
-          gc.dbgContains(cell) && "Non-heap object discovered during marking");
-      const auto sz = cell->getAllocatedSize();
-      numMarkedBytes += sz;
-      gc.markCell(cell, *this);
-    }
-    markedBytes_ += numMarkedBytes;
-    return !localWorklist_.empty();
+  /// Move the work left in \p other, which may be this marker, to this
+  /// marker, along with its count of marked bytes.
+  /// WARN: This can only be called when no other thread is marking.
+  void takeWork(MarkAcceptor &other) {
+    localWorklist_.takeAll(other.localWorklist_);
+    if (&other == this)
+      return;
+    markedBytes_ += other.markedBytes_;
+    other.markedBytes_ = 0;
+  }
+
+  /// Add the symbols marked by \p other to the symbols marked by this
+  /// marker.
+  void mergeMarkedSymbols(const MarkAcceptor &other) {
+    markedSymbols_ |= other.markedSymbols_;
   }
 
   bool isLocalWorklistEmpty() const {
@@ -909,7 +1393,7 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
   /// A worklist local to the marking thread, that is only pushed onto by the
   /// marking thread. If this is empty, the global worklist must be consulted
   /// to ensure that pointers modified in write barriers are handled.
-  std::stack<GCCell *, std::vector<GCCell *>> localWorklist_;
+  MarkStack localWorklist_;
 
   /// A worklist that other threads may add to as objects to be marked and
   /// considered alive. These objects will *not* have their mark bits set,
@@ -938,14 +1422,29 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
   /// The number of bytes that have been marked so far.
   uint64_t markedBytes_{0};
 
+  /// Whether other markers may mark cells concurrently with this one, in
+  /// which case mark bits must be set atomically.
+  const bool parallel_;
+
+  /// Index in the markers of a parallel round at which to look for cells to
+  /// steal next.
+  size_t stealCursor_{0};
+
   void push(GCCell *cell) {
-    assert(
-        !HeapSegment::getCellMarkBit(cell) &&
-        "A marked object should never be pushed onto a worklist");
     assert(
         !gc.inYoungGen(cell) &&
         "Shouldn't ever push a YG object onto the worklist");
-    HeapSegment::setCellMarkBit(cell);
+    if (parallel_) {
+      // Another mark thread may have marked the cell since its mark bit was
+      // checked. Only the thread that sets the bit pushes the cell.
+      if (!HeapSegment::setCellMarkBitAtomic(cell))
+        return;
+    } else {
+      assert(
+          !HeapSegment::getCellMarkBit(cell) &&
+          "A marked object should never be pushed onto a worklist");
+      HeapSegment::setCellMarkBit(cell);
+    }
     // There could be a race here: however, the mutator will never change a
     // cell's kind after initialization. The GC thread might to a free cell, but
     // only during sweeping, not concurrently with this operation. Therefore
@@ -953,6 +1452,43 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor {
     localWorklist_.push(cell);
   }
 
+  /// Mark cells from the local worklist until it is empty, or at least
+  /// \p markLimit bytes have been marked.
+  /// \return the number of bytes marked.
+  size_t drainLocalWork(const size_t markLimit) {
+    size_t numMarkedBytes = 0;
+    while (!localWorklist_.empty() && numMarkedBytes < markLimit) {
+      GCCell *const cell = localWorklist_.pop();
+      assert(cell->isValid() && "Invalid cell in marking");
+      assert(HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
+      assert(
+          !gc.inYoungGen(cell) &&
+          "Shouldn't ever traverse a YG object in this loop");
+      HERMES_SLOW_ASSERT(
+          gc.dbgContains(cell) && "Non-heap object discovered during marking");
+      const auto sz = cell->getAllocatedSize();
+      numMarkedBytes += sz;
+      gc.markCell(cell, *this);
+    }
+    return numMarkedBytes;
+  }
+
+  /// Move some of the shared cells of one of the markers of \p round, starting
+  /// with this one, to the local worklist.
+  /// \return true if any cells were stolen.
+  bool stealWork(ParallelRound &round) {
+    if (localWorklist_.stealFrom(localWorklist_))
+      return true;
+    const size_t numMarkers = round.markers.size();
+    for (size_t i = 0; i < numMarkers; ++i) {
+      MarkAcceptor *victim = round.markers[stealCursor_];
+      stealCursor_ = (stealCursor_ + 1) % numMarkers;
+      if (victim != this && localWorklist_.stealFrom(victim->localWorklist_))
+        return true;
+    }
+    return false;
+  }
+
   template <typename T>
   T concurrentReadImpl(const T &valRef) {
     using Storage =
@@ -1077,6 +1613,86 @@ class HadesGC::Executor {
   std::thread thread_;
 };
 
+/// A fixed set of threads that run the same task together, to split a phase of
+/// a collection across several threads. The thread that runs a task takes
+/// part in it as worker 0, and waits for the other workers to finish it.
+class HadesGC::WorkerPool {
+ public:
+  /// Create a pool of \p numWorkers workers, including the thread that will
+  /// run the tasks.
+  explicit WorkerPool(unsigned numWorkers) {
+    assert(numWorkers > 1 && "A pool needs more than the calling thread");
+    for (unsigned i = 1; i < numWorkers; ++i)
+      threads_.emplace_back([this, i] { worker(i); });
+  }
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      shutdown_ = true;
+    }
+    startCV_.notify_all();
+    for (std::thread &thread : threads_)
+      thread.join();
+  }
+
+  /// \return the number of workers, including the thread running the tasks.
+  unsigned numWorkers() const {
+    return threads_.size() + 1;
+  }
+
+  /// Run \p task on every worker, passing it the index of the worker, and
+  /// return once all the workers have finished.
+  void run(const std::function<void(unsigned)> &task) {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      task_ = &task;
+      numPending_ = threads_.size();
+      ++generation_;
+    }
+    startCV_.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lk(mtx_);
+    doneCV_.wait(lk, [this]() { return numPending_ == 0; });
+    task_ = nullptr;
+  }
+
+ private:
+  /// Run each new task as worker \p index.
+  void worker(unsigned index) {
+    oscompat::set_thread_name("hades-worker");
+    uint64_t lastGeneration = 0;
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (true) {
+      startCV_.wait(lk, [this, &lastGeneration]() {
+        return shutdown_ || generation_ != lastGeneration;
+      });
+      if (shutdown_)
+        return;
+      lastGeneration = generation_;
+      const std::function<void(unsigned)> *task = task_;
+      lk.unlock();
+      (*task)(index);
+      lk.lock();
+      if (--numPending_ == 0)
+        doneCV_.notify_one();
+    }
+  }
+
+  std::mutex mtx_;
+  /// Signals the workers that a task started, or that the pool shuts down.
+  std::condition_variable startCV_;
+  /// Signals the thread running a task that all the workers finished it.
+  std::condition_variable doneCV_;
+  /// The current task.
+  const std::function<void(unsigned)> *task_{nullptr};
+  /// Incremented for each task, so workers run each task once.
+  uint64_t generation_{0};
+  /// The number of workers, other than worker 0, still running the task.
+  size_t numPending_{0};
+  bool shutdown_{false};
+  std::vector<std::thread> threads_;
+};
+
 bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
   // Check if there are any more segments to sweep. Note that in the case where
   // OG has zero segments, this also skips updating the stats and survival ratio
@@ -1281,6 +1897,14 @@ HadesGC::HadesGC(
       oldGen_{*this},
       backgroundExecutor_{
           kConcurrentGC ? std::make_unique<Executor>() : nullptr},
+      markWorkers_{
+          kConcurrentGC && gcConfig.getNumMarkThreads() > 1
+              ? std::make_unique<WorkerPool>(gcConfig.getNumMarkThreads())
+              : nullptr},
+      evacWorkers_{
+          kConcurrentGC && gcConfig.getNumEvacuationThreads() > 1
+              ? std::make_unique<WorkerPool>(gcConfig.getNumEvacuationThreads())
+              : nullptr},
       promoteYGToOG_{!gcConfig.getAllocInYoung()},
       revertToYGAtTTI_{gcConfig.getRevertToYGAtTTI()},
       overwriteDeadYGObjects_{gcConfig.getOverwriteDeadYGObjects()},
@@ -1291,6 +1915,8 @@ HadesGC::HadesGC(
               kYGInitialSurvivalRatio} {
   (void)vmExperimentFlags;
   std::lock_guard<Mutex> lk(gcMutex_);
+  if (markWorkers_)
+    markThreadStats_.resize(markWorkers_->numWorkers());
   crashMgr_->setCustomData("HermesGC", getKindAsStr().c_str());
   // createSegment relies on member variables and should not be called until
   // they are initialised.
@@ -1442,6 +2068,39 @@ void HadesGC::printStats(JSONEmitter &json) {
   json.emitKey("stats");
   json.openDict();
   json.emitKeyValue("Num compactions", numCompactions_);
+  {
+    std::lock_guard<Mutex> lk{gcMutex_};
+    if (!markThreadStats_.empty()) {
+      json.emitKey("Mark threads");
+      json.openArray();
+      for (const MarkThreadStats &stats : markThreadStats_) {
+        json.openDict();
+        json.emitKeyValue("Marked bytes", stats.markedBytes);
+        json.emitKeyValue("Mark time", stats.markTime);
+        json.emitKeyValue(
+            "Marked MB per second",
+            stats.markTime ? stats.markedBytes / stats.markTime / 1e6 : 0.0);
+        json.closeDict();
+      }
+      json.closeArray();
+    }
+    static const char *const kYGPauseBucketNames[kNumYGPauseBuckets] = {
+        "< 0.25 ms",
+        "< 0.5 ms",
+        "< 1 ms",
+        "< 2 ms",
+        "< 4 ms",
+        "< 8 ms",
+        "< 16 ms",
+        "< 32 ms",
+        "< 64 ms",
+        ">= 64 ms"};
+    json.emitKey("YG pause histogram");
+    json.openDict();
+    for (size_t i = 0; i < kNumYGPauseBuckets; ++i)
+      json.emitKeyValue(kYGPauseBucketNames[i], ygPauseHistogram_[i]);
+    json.closeDict();
+  }
   json.closeDict();
   json.closeDict();
 }
@@ -1554,6 +2213,11 @@ void HadesGC::oldGenCollection(std::string cause, bool forceCompaction) {
   // leave the last marker alive to avoid a race condition with setting
   // concurrentPhase_, oldGenMarker_ and the write barrier.
   oldGenMarker_.reset(new MarkAcceptor{*this});
+  helperMarkers_.clear();
+  if (markWorkers_) {
+    for (unsigned i = 1; i < markWorkers_->numWorkers(); ++i)
+      helperMarkers_.emplace_back(new MarkAcceptor{*this});
+  }
   {
     // Roots are marked before a marking thread is spun up, so that the root
     // marking is atomic.
@@ -1663,7 +2327,8 @@ void HadesGC::incrementalCollect(bool backgroundThread) {
         ygCollectionStats_->addCollectionType("marking");
       // Drain some work from the mark worklist. If the work has finished
       // completely, move on to CompleteMarking.
-      if (!oldGenMarker_->drainSomeWork())
+      if (!(markWorkers_ ? drainMarkWorkInParallel()
+                         : oldGenMarker_->drainSomeWork()))
         concurrentPhase_ = Phase::CompleteMarking;
       break;
     case Phase::CompleteMarking:
@@ -1694,6 +2359,41 @@ void HadesGC::incrementalCollect(bool backgroundThread) {
   }
 }
 
+bool HadesGC::drainMarkWorkInParallel() {
+  assert(gcMutex_ && "Must hold the GC lock while accessing mark bits.");
+  // The number of bytes each thread marks in a round. The round ends earlier if
+  // the mutator needs the background thread to release gcMutex_.
+  constexpr int64_t kParallelMarkLimit = 1 << 20;
+
+  oldGenMarker_->pullGlobalWork();
+  llvh::SmallVector<MarkAcceptor *, 8> markers{oldGenMarker_.get()};
+  for (const std::unique_ptr<MarkAcceptor> &helper : helperMarkers_)
+    markers.push_back(helper.get());
+  MarkAcceptor::ParallelRound round{
+      markers, kParallelMarkLimit * static_cast<int64_t>(markers.size())};
+  llvh::SmallVector<MarkThreadStats, 8> roundStats(markers.size());
+  markWorkers_->run([&markers, &round, &roundStats](unsigned index) {
+    MarkAcceptor &marker = *markers[index];
+    const uint64_t markedBytesBefore = marker.markedBytes();
+    const auto start = std::chrono::steady_clock::now();
+    marker.drainWithStealing(round);
+    roundStats[index].markTime = std::chrono::duration<double>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count();
+    roundStats[index].markedBytes = marker.markedBytes() - markedBytesBefore;
+  });
+
+  // Collect the cells that were not marked in this round, and the marked byte
+  // counts, in the background thread's marker.
+  for (MarkAcceptor *marker : markers)
+    oldGenMarker_->takeWork(*marker);
+  for (size_t i = 0; i < markers.size(); ++i) {
+    markThreadStats_[i].markedBytes += roundStats[i].markedBytes;
+    markThreadStats_[i].markTime += roundStats[i].markTime;
+  }
+  return !oldGenMarker_->isLocalWorklistEmpty();
+}
+
 void HadesGC::prepareCompactee(bool forceCompaction) {
   assert(gcMutex_);
   assert(
@@ -1863,6 +2563,10 @@ void HadesGC::completeMarking() {
     gcCallbacks_.markRootsForCompleteMarking(nameAcceptor);
   }
   // Drain the marking queue.
+  if (markWorkers_) {
+    while (drainMarkWorkInParallel()) {
+    }
+  }
   oldGenMarker_->drainAllWork();
   assert(
       oldGenMarker_->globalWorklist().empty() &&
@@ -1881,6 +2585,9 @@ void HadesGC::completeMarking() {
   markWeakRoots(acceptor, /*markLongLived*/ true);
 
   // Now free symbols and weak refs.
+  for (const std::unique_ptr<MarkAcceptor> &helper : helperMarkers_)
+    oldGenMarker_->mergeMarkedSymbols(*helper);
+  helperMarkers_.clear();
   gcCallbacks_.freeSymbols(oldGenMarker_->markedSymbols());
 
   // Nothing needs oldGenMarker_ from this point onward.
@@ -1889,6 +2596,7 @@ void HadesGC::completeMarking() {
 
 void HadesGC::finalizeAll() {
   std::lock_guard<Mutex> lk{gcMutex_};
+  retireLongLivedBuffer();
   // Terminate any existing OG collection.
   concurrentPhase_ = Phase::None;
   if (ogCollectionStats_)
@@ -2137,6 +2845,7 @@ bool HadesGC::canAllocExternalMemory(uint32_t size) {
 
 void HadesGC::forAllObjs(const std::function<void(GCCell *)> &callback) {
   std::lock_guard<Mutex> lk{gcMutex_};
+  retireLongLivedBuffer();
   youngGen().forAllObjs(callback);
 
   const auto skipGarbageCallback = [callback](GCCell *cell) {
@@ -2226,13 +2935,101 @@ void *HadesGC::allocLongLived(uint32_t sz) {
   return oldGen_.alloc(sz);
 }
 
+void *HadesGC::refillLongLivedBuffer(uint32_t sz) {
+  // The preferred size of a buffer. Smaller buffers are taken from the
+  // freelist before growing the heap.
+  constexpr uint32_t kBufferSize = 8 * 1024;
+  // Larger cells would waste too much of a buffer, and are rare enough that
+  // taking the lock for each of them is cheap.
+  if (sz > kBufferSize / 4)
+    return nullptr;
+  // The FillerCell covering the buffer takes the first minAllocationSize()
+  // bytes, and the rest of the buffer must be large enough to go back on the
+  // freelist.
+  const uint32_t minBufferSize = sz + 2 * minAllocationSize();
+  auto lk = ensureBackgroundTaskPaused();
+  retireLongLivedBuffer();
+  uint32_t bufSize = kBufferSize;
+  GCCell *start = nullptr;
+  for (; bufSize >= minBufferSize; bufSize /= 2) {
+    if ((start = oldGen_.search(bufSize)))
+      break;
+  }
+  if (!start) {
+    llvh::ErrorOr<GCCell *> res = oldGen_.allocOrError(kBufferSize);
+    if (!res)
+      return nullptr;
+    start = res.get();
+    bufSize = kBufferSize;
+  }
+  // Cover the buffer, so that nothing walks into the cells allocated from it
+  // while they are constructed without the lock.
+  constructCell<FillerCell>(start, bufSize);
+  HeapSegment::setCellHead(start, bufSize);
+  MarkBitArrayNC *markBits = HeapSegment::markBitArrayCovering(start);
+  const size_t startIdx = markBits->addressToIndex(start);
+  markBits->markRange(startIdx, startIdx + (bufSize >> LogHeapAlign));
+
+  LongLivedBuffer &buf = longLivedBuffer_;
+  buf.start = reinterpret_cast<char *>(start);
+  buf.level = buf.start + minAllocationSize() + sz;
+  buf.end = buf.start + bufSize;
+  totalAllocatedBytes_ += sz;
+  return buf.start + minAllocationSize();
+}
+
+void HadesGC::retireLongLivedBuffer() {
+  assert(gcMutex_ && "gcMutex_ must be held to retire the long-lived buffer");
+  assert(
+      !calledByBackgroundThread() &&
+      "Only the mutator can use the long-lived buffer");
+  LongLivedBuffer &buf = longLivedBuffer_;
+  if (!buf.start)
+    return;
+  // Only the cell starts should be marked, so that the sweeper can free the
+  // space it trims from the cells.
+  MarkBitArrayNC *markBits = HeapSegment::markBitArrayCovering(buf.start);
+  const size_t startIdx = markBits->addressToIndex(buf.start);
+  markBits->clearRange(
+      startIdx, startIdx + ((buf.end - buf.start) >> LogHeapAlign));
+  char *const cellsStart = buf.start + minAllocationSize();
+  if (buf.level == cellsStart) {
+    oldGen_.returnToFreelist(buf.start, buf.end - buf.start);
+  } else {
+    // Shrink the FillerCell to its own space, which is left unmarked for the
+    // sweeper to free.
+    constructCell<FillerCell>(buf.start, minAllocationSize());
+    for (char *cur = cellsStart; cur < buf.level;) {
+      GCCell *const cell = reinterpret_cast<GCCell *>(cur);
+      const uint32_t sz = cell->getAllocatedSize();
+      HeapSegment::setCellHead(cell, sz);
+      HeapSegment::setCellMarkBit(cell);
+      cur += sz;
+    }
+    if (buf.level != buf.end)
+      oldGen_.returnToFreelist(buf.level, buf.end - buf.level);
+  }
+  buf = LongLivedBuffer{};
+}
+
 GCCell *HadesGC::OldGen::alloc(uint32_t sz) {
+  llvh::ErrorOr<GCCell *> res = allocOrError(sz);
+  if (!res) {
+    // The GC didn't recover enough memory, OOM.
+    gc_.oom(res.getError());
+  }
+  return res.get();
+}
+
+llvh::ErrorOr<GCCell *> HadesGC::OldGen::allocOrError(uint32_t sz) {
   assert(
       isSizeHeapAligned(sz) &&
       "Should be aligned before entering this function");
   assert(sz >= minAllocationSize() && "Allocating too small of an object");
   assert(sz <= maxAllocationSize() && "Allocating too large of an object");
-  assert(gc_.gcMutex_ && "gcMutex_ must be held before calling oldGenAlloc");
+  assert(
+      (gc_.gcMutex_ || gc_.promotionMutex_) &&
+      "gcMutex_ must be held before calling oldGenAlloc");
   if (GCCell *cell = search(sz)) {
     return cell;
   }
@@ -2265,11 +3062,24 @@ GCCell *HadesGC::OldGen::alloc(uint32_t sz) {
     return cell;
   }
 
-  // The GC didn't recover enough memory, OOM.
   // Re-use the error code from the earlier heap segment allocation, because
   // it's either that the max heap size was reached, or that segment failed to
   // allocate.
-  gc_.oom(seg.getError());
+  return seg.getError();
+}
+
+void HadesGC::OldGen::returnToFreelist(char *start, uint32_t sz) {
+  assert(
+      (gc_.gcMutex_ || gc_.promotionMutex_) &&
+      "gcMutex_ must be held to modify the freelist");
+  // Segments are aligned to their size, so compare the starts of the storage.
+  const char *const storageStart =
+      static_cast<const char *>(AlignedStorage::start(start));
+  size_t segIdx = 0;
+  while (segments_[segIdx].lowLim() != storageStart)
+    ++segIdx;
+  addCellToFreelist(start, sz, &segmentBuckets_[segIdx][getFreelistBucket(sz)]);
+  incrementAllocatedBytes(-static_cast<int32_t>(sz));
 }
 
 uint32_t HadesGC::OldGen::getFreelistBucket(uint32_t size) {
@@ -2419,6 +3229,91 @@ void HadesGC::youngGenEvacuateImpl(Acceptor &acceptor, bool doCompaction) {
   markWeakRoots(acceptor, /*markLongLived*/ doCompaction);
 }
 
+template <bool CompactionEnabled>
+uint64_t HadesGC::youngGenEvacuate(bool doCompaction) {
+  // Moving tracked objects updates the ID tracker, which is not thread safe.
+  if (evacWorkers_ && !isTrackingIDs())
+    return youngGenEvacuateInParallel<CompactionEnabled>(doCompaction);
+  EvacAcceptor<CompactionEnabled> acceptor{*this};
+  youngGenEvacuateImpl(acceptor, doCompaction);
+  // The remaining bytes after the collection is just the number of bytes that
+  // were evacuated.
+  return acceptor.evacuatedBytes();
+}
+
+template <bool CompactionEnabled>
+uint64_t HadesGC::youngGenEvacuateInParallel(bool doCompaction) {
+  const unsigned numThreads = evacWorkers_->numWorkers();
+  ParallelEvacuation evacuation{*this, numThreads};
+  const bool preparingCompaction =
+      CompactionEnabled && !compactee_.evacActive();
+
+  // Scan the dirty cards before evacuating anything, so that the scan does not
+  // race with the cells that are promoted into the OG. As in scanDirtyCards,
+  // segments added by the evacuation do not need to be scanned.
+  const size_t numSegments = oldGen_.numSegments();
+  const size_t numScanned = numSegments + (preparingCompaction ? 1 : 0);
+  evacWorkers_->run([this, &evacuation, numSegments, numScanned](
+                        unsigned index) {
+    ParallelEvacuation::SlotRecorder recorder{*this, evacuation.slots[index]};
+    SlotVisitor<ParallelEvacuation::SlotRecorder> visitor{recorder};
+    while (true) {
+      const size_t i =
+          evacuation.nextSegment.fetch_add(1, std::memory_order_relaxed);
+      if (i >= numScanned)
+        break;
+      if (i == numSegments) {
+        scanDirtyCardsForSegment(visitor, *compactee_.segment);
+        continue;
+      }
+      HeapSegment &seg = oldGen_[i];
+      scanDirtyCardsForSegment(visitor, seg);
+      // Do not clear the card table if the OG thread is currently marking to
+      // prepare for a compaction.
+      if (numScanned == numSegments)
+        seg.cardTable().clear();
+    }
+  });
+
+  // Evacuate the cells referenced by the recorded slots, and everything
+  // reachable from them. The roots are marked by the mutator thread, which
+  // then joins the other threads.
+  std::vector<std::unique_ptr<EvacAcceptor<CompactionEnabled>>> acceptors;
+  llvh::SmallVector<EvacAcceptor<CompactionEnabled> *, 8> acceptorPtrs;
+  for (unsigned i = 0; i < numThreads; ++i) {
+    acceptors.emplace_back(
+        new EvacAcceptor<CompactionEnabled>{*this, &evacuation});
+    acceptorPtrs.push_back(acceptors.back().get());
+  }
+  evacWorkers_->run([this, &evacuation, &acceptorPtrs, doCompaction](
+                        unsigned index) {
+    EvacAcceptor<CompactionEnabled> &acceptor = *acceptorPtrs[index];
+    if (index == 0) {
+      DroppingAcceptor<EvacAcceptor<CompactionEnabled>> nameAcceptor{acceptor};
+      markRoots(nameAcceptor, /*markLongLived*/ doCompaction);
+      // See youngGenEvacuateImpl.
+      weakMapEntrySlots_.forEach([&nameAcceptor](WeakMapEntrySlot &slot) {
+        nameAcceptor.accept(slot.mappedValue);
+      });
+    }
+    acceptor.acceptRecordedSlots(evacuation.slots[index]);
+    acceptor.drainWithStealing(acceptorPtrs);
+  });
+  if (evacuation.failed())
+    oom(evacuation.oomReason());
+
+  uint64_t evacuatedBytes = 0;
+  for (auto &acceptor : acceptors) {
+    evacuation.retire(acceptor->promotionBuffer());
+    evacuatedBytes += acceptor->evacuatedBytes();
+  }
+  evacuation.finish();
+
+  // Weak roots only read forwarding pointers, so one thread is enough.
+  markWeakRoots(*acceptors[0], /*markLongLived*/ doCompaction);
+  return evacuatedBytes;
+}
+
 void HadesGC::youngGenCollection(
     std::string cause,
     bool forceOldGenCollection) {
@@ -2429,6 +3324,9 @@ void HadesGC::youngGenCollection(
   auto lk = ensureBackgroundTaskPaused();
   // The YG is not parseable while a collection is occurring.
   assert(!inGC() && "Cannot be in GC at the start of YG!");
+  // Give the cells in the long-lived buffer cell heads before the dirty cards
+  // are scanned, and mark bits before an OG collection clears them.
+  retireLongLivedBuffer();
   GCCycle cycle{*this, "GC Young Gen"};
 #ifdef HERMES_SLOW_DEBUG
   checkWellFormed();
@@ -2461,17 +3359,9 @@ void HadesGC::youngGenCollection(
   } else {
     auto &yg = youngGen();
 
-    if (compactee_.segment) {
-      EvacAcceptor<true> acceptor{*this};
-      youngGenEvacuateImpl(acceptor, doCompaction);
-      // The remaining bytes after the collection is just the number of bytes
-      // that were evacuated.
-      heapBytes.after = acceptor.evacuatedBytes();
-    } else {
-      EvacAcceptor<false> acceptor{*this};
-      youngGenEvacuateImpl(acceptor, false);
-      heapBytes.after = acceptor.evacuatedBytes();
-    }
+    heapBytes.after = compactee_.segment
+        ? youngGenEvacuate<true>(doCompaction)
+        : youngGenEvacuate<false>(false);
     // Inform trackers about objects that died during this YG collection.
     if (isTrackingIDs()) {
       auto trackerCallback = [this](GCCell *cell) {
@@ -2604,12 +3494,25 @@ void HadesGC::youngGenCollection(
 #endif
   ygCollectionStats_->setEndTime();
   ygCollectionStats_->endCPUTimeSection();
+  recordYGPause(ygCollectionStats_->getDuration());
   auto statsEvent = std::move(*ygCollectionStats_).getEvent();
   recordGCStats(statsEvent, true);
   recordGCStats(statsEvent, &ygCumulativeStats_, true);
   ygCollectionStats_.reset();
 }
 
+void HadesGC::recordYGPause(std::chrono::microseconds pause) {
+  assert(gcMutex_ && "Must hold gcMutex_ when accessing ygPauseHistogram_.");
+  // The first bucket ends at 250us, and each bucket is twice as wide as the
+  // previous one.
+  size_t bucket = 0;
+  for (auto limit = std::chrono::microseconds{250};
+       bucket < kNumYGPauseBuckets - 1 && pause >= limit;
+       limit *= 2)
+    ++bucket;
+  ++ygPauseHistogram_[bucket];
+}
+
 bool HadesGC::promoteYoungGenToOldGen() {
   if (!promoteYGToOG_) {
     return false;
@@ -2697,9 +3600,9 @@ void HadesGC::updateYoungGenSizeFactor() {
     ygSizeFactor_ = std::max(ygSizeFactor_ * 0.9, 0.25);
 }
 
-template <bool CompactionEnabled>
+template <typename Acceptor>
 void HadesGC::scanDirtyCardsForSegment(
-    SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
+    SlotVisitor<Acceptor> &visitor,
     HeapSegment &seg) {
   const auto &cardTable = seg.cardTable();
   // Use level instead of end in case the OG segment is still in bump alloc
@@ -2850,7 +3753,9 @@ void HadesGC::OldGen::incrementAllocatedBytes(int32_t incr) {
 }
 
 uint64_t HadesGC::OldGen::externalBytes() const {
-  assert(gc_.gcMutex_ && "OG external bytes must be accessed under gcMutex_.");
+  assert(
+      (gc_.gcMutex_ || gc_.promotionMutex_) &&
+      "OG external bytes must be accessed under gcMutex_.");
   return externalBytes_;
 }
 
@@ -190,6 +190,18 @@ enum class GCEventKind {
   /* Whether to use mprotect on GC metadata between GCs. */              \
   F(constexpr, bool, ProtectMetadata, false)                             \
                                                                          \
+  /* Number of threads that mark the old generation concurrently with */ \
+  /* the mutator. More than 1 enables parallel marking. */               \
+  F(constexpr, unsigned, NumMarkThreads, 1)                              \
+                                                                         \
+  /* Number of threads that evacuate the young generation during a */    \
+  /* collection. More than 1 enables parallel evacuation. */             \
+  F(constexpr, unsigned, NumEvacuationThreads, 1)                        \
+                                                                         \
+  /* Whether allocation sites whose objects usually survive a young */   \
+  /* gen collection allocate them directly in the old gen. */            \
+  F(constexpr, bool, Pretenure, false)                                   \
+                                                                         \
   /* Callout for an analytics event. */                                  \
   F(HERMES_NON_CONSTEXPR,                                                \
     std::function<void(const GCAnalyticsEvent &)>,                       \
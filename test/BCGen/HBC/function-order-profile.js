@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -emit-binary -target=HBC -out=%t.hbc %s && %hermes -record-function-order=%t.prof %t.hbc | %FileCheck --match-full-lines --check-prefix=EXEC %s
+// RUN: %hermes -O -emit-binary -target=HBC -function-order-profile=%t.prof -out=%t.2.hbc %s && %hermes %t.2.hbc | %FileCheck --match-full-lines --check-prefix=EXEC %s
+// RUN: %hbcdump %t.2.hbc -c "function-info;quit" | grep -E '"(Offset|Name)"' | paste - - | sort -n -k2 | %FileCheck --check-prefix=LAYOUT %s
+
+// Functions that ran while the profile was recorded are laid out first, in
+// the order they first ran, and the strings they use are stored ahead of the
+// others. Function IDs do not change.
+
+function neverCalled() {
+  return 'cold';
+}
+
+function calledSecond() {
+  return 'called second';
+}
+
+function calledFirst() {
+  return 'called first';
+}
+
+print(calledFirst());
+print(calledSecond());
+// EXEC: called first
+// EXEC-NEXT: called second
+
+// The functions, sorted by their offset in the bytecode.
+// LAYOUT: "Offset": {{[0-9]+}}, "Name": "global"
+// LAYOUT-NEXT: "Offset": {{[0-9]+}}, "Name": "calledFirst"
+// LAYOUT-NEXT: "Offset": {{[0-9]+}}, "Name": "calledSecond"
+// LAYOUT-NEXT: "Offset": {{[0-9]+}}, "Name": "neverCalled"
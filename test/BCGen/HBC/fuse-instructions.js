@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermesc -O -dump-bytecode %s | %FileCheck --match-full-lines %s
+// RUN: %hermesc -O -fno-fuse-instructions -dump-bytecode %s | %FileCheck --match-full-lines --check-prefix=NOFUSE %s
+
+// Fused instructions keep the operands of the first instruction of the pair,
+// and the second instruction is left in place after them.
+
+function sum(a, n) {
+  var s = 0;
+  for (var i = 0; i < n; i++) {
+    s = s + a[i];
+  }
+  return s;
+}
+
+// CHECK-LABEL: Function<sum>(3 params, 7 registers, 0 symbols):
+// CHECK-NEXT: Offset in debug table: {{.*}}
+// CHECK-NEXT:    LoadParam         r4, 1
+// CHECK-NEXT:    LoadParam         r3, 2
+// CHECK-NEXT:    LoadConstZero     r0
+// CHECK-NEXT:    Less              r5, r0, r3
+// CHECK-NEXT:    LoadConstZero     r2
+// CHECK-NEXT:    LoadConstZero     r1
+// CHECK-NEXT:    JmpFalse          L1, r5
+// CHECK-NEXT:L2:
+// CHECK-NEXT:    GetByValAdd       r5, r4, r1
+// CHECK-NEXT:    Add               r2, r2, r5
+// CHECK-NEXT:    Inc               r1, r1
+// CHECK-NEXT:    MovJLess          r0, r2
+// CHECK-NEXT:    JLess             L2, r1, r3
+// CHECK-NEXT:L1:
+// CHECK-NEXT:    Ret               r0
+
+// NOFUSE-LABEL: Function<sum>(3 params, 7 registers, 0 symbols):
+// NOFUSE-NEXT: Offset in debug table: {{.*}}
+// NOFUSE-NEXT:    LoadParam         r4, 1
+// NOFUSE-NEXT:    LoadParam         r3, 2
+// NOFUSE-NEXT:    LoadConstZero     r0
+// NOFUSE-NEXT:    Less              r5, r0, r3
+// NOFUSE-NEXT:    LoadConstZero     r2
+// NOFUSE-NEXT:    LoadConstZero     r1
+// NOFUSE-NEXT:    JmpFalse          L1, r5
+// NOFUSE-NEXT:L2:
+// NOFUSE-NEXT:    GetByVal          r5, r4, r1
+// NOFUSE-NEXT:    Add               r2, r2, r5
+// NOFUSE-NEXT:    Inc               r1, r1
+// NOFUSE-NEXT:    Mov               r0, r2
+// NOFUSE-NEXT:    JLess             L2, r1, r3
+// NOFUSE-NEXT:L1:
+// NOFUSE-NEXT:    Ret               r0
+
+function count(a, n) {
+  var c = 0;
+  for (var i = 0; i < n; i++) {
+    c = c + a;
+    c++;
+  }
+  return c;
+}
+
+// CHECK-LABEL: Function<count>(3 params, 7 registers, 0 symbols):
+// CHECK-NEXT: Offset in debug table: {{.*}}
+// CHECK-NEXT:    LoadParam         r4, 1
+// CHECK-NEXT:    LoadParam         r3, 2
+// CHECK-NEXT:    LoadConstZero     r0
+// CHECK-NEXT:    Less              r5, r0, r3
+// CHECK-NEXT:    LoadConstZero     r2
+// CHECK-NEXT:    LoadConstZero     r1
+// CHECK-NEXT:    JmpFalse          L1, r5
+// CHECK-NEXT:L2:
+// CHECK-NEXT:    AddInc            r5, r2, r4
+// CHECK-NEXT:    Inc               r2, r5
+// CHECK-NEXT:    Inc               r1, r1
+// CHECK-NEXT:    MovJLess          r0, r2
+// CHECK-NEXT:    JLess             L2, r1, r3
+// CHECK-NEXT:L1:
+// CHECK-NEXT:    Ret               r0
+
+function fill(a, n) {
+  for (var i = 0; i < n; i++) {
+    a[i] = i;
+  }
+}
+
+// CHECK-LABEL: Function<fill>(3 params, 4 registers, 0 symbols):
+// CHECK-NEXT: Offset in debug table: {{.*}}
+// CHECK-NEXT:    LoadParam         r2, 1
+// CHECK-NEXT:    LoadParam         r1, 2
+// CHECK-NEXT:    LoadConstZero     r0
+// CHECK-NEXT:    Less              r3, r0, r1
+// CHECK-NEXT:    JmpFalse          L1, r3
+// CHECK-NEXT:L2:
+// CHECK-NEXT:    PutByVal          r2, r0, r0
+// CHECK-NEXT:    IncJLess          r0, r0
+// CHECK-NEXT:    JLess             L2, r0, r1
+// CHECK-NEXT:L1:
+// CHECK-NEXT:    LoadConstUndefined r0
+// CHECK-NEXT:    Ret               r0
@@ -0,0 +1,28 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: diff <(%hermesc -O -g -dump-bytecode %s) <(%hermesc -O -g -jobs=4 -dump-bytecode %s)
+// RUN: diff <(%hermesc -O0 -dump-bytecode %s) <(%hermesc -O0 -jobs=4 -dump-bytecode %s)
+
+// Generating the functions on several threads must produce the same bytecode,
+// including the regexp, bigint and function tables and the debug info.
+
+function outer(a) {
+  var x = 10n;
+  function inner(b) {
+    return function () {
+      return [a, b, /a+b/g, 20n, x];
+    };
+  }
+  return inner(a)() + /c*/.source;
+}
+
+function other() {
+  return [/c*/, 30n, 10n, outer(1)];
+}
+
+print(outer(1), other());
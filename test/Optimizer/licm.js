@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermesc -O -dump-ir %s | %FileCheckOrRegen --match-full-lines %s
+
+// The loads of the captured variables can be hoisted out of the loop in the
+// closure although it calls unknown code, since only the function owning the
+// variables stores to them.
+function capturedLoad(n, f) {
+  var k = n * 2;
+  return function () {
+    var sum = 0;
+    for (var i = 0; i < n; ++i) {
+      sum += f(i) + k;
+    }
+    return sum;
+  };
+}
+
+// The closure stores to the captured variable, and the loop calls it, so the
+// load must stay in the loop.
+function storedByClosure(n, f) {
+  var k = 1;
+  function bump() {
+    k++;
+  }
+  var sum = 0;
+  for (var i = 0; i < n; ++i) {
+    f(bump);
+    sum += k;
+  }
+  return sum;
+}
+
+// The length of a string and arithmetic on loop invariant values are hoisted.
+function invariantArith(s, a, b) {
+  s = '' + s;
+  a = +a;
+  b = +b;
+  var sum = 0;
+  for (var i = 0; i < s.length; ++i) {
+    sum += a * b + i;
+  }
+  return sum;
+}
+
+// The length of an array can change, so it is not hoisted.
+function arrayLength(arr) {
+  var sum = 0;
+  for (var i = 0; i < arr.length; ++i) {
+    sum += arr[i];
+  }
+  return sum;
+}
+
+// Auto-generated content below. Please do not modify manually.
+
+// CHECK:function global#0()#1 : undefined
+// CHECK-NEXT:globals = [capturedLoad, storedByClosure, invariantArith, arrayLength]
+// CHECK-NEXT:S{global#0()#1} = []
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{global#0()#1}
+// CHECK-NEXT:  %1 = CreateFunctionInst %capturedLoad#0#1()#2 : closure, %0
+// CHECK-NEXT:  %2 = StorePropertyInst %1 : closure, globalObject : object, "capturedLoad" : string
+// CHECK-NEXT:  %3 = CreateFunctionInst %storedByClosure#0#1()#4 : string|number|bigint, %0
+// CHECK-NEXT:  %4 = StorePropertyInst %3 : closure, globalObject : object, "storedByClosure" : string
+// CHECK-NEXT:  %5 = CreateFunctionInst %invariantArith#0#1()#6 : string|number, %0
+// CHECK-NEXT:  %6 = StorePropertyInst %5 : closure, globalObject : object, "invariantArith" : string
+// CHECK-NEXT:  %7 = CreateFunctionInst %arrayLength#0#1()#7 : string|number|bigint, %0
+// CHECK-NEXT:  %8 = StorePropertyInst %7 : closure, globalObject : object, "arrayLength" : string
+// CHECK-NEXT:  %9 = ReturnInst undefined : undefined
+// CHECK-NEXT:function_end
+
+// CHECK:function capturedLoad#0#1(n, f)#2 : closure
+// CHECK-NEXT:S{capturedLoad#0#1()#2} = [n#2, f#2, k#2 : number]
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{capturedLoad#0#1()#2}
+// CHECK-NEXT:  %1 = StoreFrameInst %n, [n#2], %0
+// CHECK-NEXT:  %2 = StoreFrameInst %f, [f#2], %0
+// CHECK-NEXT:  %3 = BinaryOperatorInst '*', %n, 2 : number
+// CHECK-NEXT:  %4 = StoreFrameInst %3 : number, [k#2] : number, %0
+// CHECK-NEXT:  %5 = CreateFunctionInst %""#1#2()#3 : string|number, %0
+// CHECK-NEXT:  %6 = ReturnInst %5 : closure
+// CHECK-NEXT:function_end
+
+// CHECK:function ""#1#2()#3 : string|number
+// CHECK-NEXT:S{""#1#2()#3} = []
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{""#1#2()#3}
+// CHECK-NEXT:  %1 = LoadFrameInst [n#2@capturedLoad], %0
+// CHECK-NEXT:  %2 = BinaryOperatorInst '<', 0 : number, %1
+// CHECK-NEXT:  %3 = LoadFrameInst [f#2@capturedLoad], %0
+// CHECK-NEXT:  %4 = LoadFrameInst [k#2@capturedLoad] : number, %0
+// CHECK-NEXT:  %5 = CondBranchInst %2 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB1:
+// CHECK-NEXT:  %6 = PhiInst 0 : number, %BB0, %10 : string|number, %BB1
+// CHECK-NEXT:  %7 = PhiInst 0 : number, %BB0, %11 : number|bigint, %BB1
+// CHECK-NEXT:  %8 = CallInst %3, undefined : undefined, undefined : undefined, %7 : number|bigint
+// CHECK-NEXT:  %9 = BinaryOperatorInst '+', %8, %4 : number
+// CHECK-NEXT:  %10 = BinaryOperatorInst '+', %6 : string|number, %9 : string|number
+// CHECK-NEXT:  %11 = UnaryOperatorInst '++', %7 : number|bigint
+// CHECK-NEXT:  %12 = BinaryOperatorInst '<', %11 : number|bigint, %1
+// CHECK-NEXT:  %13 = CondBranchInst %12 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB2:
+// CHECK-NEXT:  %14 = PhiInst 0 : number, %BB0, %10 : string|number, %BB1
+// CHECK-NEXT:  %15 = ReturnInst %14 : string|number
+// CHECK-NEXT:function_end
+
+// CHECK:function storedByClosure#0#1(n, f)#4 : string|number|bigint
+// CHECK-NEXT:S{storedByClosure#0#1()#4} = [k#4 : number|bigint]
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{storedByClosure#0#1()#4}
+// CHECK-NEXT:  %1 = CreateFunctionInst %bump#1#4()#5 : undefined, %0
+// CHECK-NEXT:  %2 = StoreFrameInst 1 : number, [k#4] : number|bigint, %0
+// CHECK-NEXT:  %3 = BinaryOperatorInst '<', 0 : number, %n
+// CHECK-NEXT:  %4 = CondBranchInst %3 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB1:
+// CHECK-NEXT:  %5 = PhiInst 0 : number, %BB0, %9 : string|number|bigint, %BB1
+// CHECK-NEXT:  %6 = PhiInst 0 : number, %BB0, %10 : number|bigint, %BB1
+// CHECK-NEXT:  %7 = CallInst %f, undefined : undefined, undefined : undefined, %1 : closure
+// CHECK-NEXT:  %8 = LoadFrameInst [k#4] : number|bigint, %0
+// CHECK-NEXT:  %9 = BinaryOperatorInst '+', %5 : string|number|bigint, %8 : number|bigint
+// CHECK-NEXT:  %10 = UnaryOperatorInst '++', %6 : number|bigint
+// CHECK-NEXT:  %11 = BinaryOperatorInst '<', %10 : number|bigint, %n
+// CHECK-NEXT:  %12 = CondBranchInst %11 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB2:
+// CHECK-NEXT:  %13 = PhiInst 0 : number, %BB0, %9 : string|number|bigint, %BB1
+// CHECK-NEXT:  %14 = ReturnInst %13 : string|number|bigint
+// CHECK-NEXT:function_end
+
+// CHECK:function bump#1#4()#5 : undefined
+// CHECK-NEXT:S{bump#1#4()#5} = []
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{bump#1#4()#5}
+// CHECK-NEXT:  %1 = LoadFrameInst [k#4@storedByClosure] : number|bigint, %0
+// CHECK-NEXT:  %2 = UnaryOperatorInst '++', %1 : number|bigint
+// CHECK-NEXT:  %3 = StoreFrameInst %2 : number|bigint, [k#4@storedByClosure] : number|bigint, %0
+// CHECK-NEXT:  %4 = ReturnInst undefined : undefined
+// CHECK-NEXT:function_end
+
+// CHECK:function invariantArith#0#1(s, a, b)#6 : string|number
+// CHECK-NEXT:S{invariantArith#0#1()#6} = []
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{invariantArith#0#1()#6}
+// CHECK-NEXT:  %1 = AddEmptyStringInst %s
+// CHECK-NEXT:  %2 = AsNumberInst %a
+// CHECK-NEXT:  %3 = AsNumberInst %b
+// CHECK-NEXT:  %4 = LoadPropertyInst %1 : string, "length" : string
+// CHECK-NEXT:  %5 = BinaryOperatorInst '<', 0 : number, %4
+// CHECK-NEXT:  %6 = BinaryOperatorInst '*', %2 : number, %3 : number
+// CHECK-NEXT:  %7 = LoadPropertyInst %1 : string, "length" : string
+// CHECK-NEXT:  %8 = CondBranchInst %5 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB1:
+// CHECK-NEXT:  %9 = PhiInst 0 : number, %BB0, %12 : string|number, %BB1
+// CHECK-NEXT:  %10 = PhiInst 0 : number, %BB0, %13 : number|bigint, %BB1
+// CHECK-NEXT:  %11 = BinaryOperatorInst '+', %6 : number, %10 : number|bigint
+// CHECK-NEXT:  %12 = BinaryOperatorInst '+', %9 : string|number, %11 : number
+// CHECK-NEXT:  %13 = UnaryOperatorInst '++', %10 : number|bigint
+// CHECK-NEXT:  %14 = BinaryOperatorInst '<', %13 : number|bigint, %7
+// CHECK-NEXT:  %15 = CondBranchInst %14 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB2:
+// CHECK-NEXT:  %16 = PhiInst 0 : number, %BB0, %12 : string|number, %BB1
+// CHECK-NEXT:  %17 = ReturnInst %16 : string|number
+// CHECK-NEXT:function_end
+
+// CHECK:function arrayLength#0#1(arr)#7 : string|number|bigint
+// CHECK-NEXT:S{arrayLength#0#1()#7} = []
+// CHECK-NEXT:%BB0:
+// CHECK-NEXT:  %0 = CreateScopeInst %S{arrayLength#0#1()#7}
+// CHECK-NEXT:  %1 = LoadPropertyInst %arr, "length" : string
+// CHECK-NEXT:  %2 = BinaryOperatorInst '<', 0 : number, %1
+// CHECK-NEXT:  %3 = CondBranchInst %2 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB1:
+// CHECK-NEXT:  %4 = PhiInst 0 : number, %BB0, %7 : string|number|bigint, %BB1
+// CHECK-NEXT:  %5 = PhiInst 0 : number, %BB0, %8 : number|bigint, %BB1
+// CHECK-NEXT:  %6 = LoadPropertyInst %arr, %5 : number|bigint
+// CHECK-NEXT:  %7 = BinaryOperatorInst '+', %4 : string|number|bigint, %6
+// CHECK-NEXT:  %8 = UnaryOperatorInst '++', %5 : number|bigint
+// CHECK-NEXT:  %9 = LoadPropertyInst %arr, "length" : string
+// CHECK-NEXT:  %10 = BinaryOperatorInst '<', %8 : number|bigint, %9
+// CHECK-NEXT:  %11 = CondBranchInst %10 : boolean, %BB1, %BB2
+// CHECK-NEXT:%BB2:
+// CHECK-NEXT:  %12 = PhiInst 0 : number, %BB0, %7 : string|number|bigint, %BB1
+// CHECK-NEXT:  %13 = ReturnInst %12 : string|number|bigint
+// CHECK-NEXT:function_end
@@ -0,0 +1,14 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -Xlexer-only %s | %FileCheck --match-full-lines %s
+
+var s = 'string'; /* block */ // line
+identifier + 1;
+
+// CHECK: 9 tokens lexed
+// CHECK-NEXT: {{[0-9]+}} bytes lexed in {{[0-9.]+}} ms ({{[0-9.]+}} MB/s)
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -Xhermes-internal-test-methods -O %s | %FileCheck --match-full-lines %s
+
+// Exercise the paths of Array.prototype.sort and %TypedArray%.prototype.sort:
+// the dense array paths, the generic path, and the merges of TimSort.
+
+print('sort');
+// CHECK-LABEL: sort
+
+// Default order of numbers compares their string representations.
+print([10, 9, 1, -1, -10, -2, 0, -0, 1.5, 100, 1e21, 5e-7, NaN, Infinity,
+       -Infinity, 4294967295, 4294967296, undefined, 2].sort());
+// CHECK-NEXT: -1,-10,-2,-Infinity,0,0,1,1.5,10,100,1e+21,2,4294967295,4294967296,5e-7,9,Infinity,NaN,
+
+// Mixed strings and numbers.
+print(['b', 3, 'a', 20, undefined, '10'].sort());
+// CHECK-NEXT: 10,20,3,a,b,
+
+// Objects are converted with toString().
+var converted = 0;
+var objs = [{toString: function() { ++converted; return 'y'; }}, 'x'];
+print(objs.sort()[0] === 'x' ? 'obj last' : 'obj first', converted > 0);
+// CHECK-NEXT: obj last true
+
+// Stability with a compare function, on an array long enough to be merged.
+function checkStable(n, mod) {
+  var a = [];
+  for (var i = 0; i < n; ++i)
+    a.push({key: (i * 7919) % mod, idx: i});
+  a.sort(function(x, y) { return x.key - y.key; });
+  for (var i = 1; i < n; ++i) {
+    if (a[i - 1].key > a[i].key ||
+        (a[i - 1].key === a[i].key && a[i - 1].idx > a[i].idx))
+      return 'unstable at ' + i;
+  }
+  return 'stable';
+}
+print(checkStable(10, 3), checkStable(1000, 7), checkStable(20000, 101));
+// CHECK-NEXT: stable stable stable
+
+// Sorted, reversed and nearly sorted inputs.
+function check(a) {
+  for (var i = 1; i < a.length; ++i)
+    if (a[i - 1] > a[i])
+      return 'unsorted at ' + i;
+  return 'sorted';
+}
+var n = 5000;
+var asc = [], desc = [], nearly = [];
+for (var i = 0; i < n; ++i) {
+  asc.push(i);
+  desc.push(n - i);
+  nearly.push(i);
+}
+for (var i = 0; i < n; i += 97) {
+  var t = nearly[i];
+  nearly[i] = nearly[n - 1 - i];
+  nearly[n - 1 - i] = t;
+}
+function numeric(x, y) { return x - y; }
+print(check(asc.sort(numeric)), check(desc.sort(numeric)),
+      check(nearly.sort(numeric)));
+// CHECK-NEXT: sorted sorted sorted
+
+// Undefined values go last and are not passed to the compare function.
+print([3, undefined, 1, undefined, 2].sort(function(x, y) {
+  if (x === undefined || y === undefined)
+    throw new Error('undefined passed');
+  return x - y;
+}));
+// CHECK-NEXT: 1,2,3,,
+
+// Exceptions from the compare function leave a permutation of the array.
+var a = [5, 4, 3, 2, 1, 0, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+         20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36];
+var calls = 0;
+try {
+  a.sort(function(x, y) {
+    if (++calls === 40)
+      throw new Error('stop');
+    return x - y;
+  });
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: stop
+var expected = [];
+for (var i = 0; i < 37; ++i)
+  expected.push(i);
+print(a.slice().sort(numeric).join() === expected.join());
+// CHECK-NEXT: true
+
+// A compare function that freezes the array makes writing back throw.
+var frozen = [3, 2, 1];
+try {
+  frozen.sort(function(x, y) {
+    Object.freeze(frozen);
+    return x - y;
+  });
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+// A compare function that shrinks the array doesn't crash.
+var shrink = [3, 2, 1, 0];
+shrink.sort(function(x, y) {
+  shrink.length = 1;
+  return x - y;
+});
+print(shrink);
+// CHECK-NEXT: 0,1,2,3
+
+// Typed arrays use numeric order, with -0 before +0 and NaN last.
+print(Array.from(new Float64Array([3, NaN, -0, 0, -Infinity, 1.5, -0]).sort())
+      .map(function(x) { return Object.is(x, -0) ? '-0' : String(x); }));
+// CHECK-NEXT: -Infinity,-0,-0,0,1.5,3,NaN
+print(new Int8Array([5, -3, 127, -128, 0]).sort());
+// CHECK-NEXT: -128,-3,0,5,127
+print(new BigInt64Array([5n, -3n, 0n]).sort());
+// CHECK-NEXT: -3,0,5
+print(new Uint16Array([5, 3, 9, 1]).sort(function(x, y) { return y - x; }));
+// CHECK-NEXT: 9,5,3,1
+print(new BigUint64Array([5n, 3n, 9n]).sort(function(x, y) {
+  return x < y ? 1 : x > y ? -1 : 0;
+}));
+// CHECK-NEXT: 9,5,3
+
+var ta = new Float32Array(40);
+for (var i = 0; i < ta.length; ++i)
+  ta[i] = (i * 13) % 40;
+try {
+  ta.sort(function(x, y) {
+    HermesInternal.detachArrayBuffer(ta.buffer);
+    return x - y;
+  });
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: Callback to sort() detached the array
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -fno-fuse-instructions %s | %FileCheck --match-full-lines %s
+
+// Superinstructions only execute the second instruction inline when it takes
+// its number fast path. Every other combination of operands must behave like
+// the unfused pair.
+
+print('fuse-instructions');
+// CHECK-LABEL: fuse-instructions
+
+function sum(a, n) {
+  var s = 0;
+  for (var i = 0; i < n; i++) {
+    s = s + a[i];
+  }
+  return s;
+}
+
+print(sum([1, 2, 3, 4], 4));
+// CHECK-NEXT: 10
+print(sum(['a', 'b', 'c'], 3));
+// CHECK-NEXT: 0abc
+print(sum('xyz', 3));
+// CHECK-NEXT: 0xyz
+print(sum([1, 2], 4));
+// CHECK-NEXT: NaN
+try {
+  sum([1n], 1);
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+function count(from, to) {
+  var n = 0;
+  for (var i = from; i < to; i++) {
+    n++;
+  }
+  return n;
+}
+
+print(count(0, 5), count('3', 5), count(0, '4'), count(NaN, 3), count(0, NaN));
+// CHECK-NEXT: 5 2 4 0 0
+print(count({valueOf: () => 1}, 3));
+// CHECK-NEXT: 2
+
+print(count(0n, 2), count(0, 2n), count('a', 'b'));
+// CHECK-NEXT: 2 2 1
+
+function throwsFromGetter(o) {
+  var s = 0;
+  for (var i = 0; i < 2; i++) {
+    try {
+      s = s + o[i];
+    } catch (e) {
+      s = s + 100;
+    }
+  }
+  return s;
+}
+
+print(
+  throwsFromGetter({
+    get 0() {
+      throw new Error();
+    },
+    1: 1,
+  }),
+);
+// CHECK-NEXT: 101
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -gc-evacuation-threads=4 -gc-max-heap=64M -gc-print-stats %s 2>&1 | %FileCheck --match-full-lines %s
+// RUN: %hermes -gc-evacuation-threads=3 -gc-sanitize-handles=0 %s | %FileCheck --match-full-lines --check-prefix=OUT %s
+// RUN: %hermes -gc-evacuation-threads=2 -gc-mark-threads=2 %s | %FileCheck --match-full-lines --check-prefix=OUT %s
+// REQUIRES: !slow_debug
+
+// Young generation collections evacuated by several threads must keep every
+// object reachable from the roots, from old objects and from WeakMaps.
+
+print('gc-parallel-evacuate');
+// CHECK-LABEL: gc-parallel-evacuate
+// OUT-LABEL: gc-parallel-evacuate
+
+// Old objects that keep pointing to newly allocated young objects.
+var holders = [];
+for (var i = 0; i < 2000; i++) holders.push({young: null, i: i});
+
+var keys = [];
+var wm = new WeakMap();
+for (var i = 0; i < 1000; i++) {
+  var key = {i: i};
+  keys.push(key);
+  wm.set(key, {value: i});
+}
+
+// Young objects shared by many old objects, so that several threads race to
+// evacuate them.
+var shared = [];
+var garbage;
+for (var i = 0; i < 300000; i++) {
+  var holder = holders[i % holders.length];
+  holder.young = {a: [i, i + 1], b: 'x' + i};
+  if (i % 100 === 0) shared.push(holder.young);
+  holders[(i * 7) % holders.length].other = shared[shared.length - 1];
+  garbage = {c: new Array(8), d: i};
+  if (i % 50000 === 0) holder.big = new Array(100000).fill(i);
+}
+
+var sum = 0;
+for (var i = 0; i < holders.length; i++) sum += holders[i].young.a[1] - holders[i].young.a[0];
+print(sum, holders[1999].young.b);
+// CHECK-NEXT: 2000 x299999
+// OUT-NEXT: 2000 x299999
+var wmSum = 0;
+for (var i = 0; i < keys.length; i++) wmSum += wm.get(keys[i]).value;
+var sharedSum = 0;
+for (var i = 0; i < shared.length; i++) sharedSum += shared[i].a[0];
+print(wmSum, shared.length, sharedSum);
+// CHECK-NEXT: 499500 3000 449850000
+// OUT-NEXT: 499500 3000 449850000
+print(holders[0].big.length, holders[0].big[0]);
+// CHECK-NEXT: 100000 250000
+// OUT-NEXT: 100000 250000
+
+// CHECK: "YG pause histogram": {
+// CHECK-NEXT: "< 0.25 ms": {{[0-9]+}},
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -gc-mark-threads=4 -gc-max-heap=64M -gc-print-stats %s 2>&1 | %FileCheck --match-full-lines %s
+// RUN: %hermes -gc-mark-threads=3 -gc-sanitize-handles=0 %s | %FileCheck --match-full-lines --check-prefix=OUT %s
+// REQUIRES: !slow_debug
+
+// Old generation collections marked by several threads must keep every
+// reachable object, symbol and WeakMap entry alive.
+
+print('gc-parallel-mark');
+// CHECK-LABEL: gc-parallel-mark
+// OUT-LABEL: gc-parallel-mark
+
+// A long-lived tree, with symbol properties that are only reachable from it.
+function makeTree(depth) {
+  if (depth === 0) return {leaf: true};
+  var node = {left: makeTree(depth - 1), right: makeTree(depth - 1)};
+  node[Symbol.for('sym' + depth)] = depth;
+  return node;
+}
+function countLeaves(node) {
+  return node.leaf ? 1 : countLeaves(node.left) + countLeaves(node.right);
+}
+var tree = makeTree(14);
+
+var keys = [];
+var wm = new WeakMap();
+for (var i = 0; i < 1000; i++) {
+  var key = {i: i};
+  keys.push(key);
+  wm.set(key, {value: i});
+}
+
+// Churn through enough garbage to run several old generation collections.
+var garbage;
+for (var i = 0; i < 300000; i++) {
+  garbage = {a: [i, i + 1], b: 'x' + i};
+  if (i % 1000 === 0) tree['extra' + (i / 1000)] = garbage;
+}
+
+var sum = 0;
+for (var i = 0; i < keys.length; i++) sum += wm.get(keys[i]).value;
+print(countLeaves(tree), tree[Symbol.for('sym14')], sum);
+// CHECK-NEXT: 16384 14 499500
+// OUT-NEXT: 16384 14 499500
+print(tree.extra299.b);
+// CHECK-NEXT: x299000
+// OUT-NEXT: x299000
+
+// CHECK: "Mark threads": [
+// CHECK-NEXT: {
+// CHECK-NEXT: "Marked bytes": {{[0-9]+}},
@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -gc-pretenure -gc-print-stats %s 2>&1 | %FileCheck --match-full-lines %s
+// RUN: %hermes -gc-pretenure -gc-evacuation-threads=2 %s | %FileCheck --match-full-lines --check-prefix=OUT %s
+// REQUIRES: !slow_debug
+
+// Allocation sites whose objects survive are pretenured, go back to the young
+// generation when their objects stop surviving, and pretenured objects keep
+// pointing to young objects correctly.
+
+print('gc-pretenure');
+// CHECK-LABEL: gc-pretenure
+// OUT-LABEL: gc-pretenure
+
+function makeEntry(i) {
+  return {id: i, tags: [i, 'tag' + i], child: null};
+}
+function makeLiteral(i) {
+  return {a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, h: i};
+}
+
+// Startup: every entry is kept, so the sites get pretenured.
+var entries = [];
+for (var i = 0; i < 20000; i++) {
+  var e = makeEntry(i);
+  // Pretenured objects point to objects allocated in the young generation.
+  e.child = {value: i};
+  entries.push(e);
+  entries.push(makeLiteral(i));
+}
+
+// Steady state: the same sites now allocate garbage.
+var garbage;
+for (var i = 0; i < 60000; i++) {
+  garbage = makeEntry(i);
+  garbage = makeLiteral(i);
+  garbage = 'g' + i;
+}
+
+var sum = 0;
+for (var i = 0; i < entries.length; i += 2) {
+  var e = entries[i];
+  sum += e.id + e.tags[0] + e.child.value + entries[i + 1].h;
+}
+print(entries.length, sum, entries[39998].tags[1]);
+// CHECK-NEXT: 40000 799960000 tag19999
+// OUT-NEXT: 40000 799960000 tag19999
+
+// CHECK: "allocationSites": {
+// CHECK-NEXT: "sites": {{[0-9]+}},
+// CHECK-NEXT: "pretenuredSites": {{[0-9]+}},
+// CHECK-NEXT: "pretenureDecisions": {{[1-9][0-9]*}},
+// CHECK-NEXT: "revertDecisions": {{[1-9][0-9]*}}
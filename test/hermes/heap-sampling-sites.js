@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -heap-sampling-sites=%t.tsv -heap-sampling-interval=1 %s \
+// RUN:   && cat %t.tsv | %FileCheck --match-full-lines %s
+// RUN: %hermes -heap-sampling-sites=%t.4k.tsv -heap-sampling-interval=4096 %s \
+// RUN:   && cat %t.4k.tsv | %FileCheck --match-full-lines --check-prefix=INTERVAL %s
+// REQUIRES: debugger
+
+// With an interval of one byte every allocation is sampled, so the counts are
+// exact. The objects of keep() are alive at exit, those of drop() are freed.
+// Sites are sorted by their stack, where the call to keep() comes first.
+
+function keep() {
+  return {a: 1};
+}
+
+function drop() {
+  return {b: 2};
+}
+
+var kept = [];
+for (var i = 0; i < 1000; i++) {
+  kept.push(keep());
+  drop();
+}
+
+// CHECK: # Sampling interval: 1 bytes
+// CHECK-NEXT: # live_bytes live_count freed_bytes freed_count estimated_live_bytes estimated_freed_bytes stack
+// CHECK: {{[0-9]+}} 1000 0 0 {{[0-9]+}} 0 global {{.*}};keep {{.*}}
+// CHECK: 0 0 {{[0-9]+}} 1000 0 {{[0-9]+}} global {{.*}};drop {{.*}}
+
+// INTERVAL: # Sampling interval: 4096 bytes
+// INTERVAL-NEXT: # live_bytes live_count freed_bytes freed_count estimated_live_bytes estimated_freed_bytes stack
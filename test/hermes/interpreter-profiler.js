@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -profile-interpreter=functions,native %s 2>&1 | %FileCheck --check-prefix=CLI %s
+
+print('interpreter-profiler');
+// CHECK-LABEL: interpreter-profiler
+
+function fib(n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+function work() {
+  var a = [];
+  for (var i = 0; i < 10; i++) {
+    a.push(fib(10));
+  }
+  return a.length;
+}
+
+/// \return the count of \p name in \p section of \p profile.
+function count(profile, section, name) {
+  var lines = profile.split('\n');
+  for (var i = lines.indexOf(section) + 2; i < lines.length && lines[i]; ++i) {
+    var fields = lines[i].trim().split(/ +/);
+    if (fields[3] === name) return +fields[0];
+  }
+  return 0;
+}
+
+function profile(kinds) {
+  HermesInternal.enableInterpreterProfiler(kinds);
+  // Only the functions called after the profiler is enabled are profiled.
+  work();
+  HermesInternal.disableInterpreterProfiler();
+  return HermesInternal.getInterpreterProfile();
+}
+
+var p = profile('functions,native');
+print(count(p, 'JS functions:', 'fib'), count(p, 'JS functions:', 'work'));
+// CHECK-NEXT: 1770 1
+print(count(p, 'JS functions:', 'profile'));
+// CHECK-NEXT: 0
+print(count(p, 'Native functions:', 'arrayPrototypePush'));
+// CHECK-NEXT: 10
+
+// Disabling the profiler keeps the profile, enabling it again adds to it.
+work();
+p = profile('all');
+print(count(p, 'JS functions:', 'fib'));
+// CHECK-NEXT: 3540
+print(count(p, 'Opcodes:', 'Ret') >= 1771);
+// CHECK-NEXT: true
+
+try {
+  HermesInternal.enableInterpreterProfiler('cycles');
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: RangeError
+
+// With -profile-interpreter, the profile of everything run while the profiler
+// was enabled is printed at exit.
+// CLI: Interpreter profile {{.*}}
+// CLI: JS functions:
+// CLI: {{ +}}3540 {{.*}} fib ({{[0-9]+:[0-9]+}})
+// CLI: Native functions:
+// CLI: {{ +}}20 {{.*}} arrayPrototypePush
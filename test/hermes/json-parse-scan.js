@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// JSON.parse scans strings and whitespace a vector of code units at a time,
+// and parses ASCII text without widening it to UTF16. Special characters must
+// be found at every position within a vector, in both encodings.
+
+print('json-parse-scan');
+// CHECK-LABEL: json-parse-scan
+
+function repeat(s, n) {
+  var r = '';
+  for (var i = 0; i < n; i++) r += s;
+  return r;
+}
+
+// Parse the same document as ASCII text (when it is ASCII), and as UTF16 text
+// by adding a non-ASCII string to it, and check both values.
+function check(text, expected) {
+  var results = [JSON.parse(text), JSON.parse('["é",' + text + ']')[1]];
+  for (var i = 0; i < results.length; i++) {
+    if (JSON.stringify(results[i]) !== JSON.stringify(expected)) {
+      print('mismatch', i, JSON.stringify(text), JSON.stringify(results[i]));
+      return false;
+    }
+  }
+  return true;
+}
+
+// An escape, a quote or a multi-byte character at every offset.
+var ok = true;
+for (var len = 0; len < 70; len++) {
+  var prefix = repeat('a', len);
+  ok &= check('"' + prefix + '"', prefix);
+  ok &= check('"' + prefix + '\\n' + prefix + '"', prefix + '\n' + prefix);
+  ok &= check('"' + prefix + '\\u00e9x"', prefix + 'éx');
+  ok &= check('"' + prefix + 'é' + prefix + '"', prefix + 'é' + prefix);
+  ok &= check('"' + prefix + '\\"\\\\"', prefix + '"\\');
+  var obj = {};
+  obj[prefix + '\t'] = len;
+  ok &= check('{"' + prefix + '\\t":' + len + '}', obj);
+}
+print(ok);
+// CHECK-NEXT: 1
+
+// Whitespace runs of every length before and between tokens.
+ok = true;
+for (var len = 0; len < 70; len++) {
+  var ws = repeat(' \t\r\n'.charAt(len % 4), len);
+  var text = ws + '[' + ws + '1' + ws + ',' + repeat(' ', len) + '{' + ws +
+    '"k"' + ws + ':' + ws + 'true' + ws + '}' + ws + ']' + ws;
+  var v = JSON.parse(text);
+  ok &= v.length === 2 && v[0] === 1 && v[1].k === true;
+}
+print(ok);
+// CHECK-NEXT: 1
+
+// Control characters are rejected wherever they are.
+for (var len of [0, 7, 8, 15, 16, 31, 40]) {
+  try {
+    JSON.parse('"' + repeat('b', len) + '\u0001' + repeat('b', 20) + '"');
+    print('parsed');
+  } catch (e) {
+    print(len, e.message);
+  }
+}
+// CHECK-NEXT: 0 JSON Parse error: U+0000 thru U+001F is not allowed in string
+// CHECK-NEXT: 7 JSON Parse error: U+0000 thru U+001F is not allowed in string
+// CHECK-NEXT: 8 JSON Parse error: U+0000 thru U+001F is not allowed in string
+// CHECK-NEXT: 15 JSON Parse error: U+0000 thru U+001F is not allowed in string
+// CHECK-NEXT: 16 JSON Parse error: U+0000 thru U+001F is not allowed in string
+// CHECK-NEXT: 31 JSON Parse error: U+0000 thru U+001F is not allowed in string
+// CHECK-NEXT: 40 JSON Parse error: U+0000 thru U+001F is not allowed in string
+
+// Unterminated strings.
+for (var text of ['"' + repeat('c', 40), '"' + repeat('c', 40) + '\\']) {
+  try {
+    JSON.parse(text);
+  } catch (e) {
+    print(e.message);
+  }
+}
+// CHECK-NEXT: JSON Parse error: Unexpected end of input
+// CHECK-NEXT: JSON Parse error: Unexpected end of input
+
+// Strings from ASCII text are ASCII, and non-ASCII strings keep their
+// characters.
+var long = repeat('0123456789', 10);
+var parsed = JSON.parse('["' + long + '","' + long + '中","\\ud83d\\ude00"]');
+print(
+  parsed[0] === long,
+  parsed[1].length,
+  parsed[1].charCodeAt(100),
+  parsed[2].codePointAt(0),
+);
+// CHECK-NEXT: true 101 20013 128512
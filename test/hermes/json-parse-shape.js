@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// JSON.parse predicts that an object has the keys of the previous object at
+// the same nesting level. Objects that don't match the prediction must still
+// get exactly their own keys, in order.
+
+print('json-parse-shape');
+// CHECK-LABEL: json-parse-shape
+
+function show(v) {
+  return JSON.stringify(v);
+}
+
+var records = JSON.parse(
+  '[{"id":1,"name":"a","pos":{"x":1,"y":2}},' +
+    '{"id":2,"name":"b","pos":{"x":3,"y":4}},' +
+    '{"id":3,"name":"c","pos":{"x":5,"y":6}}]',
+);
+print(show(records));
+// CHECK-NEXT: [{"id":1,"name":"a","pos":{"x":1,"y":2}},{"id":2,"name":"b","pos":{"x":3,"y":4}},{"id":3,"name":"c","pos":{"x":5,"y":6}}]
+records[2].id = 30;
+records[2].extra = true;
+delete records[1].name;
+print(show(records), Object.keys(records[0]));
+// CHECK-NEXT: [{"id":1,"name":"a","pos":{"x":1,"y":2}},{"id":2,"pos":{"x":3,"y":4}},{"id":30,"name":"c","pos":{"x":5,"y":6},"extra":true}] id,name,pos
+var desc = Object.getOwnPropertyDescriptor(records[1], 'id');
+print(desc.value, desc.writable, desc.enumerable, desc.configurable);
+// CHECK-NEXT: 2 true true true
+
+// A different key, fewer keys, more keys, keys in another order.
+var mixed = JSON.parse(
+  '[{"a":1,"b":2,"c":3},{"a":4,"x":5,"c":6},{"a":7,"b":8},' +
+    '{"a":9,"b":10,"c":11,"d":12},{"c":13,"b":14,"a":15},{"a":16,"b":17,"c":18}]',
+);
+for (var i = 0; i < mixed.length; i++) print(show(mixed[i]));
+// CHECK-NEXT: {"a":1,"b":2,"c":3}
+// CHECK-NEXT: {"a":4,"x":5,"c":6}
+// CHECK-NEXT: {"a":7,"b":8}
+// CHECK-NEXT: {"a":9,"b":10,"c":11,"d":12}
+// CHECK-NEXT: {"c":13,"b":14,"a":15}
+// CHECK-NEXT: {"a":16,"b":17,"c":18}
+print(mixed[1].b, mixed[2].c, 'c' in mixed[2]);
+// CHECK-NEXT: undefined undefined false
+
+// Duplicate keys keep the last value, at the position of the first.
+print(show(JSON.parse('[{"a":1,"b":2},{"a":3,"b":4,"a":5},{"a":6,"a":7}]')));
+// CHECK-NEXT: [{"a":1,"b":2},{"a":5,"b":4},{"a":7}]
+
+// Escaped keys, index-like keys, __proto__ and empty objects.
+var odd = JSON.parse(
+  '[{"\\u0061":1,"b\\n":2},{"a":3,"b\\n":4},{"0":5,"1":6},{"0":7,"1":8},' +
+    '{"__proto__":9},{"__proto__":10},{},{"a":11}]',
+);
+print(show(odd));
+// CHECK-NEXT: [{"a":1,"b\n":2},{"a":3,"b\n":4},{"0":5,"1":6},{"0":7,"1":8},{"__proto__":9},{"__proto__":10},{},{"a":11}]
+print(odd[3][1], Object.getPrototypeOf(odd[5]) === Object.prototype);
+// CHECK-NEXT: 8 true
+
+// Objects too large to share a class.
+var keys = [];
+for (var i = 0; i < 300; i++) keys.push('"k' + i + '":' + i);
+var big = JSON.parse('[{' + keys.join(',') + '},{' + keys.join(',') + '}]');
+print(Object.keys(big[1]).length, big[1].k0, big[1].k299);
+// CHECK-NEXT: 300 0 299
+
+// Values that allocate while the predicted object is being filled.
+var parts = [];
+for (var i = 0; i < 2000; i++) {
+  parts.push(
+    '{"n":' + (i + 0.5) + ',"s":"str' + i + '","arr":[' + i + ',{"v":' + i +
+      '}],"o":{"k":"' + i + '"}}',
+  );
+}
+var many = JSON.parse('[' + parts.join(',') + ']');
+var sum = 0;
+for (var i = 0; i < many.length; i++) {
+  sum += many[i].n + many[i].arr[1].v + +many[i].o.k;
+  if (many[i].s !== 'str' + i) print('bad', i);
+}
+print(many.length, sum);
+// CHECK-NEXT: 2000 5998000
+
+// The reviver sees every key.
+var seen = [];
+JSON.parse('[{"a":1,"b":2},{"a":3,"b":4}]', function (k, v) {
+  seen.push(k);
+  return v;
+});
+print(seen.join());
+// CHECK-NEXT: a,b,0,a,b,1,
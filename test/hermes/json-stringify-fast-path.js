@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// JSON.stringify serializes plain data objects from the quoted keys cached in
+// their class, and reads their values directly from the slots. Anything that
+// can observe the serialization must still see the generic behavior.
+
+print('json-stringify-fast-path');
+// CHECK-LABEL: json-stringify-fast-path
+
+var records = [];
+for (var i = 0; i < 3; i++) {
+  records.push({id: i, name: 'n' + i, 'quo"te': [i, null, true], nested: {}});
+}
+print(JSON.stringify(records));
+// CHECK-NEXT: [{"id":0,"name":"n0","quo\"te":[0,null,true],"nested":{}},{"id":1,"name":"n1","quo\"te":[1,null,true],"nested":{}},{"id":2,"name":"n2","quo\"te":[2,null,true],"nested":{}}]
+print(JSON.stringify({a: 1, b: [1, {c: 2}]}, null, 2));
+// CHECK-NEXT: {
+// CHECK-NEXT:   "a": 1,
+// CHECK-NEXT:   "b": [
+// CHECK-NEXT:     1,
+// CHECK-NEXT:     {
+// CHECK-NEXT:       "c": 2
+// CHECK-NEXT:     }
+// CHECK-NEXT:   ]
+// CHECK-NEXT: }
+
+// Non-ASCII keys and values switch the output to UTF16 at any point.
+var s = JSON.stringify({ascii: 'x', 'ké': 'é', after: '中'});
+print(s, s.length);
+// CHECK-NEXT: {"ascii":"x","ké":"é","after":"中"} 34
+
+// Undefined values and functions are skipped, and non-enumerable and symbol
+// properties are not serialized.
+var o = {a: undefined, b: function () {}, c: 1};
+Object.defineProperty(o, 'hidden', {value: 2, enumerable: false});
+o[Symbol('s')] = 3;
+print(JSON.stringify(o));
+// CHECK-NEXT: {"c":1}
+
+// toJSON added to a prototype after objects of the same class were
+// serialized.
+function Point(x) {
+  this.x = x;
+}
+print(JSON.stringify([new Point(1), new Point(2)]));
+// CHECK-NEXT: [{"x":1},{"x":2}]
+Point.prototype.toJSON = function () {
+  return 'P' + this.x;
+};
+print(JSON.stringify([new Point(1), new Point(2)]));
+// CHECK-NEXT: ["P1","P2"]
+Object.prototype.toJSON = function () {
+  return 'O';
+};
+print(JSON.stringify({a: 1}), JSON.stringify([1]));
+// CHECK-NEXT: "O" "O"
+delete Object.prototype.toJSON;
+print(JSON.stringify({a: 1}), JSON.stringify([1]));
+// CHECK-NEXT: {"a":1} [1]
+
+// Accessors are called.
+var getter = {a: 1};
+Object.defineProperty(getter, 'b', {
+  get: function () {
+    return 'got';
+  },
+  enumerable: true,
+});
+print(JSON.stringify(getter));
+// CHECK-NEXT: {"a":1,"b":"got"}
+
+// A toJSON of an earlier value mutates the object being serialized.
+var mutated = {
+  first: {
+    toJSON: function () {
+      mutated.second = 'changed';
+      delete mutated.third;
+      return 1;
+    },
+  },
+  second: 'original',
+  third: 3,
+};
+print(JSON.stringify(mutated));
+// CHECK-NEXT: {"first":1,"second":"changed"}
+
+// A toJSON of an earlier element mutates the array being serialized.
+var arr = [
+  {
+    toJSON: function () {
+      arr[1] = 'changed';
+      Object.defineProperty(arr, 2, {
+        get: function () {
+          return 'getter';
+        },
+      });
+      return 0;
+    },
+  },
+  'original',
+  2,
+  ,
+];
+print(JSON.stringify(arr));
+// CHECK-NEXT: [0,"changed","getter",null]
+
+// Holes are looked up on the prototype chain.
+Array.prototype[1] = 'proto';
+print(JSON.stringify([0, , 2]));
+// CHECK-NEXT: [0,"proto",2]
+delete Array.prototype[1];
+
+// Replacers still see every key and value.
+print(
+  JSON.stringify({a: 1, b: {c: 2}}, function (k, v) {
+    return typeof v === 'number' ? v * 10 : v;
+  }),
+);
+// CHECK-NEXT: {"a":10,"b":{"c":20}}
+print(JSON.stringify({a: 1, b: 2, c: 3}, ['c', 'a']));
+// CHECK-NEXT: {"c":3,"a":1}
+
+// Index-like keys come first, in ascending order.
+print(JSON.stringify({b: 1, 2: 2, a: 3, 1: 4}));
+// CHECK-NEXT: {"1":4,"2":2,"b":1,"a":3}
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -emit-binary -out %t.hbc %s && %hermes %t.hbc | %FileCheck --match-full-lines %s
+
+// The identifiers of a module are registered the first time they are used,
+// and must resolve to the same symbols as identifiers created at runtime.
+
+print('lazy-identifiers');
+// CHECK-LABEL: lazy-identifiers
+
+var declaredGlobal = 1;
+print(globalThis['declared' + 'Global']);
+// CHECK-NEXT: 1
+
+var o = {firstKey: 1, secondKey: 2, 3: 'three'};
+print(o['first' + 'Key'], o.secondKey, o[3]);
+// CHECK-NEXT: 1 2 three
+o.thirdKey = 3;
+print(Object.keys(o).join());
+// CHECK-NEXT: 3,firstKey,secondKey,thirdKey
+delete o.firstKey;
+print('firstKey' in o, o.hasOwnProperty('secondKey'));
+// CHECK-NEXT: false true
+
+// The identifier is used for the first time in a function that was not
+// called before.
+function late(obj) {
+  return obj.onlyUsedLate;
+}
+var dyn = {};
+dyn['only' + 'Used' + 'Late'] = 'late';
+print(late(dyn));
+// CHECK-NEXT: late
+
+// Identifiers shared with eval'd code, which is compiled into its own module.
+var geval = eval;
+geval('var fromEval = {sharedName: "shared"};');
+print(fromEval.sharedName, typeof this.fromEval);
+// CHECK-NEXT: shared object
+
+// Non-ASCII identifiers.
+var é = {ключ: 'значение'};
+print(é.ключ, Object.keys(é)[0] === 'ключ');
+// CHECK-NEXT: значение true
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// The lexer skips string bodies, comment bodies and identifier runs a vector
+// at a time. Place every interesting character at every offset of a vector,
+// and near the end of the source, where only the scalar path can be used.
+
+print('lexer-vector-scan');
+// CHECK-LABEL: lexer-vector-scan
+
+var geval = eval;
+var failures = 0;
+function check(what, actual, expected) {
+  if (actual !== expected) {
+    ++failures;
+    print('FAIL', what, JSON.stringify(actual), JSON.stringify(expected));
+  }
+}
+
+var specials = [
+  ['"', '\\"'],
+  ["'", "\\'"],
+  ['\\', '\\\\'],
+  ['\n', '\\n'],
+  ['\x01', '\\x01'],
+  ['A', '\\u0041'],
+  ['', '\\\u2028'],
+  ['é', 'é'],
+  ['中', '中'],
+  ['&', '&'],
+  ['*', '*'],
+];
+
+for (var k = 0; k < 40; ++k) {
+  var pre = 'a'.repeat(k);
+  var post = 'b'.repeat(40 - k);
+
+  // Strings.
+  for (var i = 0; i < specials.length; ++i) {
+    var sp = specials[i];
+    var expected = pre + sp[0] + post;
+    check('string ' + k, geval('"' + pre + sp[1] + post + '"'), expected);
+    check('string ' + k, geval("'" + pre + sp[1] + post + "'"), expected);
+    // Line continuations produce nothing.
+    check('string ' + k, geval("'" + pre + '\\\n' + post + "'"), pre + post);
+  }
+  check('string end ' + k, geval('"' + pre + '"'), pre);
+
+  // Block comments, with '*' and terminators at every offset.
+  check('block ' + k, geval('1 /*' + pre + '*' + post + '*/ + 2'), 3);
+  check('block ' + k, geval('1 /*' + pre + '**/ + 2'), 3);
+  check('block ' + k, geval('1 /*' + pre + 'é中' + post + '*/ + 2'), 3);
+  // A line terminator in a block comment allows ASI after return.
+  check(
+    'block newline ' + k,
+    geval('(function(){ return /*' + pre + '\n' + post + '*/ 7 })()'),
+    undefined,
+  );
+  check(
+    'block ls ' + k,
+    geval('(function(){ return /*' + pre + '\u2028' + post + '*/ 7 })()'),
+    undefined,
+  );
+  check(
+    'block no newline ' + k,
+    geval('(function(){ return /*' + pre + post + '*/ 7 })()'),
+    7,
+  );
+
+  // Line comments.
+  check('line ' + k, geval('1 //' + pre + '*é' + post + '\n + 2'), 3);
+  check('line cr ' + k, geval('1 //' + pre + '\r + 2'), 3);
+  check('line ps ' + k, geval('1 //' + pre + '\u2029 + 2'), 3);
+  check('line end ' + k, geval('5 //' + pre), 5);
+
+  // Identifiers, followed by each kind of character that ends the ASCII run.
+  var id = 'Z' + pre + '$_9' + post.toUpperCase();
+  check('ident ' + k, geval('var ' + id + ' = ' + k + '; ' + id), k);
+  var uid = pre + 'é' + post;
+  check('ident unicode ' + k, geval('var ' + uid + ' = 1; ' + uid), 1);
+  var eid = pre + '\\u0063' + post;
+  var cid = pre + 'c' + post;
+  check('ident escape ' + k, geval('var ' + eid + ' = 2; ' + cid), 2);
+  check('ident end ' + k, geval('var $' + pre + ' = 3; $' + pre), 3);
+  check('ident op ' + k, geval('var q' + pre + ' = 4; q' + pre + '-1'), 3);
+}
+
+print('failures', failures);
+// CHECK-NEXT: failures 0
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+// Loads hoisted out of loops must observe the stores made while the loop runs.
+
+print('licm');
+// CHECK-LABEL: licm
+
+function capturedLoad(n, f) {
+  var k = n * 2;
+  return function () {
+    var sum = 0;
+    for (var i = 0; i < n; ++i) {
+      sum += f(i) + k;
+    }
+    return sum;
+  };
+}
+print(capturedLoad(3, (i) => i)());
+// CHECK-NEXT: 21
+
+function storedByClosure(n, f) {
+  var k = 1;
+  function bump() {
+    k++;
+  }
+  var sum = 0;
+  for (var i = 0; i < n; ++i) {
+    f(bump);
+    sum += k;
+  }
+  return sum;
+}
+print(storedByClosure(3, (g) => g()));
+// CHECK-NEXT: 9
+
+function storedByInner(n) {
+  var k = 0;
+  function inner() {
+    var sum = 0;
+    for (var i = 0; i < n; ++i) {
+      set(i);
+      sum += k;
+    }
+    return sum;
+  }
+  function set(v) {
+    k = v;
+  }
+  return inner();
+}
+print(storedByInner(4));
+// CHECK-NEXT: 6
+
+function* gen() {
+  var k = 0;
+  function sum() {
+    var s = 0;
+    for (var i = 0; i < 3; ++i) {
+      it.next();
+      s += k;
+    }
+    return s;
+  }
+  for (;;) {
+    ++k;
+    yield sum;
+  }
+}
+var it = gen();
+print(it.next().value());
+// CHECK-NEXT: 9
+
+function arrayLength(arr) {
+  var sum = 0;
+  for (var i = 0; i < arr.length; ++i) {
+    sum += arr[i];
+  }
+  return sum;
+}
+var arr = [1, 2];
+Object.defineProperty(arr, 1, {
+  get: function () {
+    arr.push(10);
+    return 2;
+  },
+});
+print(arrayLength(arr));
+// CHECK-NEXT: 13
+
+function stringLength(s, a, b) {
+  s = '' + s;
+  var sum = 0;
+  for (var i = 0; i < s.length; ++i) {
+    sum += a * b + i;
+  }
+  return sum;
+}
+print(stringLength('abc', 2, 3));
+// CHECK-NEXT: 21
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -gc-sanitize-handles=1 %s | %FileCheck --match-full-lines %s
+
+// Map and Set iterators keep their position when the underlying table is
+// grown, shrunk, compacted or cleared while they are live.
+
+print('map-iterator-rehash');
+// CHECK-LABEL: map-iterator-rehash
+
+// Growing the table while iterating visits the new entries.
+var m = new Map([[0, 0], [1, 1]]);
+var it = m.entries();
+print(it.next().value);
+// CHECK-NEXT: 0,0
+for (var i = 2; i < 100; i++) m.set(i, i);
+var sum = 0, count = 0;
+for (var e of it) {
+  sum += e[1];
+  count++;
+}
+print(count, sum);
+// CHECK-NEXT: 99 4950
+
+// Deleting most entries shrinks the table, and the iterator continues with
+// the next surviving entry.
+var s = new Set();
+for (var i = 0; i < 1000; i++) s.add(i);
+var it = s.values();
+for (var i = 0; i < 10; i++) it.next();
+for (var i = 0; i < 990; i++) if (i % 100 !== 50) s.delete(i);
+print(s.size, Array.from(it).join(','));
+// CHECK-NEXT: 20 50,150,250,350,450,550,650,750,850,950,990,991,992,993,994,995,996,997,998,999
+
+// Alternately deleting and adding compacts the table in place.
+var s = new Set([0, 1, 2, 3]);
+var it = s.keys();
+it.next();
+for (var i = 4; i < 10000; i++) {
+  s.delete(i - 4);
+  s.add(i);
+}
+print(s.size, Array.from(it).join(','));
+// CHECK-NEXT: 4 9996,9997,9998,9999
+
+// Clearing the map restarts live iterators at the entries added afterwards.
+var m = new Map([['a', 1], ['b', 2], ['c', 3]]);
+var it1 = m.keys();
+var it2 = m.keys();
+it1.next();
+m.clear();
+m.set('d', 4);
+print(Array.from(it1).join(','), Array.from(it2).join(','));
+// CHECK-NEXT: d d
+
+// An iterator that reached the end stays finished.
+var m = new Map([[1, 1]]);
+var it = m.keys();
+it.next();
+print(it.next().done);
+// CHECK-NEXT: true
+m.set(2, 2);
+print(it.next().done);
+// CHECK-NEXT: true
+
+// forEach visits entries added and skips entries deleted during the walk.
+var m = new Map([[1, 'a'], [2, 'b'], [3, 'c']]);
+var seen = [];
+m.forEach(function(v, k) {
+  seen.push(k);
+  if (k === 1) {
+    m.delete(2);
+    for (var i = 10; i < 40; i++) m.set(i, i);
+  }
+});
+print(seen.length, seen.slice(0, 4).join(','));
+// CHECK-NEXT: 32 1,3,10,11
+
+// Keys are compared with SameValueZero across rehashes.
+var m = new Map();
+var obj = {};
+m.set(NaN, 'nan').set(-0, 'zero').set(obj, 'obj').set('s', 'str');
+for (var i = 0; i < 1000; i++) m.set(i + 0.5, i);
+print(m.get(NaN), m.get(0), m.get(obj), m.get('s'), m.get(999.5), m.size);
+// CHECK-NEXT: nan zero obj str 999 1004
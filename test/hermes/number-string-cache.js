@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -gc-sanitize-handles=1 %s | %FileCheck --match-full-lines %s
+
+// Repeated conversions between numbers and strings are served from the
+// runtime's caches, and must produce the same results as fresh conversions.
+
+print('number-string-cache');
+// CHECK-LABEL: number-string-cache
+
+for (var k = 0; k < 3; k++)
+  print('' + 123.456, String(-1e21), (0.1 + 0.2).toString());
+// CHECK-NEXT: 123.456 -1e+21 0.30000000000000004
+// CHECK-NEXT: 123.456 -1e+21 0.30000000000000004
+// CHECK-NEXT: 123.456 -1e+21 0.30000000000000004
+
+// 0 and -0 both convert to "0", which converts back to +0.
+print(String(0), String(-0), 1 / +String(-0), 1 / +String(0));
+// CHECK-NEXT: 0 0 Infinity Infinity
+print(String(NaN), String(NaN), +'NaN', +'abc');
+// CHECK-NEXT: NaN NaN NaN NaN
+
+// Strings that are not the canonical form of their number.
+for (var k = 0; k < 2; k++)
+  print(+' 12 ', +'12', +'0x10', +'1e3', +'', +'-Infinity');
+// CHECK-NEXT: 12 12 16 1000 0 -Infinity
+// CHECK-NEXT: 12 12 16 1000 0 -Infinity
+
+// Non-index numbers used as property keys.
+var o = {};
+for (var i = 0; i < 500; i++)
+  o[-i - 0.5] = i;
+if (typeof gc === 'function')
+  gc();
+var sum = 0;
+for (var i = 0; i < 500; i++)
+  sum += o[-i - 0.5] + o[String(-i - 0.5)];
+print(sum, o['-2.5'], Object.keys(o)[3]);
+// CHECK-NEXT: 249500 2 -3.5
+
+// Cached strings may be collected or moved between conversions.
+var strs = [];
+for (var i = 0; i < 10000; i++) {
+  strs.push('' + (i % 300) / 8);
+  if (i % 1000 === 0 && typeof gc === 'function')
+    gc();
+}
+var bad = 0;
+for (var i = 0; i < 300; i++) {
+  var n = i / 8;
+  if (String(n) !== n.toString() || +String(n) !== n)
+    bad++;
+}
+print(bad, strs[9999]);
+// CHECK-NEXT: 0 12.375
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+// Exercise the polymorphic property cache: the same access sites observe an
+// increasing number of shapes, up to and beyond the megamorphic limit.
+
+function getX(o) {
+  return o.x;
+}
+function setX(o, v) {
+  o.x = v;
+}
+
+var shapes = [
+  {x: 0},
+  {a: 0, x: 0},
+  {a: 0, b: 0, x: 0},
+  {a: 0, b: 0, c: 0, x: 0},
+  {a: 0, b: 0, c: 0, d: 0, x: 0},
+  {a: 0, b: 0, c: 0, d: 0, e: 0, x: 0},
+];
+
+for (var round = 0; round < 3; ++round) {
+  var res = [];
+  for (var i = 0; i < shapes.length; ++i) {
+    setX(shapes[i], i * 10 + round);
+    res.push(getX(shapes[i]));
+  }
+  print(res.join(','));
+}
+// CHECK: 0,10,20,30,40,50
+// CHECK-NEXT: 1,11,21,31,41,51
+// CHECK-NEXT: 2,12,22,32,42,52
+
+// A cached shape must not be confused with a shape whose property lives
+// elsewhere, including on the prototype.
+var proto = {x: 'proto'};
+var inherits = Object.create(proto);
+inherits.y = 1;
+print(getX(inherits));
+// CHECK-NEXT: proto
+inherits.x = 'own';
+print(getX(inherits));
+// CHECK-NEXT: own
+print(getX({y: 1}));
+// CHECK-NEXT: undefined
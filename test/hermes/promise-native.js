@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -Xmicrotask-queue %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xmicrotask-queue %s | %FileCheck --match-full-lines %s
+
+print('promise-native');
+// CHECK-LABEL: promise-native
+
+var p = Promise.resolve(1);
+print(Object.prototype.toString.call(p), Promise.resolve(p) === p);
+// CHECK-NEXT: [object Promise] true
+print(Promise.length, Promise.prototype.then.length, Promise.resolve.length);
+// CHECK-NEXT: 1 2 1
+
+// The state that the REPL prints.
+print(
+  JSON.stringify(HermesInternal.getPromiseState(p)),
+  JSON.stringify(HermesInternal.getPromiseState(Promise.reject('r'))),
+  JSON.stringify(HermesInternal.getPromiseState(new Promise(function() {}))),
+  HermesInternal.getPromiseState({}),
+);
+// CHECK-NEXT: [1,1] [2,"r"] [0,null] undefined
+
+try {
+  Promise(function () {});
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+try {
+  new Promise(1);
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+try {
+  Promise.prototype.then.call({}, function () {});
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+var log = [];
+function step(name) {
+  return function (v) {
+    log.push(name + ':' + v);
+    return v;
+  };
+}
+
+// Reactions run in the order they were added, after the current script.
+p.then(step('a'));
+Promise.reject(2).catch(step('b'));
+p.then(step('c'))
+  .then(step('d'))
+  .then(function () {
+    print(log.join());
+  });
+new Promise(function (resolve) {
+  resolve(p);
+}).then(step('e'));
+log.push('sync');
+
+// Self resolution and throwing thenables reject.
+var self = new Promise(function (resolve) {
+  setTimeout(function () {
+    resolve(self);
+  }, 0);
+});
+self.catch(function (e) {
+  print('self', e.name);
+});
+Promise.resolve({
+  get then() {
+    throw 'getter';
+  },
+}).catch(function (e) {
+  print('thenable', e);
+});
+Promise.resolve({
+  then: function (resolve, reject) {
+    resolve('once');
+    reject('twice');
+  },
+}).then(function (v) {
+  print('thenable', v);
+});
+
+// then on a subclass creates the derived promise with the subclass.
+function MyPromise(executor) {
+  return Reflect.construct(Promise, [executor], MyPromise);
+}
+Object.setPrototypeOf(MyPromise, Promise);
+MyPromise.prototype = Object.create(Promise.prototype, {
+  constructor: {value: MyPromise, writable: true, configurable: true},
+});
+var mine = MyPromise.resolve(3).then(function (v) {
+  return v + 1;
+});
+print(mine instanceof MyPromise, MyPromise.resolve(mine) === mine);
+// CHECK-NEXT: true true
+
+// The runtime reports rejections without handlers to the tracker, and
+// handlers added to them later.
+HermesInternal.enablePromiseRejectionTracker({
+  allRejections: true,
+  onUnhandled: function (id, error) {
+    print('unhandled', id, error);
+  },
+  onHandled: function (id, error) {
+    print('handled', id, error);
+  },
+});
+var late = Promise.reject('late');
+setTimeout(function () {
+  late.catch(function () {});
+}, 3000);
+Promise.reject('caught').catch(function () {});
+
+// Await on native promises, primitives, and thenables.
+async function waiter() {
+  var a = await Promise.resolve('x');
+  var b = await 'y';
+  var c = await {
+    then: function (resolve) {
+      resolve('z');
+    },
+  };
+  try {
+    await Promise.reject('w');
+  } catch (e) {
+    return a + b + c + e;
+  }
+}
+waiter().then(function (v) {
+  print('await', v);
+});
+
+async function thrower() {
+  throw new Error('async');
+}
+thrower().catch(function (e) {
+  print('async', e.message);
+});
+
+var poisoned = Promise.resolve(5);
+Object.defineProperty(poisoned, 'constructor', {
+  get: function () {
+    throw 'constructor';
+  },
+});
+(async function () {
+  try {
+    await poisoned;
+  } catch (e) {
+    print('await', e);
+  }
+})();
+
+Promise.all([1, Promise.resolve(2), mine]).then(function (v) {
+  print('all', v);
+});
+Promise.allSettled([Promise.reject(1), 2]).then(function (v) {
+  print('allSettled', JSON.stringify(v));
+});
+Promise.race([new Promise(function () {}), Promise.resolve('r')]).then(
+  function (v) {
+    print('race', v);
+  },
+);
+Promise.any([Promise.reject(1), Promise.resolve('any')]).then(function (v) {
+  print('any', v);
+});
+Promise.resolve('f')
+  .finally(function () {
+    print('finally');
+  })
+  .then(function (v) {
+    print('finally', v);
+  });
+
+// CHECK-DAG: thenable getter
+// CHECK-DAG: thenable once
+// CHECK-DAG: await xyzw
+// CHECK-DAG: async async
+// CHECK-DAG: await constructor
+// CHECK-DAG: all 1,2,4
+// CHECK-DAG: allSettled [{"status":"rejected","reason":1},{"status":"fulfilled","value":2}]
+// CHECK-DAG: race r
+// CHECK-DAG: any any
+// CHECK-DAG: finally
+// CHECK-DAG: finally f
+// CHECK-DAG: self TypeError
+// CHECK-DAG: sync,a:1,b:2,c:1,e:1,d:1
+// CHECK-DAG: unhandled 0 late
+// CHECK-DAG: handled 0 late
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+// Exercise the prototype chain and accessor entries of the property cache,
+// and make sure they are invalidated when the chain changes.
+
+function A() {}
+A.prototype.m = function() { return 'A.m'; };
+Object.defineProperty(A.prototype, 'g', {
+  get: function() { return 'A.g ' + this.v; },
+  configurable: true,
+});
+function B() {}
+B.prototype = Object.create(A.prototype);
+function C() {}
+C.prototype = Object.create(B.prototype);
+
+function callM(o) {
+  return o.m();
+}
+function getG(o) {
+  return o.g;
+}
+
+var c = new C();
+c.v = 1;
+for (var i = 0; i < 3; ++i) {
+  print(callM(c), getG(c));
+}
+// CHECK: A.m A.g 1
+// CHECK-NEXT: A.m A.g 1
+// CHECK-NEXT: A.m A.g 1
+
+// Shadow the method on an intermediate prototype.
+B.prototype.m = function() { return 'B.m'; };
+print(callM(c));
+// CHECK-NEXT: B.m
+
+// Replace the method on the holder without changing its shape.
+B.prototype.m = function() { return 'B.m2'; };
+print(callM(c));
+// CHECK-NEXT: B.m2
+
+// Redefine the getter.
+Object.defineProperty(A.prototype, 'g', {
+  get: function() { return 'A.g2 ' + this.v; },
+  configurable: true,
+});
+print(getG(c));
+// CHECK-NEXT: A.g2 1
+
+// Setter-only accessors.
+Object.defineProperty(
+  A.prototype, 'g', {get: undefined, set: function(v) {}});
+print(getG(c));
+// CHECK-NEXT: undefined
+
+// Assignment calls the setter; defineProperty shadows the accessor.
+c.g = 'own';
+print(getG(c));
+// CHECK-NEXT: undefined
+Object.defineProperty(c, 'g', {value: 'own'});
+print(getG(c));
+// CHECK-NEXT: own
+
+// Change the prototype of the receiver.
+var d = new C();
+print(callM(d));
+// CHECK-NEXT: B.m2
+Object.setPrototypeOf(d, {m: function() { return 'other'; }});
+print(callM(d));
+// CHECK-NEXT: other
+
+// Delete the method from the holder.
+delete B.prototype.m;
+print(callM(new C()));
+// CHECK-NEXT: A.m
+
+// Own accessors.
+var own = {};
+Object.defineProperty(own, 'g', {get: function() { return 'own getter'; }});
+for (var i = 0; i < 2; ++i)
+  print(getG(own));
+// CHECK-NEXT: own getter
+// CHECK-NEXT: own getter
+
+// Getters that throw.
+var thrower = {};
+Object.defineProperty(thrower, 'g', {
+  get: function() { throw new Error('thrown'); },
+});
+for (var i = 0; i < 2; ++i) {
+  try {
+    getG(thrower);
+  } catch (e) {
+    print(e.message);
+  }
+}
+// CHECK-NEXT: thrown
+// CHECK-NEXT: thrown
+
+// Built-in methods on prototypes.
+function push(arr, v) {
+  return arr.push(v);
+}
+var arr = [];
+for (var i = 0; i < 3; ++i)
+  push(arr, i);
+print(arr);
+// CHECK-NEXT: 0,1,2
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -lazy %s | %FileCheck --match-full-lines %s
+
+// Regexes whose matches must start with known code units skip ahead to the
+// positions where those code units occur.
+
+print('regexp-match-start');
+// CHECK-LABEL: regexp-match-start
+
+var filler = 'xyz'.repeat(100);
+
+// Literal prefixes.
+print(/needle/.exec(filler + 'needle' + filler).index);
+// CHECK-NEXT: 300
+print(/needle/.exec(filler + 'needl' + filler));
+// CHECK-NEXT: null
+print(/ab+c/.exec('aaabbbcab').index);
+// CHECK-NEXT: 2
+print(/(ab)(cd)e/.exec('abcdabcde'));
+// CHECK-NEXT: abcde,ab,cd
+print(/a[b]c/.exec('abacabc').index);
+// CHECK-NEXT: 4
+print(/\bfoo\b/.exec('foobar foo').index);
+// CHECK-NEXT: 7
+print(/^foo/m.exec('bar\nfoo').index);
+// CHECK-NEXT: 4
+print(/(?<=x)foo/.exec('foo xfoo').index);
+// CHECK-NEXT: 5
+
+// Sets of first code units.
+print(/cat|dog/.exec(filler + 'dog').index);
+// CHECK-NEXT: 300
+print(/[xq]uux/.exec('xyzquux').index);
+// CHECK-NEXT: 3
+print(/(?:foobar|foobaz)/.exec('foobaz').index);
+// CHECK-NEXT: 0
+print(/é|a/.exec('xyza').index);
+// CHECK-NEXT: 3
+print(/é|ü/.exec('xyza'));
+// CHECK-NEXT: null
+print(/é|ü/.exec('xyzü').index);
+// CHECK-NEXT: 3
+
+// Regexes without a known start are unaffected.
+print(/a*b/.exec('xxb').index);
+// CHECK-NEXT: 2
+print(/a|/.exec('xa').index);
+// CHECK-NEXT: 0
+print(/A/i.exec('xa').index);
+// CHECK-NEXT: 1
+
+// Global and sticky searches start at lastIndex.
+var re = /ab/g;
+var s = 'ab-ab--ab';
+var r;
+var indices = [];
+while ((r = re.exec(s)))
+  indices.push(r.index);
+print(indices);
+// CHECK-NEXT: 0,3,7
+re = /ab/y;
+re.lastIndex = 1;
+print(re.exec(s));
+// CHECK-NEXT: null
+re.lastIndex = 3;
+print(re.exec(s).index);
+// CHECK-NEXT: 3
+
+// Unicode regexes do not match within surrogate pairs.
+print(/b/u.exec('\u{1F600}b').index);
+// CHECK-NEXT: 2
+print(/\u{1F600}x/u.exec('a\u{1F600}x').index);
+// CHECK-NEXT: 1
+
+print('abcabc'.replace(/bc/g, '-'));
+// CHECK-NEXT: a-a-
+print('a,b;c'.split(/[,;]/));
+// CHECK-NEXT: a,b,c
@@ -5,16 +5,23 @@
  * LICENSE file in the root directory of this source tree.
  */
 
-// RUN: %hermes -O %s
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
 
 var a = [0,1]
-a.sort(function(x,y){
-  a.__defineGetter__(1, function(){
-    delete a[0];
-    return 1;
-  });
-  a.__defineGetter__(0, function(){
-    return 1;
-  });
-  return -1;
-})
+try {
+  a.sort(function(x,y){
+    a.__defineGetter__(1, function(){
+      delete a[0];
+      return 1;
+    });
+    a.__defineGetter__(0, function(){
+      return 1;
+    });
+    return -1;
+  })
+} catch (e) {
+  // The sorted values are written back with [[Set]], which fails on the
+  // getter-only property.
+  print(e.name);
+}
+// CHECK: TypeError
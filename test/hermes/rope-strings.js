@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -gc-sanitize-handles=1 %s | %FileCheck --match-full-lines %s
+// REQUIRES: !slow_debug
+
+// Long strings built by prepending, by appending to the middle of a
+// concatenation chain, or by slicing, are ropes and sliced strings that refer
+// to other strings. They must behave like any other string.
+
+print('rope-strings');
+// CHECK-LABEL: rope-strings
+
+function checksum(s) {
+  var h = 0;
+  for (var i = 0; i < s.length; i++) h = (h * 31 + s.charCodeAt(i)) | 0;
+  return h;
+}
+
+function repeat(s, n) {
+  var r = '';
+  for (var i = 0; i < n; i++) r += s;
+  return r;
+}
+
+// Prepending.
+var pre = '';
+for (var i = 0; i < 1000; i++) pre = (i % 10) + pre;
+print(pre.length, pre.slice(0, 12), pre.slice(-12));
+// CHECK-NEXT: 1000 987654321098 109876543210
+print(checksum(pre) === checksum(pre.split('').join('')));
+// CHECK-NEXT: true
+
+// Appending to the middle of a concatenation chain.
+var base = repeat('x', 300);
+var a = base + 'a';
+var b = base + 'b';
+var c = a + 'c';
+print(a.length, a[300], b[300], c.slice(299));
+// CHECK-NEXT: 301 a b xac
+print(a === base + 'a', a < b, b > c, c.indexOf('ac'));
+// CHECK-NEXT: true true true 300
+
+// Ropes deeper than the depth limit.
+var deep = repeat('y', 300);
+for (var i = 0; i < 1000; i++) deep = 'ab' + deep + 'cd';
+print(deep.length, deep.slice(0, 6), deep.slice(-6), deep.charAt(2299));
+// CHECK-NEXT: 4300 ababab cdcdcd y
+
+// Mixing ASCII and UTF-16.
+var mixed = 'é中' + repeat('z', 300);
+mixed = repeat('w', 300) + mixed;
+mixed = '\u{1F600}' + mixed;
+print(mixed.length, mixed.codePointAt(0).toString(16), mixed.charCodeAt(303));
+// CHECK-NEXT: 604 1f600 20013
+print(encodeURIComponent(mixed.slice(300, 306)));
+// CHECK-NEXT: ww%C3%A9%E4%B8%ADzz
+
+// Ropes as property keys.
+var obj = {};
+var key = repeat('k', 200) + repeat('q', 200);
+obj[key] = 1;
+obj[repeat('k', 200).concat(repeat('q', 200))] += 1;
+print(obj[key], Object.keys(obj)[0] === key);
+// CHECK-NEXT: 2 true
+
+// Sliced strings.
+var text = '';
+for (var i = 0; i < 100; i++) text += 'line ' + i + ': ' + repeat('.', i) + '\n';
+var lines = text.split('\n');
+print(lines.length, lines[99].length, lines[99].slice(0, 9));
+// CHECK-NEXT: 101 108 line 99: 
+var middle = text.substring(1000, 2000);
+var inner = middle.substring(100, 300);
+print(middle.length, inner.length, inner === text.substring(1100, 1300));
+// CHECK-NEXT: 1000 200 true
+print(inner.slice(0, 20) === text.slice(1100, 1120));
+// CHECK-NEXT: true
+var utf16 = repeat('中', 100) + repeat('é', 100);
+print(utf16.substring(50, 150).length, utf16.substring(90, 110).charCodeAt(15));
+// CHECK-NEXT: 100 233
+
+// Template literals substituting long strings.
+var html = '';
+for (var i = 0; i < 50; i++) {
+  html = `<li class="item">${html}</li>`;
+}
+print(html.length, html.slice(0, 20), html.slice(-10));
+// CHECK-NEXT: 1100 <li class="item"><li </li></li>
+print(`[${repeat('a', 300)}]`.length, `${key}${key}` === key + key);
+// CHECK-NEXT: 302 true
+
+// Flattening survives garbage collection.
+var keep = [];
+for (var i = 0; i < 20; i++) keep.push('p' + i + repeat('-', 300) + i);
+gc();
+print(keep[7].slice(0, 3), keep[7].length, JSON.stringify(keep[19]).length);
+// CHECK-NEXT: p7- 303 307
+print(/p1(-+)1$/.exec(keep[1])[1].length, keep[13].replace(/-+/, '~'));
+// CHECK-NEXT: 300 p13~13
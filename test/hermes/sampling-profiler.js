@@ -6,6 +6,7 @@
  */
 
 // RUN: %hermes -O -Wno-direct-eval -sample-profiling %s
+// RUN: %hermes -O -Wno-direct-eval -sample-profiling -sample-profiling-counters %s
 // RUN: %hermes -O -Wno-direct-eval -sample-profiling -emit-binary -out %t.hbc %s && %hermes %t.hbc
 
 // NOTE: This test is here to check that the sampling profiler can play nicely
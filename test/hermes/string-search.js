@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Exercise the substring search used by indexOf, lastIndexOf, includes, split
+// and replace, with needles of every length class and with ASCII and UTF-16
+// haystacks and needles.
+
+print('search');
+// CHECK-LABEL: search
+
+var filler = 'abcdefghijklmnopqrstuvwxyz0123456789'.repeat(20);
+var ascii = filler + 'needle' + filler + 'needle';
+var utf16 = filler + '世needle' + filler + '世needle';
+
+print(ascii.indexOf('n'), ascii.indexOf('needle'), ascii.lastIndexOf('needle'));
+// CHECK-NEXT: 13 720 1446
+print(utf16.indexOf('n'), utf16.indexOf('世n'), utf16.lastIndexOf('e'));
+// CHECK-NEXT: 13 720 1453
+print(ascii.indexOf('世needle'), utf16.indexOf('needle', 722));
+// CHECK-NEXT: -1 1448
+
+// Long needles are found at the right position, including partial matches.
+var longNeedle = filler.slice(620) + 'needle';
+print(ascii.indexOf(longNeedle), ascii.indexOf(longNeedle + 'x'));
+// CHECK-NEXT: 620 -1
+print(utf16.indexOf(filler.slice(500) + '世needle'));
+// CHECK-NEXT: 500
+
+// Matches at the very end, and positions past the end.
+print(ascii.indexOf('edle', ascii.length - 4), ascii.indexOf('', 5000));
+// CHECK-NEXT: 1448 1452
+print(ascii.lastIndexOf('abc', 0), ascii.lastIndexOf('', 3));
+// CHECK-NEXT: 0 3
+
+print(ascii.includes('needle'), utf16.includes('世needle', 1000),
+      ascii.includes('needles'));
+// CHECK-NEXT: true true false
+
+print(utf16.split('世').length, ascii.split('needle').length);
+// CHECK-NEXT: 3 3
+print('a-b-c'.replace('-', '+'), utf16.replace('世needle', '!').length);
+// CHECK-NEXT: a+b-c 1448
@@ -120,20 +120,23 @@ static ExecutionStatus diffFiles(
     auto start = bytecode->getBytecode(0);
     auto lastFuncStart = start;
     uint32_t lastFuncId = 0;
+    // Function info starts after the last function body.
+    auto funcInfoStart = bytecode->getFunctionHeader(0).infoOffset();
     for (uint32_t funcId = 0; funcId < functionCount; ++funcId) {
       auto funcStart = bytecode->getBytecode(funcId);
+      start = std::min(start, funcStart);
       if (funcStart > lastFuncStart) {
         lastFuncStart = funcStart;
         lastFuncId = funcId;
       }
+      funcInfoStart = std::min(
+          funcInfoStart, bytecode->getFunctionHeader(funcId).infoOffset());
     }
     auto lastFuncHeader = bytecode->getFunctionHeader(lastFuncId);
     auto lastFuncEnd = lastFuncStart + lastFuncHeader.bytecodeSizeInBytes();
     fileSizes[i].push_back(lastFuncEnd - start);
 
     // function info, debug info
-    auto firstFuncHeader = bytecode->getFunctionHeader(0);
-    auto funcInfoStart = firstFuncHeader.infoOffset();
     auto debugInfoStart = fileHeader->debugInfoOffset;
     fileSizes[i].push_back(debugInfoStart - funcInfoStart);
     fileSizes[i].push_back(fileHeader->fileLength - debugInfoStart);
@@ -300,6 +300,138 @@ void ProfileAnalyzer::dumpInstructionStats() {
   }
 }
 
+/// Visitor to count the sequences of consecutive instructions in a function, by
+/// opcode. Without a profile every sequence counts once; with a profile it
+/// counts as many times as the basic block of its first instruction executed.
+/// Sequences do not continue past instructions that may transfer control
+/// elsewhere, but they may continue into a jump target.
+class OpcodeSequenceVisitor : public hermes::hbc::BytecodeVisitor {
+ private:
+  // Maps <profile_index => execution_count>, or null to count statically.
+  std::unordered_map<uint16_t, uint64_t> *funcLogData_;
+  ProfileIndexMap *profileIndexMap_;
+  // State flag to record current basic block's profile_index.
+  uint16_t curProfileIndex_{0};
+  // Whether the current instruction may transfer control elsewhere.
+  bool endsSequence_{false};
+  unsigned maxLength_;
+  // The last instructions of the current sequence, and their weights.
+  llvh::SmallVector<std::pair<OpCode, uint64_t>, 4> window_{};
+  // Maps <opcode sequence => count>.
+  OpcodeSequenceMap &sequences_;
+
+ protected:
+  void beforeStart(unsigned funcId, const uint8_t *bytecodeStart) override {
+    window_.clear();
+  }
+
+  void preVisitInstruction(OpCode opcode, const uint8_t *ip, int length)
+      override {
+    endsSequence_ = opcode == OpCode::Ret || opcode == OpCode::Throw ||
+        opcode == OpCode::SwitchImm;
+    uint64_t weight = 1;
+    if (funcLogData_) {
+      auto it = profileIndexMap_->find(ip);
+      if (it != profileIndexMap_->end()) {
+        curProfileIndex_ = it->second;
+      }
+      weight = (*funcLogData_)[curProfileIndex_];
+    }
+    // Profile points are not part of the program.
+    if (opcode == OpCode::ProfilePoint)
+      return;
+
+    window_.push_back({opcode, weight});
+    if (window_.size() > maxLength_)
+      window_.erase(window_.begin());
+    for (size_t start = 0; start + 1 < window_.size(); ++start) {
+      std::vector<OpCode> sequence;
+      for (size_t i = start; i < window_.size(); ++i)
+        sequence.push_back(window_[i].first);
+      sequences_[std::move(sequence)] += window_[start].second;
+    }
+  }
+
+  void visitOperand(
+      const uint8_t *ip,
+      inst::OperandType operandType,
+      const uint8_t *operandBuf,
+      int operandIndex) override {
+    if (operandType == inst::OperandType::Addr8 ||
+        operandType == inst::OperandType::Addr32) {
+      endsSequence_ = true;
+    }
+  }
+
+  void postVisitInstruction(OpCode opcode, const uint8_t *ip, int length)
+      override {
+    if (endsSequence_)
+      window_.clear();
+  }
+
+ public:
+  OpcodeSequenceVisitor(
+      std::shared_ptr<hbc::BCProvider> bcProvider,
+      std::unordered_map<uint16_t, uint64_t> *funcLogData,
+      ProfileIndexMap *profileIndexMap,
+      unsigned maxLength,
+      OpcodeSequenceMap &sequences)
+      : BytecodeVisitor(bcProvider),
+        funcLogData_(funcLogData),
+        profileIndexMap_(profileIndexMap),
+        maxLength_(maxLength),
+        sequences_(sequences) {}
+};
+
+void ProfileAnalyzer::dumpOpcodeSequences(unsigned maxLength) {
+  OpcodeSequenceMap sequences;
+  if (profileDataOpt_.hasValue()) {
+    forEachTracedFunction(
+        [&sequences, maxLength](
+            std::shared_ptr<hbc::BCProvider> bcProvider,
+            std::unordered_map<uint16_t, uint64_t> &funcExecInfo,
+            ProfileIndexMap &profileIndexMap,
+            unsigned funcId) {
+          OpcodeSequenceVisitor visitor(
+              bcProvider, &funcExecInfo, &profileIndexMap, maxLength, sequences);
+          visitor.visitInstructionsInFunction(funcId);
+        });
+    reportUnmatchedChecksums();
+  } else {
+    std::shared_ptr<hbc::BCProvider> bcProvider = hbcParser_.getBCProvider();
+    for (uint32_t funcId = 0, e = bcProvider->getFunctionCount(); funcId < e;
+         ++funcId) {
+      // Lazy functions have no bytecode.
+      if (bcProvider->isFunctionLazy(funcId))
+        continue;
+      OpcodeSequenceVisitor visitor(
+          bcProvider, nullptr, nullptr, maxLength, sequences);
+      visitor.visitInstructionsInFunction(funcId);
+    }
+  }
+
+  // Sort the result by frequency in descending order, then by sequence, so
+  // that the output is deterministic.
+  std::vector<std::pair<std::vector<OpCode>, uint64_t>> sortedElements(
+      sequences.begin(), sequences.end());
+  std::stable_sort(
+      sortedElements.begin(),
+      sortedElements.end(),
+      [](const std::pair<std::vector<OpCode>, uint64_t> &x,
+         const std::pair<std::vector<OpCode>, uint64_t> &y) {
+        return x.second > y.second;
+      });
+
+  for (const auto &entry : sortedElements) {
+    const char *sep = "";
+    for (OpCode opcode : entry.first) {
+      os_ << sep << getOpCodeString(opcode);
+      sep = " ";
+    }
+    os_ << ": " << entry.second << "\n";
+  }
+}
+
 void ProfileAnalyzer::reportUnmatchedChecksums() {
   if (!this->unusedChecksumsInTrace_.empty()) {
     os_ << "WARNING: Cannot find matching checksum for the following profile entries: \n";
@@ -660,10 +792,15 @@ void ProfileAnalyzer::dumpIO() {
   os_ << executionInfo.size() << " functions accessed out of total "
       << funcCount << " functions\n";
 
-  uint32_t funcRegionStartOffset = bcProvider->getFunctionHeader(0).offset();
-  uint32_t funcRegionEndOffset =
-      bcProvider->getFunctionHeader(funcCount - 1).offset() +
-      bcProvider->getFunctionHeader(funcCount - 1).bytecodeSizeInBytes() - 1;
+  // Function bodies may be laid out in any order.
+  uint32_t funcRegionStartOffset = UINT32_MAX;
+  uint32_t funcRegionEndOffset = 0;
+  for (uint32_t i = 0; i < funcCount; ++i) {
+    auto header = bcProvider->getFunctionHeader(i);
+    funcRegionStartOffset = std::min(funcRegionStartOffset, header.offset());
+    funcRegionEndOffset = std::max(
+        funcRegionEndOffset, header.offset() + header.bytecodeSizeInBytes() - 1);
+  }
 
   uint32_t funcRegionStartPage = getPageIndexFromOffset(funcRegionStartOffset);
   uint32_t funcRegionEndPage = getPageIndexFromOffset(funcRegionEndOffset);
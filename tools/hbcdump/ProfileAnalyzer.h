@@ -14,9 +14,11 @@
 
 #include "llvh/Support/raw_ostream.h"
 
+#include <map>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace hermes {
 
@@ -24,6 +26,9 @@ namespace hermes {
 using ExecutionInfo =
     std::unordered_map<std::string, std::unordered_map<uint16_t, uint64_t>>;
 
+/// <opcode_sequence, count> map, ordered by sequence.
+using OpcodeSequenceMap = std::map<std::vector<inst::OpCode>, uint64_t>;
+
 /// Basic block profile trace data.
 struct ProfileData {
   // Profile version.
@@ -131,6 +136,9 @@ class ProfileAnalyzer {
 
   // Print each instruction's runtime statistics.
   void dumpInstructionStats();
+  // Print how often each sequence of 2 to \p maxLength consecutive
+  // instructions appears, or executes if there is a trace profile.
+  void dumpOpcodeSequences(unsigned maxLength);
   // Print top K basic blocks' runtime statistics.
   void dumpBasicBlockStats();
   // Print top K functions' runtime statistics.
@@ -140,6 +140,16 @@ static void printHelp(llvh::Optional<llvh::StringRef> command = llvh::None) {
        "and displays it in descending order.\n\n"
        "USAGE: instruction\n"
        "       inst\n"},
+      {"sequence",
+       "'sequence': Count how often each sequence of 2 or 3 consecutive "
+       "instructions appears in the bytecode, by opcode, and display them in "
+       "descending order. With a profile (-profile-file), count how often "
+       "they execute instead. Sequences do not continue past jumps, returns "
+       "and throws.\n"
+       "'sequence <MAX_LENGTH>': Count sequences of 2 to <MAX_LENGTH> "
+       "instructions.\n\n"
+       "USAGE: sequence [<MAX_LENGTH>]\n"
+       "       seq [<MAX_LENGTH>]\n"},
       {"disassemble",
        "'disassemble': Display bytecode disassembled output of whole binary.\n"
        "'disassemble <FUNC_ID>': Display bytecode disassembled output of function with id <FUNC_ID>.\n"
@@ -325,6 +335,15 @@ static bool executeCommand(
       printHelp(command);
       return false;
     }
+  } else if (command == "sequence" || command == "seq") {
+    unsigned maxLength = 3;
+    if (commandTokens.size() > 2 ||
+        (commandTokens.size() == 2 &&
+         (commandTokens[1].getAsInteger(0, maxLength) || maxLength < 2))) {
+      printHelp(command);
+      return false;
+    }
+    analyzer.dumpOpcodeSequences(maxLength);
   } else if (command == "disassemble" || command == "dis") {
     auto localOptions = findAndRemoveOne(commandTokens, "-offsets")
         ? DisassemblyOptions::IncludeVirtualOffsets
@@ -63,23 +63,26 @@ C_STRING((function() {
   function prettyPrintPromise(value, visited) {
     var internalColor = colors.cyan;
     var internals = "";
-    switch(value['_i']) {
+    // [state, result], where result is the value, the reason, or the adopted
+    // promise.
+    var state = HermesInternal.getPromiseState(value);
+    switch(state[0]) {
       case 0:
         internals = "<pending>";
         break;
       case 1:
         internals = "<fulfilled: " + colors.reset +
-            prettyPrintRec(value['_j'], visited) +
+            prettyPrintRec(state[1], visited) +
             internalColor + ">";
         break;
       case 2:
         internals = "<rejected: " + colors.reset +
-            prettyPrintRec(value['_j'], visited) +
+            prettyPrintRec(state[1], visited) +
             internalColor + ">";
         break;
       case 3:
         // the case of an "adopted" promise; print the adoptee promise instead.
-        return prettyPrintPromise(value['_j'], visited);
+        return prettyPrintPromise(state[1], visited);
       default:
         break;
     };
@@ -87,13 +90,8 @@ C_STRING((function() {
 
     var elements = [];
     var propNames = Object.getOwnPropertyNames(value);
-    var internalNames = ['_h', '_i', '_j', '_k'];
     for (var i = 0; i < propNames.length; ++i) {
-      var prop = propNames[i];
-      // hide internal properties.
-      if (!internalNames.includes(prop)) {
-        elements.push(prettyPrintProp(value, prop, visited));
-      }
+      elements.push(prettyPrintProp(value, propNames[i], visited));
     }
     var elementString =
         elements.length === 0 ? "" : " { " + elements.join(', ') +  " }";
@@ -86,6 +86,9 @@ static int executeHBCBytecodeFromCL(
                             .withInitHeapSize(cl::InitHeapSize.bytes)
                             .withMaxHeapSize(cl::MaxHeapSize.bytes)
                             .withOccupancyTarget(cl::OccupancyTarget)
+                            .withNumMarkThreads(cl::GCMarkThreads)
+                            .withNumEvacuationThreads(cl::GCEvacuationThreads)
+                            .withPretenure(cl::GCPretenure)
                             .withSanitizeConfig(
                                 vm::GCSanitizeConfig::Builder()
                                     .withSanitizeRate(cl::GCSanitizeRate)
@@ -123,7 +126,12 @@ static int executeHBCBytecodeFromCL(
   options.stopAfterInit = cl::StopAfterInit;
   options.forceGCBeforeStats = cl::GCBeforeStats;
   options.sampleProfiling = cl::SampleProfiling;
+  options.sampleProfilingCounters = cl::SampleProfilingCounters;
   options.heapTimeline = cl::HeapTimeline;
+  options.heapSamplingSites = cl::HeapSamplingSites;
+  options.heapSamplingInterval = cl::HeapSamplingInterval;
+  options.functionOrderProfile = cl::RecordFunctionOrder;
+  options.interpreterProfile = cl::ProfileInterpreter;
 
   bool success;
   if (cl::Repeat <= 1) {
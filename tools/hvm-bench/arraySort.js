@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Sorts random, sorted and nearly sorted arrays of 1e5 to 1e6 elements, with
+// the default order and with a compare function, as well as typed arrays.
+(function() {
+  var seed = 42;
+  function random() {
+    // Deterministic LCG, so that runs are comparable.
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed;
+  }
+
+  function makeRandom(len) {
+    var a = Array(len);
+    for (var i = 0; i < len; i++) {
+      a[i] = random() % len;
+    }
+    return a;
+  }
+
+  function makeSorted(len) {
+    var a = Array(len);
+    for (var i = 0; i < len; i++) {
+      a[i] = i;
+    }
+    return a;
+  }
+
+  function makeNearlySorted(len) {
+    var a = makeSorted(len);
+    for (var i = 0; i < len / 100; i++) {
+      var x = random() % len;
+      var y = random() % len;
+      var t = a[x];
+      a[x] = a[y];
+      a[y] = t;
+    }
+    return a;
+  }
+
+  function numeric(x, y) {
+    return x - y;
+  }
+
+  var checksum = 0;
+  function run(name, a, compareFn) {
+    var start = Date.now();
+    if (compareFn) {
+      a.sort(compareFn);
+    } else {
+      a.sort();
+    }
+    checksum = (checksum + a[0] + a[a.length >> 1]) | 0;
+    print(name + ': ' + (Date.now() - start) + ' ms');
+  }
+
+  var lengths = [100000, 1000000];
+  for (var i = 0; i < lengths.length; i++) {
+    var len = lengths[i];
+    run('random ' + len, makeRandom(len));
+    run('random cmp ' + len, makeRandom(len), numeric);
+    run('sorted ' + len, makeSorted(len));
+    run('sorted cmp ' + len, makeSorted(len), numeric);
+    run('nearly sorted ' + len, makeNearlySorted(len));
+    run('nearly sorted cmp ' + len, makeNearlySorted(len), numeric);
+    run('Float64Array random ' + len, new Float64Array(makeRandom(len)));
+    run(
+      'Float64Array random cmp ' + len,
+      new Float64Array(makeRandom(len)),
+      numeric,
+    );
+    run('Int32Array nearly sorted ' + len, new Int32Array(makeNearlySorted(len)));
+  }
+
+  print('done ' + checksum);
+})();
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Parses a large JSON array of records that all have the same keys.
+(function() {
+  var numRecords = 20000;
+  var numIter = 10;
+
+  var records = [];
+  for (var i = 0; i < numRecords; i++) {
+    records.push({
+      id: i,
+      name: 'user' + i,
+      email: 'user' + i + '@example.com',
+      active: i % 3 === 0,
+      score: i * 1.5,
+      tags: ['a', 'b'],
+      address: {street: i + ' Main St', city: 'City' + (i % 100), zip: i},
+    });
+  }
+  var text = JSON.stringify(records);
+
+  var sum = 0;
+  for (var k = 0; k < numIter; k++) {
+    var parsed = JSON.parse(text);
+    for (var i = 0; i < parsed.length; i += 1000) {
+      sum += parsed[i].id + parsed[i].address.zip;
+    }
+  }
+
+  print('done ' + sum);
+})();
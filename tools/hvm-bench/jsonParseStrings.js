@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Parses an indented JSON document made mostly of long strings.
+(function() {
+  var numItems = 5000;
+  var numIter = 10;
+
+  var text = '';
+  for (var i = 0; i < 20; i++) text += 'lorem ipsum dolor sit amet ';
+  var items = [];
+  for (var i = 0; i < numItems; i++) {
+    items.push({
+      title: 'Item ' + i + ': ' + text.slice(0, 40),
+      body: text + i,
+      url: 'https://example.com/items/' + i + '/details?ref=feed',
+    });
+  }
+  var doc = JSON.stringify({items: items}, null, 4);
+
+  var len = 0;
+  for (var k = 0; k < numIter; k++) {
+    var parsed = JSON.parse(doc);
+    len += parsed.items[k].body.length;
+  }
+
+  print('done ' + len);
+})();
@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Serializes an array of records that all have the same keys.
+(function() {
+  var numRecords = 20000;
+  var numIter = 10;
+
+  var records = [];
+  for (var i = 0; i < numRecords; i++) {
+    records.push({
+      id: i,
+      name: 'user' + i,
+      email: 'user' + i + '@example.com',
+      active: i % 3 === 0,
+      score: i * 1.5,
+      tags: ['a', 'b'],
+      address: {street: i + ' Main St', city: 'City' + (i % 100), zip: i},
+    });
+  }
+
+  var len = 0;
+  for (var k = 0; k < numIter; k++) {
+    len += JSON.stringify(records).length;
+  }
+
+  print('done ' + len);
+})();
@@ -0,0 +1,32 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Fills a large Map and Set, then looks up every key repeatedly.
+(function() {
+  var numEntries = 200000;
+  var numIter = 5;
+  var m = new Map();
+  var s = new Set();
+
+  for (var i = 0; i < numEntries; i++) {
+    m.set(i * 7, i);
+    s.add('k' + i);
+  }
+
+  var sum = 0;
+  var found = 0;
+  for (var k = 0; k < numIter; k++) {
+    for (var i = 0; i < numEntries; i++) {
+      sum += m.get(i * 7);
+      if (s.has('k' + i)) found++;
+    }
+  }
+
+  print('done ' + sum + ' ' + found);
+})();
@@ -0,0 +1,25 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Converts a small working set of non-integer numbers to strings and back,
+// and uses them as property keys.
+(function() {
+  var numIter = 300000;
+  var obj = {};
+  var count = 0;
+
+  for (var i = 0; i < numIter; i++) {
+    var n = (i % 64) / 4 - 8;
+    var s = '' + n;
+    count += s.length + +s;
+    obj[n] = i;
+  }
+
+  print('done ' + count + ' ' + Object.keys(obj).length);
+})();
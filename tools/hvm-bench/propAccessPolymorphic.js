@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// This benchmark tests property reads and writes at sites that observe four
+// different object shapes, which should all be serviced by the polymorphic
+// inline cache. Run with a HERMESVM_PROFILER_BB build and
+// -basic-block-profiling to see the per-site hit rate.
+function access8Times(o) {
+    var sum = 0;
+    sum += o.x;
+    sum += o.y;
+    sum += o.x;
+    sum += o.y;
+    o.x = sum & 0xff;
+    sum += o.x;
+    sum += o.y;
+    sum += o.x;
+    sum += o.y;
+    return sum;
+}
+
+function access8NTimes(n) {
+    var shapes = [
+        {x: 1, y: 2},
+        {y: 2, x: 1},
+        {a: 0, x: 1, y: 2},
+        {a: 0, b: 0, y: 2, x: 1},
+    ];
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum += access8Times(shapes[i & 3]);
+    }
+    return sum;
+}
+
+print(access8NTimes(10000000));
@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Searches a multi-KB string with regexes whose matches start with a literal
+// prefix or with one of a few characters, through exec, test and replace.
+(function() {
+  var line = '2024-01-01T00:00:00Z INFO request handled path=/api/v1/items ';
+  var log = line.repeat(100) + 'ERROR code=504 upstream timed out\n';
+  var numIter = 5000;
+  var count = 0;
+
+  for (var i = 0; i < numIter; i++) {
+    count += /ERROR code=(\d+)/.exec(log)[1].length;
+    if (/(?:WARN|ERROR) /.test(log)) {
+      count++;
+    }
+    count += /[#@]\w+/.test(log) ? 1 : 0;
+  }
+
+  for (var i = 0; i < numIter / 10; i++) {
+    count += log.replace(/upstream/g, 'backend').length;
+  }
+
+  print('done ' + count);
+})();
@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Builds long strings by prepending, by template literals and by slicing.
+(function() {
+  var numIter = 200;
+  var numParts = 2000;
+
+  var len = 0;
+  for (var k = 0; k < numIter; k++) {
+    var s = '';
+    for (var i = 0; i < numParts; i++) {
+      s = 'part' + i + ',' + s;
+    }
+    var t = `<div>${s}</div>${s}`;
+    for (var j = 0; j < 100; j++) {
+      len += t.slice(j, t.length - j).length;
+    }
+    len += t.charCodeAt(t.length >> 1);
+  }
+
+  print('done ' + len);
+})();
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ *
+ * @format
+ */
+
+// Searches multi-KB ASCII and UTF-16 strings for single characters, short
+// needles and long needles, through indexOf, includes, split and replace.
+(function() {
+  var line = '2024-01-01T00:00:00Z INFO request handled path=/api/v1/items ';
+  var log = line.repeat(100) + 'ERROR timeout while waiting for upstream\n';
+  var log16 = log.replace('INFO', 'INFO ✓');
+  var longNeedle = 'ERROR timeout while waiting for upstream';
+  var numIter = 20000;
+  var count = 0;
+
+  for (var i = 0; i < numIter; i++) {
+    count += log.indexOf('\n');
+    count += log.indexOf('ERROR');
+    count += log.indexOf(longNeedle);
+    count += log16.indexOf('ERROR');
+    count += log16.indexOf(longNeedle);
+    count += log.lastIndexOf('request');
+    if (log.includes('upstream')) {
+      count++;
+    }
+  }
+
+  for (var i = 0; i < numIter / 10; i++) {
+    count += log.split('path=').length;
+    count += log.replace('timeout', 'deadline').length;
+  }
+
+  print('done ' + count);
+})();
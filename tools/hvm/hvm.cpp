@@ -150,6 +150,8 @@ int main(int argc, char **argv) {
           .build();
 
   options.stopAfterInit = cl::StopAfterInit;
+  options.functionOrderProfile = cl::RecordFunctionOrder;
+  options.interpreterProfile = cl::ProfileInterpreter;
 
   bool success;
   if (Repeat <= 1) {
@@ -236,6 +236,7 @@ int main(int argc, char **argv) {
     }
     options.forceGCBeforeStats = cl::GCBeforeStats;
     options.disableSourceHashCheck = cl::DisableSourceHashCheck;
+    options.interpreterProfile = cl::ProfileInterpreter;
 
     // These are the config parameters.
 
@@ -10,6 +10,8 @@
 #include "gtest/gtest.h"
 
 #include <deque>
+#include <thread>
+#include <utility>
 
 namespace {
 
@@ -137,4 +139,54 @@ TYPED_TEST(BitArrayTest, PrevZeroBit) {
   }
 }
 
+TYPED_TEST(BitArrayTest, SetRange) {
+  constexpr size_t N = TypeParam::value;
+  BitArray<N> ba;
+  // Ranges within one word, across word boundaries, and at the ends.
+  const std::pair<size_t, size_t> ranges[] = {
+      {0, 1}, {3, 60}, {63, 65}, {100, 1100}, {N - 70, N}, {500, 500}};
+  for (auto range : ranges) {
+    ba.reset();
+    ba.set(range.first, range.second, true);
+    for (size_t idx = 0; idx < N; ++idx)
+      EXPECT_EQ(range.first <= idx && idx < range.second, ba.at(idx));
+
+    ba.set();
+    ba.set(range.first, range.second, false);
+    for (size_t idx = 0; idx < N; ++idx)
+      EXPECT_EQ(range.first <= idx && idx < range.second, !ba.at(idx));
+  }
+}
+
+TYPED_TEST(BitArrayTest, TestAndSetAtomic) {
+  constexpr size_t N = TypeParam::value;
+  BitArray<N> ba;
+  ba.reset();
+  auto testIndices = this->getTestIndices();
+  for (size_t idx : testIndices.front()) {
+    EXPECT_TRUE(ba.testAndSetAtomic(idx));
+    EXPECT_TRUE(ba.at(idx));
+    EXPECT_FALSE(ba.testAndSetAtomic(idx));
+  }
+
+  // Threads setting interleaved bits of the same words do not lose each
+  // other's updates, and each bit is reported as newly set exactly once.
+  ba.reset();
+  constexpr size_t kNumThreads = 4;
+  size_t numSet[kNumThreads] = {};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&ba, &numSet, t] {
+      for (size_t idx = 0; idx < N; ++idx) {
+        if (idx % 2 == t % 2 && ba.testAndSetAtomic(idx))
+          ++numSet[t];
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+  EXPECT_EQ(N, numSet[0] + numSet[1] + numSet[2] + numSet[3]);
+  EXPECT_EQ(N, ba.findNextZeroBitFrom(0));
+}
+
 } // namespace
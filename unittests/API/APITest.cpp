@@ -111,6 +111,29 @@ TEST_P(HermesRuntimeTest, DescriptionTest) {
   EXPECT_NE(rt2->description().find("Hermes"), std::string::npos);
 }
 
+TEST_P(HermesRuntimeTest, CreateValueFromJsonUtf8Test) {
+  // ASCII text is scanned in place, other text is converted to UTF16.
+  const char ascii[] = R"({"a": [1, "two", {"b": null}], "c": "d\u00e9"})";
+  auto v = rt->createValueFromJsonUtf8(
+      reinterpret_cast<const uint8_t *>(ascii), sizeof(ascii) - 1);
+  auto obj = v.getObject(*rt);
+  EXPECT_EQ(
+      obj.getPropertyAsObject(*rt, "a")
+          .getArray(*rt)
+          .getValueAtIndex(*rt, 1)
+          .getString(*rt)
+          .utf8(*rt),
+      "two");
+  EXPECT_EQ(obj.getProperty(*rt, "c").getString(*rt).utf8(*rt), "d\xc3\xa9");
+
+  const char utf8[] = "{\"k\xc3\xa9y\": \"\xe4\xb8\xad\\n\"}";
+  v = rt->createValueFromJsonUtf8(
+      reinterpret_cast<const uint8_t *>(utf8), sizeof(utf8) - 1);
+  EXPECT_EQ(
+      v.getObject(*rt).getProperty(*rt, "k\xc3\xa9y").getString(*rt).utf8(*rt),
+      "\xe4\xb8\xad\n");
+}
+
 TEST_P(HermesRuntimeTest, ArrayBufferTest) {
   eval(
       "var buffer = new ArrayBuffer(16);\
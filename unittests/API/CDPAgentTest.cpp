@@ -3720,6 +3720,15 @@ TEST_F(CDPAgentTest, HeapProfilerSampling) {
     )");
   waitForScheduledScripts();
 
+  // Get the profile without stopping.
+  {
+    sendRequest("HeapProfiler.getSamplingProfile", msgId);
+    auto resp = expectResponse(std::nullopt, msgId++);
+    EXPECT_NE(
+        jsonScope_.getArray(resp, {"result", "profile", "samples"})->size(),
+        0);
+  }
+
   // Stop sampling
   sendRequest("HeapProfiler.stopSampling", msgId);
   auto resp = expectResponse(std::nullopt, msgId++);
@@ -3732,6 +3741,8 @@ TEST_F(CDPAgentTest, HeapProfilerSampling) {
   sendRequest("HeapProfiler.startSampling", msgId);
   expectErrorMessageContaining(kMemoryInstrumentationSubstring, msgId++);
   sendRequest("HeapProfiler.stopSampling", msgId);
+  expectErrorMessageContaining(kMemoryInstrumentationSubstring, msgId++);
+  sendRequest("HeapProfiler.getSamplingProfile", msgId);
   expectErrorMessageContaining(kMemoryInstrumentationSubstring, msgId);
 #endif // HERMES_MEMORY_INSTRUMENTATION
 }
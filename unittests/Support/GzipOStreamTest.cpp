@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "hermes/Support/GzipOStream.h"
+
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "zip/src/miniz.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+using namespace hermes;
+
+/// Compress \p input in writes of \p writeSize bytes, check the gzip header
+/// and trailer, and \return the inflated contents.
+std::string roundTrip(const std::string &input, size_t writeSize) {
+  std::string compressed;
+  {
+    llvh::raw_string_ostream os{compressed};
+    GzipOStream gzip{os};
+    for (size_t i = 0; i < input.size(); i += writeSize)
+      gzip << llvh::StringRef{input}.substr(i, writeSize);
+  }
+  // Header (10 bytes) and trailer (8 bytes).
+  EXPECT_GE(compressed.size(), 18u);
+  EXPECT_EQ('\x1f', compressed[0]);
+  EXPECT_EQ('\x8b', compressed[1]);
+  uint32_t crc = 0, size = 0;
+  for (unsigned i = 0; i < 4; ++i) {
+    crc |= (uint32_t)(uint8_t)compressed[compressed.size() - 8 + i] << (8 * i);
+    size |= (uint32_t)(uint8_t)compressed[compressed.size() - 4 + i]
+        << (8 * i);
+  }
+  auto *data = (const unsigned char *)input.data();
+  EXPECT_EQ(mz_crc32(MZ_CRC32_INIT, data, input.size()), crc);
+  EXPECT_EQ(input.size(), size);
+
+  size_t outLen = 0;
+  void *out = tinfl_decompress_mem_to_heap(
+      compressed.data() + 10, compressed.size() - 18, &outLen, 0);
+  std::string result{(const char *)out, outLen};
+  free(out);
+  return result;
+}
+
+TEST(GzipOStreamTest, Empty) {
+  EXPECT_EQ("", roundTrip("", 1));
+}
+
+TEST(GzipOStreamTest, Small) {
+  EXPECT_EQ("hello, world", roundTrip("hello, world", 5));
+}
+
+TEST(GzipOStreamTest, LargerThanBuffers) {
+  std::string input;
+  for (unsigned i = 0; input.size() < 4 * GzipOStream::kBufferSize; ++i)
+    input += "node " + std::to_string(i * 7919 % 100003) + ",";
+  EXPECT_EQ(input, roundTrip(input, 1000));
+  EXPECT_EQ(input, roundTrip(input, input.size()));
+}
+
+} // namespace
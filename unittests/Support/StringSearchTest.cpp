@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringSearch.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace hermes;
+
+namespace {
+
+/// Reference implementation of stringSearch() with std::search.
+template <typename T>
+size_t naiveSearch(
+    const std::basic_string<T> &hay,
+    const std::basic_string<T> &needle,
+    size_t from) {
+  if (from > hay.size())
+    return kStringSearchNotFound;
+  auto it =
+      std::search(hay.begin() + from, hay.end(), needle.begin(), needle.end());
+  if (it == hay.end() && !needle.empty())
+    return kStringSearchNotFound;
+  return it - hay.begin();
+}
+
+/// Reference implementation of stringSearchLast().
+template <typename T>
+size_t naiveSearchLast(
+    const std::basic_string<T> &hay,
+    const std::basic_string<T> &needle,
+    size_t maxStart) {
+  if (needle.size() > hay.size())
+    return kStringSearchNotFound;
+  for (size_t i = std::min(maxStart, hay.size() - needle.size()) + 1;
+       i-- != 0;) {
+    if (hay.compare(i, needle.size(), needle) == 0)
+      return i;
+  }
+  return kStringSearchNotFound;
+}
+
+/// Reference implementation of stringSearchAnyOf().
+template <typename T>
+size_t naiveSearchAnyOf(
+    const std::basic_string<T> &hay,
+    const std::basic_string<T> &codeUnits,
+    size_t from) {
+  if (from >= hay.size())
+    return kStringSearchNotFound;
+  size_t pos = hay.find_first_of(codeUnits, from);
+  return pos == std::basic_string<T>::npos ? kStringSearchNotFound : pos;
+}
+
+template <typename T>
+llvh::ArrayRef<T> toRef(const std::basic_string<T> &s) {
+  return {s.data(), s.size()};
+}
+
+TEST(StringSearchTest, Basic) {
+  std::string hay = "the quick brown fox jumps over the lazy dog";
+  EXPECT_EQ(0u, stringSearch(toRef(hay), toRef(std::string("the"))));
+  EXPECT_EQ(31u, stringSearch(toRef(hay), toRef(std::string("the")), 1));
+  EXPECT_EQ(4u, stringSearch(toRef(hay), toRef(std::string("q"))));
+  EXPECT_EQ(40u, stringSearch(toRef(hay), toRef(std::string("dog"))));
+  EXPECT_EQ(
+      kStringSearchNotFound,
+      stringSearch(toRef(hay), toRef(std::string("cat"))));
+  EXPECT_EQ(5u, stringSearch(toRef(hay), toRef(std::string()), 5));
+  EXPECT_EQ(
+      hay.size(), stringSearch(toRef(hay), toRef(std::string()), hay.size()));
+  EXPECT_EQ(
+      kStringSearchNotFound,
+      stringSearch(toRef(hay), toRef(std::string()), hay.size() + 1));
+
+  EXPECT_EQ(31u, stringSearchLast(toRef(hay), toRef(std::string("the"))));
+  EXPECT_EQ(0u, stringSearchLast(toRef(hay), toRef(std::string("the")), 30));
+  EXPECT_EQ(hay.size(), stringSearchLast(toRef(hay), toRef(std::string())));
+  EXPECT_EQ(3u, stringSearchLast(toRef(hay), toRef(std::string()), 3));
+
+  std::u16string hay16 = u"été 世界 世界!";
+  EXPECT_EQ(4u, stringSearch(toRef(hay16), toRef(std::u16string(u"世界"))));
+  EXPECT_EQ(
+      7u, stringSearchLast(toRef(hay16), toRef(std::u16string(u"世界"))));
+  EXPECT_EQ(2u, stringSearch(toRef(hay16), toRef(std::u16string(u"é")), 1));
+
+  EXPECT_EQ(2u, stringSearchAnyOf(toRef(hay), toRef(std::string("xe"))));
+  EXPECT_EQ(16u, stringSearchAnyOf(toRef(hay), toRef(std::string("xf"))));
+  EXPECT_EQ(
+      kStringSearchNotFound,
+      stringSearchAnyOf(toRef(hay), toRef(std::string("XYZ"))));
+  EXPECT_EQ(
+      kStringSearchNotFound,
+      stringSearchAnyOf(toRef(hay), toRef(std::string())));
+  EXPECT_EQ(
+      4u, stringSearchAnyOf(toRef(hay16), toRef(std::u16string(u"界世"))));
+}
+
+/// Compare against the reference implementation on random strings over small
+/// alphabets, so that there are many partial matches, with needles of every
+/// length handled by a different algorithm.
+template <typename T>
+void randomTest(unsigned alphabet) {
+  std::mt19937 rng(alphabet);
+  for (unsigned iter = 0; iter < 300; ++iter) {
+    std::basic_string<T> hay(rng() % 300, 0);
+    for (auto &c : hay)
+      c = (T)(0x61 + (rng() % alphabet) * 0x101);
+    size_t m = rng() % 50;
+    std::basic_string<T> needle;
+    if (m <= hay.size() && rng() % 2) {
+      // Take the needle from the haystack, so that it is found.
+      needle = hay.substr(rng() % (hay.size() - m + 1), m);
+    } else {
+      needle.resize(m);
+      for (auto &c : needle)
+        c = (T)(0x61 + (rng() % alphabet) * 0x101);
+    }
+    size_t from = rng() % (hay.size() + 2);
+    EXPECT_EQ(
+        naiveSearch(hay, needle, from),
+        stringSearch(toRef(hay), toRef(needle), from));
+    EXPECT_EQ(
+        naiveSearchLast(hay, needle, from),
+        stringSearchLast(toRef(hay), toRef(needle), from));
+    // Use a prefix of the needle as a set of code units, so that sets of every
+    // size are searched.
+    std::basic_string<T> codeUnits = needle.substr(0, rng() % 7);
+    EXPECT_EQ(
+        naiveSearchAnyOf(hay, codeUnits, from),
+        stringSearchAnyOf(toRef(hay), toRef(codeUnits), from));
+  }
+}
+
+TEST(StringSearchTest, RandomChar) {
+  randomTest<char>(2);
+  randomTest<char>(4);
+}
+
+TEST(StringSearchTest, RandomChar16) {
+  randomTest<char16_t>(2);
+  randomTest<char16_t>(4);
+}
+
+} // end anonymous namespace
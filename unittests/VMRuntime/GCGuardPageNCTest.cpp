@@ -28,8 +28,9 @@ TEST(GCGuardPageNCTest, ObjectUnderflow) {
     DummyRuntime &rt = *runtime;
 
     // Allocate the first cell in the segment and try to write directly before
-    // it.
-    auto *cell = EmptyCell<256>::createLongLived(rt);
+    // it. The cell is too large to be allocated from a long-lived buffer, which
+    // would place it after the FillerCell that covers the buffer.
+    auto *cell = EmptyCell<4096>::createLongLived(rt);
     char *raw = reinterpret_cast<char *>(cell);
     raw[-1] = '\0';
   };
@@ -971,7 +971,7 @@ TEST_F(JSLibTest, SmallSortTest) {
        "seven",
        "eight",
        "nine"});
-  ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&sbl, 0, sbl.v.size()));
+  ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&sbl, 0, sbl.v.size()));
   std::vector<std::string> expected = {
       "one",
       "two",
@@ -991,7 +991,7 @@ TEST_F(JSLibTest, SmallSortTest) {
     vs[i] = std::string(i, 'x');
   do {
     StringByLength sm(vs);
-    ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&sm, 0, vs.size()));
+    ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&sm, 0, vs.size()));
     for (unsigned i = 0; i < vs.size(); ++i)
       EXPECT_EQ(i, sm.v[i].size());
   } while (std::next_permutation(vs.begin(), vs.end()));
@@ -1020,7 +1020,7 @@ TEST_F(JSLibTest, HugeSortTest) {
   for (uint64_t i = 0; i < size; ++i)
     v[i] |= i;
   Uint64ByHigh32 ubh(v);
-  ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&ubh, 0, ubh.v.size()));
+  ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&ubh, 0, ubh.v.size()));
   for (uint64_t i = 0; i < size; ++i) {
     auto cur = ubh.v[i];
     EXPECT_EQ(i / 10, cur >> 32);
@@ -1044,7 +1044,7 @@ TEST_F(JSLibTest, HugeSortTest) {
     }
   };
   RandomLess rl;
-  ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&rl, 0, 1000 * 1000));
+  ASSERT_EQ(ExecutionStatus::RETURNED, timSort(&rl, 0, 1000 * 1000));
 }
 
 class JSLibMockedEnvironmentTest : public RuntimeTestFixtureBase {
@@ -201,6 +201,90 @@ foo();
   }
 }
 
+TEST_F(SamplingHeapProfilerTest, Sites) {
+  runtime.enableSamplingHeapProfiler(1 << 10, /*seed*/ 10);
+
+  std::string source = R"(
+function keep() {
+  return new Object();
+}
+function drop() {
+  return new Object();
+}
+function foo() {
+  var arr = [];
+  for (var i = 0; i < 5000; i++) {
+    arr[i] = keep();
+    drop();
+  }
+  return arr;
+}
+foo();
+  )";
+  hbc::CompileFlags flags;
+  CallResult<HermesValue> res = runtime.run(source, "file:///fake.js", flags);
+  ASSERT_FALSE(isException(res));
+  auto arrayToHold = runtime.makeHandle<JSArray>(*res);
+  ASSERT_EQ(JSArray::getLength(*arrayToHold, runtime), 5000);
+  runtime.collect("test");
+
+  std::string result;
+  llvh::raw_string_ostream str(result);
+  runtime.getHeap().writeSamplingHeapProfileSites(str);
+  runtime.disableSamplingHeapProfiler(llvh::nulls());
+  str.flush();
+
+  llvh::SmallVector<llvh::StringRef, 8> lines;
+  llvh::StringRef(result).split(lines, '\n', -1, false);
+  ASSERT_GE(lines.size(), 2u);
+  EXPECT_EQ(lines[0], "# Sampling interval: 1024 bytes");
+  EXPECT_TRUE(lines[1].startswith("# live_bytes\t"));
+
+  // Columns: live bytes, live count, freed bytes, freed count, and their
+  // estimates, followed by the stack, from the outermost frame.
+  uint64_t keptLive = 0, keptLiveBytes = 0, keptEstimate = 0;
+  uint64_t droppedLive = 0, droppedFreed = 0, droppedFreedBytes = 0,
+           droppedEstimate = 0;
+  llvh::StringRef prevStack;
+  for (llvh::StringRef line : llvh::makeArrayRef(lines).drop_front(2)) {
+    llvh::SmallVector<llvh::StringRef, 7> columns;
+    line.split(columns, '\t');
+    ASSERT_EQ(columns.size(), 7u) << line.str();
+    llvh::StringRef stack = columns[6];
+    EXPECT_LT(prevStack, stack) << "Sites should be sorted by stack";
+    prevStack = stack;
+    EXPECT_TRUE(stack.startswith("global file:///fake.js:")) << stack.str();
+    uint64_t values[6];
+    for (unsigned i = 0; i < 6; ++i)
+      ASSERT_FALSE(columns[i].getAsInteger(10, values[i])) << line.str();
+    if (stack.endswith(";keep file:///fake.js:3:20")) {
+      keptLive += values[1];
+      keptLiveBytes += values[0];
+      keptEstimate += values[4];
+    }
+    if (stack.endswith(";drop file:///fake.js:6:20")) {
+      droppedLive += values[1];
+      droppedFreed += values[3];
+      droppedFreedBytes += values[2];
+      droppedEstimate += values[5];
+    }
+  }
+  ASSERT_NE(keptLive, 0u);
+  // The dropped objects are all unreachable after the full collection.
+  EXPECT_EQ(droppedLive, 0u);
+  ASSERT_NE(droppedFreed, 0u);
+
+  // Each site allocated 5000 objects of the same size, about 200 samples'
+  // worth at this interval, so the estimates should be within a few standard
+  // deviations (~7% each) of the actual totals.
+  auto expectNear = [](uint64_t estimate, uint64_t actual) {
+    EXPECT_GE(estimate, actual * 3 / 4) << "actual: " << actual;
+    EXPECT_LE(estimate, actual * 5 / 4) << "actual: " << actual;
+  };
+  expectNear(keptEstimate, 5000 * (keptLiveBytes / keptLive));
+  expectNear(droppedEstimate, 5000 * (droppedFreedBytes / droppedFreed));
+}
+
 #endif
 
 } // namespace
@@ -10,12 +10,17 @@
 #if HERMESVM_SAMPLING_PROFILER_AVAILABLE
 
 #include "TestHelpers1.h"
+#include "hermes/Parser/JSONParser.h"
+#include "hermes/Support/SourceErrorManager.h"
 #include "hermes/VM/Runtime.h"
 
+#include "llvh/Support/raw_ostream.h"
+
 #include <gtest/gtest.h>
 
 namespace {
 using namespace hermes::vm;
+using namespace hermes::parser;
 
 static constexpr bool withSamplingProfilerEnabled = true;
 static constexpr bool withSamplingProfilerDisabled = false;
@@ -86,6 +91,88 @@ TEST(SamplingProfilerTest, RegisterIdenticalThread) {
   EXPECT_TRUE(rt->samplingProfiler->belongsToCurrentThread());
 }
 
+/// Gives the tests access to the samples of a profiler, so that they can add
+/// samples with known contents.
+struct SampleInjector : SamplingProfiler {
+  static std::vector<StackTrace> &samples(SamplingProfiler &profiler) {
+    return profiler.*(&SampleInjector::sampledStacks_);
+  }
+};
+
+TEST(SamplingProfilerTest, ChromeTraceCounters) {
+  using Counters = HardwareCounters::Values;
+  auto rt = makeRuntime(withSamplingProfilerEnabled);
+  SamplingProfiler &profiler = *rt->samplingProfiler;
+
+  // Three samples of the same frame: two read the cycles and instructions
+  // counters, the last one read nothing.
+  const std::string frameName = "frame";
+  SamplingProfiler::StackFrame frame;
+  frame.kind = SamplingProfiler::StackFrame::FrameKind::SuspendFrame;
+  frame.suspendFrame = &frameName;
+  std::vector<SamplingProfiler::StackFrame> stack{frame};
+  Counters first = HardwareCounters::noValues();
+  first[HardwareCounters::Cycles] = 1000;
+  first[HardwareCounters::Instructions] = 300;
+  Counters second = HardwareCounters::noValues();
+  second[HardwareCounters::Cycles] = 500;
+  second[HardwareCounters::Instructions] = 200;
+  auto now = std::chrono::steady_clock::now();
+  for (const Counters &counters :
+       {first, second, HardwareCounters::noValues()}) {
+    SampleInjector::samples(profiler).emplace_back(
+        1, now, stack.begin(), stack.end(), counters);
+  }
+
+  std::string trace;
+  llvh::raw_string_ostream os(trace);
+  profiler.dumpChromeTrace(os);
+  os.flush();
+
+  JSLexer::Allocator alloc;
+  JSONFactory factory(alloc);
+  hermes::SourceErrorManager sm;
+  JSONParser parser(factory, trace, sm);
+  auto parsed = parser.parse();
+  ASSERT_TRUE(parsed.hasValue()) << trace;
+  const auto *root = llvh::cast<JSONObject>(parsed.getValue());
+
+  // Every sample carries the counters it read in "args", and only those.
+  const auto *samples = llvh::cast<JSONArray>(root->at("samples"));
+  ASSERT_EQ(3u, samples->size());
+  auto counterOf = [](const JSONValue *dict, const char *name) {
+    return llvh::cast<JSONNumber>(llvh::cast<JSONObject>(dict)->at(name))
+        ->getValue();
+  };
+  const auto *sample0 = llvh::cast<JSONObject>(samples->at(0));
+  const auto *sample1 = llvh::cast<JSONObject>(samples->at(1));
+  const auto *sample2 = llvh::cast<JSONObject>(samples->at(2));
+  const char *cycles = HardwareCounters::getName(HardwareCounters::Cycles);
+  const char *instructions =
+      HardwareCounters::getName(HardwareCounters::Instructions);
+  ASSERT_EQ(1u, sample0->count("args"));
+  EXPECT_EQ(2u, llvh::cast<JSONObject>(sample0->at("args"))->size());
+  EXPECT_EQ(1000, counterOf(sample0->at("args"), cycles));
+  EXPECT_EQ(300, counterOf(sample0->at("args"), instructions));
+  ASSERT_EQ(1u, sample1->count("args"));
+  EXPECT_EQ(500, counterOf(sample1->at("args"), cycles));
+  EXPECT_EQ(200, counterOf(sample1->at("args"), instructions));
+  EXPECT_EQ(0u, sample2->count("args"));
+
+  // The frame sums the counters of its samples in "counters"; the root has
+  // none.
+  const auto *stackFrames = llvh::cast<JSONObject>(root->at("stackFrames"));
+  ASSERT_EQ(2u, stackFrames->size());
+  const auto *rootFrame = llvh::cast<JSONObject>(stackFrames->at("1"));
+  EXPECT_EQ(0u, rootFrame->count("counters"));
+  const auto *leafFrame = llvh::cast<JSONObject>(stackFrames->at("2"));
+  EXPECT_EQ("[frame]", llvh::cast<JSONString>(leafFrame->at("name"))->str());
+  ASSERT_EQ(1u, leafFrame->count("counters"));
+  EXPECT_EQ(2u, llvh::cast<JSONObject>(leafFrame->at("counters"))->size());
+  EXPECT_EQ(1500, counterOf(leafFrame->at("counters"), cycles));
+  EXPECT_EQ(500, counterOf(leafFrame->at("counters"), instructions));
+}
+
 } // namespace
 
 #endif // HERMESVM_SAMPLING_PROFILER_AVAILABLE
@@ -271,11 +271,10 @@ TEST_F(StringPrimTest, FastConcatTest) {
   // Append some the first result again.
   cr = StringPrimitive::concat(runtime, resASCII_1, b);
   ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
-  auto resASCII_3 = runtime.makeHandle<BufferedASCIIStringPrimitive>(*cr);
+  auto resASCII_3 = runtime.makeHandle<ConcatASCIIStringPrimitive>(*cr);
 
-  // The buffer cannot be reused.
-  EXPECT_TRUE(
-      resASCII_3->testGetConcatBuffer() != resASCII_1->testGetConcatBuffer());
+  // The buffer cannot be reused, so the result is a rope.
+  EXPECT_EQ(1u, resASCII_3->testGetDepth());
 
   std::string asciiStr3 = asciiStr1 + strB;
   asciiRef = resASCII_3->getStringRef<char>();
@@ -317,15 +316,118 @@ TEST_F(StringPrimTest, FastConcatTest) {
   // Add some more UTF16 to resUTF_1
   cr = StringPrimitive::concat(runtime, resUTF_1, b);
   ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
-  auto resUTF_3 = runtime.makeHandle<BufferedUTF16StringPrimitive>(*cr);
+  auto resUTF_3 = runtime.makeHandle<ConcatUTF16StringPrimitive>(*cr);
 
-  // The buffer cannot be reused.
-  EXPECT_TRUE(
-      resUTF_1->testGetConcatBuffer() != resUTF_3->testGetConcatBuffer());
+  // The buffer cannot be reused, so the result is a rope.
+  EXPECT_EQ(1u, resUTF_3->testGetDepth());
 
   std::u16string utfStr3 = utfStr1 + strC;
   utf16Ref = resUTF_3->getStringRef<char16_t>();
   EXPECT_TRUE(utf16Ref.size() == utfStr3.size());
   EXPECT_TRUE(std::equal(utfStr3.begin(), utfStr3.end(), utf16Ref.begin()));
 }
+
+TEST_F(StringPrimTest, RopeTest) {
+  std::string bigStrA(300, 'a');
+  std::u16string strB(u"utf16\u1234");
+
+  // Prepending to a long string creates a rope.
+  auto a = StringPrimitive::createNoThrow(runtime, bigStrA);
+  auto b = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(strB.data(), strB.size()));
+  auto cr = StringPrimitive::concat(runtime, b, a);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope1 = runtime.makeHandle<ConcatUTF16StringPrimitive>(*cr);
+  EXPECT_EQ(1u, rope1->testGetDepth());
+  EXPECT_FALSE(rope1->isFlat());
+
+  cr = StringPrimitive::concat(runtime, b, rope1);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope2 = runtime.makeHandle<ConcatUTF16StringPrimitive>(*cr);
+  EXPECT_EQ(2u, rope2->testGetDepth());
+
+  std::u16string expected = strB + strB;
+  expected.append(bigStrA.begin(), bigStrA.end());
+
+  // Reading the characters flattens the rope, without releasing its halves.
+  auto ref = rope2->getStringRef<char16_t>();
+  ASSERT_EQ(expected.size(), ref.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), ref.begin()));
+  EXPECT_FALSE(rope2->isFlat());
+  EXPECT_EQ(0u, rope2->testGetDepth());
+
+  // ensureFlat() releases the halves.
+  StringPrimitive::ensureFlat(runtime, rope2);
+  EXPECT_TRUE(rope2->isFlat());
+  EXPECT_TRUE(StringPrimitive::createStringView(runtime, rope2)
+                  .equals(UTF16Ref(expected.data(), expected.size())));
+
+  // Concatenating the flattened rope starts a new rope of depth 1.
+  cr = StringPrimitive::concat(runtime, b, rope2);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_EQ(
+      1u, vmcast<ConcatUTF16StringPrimitive>(*cr)->testGetDepth());
+
+  // Ropes are never deeper than MAX_ROPE_DEPTH.
+  MutableHandle<StringPrimitive> deep{runtime, *a};
+  auto small = StringPrimitive::createNoThrow(runtime, "x");
+  for (uint32_t i = 0; i <= StringPrimitive::MAX_ROPE_DEPTH; ++i) {
+    GCScopeMarkerRAII marker{runtime};
+    cr = StringPrimitive::concat(runtime, small, deep);
+    ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+    deep = vmcast<StringPrimitive>(*cr);
+    if (auto *rope = dyn_vmcast<ConcatASCIIStringPrimitive>(*deep)) {
+      EXPECT_LE(rope->testGetDepth(), StringPrimitive::MAX_ROPE_DEPTH);
+    }
+  }
+  std::string deepExpected(StringPrimitive::MAX_ROPE_DEPTH + 1, 'x');
+  deepExpected += bigStrA;
+  EXPECT_TRUE(StringPrimitive::createStringView(runtime, deep)
+                  .equals(ASCIIRef(deepExpected.data(), deepExpected.size())));
+}
+
+TEST_F(StringPrimTest, SliceTest) {
+  std::string bigStr;
+  for (int i = 0; i < 300; ++i)
+    bigStr.push_back('a' + i % 26);
+  auto str = StringPrimitive::createNoThrow(runtime, bigStr);
+
+  // Short slices are copied.
+  auto cr = StringPrimitive::slice(runtime, str, 10, 20);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_FALSE(vmisa<SlicedASCIIStringPrimitive>(*cr));
+
+  // Long slices refer to the sliced string.
+  cr = StringPrimitive::slice(runtime, str, 10, 200);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto sliced1 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*str, sliced1->testGetParent());
+  EXPECT_TRUE(StringPrimitive::createStringView(runtime, sliced1)
+                  .equals(ASCIIRef(bigStr.data() + 10, 200)));
+
+  // Slicing a sliced string refers to the original string.
+  cr = StringPrimitive::slice(runtime, sliced1, 5, 100);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto sliced2 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*str, sliced2->testGetParent());
+  auto ref = sliced2->getStringRef<char>();
+  EXPECT_TRUE(std::equal(ref.begin(), ref.end(), bigStr.begin() + 15));
+
+  // Slicing a whole string returns it.
+  cr = StringPrimitive::slice(runtime, str, 0, bigStr.size());
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_EQ(*str, vmcast<StringPrimitive>(*cr));
+
+  // Slicing a rope flattens it first.
+  auto small = StringPrimitive::createNoThrow(runtime, "x");
+  cr = StringPrimitive::concat(runtime, small, str);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope = runtime.makeHandle<ConcatASCIIStringPrimitive>(*cr);
+  cr = StringPrimitive::slice(runtime, rope, 1, 100);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_TRUE(rope->isFlat());
+  EXPECT_TRUE(StringPrimitive::createStringView(
+                  runtime, runtime.makeHandle<StringPrimitive>(*cr))
+                  .equals(ASCIIRef(bigStr.data(), 100)));
+}
 } // namespace
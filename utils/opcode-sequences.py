@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+""" Opcode sequence mining.
+
+This script finds the most common sequences of consecutive instructions in a
+corpus of JavaScript sources or bytecode bundles, as candidates for
+superinstructions. JavaScript sources are compiled with hermesc first. The
+sequences of each bundle are counted by the 'sequence' command of hbcdump, and
+summed over the corpus.
+
+Pass --profile to weight the sequences by how often they executed instead. The
+profile of each bundle is expected next to it, in <bundle>.profile. It is the
+trace printed by a build with HERMESVM_PROFILER_BB when running a bundle
+compiled with -basic-block-profiling (see hbcdump -profile-file).
+"""
+
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+
+SEQUENCE_RE = re.compile(r"^([A-Za-z0-9]+(?: [A-Za-z0-9]+)+): (\d+)$")
+
+
+def count_sequences(hbcdump, bundle, max_length, profile):
+    """Returns a Counter of the opcode sequences of the given bundle."""
+    args = [hbcdump, "-c", "sequence {};quit".format(max_length)]
+    if profile:
+        args += ["-profile-file", bundle + ".profile"]
+    output = subprocess.check_output(args + [bundle], universal_newlines=True)
+    counts = collections.Counter()
+    for line in output.splitlines():
+        match = SEQUENCE_RE.match(line)
+        if match:
+            counts[match.group(1)] += int(match.group(2))
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("files", nargs="+", help="JavaScript sources or bundles")
+    parser.add_argument("--hermesc", default="hermesc", help="hermesc binary")
+    parser.add_argument("--hbcdump", default="hbcdump", help="hbcdump binary")
+    parser.add_argument(
+        "--max-length",
+        type=int,
+        default=3,
+        help="longest sequence to count (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--top",
+        type=int,
+        default=30,
+        help="sequences to print for each length (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--profile", action="store_true", help="weight sequences by a profile"
+    )
+    args = parser.parse_args()
+
+    total = collections.Counter()
+    with tempfile.TemporaryDirectory() as tmpdir:
+        for index, path in enumerate(args.files):
+            bundle = path
+            if path.endswith(".js"):
+                bundle = os.path.join(tmpdir, "{}.hbc".format(index))
+                try:
+                    subprocess.check_call(
+                        [args.hermesc, "-O", "-emit-binary", "-out", bundle, path]
+                    )
+                except subprocess.CalledProcessError:
+                    print("Skipping {}: it does not compile".format(path), file=sys.stderr)
+                    continue
+            total.update(
+                count_sequences(args.hbcdump, bundle, args.max_length, args.profile)
+            )
+
+    for length in range(2, args.max_length + 1):
+        sequences = [
+            (count, seq) for seq, count in total.items() if seq.count(" ") == length - 1
+        ]
+        sequences.sort(key=lambda entry: (-entry[0], entry[1]))
+        print("Sequences of {} instructions:".format(length))
+        for count, seq in sequences[: args.top]:
+            print("{:>12}  {}".format(count, seq))
+        print()
+
+
+if __name__ == "__main__":
+    main()